@@ -3,6 +3,7 @@
 
 #include "Luau/Config.h"
 #include "Luau/Module.h"
+#include "Luau/ModuleCache.h"
 #include "Luau/ModuleResolver.h"
 #include "Luau/RequireTracer.h"
 #include "Luau/Scope.h"
@@ -10,6 +11,7 @@
 #include "Luau/TypeInfer.h"
 #include "Luau/Variant.h"
 
+#include <atomic>
 #include <mutex>
 #include <string>
 #include <vector>
@@ -73,6 +75,11 @@ struct SourceNode
     std::string humanReadableName;
     std::unordered_set<ModuleName> requireSet;
     std::vector<std::pair<ModuleName, Location>> requireLocations;
+    uint64_t sourceHash = 0;
+    // Hash of the check options and the interfaces of the required modules at the time the module was checked
+    // Reset when the source is parsed again, since the checked module refers to the previous AST
+    std::optional<uint64_t> earlyCutoffKey;
+    std::optional<uint64_t> earlyCutoffKeyForAutocomplete;
     bool dirtySourceModule = true;
     bool dirtyModule = true;
     bool dirtyModuleForAutocomplete = true;
@@ -129,11 +136,19 @@ struct FrontendModuleResolver : ModuleResolver
     void setModule(const ModuleName& moduleName, ModulePtr module);
     void clearModules();
 
+    // Adds entries for the modules that are going to be set, after which the set of names is fixed until 'unfreezeModuleNames'
+    // While frozen, modules are read and set without a lock, so a module can't be read while it's being set
+    void freezeModuleNames(const std::vector<ModuleName>& names);
+    void unfreezeModuleNames();
+
 private:
     Frontend* frontend;
 
     mutable std::mutex moduleMutex;
     std::unordered_map<ModuleName, ModulePtr> modules;
+
+    // Read without the lock; acquire/release ordering makes the entries added by 'freezeModuleNames' visible to readers that see it set
+    std::atomic<bool> namesFrozen = false;
 };
 
 struct Frontend
@@ -150,6 +165,21 @@ struct Frontend
         double timeParse = 0;
         double timeCheck = 0;
         double timeLint = 0;
+
+        size_t moduleCacheHits = 0;
+        size_t moduleCacheMisses = 0;
+
+        // Dirty modules that were not checked again because the interfaces of the required modules didn't change
+        size_t earlyCutoffHits = 0;
+
+        // Lookups of the normal forms of global types in the cache shared between modules and the time it took to compute the ones found
+        size_t normalizerCacheHits = 0;
+        size_t normalizerCacheMisses = 0;
+        double timeNormalizerCacheSaved = 0;
+
+        // Time that each thread of checkQueuedModulesParallel spent checking modules and the total time of those calls
+        std::vector<double> timeThreadBusy;
+        double timeParallelCheck = 0;
     };
 
     Frontend(FileResolver* fileResolver, ConfigResolver* configResolver, const FrontendOptions& options = {});
@@ -193,6 +223,12 @@ struct Frontend
     std::vector<ModuleName> checkQueuedModules(std::optional<FrontendOptions> optionOverride = {},
         std::function<void(std::function<void()> task)> executeTask = {}, std::function<void(size_t done, size_t total)> progress = {});
 
+    // Checks queued modules on 'threadCount' threads (including the calling one), each of them taking the ready modules from its own queue
+    // first and from the queues of other threads when it runs out; modules with the longest chains of dependents are checked first
+    // 'progress' can be called from any of the threads, but the calls don't overlap
+    std::vector<ModuleName> checkQueuedModulesParallel(unsigned threadCount, std::optional<FrontendOptions> optionOverride = {},
+        std::function<void(size_t done, size_t total)> progress = {});
+
     std::optional<CheckResult> getCheckResult(const ModuleName& name, bool accumulateNested, bool forAutocomplete = false);
 
 private:
@@ -207,9 +243,22 @@ private:
 
     void addBuildQueueItems(std::vector<BuildQueueItem>& items, std::vector<ModuleName>& buildQueue, bool cycleDetected,
         std::unordered_set<Luau::ModuleName>& seen, const FrontendOptions& frontendOptions);
+    void addQueuedModuleItems(std::vector<BuildQueueItem>& items, const FrontendOptions& frontendOptions);
+    void linkBuildQueueItems(std::vector<BuildQueueItem>& items, bool forAutocomplete);
     void checkBuildQueueItem(BuildQueueItem& item);
     void checkBuildQueueItems(std::vector<BuildQueueItem>& items);
     void recordItemResult(const BuildQueueItem& item);
+    void publishItemResult(const BuildQueueItem& item);
+    void recordItemStats(const BuildQueueItem& item);
+
+    void prepareModuleSerializers();
+    std::optional<uint64_t> getRequireInterfaceHash(const BuildQueueItem& item) const;
+    std::optional<uint64_t> getEarlyCutoffKey(const BuildQueueItem& item) const;
+    void recordModuleInterface(const BuildQueueItem& item, Module& module) const;
+
+    std::optional<uint64_t> getModuleCacheKey(const BuildQueueItem& item) const;
+    ModulePtr loadCachedModule(const BuildQueueItem& item, uint64_t key) const;
+    void storeCachedModule(Module& module, uint64_t key) const;
 
     static LintResult classifyLints(const std::vector<LintWarning>& warnings, const Config& config);
 
@@ -220,6 +269,11 @@ private:
 
     BuiltinTypes builtinTypes_;
 
+    std::unique_ptr<ModuleSerializer> moduleSerializer;
+    std::unique_ptr<ModuleSerializer> moduleSerializerForAutocomplete;
+
+    std::unique_ptr<NormalizerSharedCache> normalizerCache;
+
 public:
     const NotNull<BuiltinTypes> builtinTypes;
 
@@ -232,6 +286,10 @@ public:
     GlobalTypes globalsForAutocomplete;
 
     ConfigResolver* configResolver;
+
+    // When set, results of checking modules are stored in and loaded from this cache, see ModuleCacheStore
+    ModuleCacheStore* moduleCacheStore = nullptr;
+
     FrontendOptions options;
     InternalErrorReporter iceHandler;
     std::function<void(const ModuleName& name, const ScopePtr& scope, bool forAutocomplete)> prepareModuleScope;
@@ -253,6 +311,6 @@ ModulePtr check(const SourceModule& sourceModule, const std::vector<RequireCycle
 ModulePtr check(const SourceModule& sourceModule, const std::vector<RequireCycle>& requireCycles, NotNull<BuiltinTypes> builtinTypes,
     NotNull<InternalErrorReporter> iceHandler, NotNull<ModuleResolver> moduleResolver, NotNull<FileResolver> fileResolver,
     const ScopePtr& globalScope, std::function<void(const ModuleName&, const ScopePtr&)> prepareModuleScope, FrontendOptions options,
-    TypeCheckLimits limits, bool recordJsonLog);
+    TypeCheckLimits limits, bool recordJsonLog, NormalizerSharedCache* normalizerCache = nullptr);
 
 } // namespace Luau
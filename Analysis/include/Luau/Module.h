@@ -118,6 +118,14 @@ struct Module
     TypePackId returnType = nullptr;
     std::unordered_map<Name, TypeFun> exportedTypeBindings;
 
+    // Hash of the return type and the exported types, computed when the module is stored in or loaded from the module cache
+    // or when Frontend uses it to skip checking the modules that require this one
+    std::optional<uint64_t> interfaceHash;
+
+    // Types of this module can refer to the types of the required modules, so a module that is reused after its dependencies are
+    // checked again keeps the previous versions alive
+    std::vector<ModulePtr> requiredModules;
+
     bool hasModuleScope() const;
     ScopePtr getModuleScope() const;
 
@@ -0,0 +1,97 @@
+// This file is part of the Luau programming language and is licensed under MIT License; see LICENSE.txt for details
+#pragma once
+
+#include "Luau/DenseHash.h"
+#include "Luau/Module.h"
+#include "Luau/NotNull.h"
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <stdint.h>
+
+namespace Luau
+{
+
+struct BuiltinTypes;
+
+// FNV-1a
+struct ModuleCacheHasher
+{
+    uint64_t value = 14695981039346656037ull;
+
+    void bytes(const void* data, size_t size)
+    {
+        const uint8_t* ptr = static_cast<const uint8_t*>(data);
+
+        for (size_t i = 0; i < size; ++i)
+            value = (value ^ ptr[i]) * 1099511628211ull;
+    }
+
+    template<typename T>
+    void pod(const T& v)
+    {
+        bytes(&v, sizeof(v));
+    }
+
+    void string(std::string_view s)
+    {
+        pod(s.size());
+        bytes(s.data(), s.size());
+    }
+};
+
+// Storage for the results of checking modules, used to skip checking modules that didn't change between runs
+// Frontend computes the key from everything that affects the result: the source, the options and the interfaces of the required modules
+// The methods are called from the threads that check modules, so the implementation has to be thread-safe
+struct ModuleCacheStore
+{
+    virtual ~ModuleCacheStore() {}
+
+    virtual std::optional<std::string> read(uint64_t key) = 0;
+    virtual void write(uint64_t key, const std::string& data) = 0;
+};
+
+// Converts the public interface of a checked module (return type and exported types) and its lint results to bytes and back
+// Types owned by other modules are copied, while builtin types and the types of the global scope are referenced by their position in a
+// traversal of the globals; getGlobalsHash() changes when the traversal does, so it has to be a part of the cache key
+// Modules with type errors are not stored, the errors refer to internal types of the module that the interface doesn't keep
+class ModuleSerializer
+{
+public:
+    ModuleSerializer(NotNull<BuiltinTypes> builtinTypes, const ScopePtr& globalScope);
+
+    uint64_t getGlobalsHash() const
+    {
+        return globalsHash;
+    }
+
+    // Returns false if the module has type errors or refers to types that can't be stored, such as free types or functions with custom type
+    // checking logic
+    // interfaceHash only depends on the return type and the exported types of the module
+    bool serialize(std::string& result, uint64_t& interfaceHash, uint64_t key, const Module& module) const;
+
+    // Returns false if the data is malformed or was stored with a different key
+    bool deserialize(Module& module, uint64_t& interfaceHash, uint64_t key, std::string_view data) const;
+
+    // Computes the same interfaceHash as serialize without storing the lint results
+    bool hashInterface(uint64_t& interfaceHash, const Module& module) const;
+
+private:
+    bool serializeInterface(std::string& result, const Module& module) const;
+
+    void addGlobal(TypeId ty);
+    void addGlobal(TypePackId tp);
+
+    std::vector<TypeId> globalTypes;
+    std::vector<TypePackId> globalTypePacks;
+
+    DenseHashMap<TypeId, uint32_t> globalTypeIndices{nullptr};
+    DenseHashMap<TypePackId, uint32_t> globalTypePackIndices{nullptr};
+
+    uint64_t globalsHash = 0;
+};
+
+} // namespace Luau
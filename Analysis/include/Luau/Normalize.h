@@ -5,7 +5,9 @@
 #include "Luau/Type.h"
 #include "Luau/UnifierSharedState.h"
 
+#include <atomic>
 #include <memory>
+#include <shared_mutex>
 
 namespace Luau
 {
@@ -295,6 +297,52 @@ struct NormalizedType
 };
 
 
+// Normal forms of the types in the global and builtin arenas, shared by the normalizers of all modules
+// Those types are not modified while modules are checked, so their normal forms only have to be computed once
+// Only the normal forms that refer to the shared types alone are stored; the methods can be called from multiple threads
+class NormalizerSharedCache
+{
+public:
+    struct Stats
+    {
+        size_t hits = 0;
+        size_t misses = 0;
+
+        // Time it took to compute the normal forms that were found in the cache
+        double timeSaved = 0;
+    };
+
+    explicit NormalizerSharedCache(std::vector<const TypeArena*> arenas);
+
+    bool isShared(TypeId ty) const;
+    bool isShared(const NormalizedType& norm) const;
+
+    const NormalizedType* find(TypeId ty);
+
+    // If another thread has already stored the normal form of the type, the existing one is returned
+    const NormalizedType* insert(TypeId ty, std::unique_ptr<NormalizedType> norm, double cost);
+
+    void clear();
+
+    // Returns the counters accumulated since the previous call
+    Stats takeStats();
+
+private:
+    struct Entry
+    {
+        std::unique_ptr<NormalizedType> norm;
+        double cost = 0;
+    };
+
+    std::vector<const TypeArena*> arenas;
+
+    std::shared_mutex mutex;
+    std::unordered_map<TypeId, Entry> entries;
+
+    std::atomic<size_t> hits{0};
+    std::atomic<size_t> misses{0};
+    std::atomic<double> timeSaved{0};
+};
 
 class Normalizer
 {
@@ -302,6 +350,7 @@ class Normalizer
     std::unordered_map<const TypeIds*, TypeId> cachedIntersections;
     std::unordered_map<const TypeIds*, TypeId> cachedUnions;
     std::unordered_map<const TypeIds*, std::unique_ptr<TypeIds>> cachedTypeIds;
+    DenseHashMap<TypeId, const NormalizedType*> cachedSharedNormals{nullptr};
 
     DenseHashMap<TypeId, bool> cachedIsInhabited{nullptr};
     DenseHashMap<std::pair<TypeId, TypeId>, bool, TypeIdPairHash> cachedIsInhabitedIntersection{{nullptr, nullptr}};
@@ -314,6 +363,9 @@ public:
     NotNull<UnifierSharedState> sharedState;
     bool cacheInhabitance = false;
 
+    // Optional cache of the normal forms of global types, shared with the normalizers of other modules
+    NormalizerSharedCache* sharedCache = nullptr;
+
     Normalizer(TypeArena* arena, NotNull<BuiltinTypes> builtinTypes, NotNull<UnifierSharedState> sharedState, bool cacheInhabitance = false);
     Normalizer(const Normalizer&) = delete;
     Normalizer(Normalizer&&) = delete;
@@ -53,4 +53,22 @@ struct TypeArena
 void freeze(TypeArena& arena);
 void unfreeze(TypeArena& arena);
 
+// Approximate memory used by the types of an arena, including the memory that they own outside of the arena
+struct TypeArenaMemoryUsage
+{
+    // Indexed by the alternative of TypeVariant, see getTypeKindName
+    std::vector<size_t> typeCounts;
+    std::vector<size_t> typeBytes;
+
+    size_t typePackCount = 0;
+    size_t typePackBytes = 0;
+
+    size_t getTotalBytes() const;
+    void add(const TypeArenaMemoryUsage& other);
+};
+
+TypeArenaMemoryUsage getMemoryUsage(const TypeArena& arena);
+
+const char* getTypeKindName(size_t index);
+
 } // namespace Luau
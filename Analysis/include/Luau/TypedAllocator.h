@@ -73,6 +73,18 @@ public:
         return stuff.empty() ? 0 : kBlockSize * (stuff.size() - 1) + currentBlockSize;
     }
 
+    template<typename F>
+    void forEach(F&& f) const
+    {
+        for (const T* block : stuff)
+        {
+            size_t blockSize = (block == stuff.back()) ? currentBlockSize : kBlockSize;
+
+            for (size_t i = 0; i < blockSize; ++i)
+                f(block[i]);
+        }
+    }
+
     void clear()
     {
         if (frozen)
@@ -106,7 +106,11 @@ private:
     static int nextIndex;
 };
 
+// Types and type packs keep their large alternatives, like tables and functions, out of line, so that a Type is sized for the common case
+// Note that these live outside of the arena pages, so DebugLuauFreezeArena doesn't write-protect them
+inline constexpr size_t kVariantInlineSize = 64;
+
 template<typename Id, typename... Value>
-using Variant = Luau::Variant<Bound<Id>, Error, Value...>;
+using Variant = Luau::BasicVariant<kVariantInlineSize, Bound<Id>, Error, Value...>;
 
 } // namespace Luau::Unifiable
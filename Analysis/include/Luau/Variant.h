@@ -11,8 +11,18 @@
 namespace Luau
 {
 
-template<typename... Ts>
-class Variant
+template<typename T, bool Boxed>
+T* getVariantValue(std::conditional_t<std::is_const_v<T>, const void, void>* storage)
+{
+    if constexpr (Boxed)
+        return *static_cast<T* const*>(storage);
+    else
+        return static_cast<T*>(storage);
+}
+
+// Alternatives that are larger than MaxInlineSize are allocated separately, so that the variant isn't as large as its largest alternative
+template<size_t MaxInlineSize, typename... Ts>
+class BasicVariant
 {
     static_assert(sizeof...(Ts) > 0, "variant must have at least 1 type (empty variants are ill-formed)");
     static_assert(std::disjunction_v<std::is_void<Ts>...> == false, "variant does not allow void as an alternative type");
@@ -44,24 +54,35 @@ private:
 public:
     using first_alternative = typename First<Ts...>::type;
 
-    Variant()
+    template<typename T>
+    static constexpr bool isBoxed = sizeof(T) > MaxInlineSize;
+
+    BasicVariant()
     {
         static_assert(std::is_default_constructible_v<first_alternative>, "first alternative type must be default constructible");
         typeId = 0;
-        new (&storage) first_alternative();
+
+        if constexpr (isBoxed<first_alternative>)
+            new (&storage) first_alternative*(new first_alternative());
+        else
+            new (&storage) first_alternative();
     }
 
     template<typename T>
-    Variant(T&& value, std::enable_if_t<getTypeId<T>() >= 0>* = 0)
+    BasicVariant(T&& value, std::enable_if_t<getTypeId<T>() >= 0>* = 0)
     {
         using TT = std::decay_t<T>;
 
         constexpr int tid = getTypeId<T>();
         typeId = tid;
-        new (&storage) TT(std::forward<T>(value));
+
+        if constexpr (isBoxed<TT>)
+            new (&storage) TT*(new TT(std::forward<T>(value)));
+        else
+            new (&storage) TT(std::forward<T>(value));
     }
 
-    Variant(const Variant& other)
+    BasicVariant(const BasicVariant& other)
     {
         static constexpr FnCopy table[sizeof...(Ts)] = {&fnCopy<Ts>...};
 
@@ -69,31 +90,34 @@ public:
         table[typeId](&storage, &other.storage);
     }
 
-    Variant(Variant&& other)
+    BasicVariant(BasicVariant&& other)
     {
         typeId = other.typeId;
         tableMove[typeId](&storage, &other.storage);
     }
 
-    ~Variant()
+    ~BasicVariant()
     {
         tableDtor[typeId](&storage);
     }
 
-    Variant& operator=(const Variant& other)
+    BasicVariant& operator=(const BasicVariant& other)
     {
-        Variant copy(other);
-        // static_cast<T&&> is equivalent to std::move() but faster in Debug
-        return *this = static_cast<Variant&&>(copy);
+        if (this != &other)
+        {
+            BasicVariant copy(other);
+            assign(copy);
+        }
+        return *this;
     }
 
-    Variant& operator=(Variant&& other)
+    BasicVariant& operator=(BasicVariant&& other)
     {
         if (this != &other)
         {
-            tableDtor[typeId](&storage);
-            typeId = other.typeId;
-            tableMove[typeId](&storage, &other.storage); // nothrow
+            // static_cast<T&&> is equivalent to std::move() but faster in Debug
+            BasicVariant value(static_cast<BasicVariant&&>(other));
+            assign(value);
         }
         return *this;
     }
@@ -105,11 +129,28 @@ public:
         constexpr int tid = getTypeId<T>();
         static_assert(tid >= 0, "unsupported T");
 
-        tableDtor[typeId](&storage);
-        typeId = tid;
-        new (&storage) TT{std::forward<Args>(args)...};
+        if constexpr (isBoxed<TT>)
+        {
+            // The allocation is reused when the alternative doesn't change, so that pointers to the value stay valid as they would inline
+            if (typeId == tid)
+            {
+                TT* value = getVariantValue<TT, true>(&storage);
+                value->~TT();
+                return *new (value) TT{std::forward<Args>(args)...};
+            }
+
+            tableDtor[typeId](&storage);
+            typeId = tid;
+            new (&storage) TT*(new TT{std::forward<Args>(args)...});
+        }
+        else
+        {
+            tableDtor[typeId](&storage);
+            typeId = tid;
+            new (&storage) TT{std::forward<Args>(args)...};
+        }
 
-        return *reinterpret_cast<T*>(&storage);
+        return *getVariantValue<TT, isBoxed<TT>>(&storage);
     }
 
     template<typename T>
@@ -118,7 +159,10 @@ public:
         constexpr int tid = getTypeId<T>();
         static_assert(tid >= 0, "unsupported T");
 
-        return tid == typeId ? reinterpret_cast<const T*>(&storage) : nullptr;
+        if constexpr (isBoxed<T>)
+            return tid == typeId ? *reinterpret_cast<const T* const*>(&storage) : nullptr;
+        else
+            return tid == typeId ? reinterpret_cast<const T*>(&storage) : nullptr;
     }
 
     template<typename T>
@@ -127,7 +171,10 @@ public:
         constexpr int tid = getTypeId<T>();
         static_assert(tid >= 0, "unsupported T");
 
-        return tid == typeId ? reinterpret_cast<T*>(&storage) : nullptr;
+        if constexpr (isBoxed<T>)
+            return tid == typeId ? *reinterpret_cast<T**>(&storage) : nullptr;
+        else
+            return tid == typeId ? reinterpret_cast<T*>(&storage) : nullptr;
     }
 
     bool valueless_by_exception() const
@@ -140,14 +187,14 @@ public:
         return typeId;
     }
 
-    bool operator==(const Variant& other) const
+    bool operator==(const BasicVariant& other) const
     {
         static constexpr FnPred table[sizeof...(Ts)] = {&fnPredEq<Ts>...};
 
         return typeId == other.typeId && table[typeId](&storage, &other.storage);
     }
 
-    bool operator!=(const Variant& other) const
+    bool operator!=(const BasicVariant& other) const
     {
         return !(*this == other);
     }
@@ -161,8 +208,8 @@ private:
         return res;
     }
 
-    static constexpr size_t storageSize = cmax({sizeof(Ts)...});
-    static constexpr size_t storageAlign = cmax({alignof(Ts)...});
+    static constexpr size_t storageSize = cmax({isBoxed<Ts> ? sizeof(void*) : sizeof(Ts)...});
+    static constexpr size_t storageAlign = cmax({isBoxed<Ts> ? alignof(void*) : alignof(Ts)...});
 
     using FnCopy = void (*)(void*, const void*);
     using FnMove = void (*)(void*, void*);
@@ -172,84 +219,141 @@ private:
     template<typename T>
     static void fnCopy(void* dst, const void* src)
     {
-        new (dst) T(*static_cast<const T*>(src));
+        if constexpr (isBoxed<T>)
+            new (dst) T*(new T(*getVariantValue<const T, isBoxed<T>>(src)));
+        else
+            new (dst) T(*static_cast<const T*>(src));
     }
 
+    // Like the inline alternatives, a separately allocated one is moved into a new allocation and the source keeps the moved-from value
     template<typename T>
     static void fnMove(void* dst, void* src)
     {
         // static_cast<T&&> is equivalent to std::move() but faster in Debug
-        new (dst) T(static_cast<T&&>(*static_cast<T*>(src)));
+        if constexpr (isBoxed<T>)
+            new (dst) T*(new T(static_cast<T&&>(*getVariantValue<T, isBoxed<T>>(src))));
+        else
+            new (dst) T(static_cast<T&&>(*static_cast<T*>(src)));
+    }
+
+    // Takes the allocation of a separately allocated alternative, which leaves the source only to be destroyed
+    template<typename T>
+    static void fnSteal(void* dst, void* src)
+    {
+        if constexpr (isBoxed<T>)
+        {
+            new (dst) T*(*static_cast<T**>(src));
+            *static_cast<T**>(src) = nullptr;
+        }
+        else
+        {
+            new (dst) T(static_cast<T&&>(*static_cast<T*>(src)));
+        }
+    }
+
+    // Replaces a value with one of the same alternative; a separately allocated value is rebuilt in its allocation, like an inline one
+    template<typename T>
+    static void fnReplace(void* dst, void* src)
+    {
+        T* value = getVariantValue<T, isBoxed<T>>(dst);
+        value->~T();
+        new (value) T(static_cast<T&&>(*getVariantValue<T, isBoxed<T>>(src)));
     }
 
     template<typename T>
     static void fnDtor(void* dst)
     {
-        static_cast<T*>(dst)->~T();
+        if constexpr (isBoxed<T>)
+            delete *static_cast<T**>(dst);
+        else
+            static_cast<T*>(dst)->~T();
     }
 
     template<typename T>
     static bool fnPredEq(const void* lhs, const void* rhs)
     {
-        return *static_cast<const T*>(lhs) == *static_cast<const T*>(rhs);
+        return *getVariantValue<const T, isBoxed<T>>(lhs) == *getVariantValue<const T, isBoxed<T>>(rhs);
     }
 
     static constexpr FnMove tableMove[sizeof...(Ts)] = {&fnMove<Ts>...};
+    static constexpr FnMove tableSteal[sizeof...(Ts)] = {&fnSteal<Ts>...};
+    static constexpr FnMove tableReplace[sizeof...(Ts)] = {&fnReplace<Ts>...};
     static constexpr FnDtor tableDtor[sizeof...(Ts)] = {&fnDtor<Ts>...};
 
+    // Replaces the value with the one of a temporary variant, which is left to be destroyed
+    void assign(BasicVariant& value)
+    {
+        if (typeId == value.typeId)
+        {
+            tableReplace[typeId](&storage, &value.storage); // nothrow
+        }
+        else
+        {
+            tableDtor[typeId](&storage);
+            typeId = value.typeId;
+            tableSteal[typeId](&storage, &value.storage); // nothrow
+        }
+    }
+
     int typeId;
     alignas(storageAlign) char storage[storageSize];
 
-    template<class Visitor, typename... _Ts>
-    friend auto visit(Visitor&& vis, const Variant<_Ts...>& var);
-    template<class Visitor, typename... _Ts>
-    friend auto visit(Visitor&& vis, Variant<_Ts...>& var);
+    template<class Visitor, size_t _MaxInlineSize, typename... _Ts>
+    friend auto visit(Visitor&& vis, const BasicVariant<_MaxInlineSize, _Ts...>& var);
+    template<class Visitor, size_t _MaxInlineSize, typename... _Ts>
+    friend auto visit(Visitor&& vis, BasicVariant<_MaxInlineSize, _Ts...>& var);
 };
 
-template<typename T, typename... Ts>
-const T* get_if(const Variant<Ts...>* var)
+// Alternatives are always stored inline
+template<typename... Ts>
+using Variant = BasicVariant<~size_t(0), Ts...>;
+
+template<typename T, size_t MaxInlineSize, typename... Ts>
+const T* get_if(const BasicVariant<MaxInlineSize, Ts...>* var)
 {
     return var ? var->template get_if<T>() : nullptr;
 }
 
-template<typename T, typename... Ts>
-T* get_if(Variant<Ts...>* var)
+template<typename T, size_t MaxInlineSize, typename... Ts>
+T* get_if(BasicVariant<MaxInlineSize, Ts...>* var)
 {
     return var ? var->template get_if<T>() : nullptr;
 }
 
-template<typename Visitor, typename Result, typename T>
+template<typename Visitor, typename Result, typename T, bool Boxed>
 static void fnVisitR(Visitor& vis, Result& dst, std::conditional_t<std::is_const_v<T>, const void, void>* src)
 {
-    dst = vis(*static_cast<T*>(src));
+    dst = vis(*getVariantValue<T, Boxed>(src));
 }
 
-template<typename Visitor, typename T>
+template<typename Visitor, typename T, bool Boxed>
 static void fnVisitV(Visitor& vis, std::conditional_t<std::is_const_v<T>, const void, void>* src)
 {
-    vis(*static_cast<T*>(src));
+    vis(*getVariantValue<T, Boxed>(src));
 }
 
-template<class Visitor, typename... Ts>
-auto visit(Visitor&& vis, const Variant<Ts...>& var)
+template<class Visitor, size_t MaxInlineSize, typename... Ts>
+auto visit(Visitor&& vis, const BasicVariant<MaxInlineSize, Ts...>& var)
 {
+    using V = BasicVariant<MaxInlineSize, Ts...>;
+
     static_assert(std::conjunction_v<std::is_invocable<Visitor, Ts>...>, "visitor must accept every alternative as an argument");
 
-    using Result = std::invoke_result_t<Visitor, typename Variant<Ts...>::first_alternative>;
+    using Result = std::invoke_result_t<Visitor, typename V::first_alternative>;
     static_assert(std::conjunction_v<std::is_same<Result, std::invoke_result_t<Visitor, Ts>>...>,
         "visitor result type must be consistent between alternatives");
 
     if constexpr (std::is_same_v<Result, void>)
     {
         using FnVisitV = void (*)(Visitor&, const void*);
-        static const FnVisitV tableVisit[sizeof...(Ts)] = {&fnVisitV<Visitor, const Ts>...};
+        static const FnVisitV tableVisit[sizeof...(Ts)] = {&fnVisitV<Visitor, const Ts, V::template isBoxed<Ts>>...};
 
         tableVisit[var.typeId](vis, &var.storage);
     }
     else
     {
         using FnVisitR = void (*)(Visitor&, Result&, const void*);
-        static const FnVisitR tableVisit[sizeof...(Ts)] = {&fnVisitR<Visitor, Result, const Ts>...};
+        static const FnVisitR tableVisit[sizeof...(Ts)] = {&fnVisitR<Visitor, Result, const Ts, V::template isBoxed<Ts>>...};
 
         Result res;
         tableVisit[var.typeId](vis, res, &var.storage);
@@ -257,26 +361,28 @@ auto visit(Visitor&& vis, const Variant<Ts...>& var)
     }
 }
 
-template<class Visitor, typename... Ts>
-auto visit(Visitor&& vis, Variant<Ts...>& var)
+template<class Visitor, size_t MaxInlineSize, typename... Ts>
+auto visit(Visitor&& vis, BasicVariant<MaxInlineSize, Ts...>& var)
 {
+    using V = BasicVariant<MaxInlineSize, Ts...>;
+
     static_assert(std::conjunction_v<std::is_invocable<Visitor, Ts&>...>, "visitor must accept every alternative as an argument");
 
-    using Result = std::invoke_result_t<Visitor, typename Variant<Ts...>::first_alternative&>;
+    using Result = std::invoke_result_t<Visitor, typename V::first_alternative&>;
     static_assert(std::conjunction_v<std::is_same<Result, std::invoke_result_t<Visitor, Ts&>>...>,
         "visitor result type must be consistent between alternatives");
 
     if constexpr (std::is_same_v<Result, void>)
     {
         using FnVisitV = void (*)(Visitor&, void*);
-        static const FnVisitV tableVisit[sizeof...(Ts)] = {&fnVisitV<Visitor, Ts>...};
+        static const FnVisitV tableVisit[sizeof...(Ts)] = {&fnVisitV<Visitor, Ts, V::template isBoxed<Ts>>...};
 
         tableVisit[var.typeId](vis, &var.storage);
     }
     else
     {
         using FnVisitR = void (*)(Visitor&, Result&, void*);
-        static const FnVisitR tableVisit[sizeof...(Ts)] = {&fnVisitR<Visitor, Result, Ts>...};
+        static const FnVisitR tableVisit[sizeof...(Ts)] = {&fnVisitR<Visitor, Result, Ts, V::template isBoxed<Ts>>...};
 
         Result res;
         tableVisit[var.typeId](vis, res, &var.storage);
@@ -2334,7 +2334,6 @@ ConstraintGraphBuilder::FunctionSignature ConstraintGraphBuilder::checkFunctionS
 
     std::vector<TypeId> argTypes;
     std::vector<std::optional<FunctionArgument>> argNames;
-    TypePack expectedArgPack;
 
     const FunctionType* expectedFunction = expectedType ? get<FunctionType>(*expectedType) : nullptr;
     // This check ensures that expectedType is precisely optional and not any (since any is also an optional type)
@@ -2351,10 +2350,11 @@ ConstraintGraphBuilder::FunctionSignature ConstraintGraphBuilder::checkFunctionS
         }
     }
 
+    // Initialized in one go, which avoids a gcc 12 warning: expectedArgPack.tail may be used uninitialized
+    TypePack expectedArgPack = expectedFunction ? extendTypePack(*arena, builtinTypes, expectedFunction->argTypes, fn->args.size) : TypePack{};
+
     if (expectedFunction)
     {
-        expectedArgPack = extendTypePack(*arena, builtinTypes, expectedFunction->argTypes, fn->args.size);
-
         genericTypes = expectedFunction->generics;
         genericTypePacks = expectedFunction->genericPacks;
     }
@@ -19,12 +19,14 @@
 #include "Luau/Variant.h"
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
 #include <exception>
 #include <mutex>
 #include <stdexcept>
 #include <string>
+#include <thread>
 
 LUAU_FASTINT(LuauTypeInferIterationLimit)
 LUAU_FASTINT(LuauTypeInferRecursionLimit)
@@ -36,6 +38,8 @@ LUAU_FASTFLAGVARIABLE(DebugLuauDeferredConstraintResolution, false)
 LUAU_FASTFLAGVARIABLE(DebugLuauLogSolverToJson, false)
 LUAU_FASTFLAGVARIABLE(DebugLuauReadWriteProperties, false)
 LUAU_FASTFLAGVARIABLE(LuauTypecheckLimitControls, false)
+LUAU_FASTFLAGVARIABLE(LuauFrontendEarlyCutoff, false)
+LUAU_FASTFLAGVARIABLE(LuauNormalizerSharedCache, false)
 
 namespace Luau
 {
@@ -62,6 +66,7 @@ struct BuildQueueItem
     // Result
     std::exception_ptr exception;
     ModulePtr module;
+    std::optional<uint64_t> earlyCutoffKey;
     Frontend::Stats stats;
 };
 
@@ -174,6 +179,9 @@ LoadDefinitionFileResult Frontend::loadDefinitionFile(GlobalTypes& globals, Scop
 
     persistCheckedTypes(checkedModule, globals, targetScope, packageName);
 
+    // Global types might have changed
+    normalizerCache->clear();
+
     return LoadDefinitionFileResult{true, parseResult, sourceModule, checkedModule};
 }
 
@@ -401,6 +409,12 @@ double getTimestamp()
     return double(duration_cast<nanoseconds>(high_resolution_clock::now().time_since_epoch()).count()) / 1e9;
 }
 
+// Module cache serializes properties in the form that is used by the old solver
+bool canUseModuleCache()
+{
+    return !FFlag::DebugLuauDeferredConstraintResolution && !FFlag::DebugLuauReadWriteProperties;
+}
+
 } // namespace
 
 Frontend::Frontend(FileResolver* fileResolver, ConfigResolver* configResolver, const FrontendOptions& options)
@@ -413,6 +427,9 @@ Frontend::Frontend(FileResolver* fileResolver, ConfigResolver* configResolver, c
     , configResolver(configResolver)
     , options(options)
 {
+    // Builtin types that are not persistent, like the string metatable, are allocated in the same arena as the persistent ones
+    normalizerCache = std::make_unique<NormalizerSharedCache>(
+        std::vector<const TypeArena*>{builtinTypes->nilType->owningArena, &globals.globalTypes, &globalsForAutocomplete.globalTypes});
 }
 
 void Frontend::parse(const ModuleName& name)
@@ -451,6 +468,8 @@ CheckResult Frontend::check(const ModuleName& name, std::optional<FrontendOption
         buildQueueItems.back().recordJsonLog = true;
     }
 
+    prepareModuleSerializers();
+
     checkBuildQueueItems(buildQueueItems);
 
     // Collect results only for checked modules, 'getCheckResult' produces a different result
@@ -484,17 +503,13 @@ void Frontend::queueModuleCheck(const ModuleName& name)
     moduleQueue.push_back(name);
 }
 
-std::vector<ModuleName> Frontend::checkQueuedModules(std::optional<FrontendOptions> optionOverride,
-    std::function<void(std::function<void()> task)> executeTask, std::function<void(size_t done, size_t total)> progress)
+void Frontend::addQueuedModuleItems(std::vector<BuildQueueItem>& items, const FrontendOptions& frontendOptions)
 {
-    FrontendOptions frontendOptions = optionOverride.value_or(options);
-
     // By taking data into locals, we make sure queue is cleared at the end, even if an ICE or a different exception is thrown
     std::vector<ModuleName> currModuleQueue;
     std::swap(currModuleQueue, moduleQueue);
 
     std::unordered_set<Luau::ModuleName> seen;
-    std::vector<BuildQueueItem> buildQueueItems;
 
     for (const ModuleName& name : currModuleQueue)
     {
@@ -512,21 +527,55 @@ std::vector<ModuleName> Frontend::checkQueuedModules(std::optional<FrontendOptio
             return seen.count(name);
         });
 
-        addBuildQueueItems(buildQueueItems, queue, cycleDetected, seen, frontendOptions);
+        addBuildQueueItems(items, queue, cycleDetected, seen, frontendOptions);
     }
+}
 
-    if (buildQueueItems.empty())
-        return {};
-
+// Records the dependencies of each item that have to be checked before it
+void Frontend::linkBuildQueueItems(std::vector<BuildQueueItem>& items, bool forAutocomplete)
+{
     // We need a mapping from modules to build queue slots
     std::unordered_map<ModuleName, size_t> moduleNameToQueue;
 
-    for (size_t i = 0; i < buildQueueItems.size(); i++)
+    for (size_t i = 0; i < items.size(); i++)
     {
-        BuildQueueItem& item = buildQueueItems[i];
+        BuildQueueItem& item = items[i];
         moduleNameToQueue[item.name] = i;
     }
 
+    for (size_t i = 0; i < items.size(); i++)
+    {
+        BuildQueueItem& item = items[i];
+
+        for (const ModuleName& dep : item.sourceNode->requireSet)
+        {
+            if (auto it = sourceNodes.find(dep); it != sourceNodes.end())
+            {
+                if (it->second->hasDirtyModule(forAutocomplete))
+                {
+                    item.dirtyDependencies++;
+
+                    items[moduleNameToQueue[dep]].reverseDeps.push_back(i);
+                }
+            }
+        }
+    }
+}
+
+std::vector<ModuleName> Frontend::checkQueuedModules(std::optional<FrontendOptions> optionOverride,
+    std::function<void(std::function<void()> task)> executeTask, std::function<void(size_t done, size_t total)> progress)
+{
+    FrontendOptions frontendOptions = optionOverride.value_or(options);
+
+    std::vector<BuildQueueItem> buildQueueItems;
+    addQueuedModuleItems(buildQueueItems, frontendOptions);
+
+    if (buildQueueItems.empty())
+        return {};
+
+    prepareModuleSerializers();
+    linkBuildQueueItems(buildQueueItems, frontendOptions.forAutocomplete);
+
     // Default task execution is single-threaded and immediate
     if (!executeTask)
     {
@@ -586,25 +635,10 @@ std::vector<ModuleName> Frontend::checkQueuedModules(std::optional<FrontendOptio
         }
     };
 
-    // In a first pass, check modules that have no dependencies and record info of those modules that wait
+    // In a first pass, check modules that have no dependencies
     for (size_t i = 0; i < buildQueueItems.size(); i++)
     {
-        BuildQueueItem& item = buildQueueItems[i];
-
-        for (const ModuleName& dep : item.sourceNode->requireSet)
-        {
-            if (auto it = sourceNodes.find(dep); it != sourceNodes.end())
-            {
-                if (it->second->hasDirtyModule(frontendOptions.forAutocomplete))
-                {
-                    item.dirtyDependencies++;
-
-                    buildQueueItems[moduleNameToQueue[dep]].reverseDeps.push_back(i);
-                }
-            }
-        }
-
-        if (item.dirtyDependencies == 0)
+        if (buildQueueItems[i].dirtyDependencies == 0)
             sendItemTask(i);
     }
 
@@ -700,6 +734,275 @@ std::vector<ModuleName> Frontend::checkQueuedModules(std::optional<FrontendOptio
     return checkedModules;
 }
 
+std::vector<ModuleName> Frontend::checkQueuedModulesParallel(
+    unsigned threadCount, std::optional<FrontendOptions> optionOverride, std::function<void(size_t done, size_t total)> progress)
+{
+    LUAU_TIMETRACE_SCOPE("Frontend::checkQueuedModulesParallel", "Frontend");
+
+    FrontendOptions frontendOptions = optionOverride.value_or(options);
+
+    std::vector<BuildQueueItem> buildQueueItems;
+    addQueuedModuleItems(buildQueueItems, frontendOptions);
+
+    if (buildQueueItems.empty())
+        return {};
+
+    prepareModuleSerializers();
+    linkBuildQueueItems(buildQueueItems, frontendOptions.forAutocomplete);
+
+    size_t itemCount = buildQueueItems.size();
+    threadCount = std::max(1u, unsigned(std::min(size_t(threadCount), itemCount)));
+
+    // Priority of an item is the length of the longest chain of its dependents, measured in lines as an estimate of the time to check them
+    // Items are listed after their dependencies, except in cycles, where the priority doesn't include some of the dependents
+    std::vector<size_t> priorities(itemCount);
+
+    for (size_t i = itemCount; i-- > 0;)
+    {
+        const BuildQueueItem& item = buildQueueItems[i];
+
+        size_t dependentsPriority = 0;
+
+        for (size_t reverseDep : item.reverseDeps)
+            dependentsPriority = std::max(dependentsPriority, priorities[reverseDep]);
+
+        priorities[i] = item.sourceModule->root->location.end.line + 1 + dependentsPriority;
+    }
+
+    auto lowerPriority = [&priorities](size_t lhs, size_t rhs) {
+        return priorities[lhs] < priorities[rhs];
+    };
+
+    struct ThreadQueue
+    {
+        std::mutex mtx;
+        std::vector<size_t> heap;
+    };
+
+    std::vector<ThreadQueue> threadQueues(threadCount);
+    std::vector<double> threadBusy(threadCount);
+
+    std::vector<std::atomic<int>> dirtyDependencies(itemCount);
+    std::vector<std::atomic<bool>> scheduled(itemCount);
+
+    for (size_t i = 0; i < itemCount; i++)
+        dirtyDependencies[i] = buildQueueItems[i].dirtyDependencies;
+
+    // Items that were added to the queues and aren't done yet
+    std::atomic<size_t> active = 0;
+    // Items in the queues, never lower than the total size of the queues
+    std::atomic<size_t> queued = 0;
+    std::atomic<size_t> done = 0;
+    std::atomic<size_t> sleeping = 0;
+    std::atomic<bool> stop = false;
+
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::mutex progressMtx;
+
+    auto enqueue = [&](unsigned thread, size_t i) {
+        if (scheduled[i].exchange(true))
+            return false;
+
+        active++;
+        queued++;
+
+        ThreadQueue& queue = threadQueues[thread];
+
+        std::unique_lock guard(queue.mtx);
+        queue.heap.push_back(i);
+        std::push_heap(queue.heap.begin(), queue.heap.end(), lowerPriority);
+        return true;
+    };
+
+    auto push = [&](unsigned thread, size_t i) {
+        if (enqueue(thread, i) && sleeping != 0)
+        {
+            std::unique_lock guard(mtx);
+            cv.notify_one();
+        }
+    };
+
+    auto take = [&](unsigned thread) -> std::optional<size_t> {
+        for (unsigned k = 0; k < threadCount; k++)
+        {
+            // Other queues are only checked when there is something to take
+            if (k != 0 && queued == 0)
+                break;
+
+            ThreadQueue& queue = threadQueues[(thread + k) % threadCount];
+
+            std::unique_lock guard(queue.mtx);
+
+            if (!queue.heap.empty())
+            {
+                std::pop_heap(queue.heap.begin(), queue.heap.end(), lowerPriority);
+                size_t i = queue.heap.back();
+                queue.heap.pop_back();
+
+                queued--;
+                return i;
+            }
+        }
+
+        return std::nullopt;
+    };
+
+    auto run = [&](unsigned thread, size_t i) {
+        BuildQueueItem& item = buildQueueItems[i];
+
+        // If an exception was thrown or the check was cancelled, remaining items are dropped
+        if (!stop)
+        {
+            double timestamp = getTimestamp();
+
+            try
+            {
+                checkBuildQueueItem(item);
+            }
+            catch (...)
+            {
+                item.exception = std::current_exception();
+            }
+
+            threadBusy[thread] += getTimestamp() - timestamp;
+
+            if (item.exception || (item.module && item.module->cancelled))
+            {
+                stop = true;
+            }
+            else
+            {
+                // Dependents can only start after the module is available to them
+                publishItemResult(item);
+
+                for (size_t reverseDep : item.reverseDeps)
+                {
+                    if (--dirtyDependencies[reverseDep] == 0)
+                        push(thread, reverseDep);
+                }
+
+                size_t doneCount = ++done;
+
+                if (progress)
+                {
+                    std::unique_lock guard(progressMtx);
+                    progress(doneCount, itemCount);
+                }
+            }
+        }
+
+        if (--active == 0)
+        {
+            std::unique_lock guard(mtx);
+            cv.notify_all();
+        }
+    };
+
+    auto threadFunction = [&](unsigned thread) {
+        for (;;)
+        {
+            if (std::optional<size_t> i = take(thread))
+            {
+                run(thread, *i);
+                continue;
+            }
+
+            std::unique_lock guard(mtx);
+
+            if (active == 0)
+            {
+                if (done == itemCount || stop)
+                    break;
+
+                // Remaining items wait for each other, which means that we hit a cycle
+                for (size_t i = 0; i < itemCount; i++)
+                {
+                    if (!scheduled[i] && enqueue(thread, i))
+                        break;
+                }
+
+                continue;
+            }
+
+            sleeping++;
+
+            cv.wait(guard, [&] {
+                return queued != 0 || active == 0;
+            });
+
+            sleeping--;
+        }
+    };
+
+    for (size_t i = 0; i < itemCount; i++)
+    {
+        if (buildQueueItems[i].dirtyDependencies == 0)
+            enqueue(unsigned(i % threadCount), i);
+    }
+
+    FrontendModuleResolver& resolver = frontendOptions.forAutocomplete ? moduleResolverForAutocomplete : moduleResolver;
+
+    std::vector<ModuleName> itemNames;
+    itemNames.reserve(itemCount);
+
+    for (const BuildQueueItem& item : buildQueueItems)
+        itemNames.push_back(item.name);
+
+    resolver.freezeModuleNames(itemNames);
+
+    double timestamp = getTimestamp();
+
+    {
+        std::vector<std::thread> threads;
+
+        for (unsigned thread = 1; thread < threadCount; thread++)
+        {
+            threads.emplace_back([&threadFunction, thread] {
+                threadFunction(thread);
+            });
+        }
+
+        threadFunction(0);
+
+        for (std::thread& thread : threads)
+            thread.join();
+    }
+
+    resolver.unfreezeModuleNames();
+
+    stats.timeParallelCheck += getTimestamp() - timestamp;
+
+    if (stats.timeThreadBusy.size() < threadCount)
+        stats.timeThreadBusy.resize(threadCount);
+
+    for (unsigned thread = 0; thread < threadCount; thread++)
+        stats.timeThreadBusy[thread] += threadBusy[thread];
+
+    std::exception_ptr exception;
+
+    for (const BuildQueueItem& item : buildQueueItems)
+    {
+        // Typechecking might have been cancelled by user, don't return partial results
+        if (item.module && item.module->cancelled)
+            return {};
+
+        if (item.exception && !exception)
+            exception = item.exception;
+    }
+
+    for (const BuildQueueItem& item : buildQueueItems)
+    {
+        if (item.module && !item.exception)
+            recordItemStats(item);
+    }
+
+    if (exception)
+        std::rethrow_exception(exception);
+
+    return itemNames;
+}
+
 std::optional<CheckResult> Frontend::getCheckResult(const ModuleName& name, bool accumulateNested, bool forAutocomplete)
 {
     auto it = sourceNodes.find(name);
@@ -892,6 +1195,27 @@ void Frontend::checkBuildQueueItem(BuildQueueItem& item)
     double timestamp = getTimestamp();
     const std::vector<RequireCycle>& requireCycles = item.requireCycles;
 
+    if (FFlag::LuauFrontendEarlyCutoff)
+    {
+        item.earlyCutoffKey = getEarlyCutoffKey(item);
+
+        // markDirty doesn't parse the dependents again, so when the required modules kept their interfaces, the previous result is still valid
+        std::optional<uint64_t> previousKey = item.options.forAutocomplete ? sourceNode.earlyCutoffKeyForAutocomplete : sourceNode.earlyCutoffKey;
+
+        if (item.earlyCutoffKey && item.earlyCutoffKey == previousKey)
+        {
+            const FrontendModuleResolver& resolver = item.options.forAutocomplete ? moduleResolverForAutocomplete : moduleResolver;
+
+            if (ModulePtr module = resolver.getModule(item.name))
+            {
+                item.stats.earlyCutoffHits++;
+
+                item.module = module;
+                return;
+            }
+        }
+    }
+
     TypeCheckLimits typeCheckLimits;
 
     if (FFlag::LuauTypecheckLimitControls)
@@ -975,10 +1299,39 @@ void Frontend::checkBuildQueueItem(BuildQueueItem& item)
         item.stats.timeCheck += duration;
         item.stats.filesStrict += 1;
 
+        recordModuleInterface(item, *moduleForAutocomplete);
+
         item.module = moduleForAutocomplete;
         return;
     }
 
+    std::optional<uint64_t> cacheKey;
+
+    if (moduleCacheStore)
+    {
+        cacheKey = getModuleCacheKey(item);
+
+        if (ModulePtr module = cacheKey ? loadCachedModule(item, *cacheKey) : nullptr)
+        {
+            ErrorVec parseErrors;
+
+            for (const ParseError& pe : sourceModule.parseErrors)
+                parseErrors.push_back(TypeError{pe.getLocation(), item.name, SyntaxError{pe.what()}});
+
+            module->errors.insert(module->errors.begin(), parseErrors.begin(), parseErrors.end());
+
+            module->checkDurationSec = getTimestamp() - timestamp;
+
+            item.stats.timeCheck += module->checkDurationSec;
+            item.stats.moduleCacheHits++;
+
+            item.module = module;
+            return;
+        }
+
+        item.stats.moduleCacheMisses++;
+    }
+
     if (!FFlag::LuauTypecheckLimitControls)
     {
         typeCheckLimits.cancellationToken = item.options.cancellationToken;
@@ -1052,6 +1405,12 @@ void Frontend::checkBuildQueueItem(BuildQueueItem& item)
             module->scopes.clear();
     }
 
+    // Results of interrupted checks are incomplete
+    if (cacheKey && !module->timeout && !module->cancelled)
+        storeCachedModule(*module, *cacheKey);
+
+    recordModuleInterface(item, *module);
+
     if (mode != Mode::NoCheck)
     {
         for (const RequireCycle& cyc : requireCycles)
@@ -1090,22 +1449,254 @@ void Frontend::recordItemResult(const BuildQueueItem& item)
     if (item.exception)
         std::rethrow_exception(item.exception);
 
+    publishItemResult(item);
+    recordItemStats(item);
+}
+
+void Frontend::publishItemResult(const BuildQueueItem& item)
+{
+    // Results of interrupted checks can't be reused
+    std::optional<uint64_t> earlyCutoffKey = item.module->timeout || item.module->cancelled ? std::nullopt : item.earlyCutoffKey;
+
     if (item.options.forAutocomplete)
     {
         moduleResolverForAutocomplete.setModule(item.name, item.module);
         item.sourceNode->dirtyModuleForAutocomplete = false;
+        item.sourceNode->earlyCutoffKeyForAutocomplete = earlyCutoffKey;
     }
     else
     {
         moduleResolver.setModule(item.name, item.module);
         item.sourceNode->dirtyModule = false;
+        item.sourceNode->earlyCutoffKey = earlyCutoffKey;
     }
+}
 
+void Frontend::recordItemStats(const BuildQueueItem& item)
+{
     stats.timeCheck += item.stats.timeCheck;
     stats.timeLint += item.stats.timeLint;
 
     stats.filesStrict += item.stats.filesStrict;
     stats.filesNonstrict += item.stats.filesNonstrict;
+
+    stats.moduleCacheHits += item.stats.moduleCacheHits;
+    stats.moduleCacheMisses += item.stats.moduleCacheMisses;
+
+    stats.earlyCutoffHits += item.stats.earlyCutoffHits;
+
+    // Normalizer cache is shared by all modules, so its counters are collected together with the stats of the items
+    NormalizerSharedCache::Stats normalizerCacheStats = normalizerCache->takeStats();
+
+    stats.normalizerCacheHits += normalizerCacheStats.hits;
+    stats.normalizerCacheMisses += normalizerCacheStats.misses;
+    stats.timeNormalizerCacheSaved += normalizerCacheStats.timeSaved;
+}
+
+void Frontend::prepareModuleSerializers()
+{
+    if (!canUseModuleCache())
+        return;
+
+    if ((moduleCacheStore || FFlag::LuauFrontendEarlyCutoff) && !moduleSerializer)
+        moduleSerializer = std::make_unique<ModuleSerializer>(builtinTypes, globals.globalScope);
+
+    if (FFlag::LuauFrontendEarlyCutoff && !moduleSerializerForAutocomplete)
+        moduleSerializerForAutocomplete = std::make_unique<ModuleSerializer>(builtinTypes, globalsForAutocomplete.globalScope);
+}
+
+std::optional<uint64_t> Frontend::getRequireInterfaceHash(const BuildQueueItem& item) const
+{
+    // Modules in a cycle see 'any' in place of some required types
+    if (!item.requireCycles.empty())
+        return std::nullopt;
+
+    const FrontendModuleResolver& resolver = item.options.forAutocomplete ? moduleResolverForAutocomplete : moduleResolver;
+
+    std::vector<ModuleName> requires(item.sourceNode->requireSet.begin(), item.sourceNode->requireSet.end());
+    std::sort(requires.begin(), requires.end());
+
+    ModuleCacheHasher hasher;
+
+    for (const ModuleName& name : requires)
+    {
+        hasher.string(name);
+
+        if (ModulePtr module = resolver.getModule(name))
+        {
+            if (!module->interfaceHash)
+                return std::nullopt;
+
+            hasher.pod(module->type);
+            hasher.pod(*module->interfaceHash);
+        }
+        else
+        {
+            hasher.pod(resolver.moduleExists(name));
+        }
+    }
+
+    return hasher.value;
+}
+
+std::optional<uint64_t> Frontend::getEarlyCutoffKey(const BuildQueueItem& item) const
+{
+    if (item.recordJsonLog)
+        return std::nullopt;
+
+    std::optional<uint64_t> requireHash = getRequireInterfaceHash(item);
+
+    if (!requireHash)
+        return std::nullopt;
+
+    ModuleCacheHasher hasher;
+
+    hasher.pod(*requireHash);
+    hasher.pod(item.options.retainFullTypeGraphs);
+    hasher.pod(item.options.runLintChecks);
+    hasher.pod(item.options.enabledLintWarnings.has_value());
+
+    if (item.options.enabledLintWarnings)
+        hasher.pod(item.options.enabledLintWarnings->warningMask);
+
+    return hasher.value;
+}
+
+void Frontend::recordModuleInterface(const BuildQueueItem& item, Module& module) const
+{
+    if (!FFlag::LuauFrontendEarlyCutoff)
+        return;
+
+    const FrontendModuleResolver& resolver = item.options.forAutocomplete ? moduleResolverForAutocomplete : moduleResolver;
+
+    for (const ModuleName& name : item.sourceNode->requireSet)
+    {
+        if (ModulePtr requiredModule = resolver.getModule(name))
+            module.requiredModules.push_back(requiredModule);
+    }
+
+    const ModuleSerializer* serializer = item.options.forAutocomplete ? moduleSerializerForAutocomplete.get() : moduleSerializer.get();
+
+    if (serializer && !module.interfaceHash)
+    {
+        uint64_t interfaceHash = 0;
+
+        if (serializer->hashInterface(interfaceHash, module))
+            module.interfaceHash = interfaceHash;
+    }
+}
+
+std::optional<uint64_t> Frontend::getModuleCacheKey(const BuildQueueItem& item) const
+{
+    // Results that depend on state which isn't a part of the key are not cached
+    if (!moduleSerializer || item.options.retainFullTypeGraphs || item.options.applyInternalLimitScaling || item.recordJsonLog || prepareModuleScope)
+        return std::nullopt;
+
+    // Modules in a cycle see 'any' in place of some required types and custom environments are not a part of the globals hash
+    if (!item.requireCycles.empty() || item.sourceModule->environmentName)
+        return std::nullopt;
+
+    const SourceModule& sourceModule = *item.sourceModule;
+    const Config& config = item.config;
+
+    ModuleCacheHasher hasher;
+
+    hasher.pod(moduleSerializer->getGlobalsHash());
+    hasher.pod(item.sourceNode->sourceHash);
+    hasher.string(item.name);
+    hasher.string(sourceModule.humanReadableName);
+    hasher.pod(sourceModule.type);
+    hasher.pod(sourceModule.mode.value_or(config.mode));
+
+    hasher.pod(config.enabledLint.warningMask);
+    hasher.pod(config.fatalLint.warningMask);
+    hasher.pod(config.lintErrors);
+    hasher.pod(config.typeErrors);
+
+    hasher.pod(config.globals.size());
+
+    for (const std::string& global : config.globals)
+        hasher.string(global);
+
+    hasher.pod(item.options.runLintChecks);
+    hasher.pod(item.options.enabledLintWarnings.has_value());
+
+    if (item.options.enabledLintWarnings)
+        hasher.pod(item.options.enabledLintWarnings->warningMask);
+
+    for (FValue<bool>* flag = FValue<bool>::list; flag; flag = flag->next)
+    {
+        hasher.string(flag->name);
+        hasher.pod(flag->value);
+    }
+
+    for (FValue<int>* flag = FValue<int>::list; flag; flag = flag->next)
+    {
+        hasher.string(flag->name);
+        hasher.pod(flag->value);
+    }
+
+    // Dependencies are checked before the module, so the key can include their interfaces
+    std::optional<uint64_t> requireHash = getRequireInterfaceHash(item);
+
+    if (!requireHash)
+        return std::nullopt;
+
+    hasher.pod(*requireHash);
+
+    return hasher.value;
+}
+
+ModulePtr Frontend::loadCachedModule(const BuildQueueItem& item, uint64_t key) const
+{
+    LUAU_TIMETRACE_SCOPE("Frontend::loadCachedModule", "Frontend");
+    LUAU_TIMETRACE_ARGUMENT("name", item.name.c_str());
+
+    std::optional<std::string> data = moduleCacheStore->read(key);
+
+    if (!data)
+        return nullptr;
+
+    const SourceModule& sourceModule = *item.sourceModule;
+
+    ModulePtr module = std::make_shared<Module>();
+    module->name = sourceModule.name;
+    module->humanReadableName = sourceModule.humanReadableName;
+    module->type = sourceModule.type;
+    module->mode = sourceModule.mode.value_or(item.config.mode);
+
+    module->internalTypes.owningModule = module.get();
+    module->interfaceTypes.owningModule = module.get();
+
+    uint64_t interfaceHash = 0;
+
+    if (!moduleSerializer->deserialize(*module, interfaceHash, key, *data))
+        return nullptr;
+
+    module->interfaceHash = interfaceHash;
+
+    freeze(module->internalTypes);
+    freeze(module->interfaceTypes);
+
+    return module;
+}
+
+void Frontend::storeCachedModule(Module& module, uint64_t key) const
+{
+    LUAU_TIMETRACE_SCOPE("Frontend::storeCachedModule", "Frontend");
+    LUAU_TIMETRACE_ARGUMENT("name", module.name.c_str());
+
+    std::string data;
+    uint64_t interfaceHash = 0;
+
+    // Modules with type errors are checked every time, as are the modules that refer to types which can't be serialized and the modules that
+    // require them
+    if (!moduleSerializer->serialize(data, interfaceHash, key, module))
+        return;
+
+    module.interfaceHash = interfaceHash;
+
+    moduleCacheStore->write(key, data);
 }
 
 ScopePtr Frontend::getModuleEnvironment(const SourceModule& module, const Config& config, bool forAutocomplete) const
@@ -1172,17 +1763,29 @@ void Frontend::markDirty(const ModuleName& name, std::vector<ModuleName>* marked
         if (markedDirty)
             markedDirty->push_back(next);
 
-        if (sourceNode.dirtySourceModule && sourceNode.dirtyModule && sourceNode.dirtyModuleForAutocomplete)
-            continue;
+        // Sources of the dependents didn't change, so they are kept to be able to reuse the results when the interface stays the same
+        if (FFlag::LuauFrontendEarlyCutoff && next != name)
+        {
+            if (sourceNode.dirtyModule && sourceNode.dirtyModuleForAutocomplete)
+                continue;
 
-        sourceNode.dirtySourceModule = true;
-        sourceNode.dirtyModule = true;
-        sourceNode.dirtyModuleForAutocomplete = true;
+            sourceNode.dirtyModule = true;
+            sourceNode.dirtyModuleForAutocomplete = true;
+        }
+        else
+        {
+            if (sourceNode.dirtySourceModule && sourceNode.dirtyModule && sourceNode.dirtyModuleForAutocomplete)
+                continue;
 
-        if (0 == reverseDeps.count(next))
-            continue;
+            sourceNode.dirtySourceModule = true;
+            sourceNode.dirtyModule = true;
+            sourceNode.dirtyModuleForAutocomplete = true;
 
-        sourceModules.erase(next);
+            if (0 == reverseDeps.count(next))
+                continue;
+
+            sourceModules.erase(next);
+        }
 
         const std::vector<ModuleName>& dependents = reverseDeps[next];
         queue.insert(queue.end(), dependents.begin(), dependents.end());
@@ -1216,7 +1819,7 @@ ModulePtr check(const SourceModule& sourceModule, const std::vector<RequireCycle
 ModulePtr check(const SourceModule& sourceModule, const std::vector<RequireCycle>& requireCycles, NotNull<BuiltinTypes> builtinTypes,
     NotNull<InternalErrorReporter> iceHandler, NotNull<ModuleResolver> moduleResolver, NotNull<FileResolver> fileResolver,
     const ScopePtr& parentScope, std::function<void(const ModuleName&, const ScopePtr&)> prepareModuleScope, FrontendOptions options,
-    TypeCheckLimits limits, bool recordJsonLog)
+    TypeCheckLimits limits, bool recordJsonLog, NormalizerSharedCache* normalizerCache)
 {
     ModulePtr result = std::make_shared<Module>();
     result->name = sourceModule.name;
@@ -1245,6 +1848,7 @@ ModulePtr check(const SourceModule& sourceModule, const std::vector<RequireCycle
     unifierState.counters.iterationLimit = limits.unifierIterationLimit.value_or(FInt::LuauTypeInferIterationLimit);
 
     Normalizer normalizer{&result->internalTypes, builtinTypes, NotNull{&unifierState}};
+    normalizer.sharedCache = normalizerCache;
 
     ConstraintGraphBuilder cgb{result, NotNull{&normalizer}, moduleResolver, builtinTypes, iceHandler, parentScope, std::move(prepareModuleScope),
         logger.get(), NotNull{&dfg}, requireCycles};
@@ -1322,6 +1926,9 @@ ModulePtr check(const SourceModule& sourceModule, const std::vector<RequireCycle
 ModulePtr Frontend::check(const SourceModule& sourceModule, Mode mode, std::vector<RequireCycle> requireCycles,
     std::optional<ScopePtr> environmentScope, bool forAutocomplete, bool recordJsonLog, TypeCheckLimits typeCheckLimits)
 {
+    // Global types are still being built while definitions are checked
+    NormalizerSharedCache* sharedNormalizerCache = FFlag::LuauNormalizerSharedCache && mode != Mode::Definition ? normalizerCache.get() : nullptr;
+
     if (FFlag::DebugLuauDeferredConstraintResolution && mode == Mode::Strict)
     {
         auto prepareModuleScopeWrap = [this, forAutocomplete](const ModuleName& name, const ScopePtr& scope) {
@@ -1333,7 +1940,8 @@ ModulePtr Frontend::check(const SourceModule& sourceModule, Mode mode, std::vect
         {
             return Luau::check(sourceModule, requireCycles, builtinTypes, NotNull{&iceHandler},
                 NotNull{forAutocomplete ? &moduleResolverForAutocomplete : &moduleResolver}, NotNull{fileResolver},
-                environmentScope ? *environmentScope : globals.globalScope, prepareModuleScopeWrap, options, typeCheckLimits, recordJsonLog);
+                environmentScope ? *environmentScope : globals.globalScope, prepareModuleScopeWrap, options, typeCheckLimits, recordJsonLog,
+                sharedNormalizerCache);
         }
         catch (const InternalCompilerError& err)
         {
@@ -1360,6 +1968,7 @@ ModulePtr Frontend::check(const SourceModule& sourceModule, Mode mode, std::vect
         typeChecker.instantiationChildLimit = typeCheckLimits.instantiationChildLimit;
         typeChecker.unifierIterationLimit = typeCheckLimits.unifierIterationLimit;
         typeChecker.cancellationToken = typeCheckLimits.cancellationToken;
+        typeChecker.normalizer.sharedCache = sharedNormalizerCache;
 
         return typeChecker.check(sourceModule, mode, environmentScope);
     }
@@ -1403,6 +2012,9 @@ std::pair<SourceNode*, SourceModule*> Frontend::getSourceNode(const ModuleName&
     SourceModule result = parse(name, source->source, opts);
     result.type = source->type;
 
+    ModuleCacheHasher sourceHasher;
+    sourceHasher.string(source->source);
+
     RequireTraceResult& require = requireTrace[name];
     require = traceRequires(fileResolver, result.root, name);
 
@@ -1423,6 +2035,9 @@ std::pair<SourceNode*, SourceModule*> Frontend::getSourceNode(const ModuleName&
     sourceNode->humanReadableName = sourceModule->humanReadableName;
     sourceNode->requireSet.clear();
     sourceNode->requireLocations.clear();
+    sourceNode->sourceHash = sourceHasher.value;
+    sourceNode->earlyCutoffKey.reset();
+    sourceNode->earlyCutoffKeyForAutocomplete.reset();
     sourceNode->dirtySourceModule = false;
 
     if (it == sourceNodes.end())
@@ -1523,6 +2138,12 @@ std::optional<ModuleInfo> FrontendModuleResolver::resolveModuleInfo(const Module
 
 const ModulePtr FrontendModuleResolver::getModule(const ModuleName& moduleName) const
 {
+    if (namesFrozen.load(std::memory_order_acquire))
+    {
+        auto it = modules.find(moduleName);
+        return it != modules.end() ? it->second : nullptr;
+    }
+
     std::scoped_lock lock(moduleMutex);
 
     auto it = modules.find(moduleName);
@@ -1544,6 +2165,17 @@ std::string FrontendModuleResolver::getHumanReadableModuleName(const ModuleName&
 
 void FrontendModuleResolver::setModule(const ModuleName& moduleName, ModulePtr module)
 {
+    if (namesFrozen.load(std::memory_order_acquire))
+    {
+        auto it = modules.find(moduleName);
+        LUAU_ASSERT(it != modules.end());
+
+        if (it != modules.end())
+            it->second = std::move(module);
+
+        return;
+    }
+
     std::scoped_lock lock(moduleMutex);
 
     modules[moduleName] = std::move(module);
@@ -1556,6 +2188,32 @@ void FrontendModuleResolver::clearModules()
     modules.clear();
 }
 
+void FrontendModuleResolver::freezeModuleNames(const std::vector<ModuleName>& names)
+{
+    std::scoped_lock lock(moduleMutex);
+
+    for (const ModuleName& name : names)
+        modules.try_emplace(name);
+
+    namesFrozen.store(true, std::memory_order_release);
+}
+
+void FrontendModuleResolver::unfreezeModuleNames()
+{
+    std::scoped_lock lock(moduleMutex);
+
+    namesFrozen.store(false, std::memory_order_release);
+
+    // Modules that weren't checked because of an error are left empty
+    for (auto it = modules.begin(); it != modules.end();)
+    {
+        if (it->second)
+            ++it;
+        else
+            it = modules.erase(it);
+    }
+}
+
 ScopePtr Frontend::addEnvironment(const std::string& environmentName)
 {
     LUAU_ASSERT(environments.count(environmentName) == 0);
@@ -1612,6 +2270,7 @@ LintResult Frontend::classifyLints(const std::vector<LintWarning>& warnings, con
 void Frontend::clearStats()
 {
     stats = {};
+    normalizerCache->takeStats();
 }
 
 void Frontend::clear()
@@ -1621,6 +2280,7 @@ void Frontend::clear()
     moduleResolver.clearModules();
     moduleResolverForAutocomplete.clearModules();
     requireTrace.clear();
+    normalizerCache->clear();
 }
 
 } // namespace Luau
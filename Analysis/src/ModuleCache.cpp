@@ -0,0 +1,1238 @@
+// This file is part of the Luau programming language and is licensed under MIT License; see LICENSE.txt for details
+#include "Luau/ModuleCache.h"
+
+#include "Luau/Scope.h"
+#include "Luau/Type.h"
+#include "Luau/TypeArena.h"
+#include "Luau/TypePack.h"
+
+#include <algorithm>
+
+#include <string.h>
+
+namespace Luau
+{
+
+static const char kModuleCacheMagic[4] = {'L', 'M', 'O', 'D'};
+static const uint8_t kModuleCacheVersion = 2;
+
+// Types and type packs of the module are written as a list of nodes in the order they are first referenced in
+// References to nodes are encoded as index * 2, references to globals as index * 2 + 1
+enum class CachedNodeKind : uint8_t
+{
+    Primitive,
+    BooleanSingleton,
+    StringSingleton,
+    Function,
+    Table,
+    Metatable,
+    Any,
+    Unknown,
+    Never,
+    Error,
+    Union,
+    Intersection,
+    Negation,
+    Generic,
+
+    TypePack,
+    VariadicTypePack,
+    GenericTypePack,
+    ErrorTypePack,
+};
+
+static bool isTypePackNode(CachedNodeKind kind)
+{
+    return kind >= CachedNodeKind::TypePack;
+}
+
+template<typename T>
+static std::vector<std::string> getSortedNames(const std::unordered_map<std::string, T>& map)
+{
+    std::vector<std::string> result;
+    result.reserve(map.size());
+
+    for (const auto& [name, _] : map)
+        result.push_back(name);
+
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+static void writeVarInt(std::string& ss, uint64_t value)
+{
+    do
+    {
+        ss.push_back(char((value & 127) | ((value > 127) << 7)));
+        value >>= 7;
+    } while (value);
+}
+
+static void writeByte(std::string& ss, uint8_t value)
+{
+    ss.push_back(char(value));
+}
+
+static void writeString(std::string& ss, std::string_view value)
+{
+    writeVarInt(ss, value.size());
+    ss.append(value.data(), value.size());
+}
+
+static void writeOptionalString(std::string& ss, const std::optional<std::string>& value)
+{
+    writeByte(ss, value.has_value());
+
+    if (value)
+        writeString(ss, *value);
+}
+
+static void writeLocation(std::string& ss, const Location& location)
+{
+    writeVarInt(ss, location.begin.line);
+    writeVarInt(ss, location.begin.column);
+    writeVarInt(ss, location.end.line);
+    writeVarInt(ss, location.end.column);
+}
+
+static void writeLevel(std::string& ss, TypeLevel level)
+{
+    writeVarInt(ss, uint32_t(level.level));
+    writeVarInt(ss, uint32_t(level.subLevel));
+}
+
+static void writeTags(std::string& ss, const Tags& tags)
+{
+    writeVarInt(ss, tags.size());
+
+    for (const std::string& tag : tags)
+        writeString(ss, tag);
+}
+
+struct ModuleCacheReader
+{
+    std::string_view data;
+    size_t offset = 0;
+    bool failed = false;
+
+    uint64_t readVarInt()
+    {
+        uint64_t result = 0;
+        unsigned shift = 0;
+
+        for (;;)
+        {
+            if (offset >= data.size() || shift >= 64)
+            {
+                failed = true;
+                return 0;
+            }
+
+            uint8_t byte = uint8_t(data[offset++]);
+            result |= uint64_t(byte & 127) << shift;
+            shift += 7;
+
+            if ((byte & 128) == 0)
+                return result;
+        }
+    }
+
+    uint32_t readCount()
+    {
+        uint64_t result = readVarInt();
+
+        // every element takes at least one byte, which rejects lengths that would lead to huge allocations
+        if (result > data.size() - offset)
+        {
+            failed = true;
+            return 0;
+        }
+
+        return uint32_t(result);
+    }
+
+    uint8_t readByte()
+    {
+        if (offset >= data.size())
+        {
+            failed = true;
+            return 0;
+        }
+
+        return uint8_t(data[offset++]);
+    }
+
+    bool readBool()
+    {
+        return readByte() != 0;
+    }
+
+    std::string readString()
+    {
+        uint32_t size = readCount();
+
+        if (failed)
+            return {};
+
+        std::string result(data.substr(offset, size));
+        offset += size;
+        return result;
+    }
+
+    std::optional<std::string> readOptionalString()
+    {
+        if (readBool())
+            return readString();
+
+        return std::nullopt;
+    }
+
+    Location readLocation()
+    {
+        unsigned beginLine = unsigned(readVarInt());
+        unsigned beginColumn = unsigned(readVarInt());
+        unsigned endLine = unsigned(readVarInt());
+        unsigned endColumn = unsigned(readVarInt());
+
+        return Location{Position{beginLine, beginColumn}, Position{endLine, endColumn}};
+    }
+
+    TypeLevel readLevel()
+    {
+        TypeLevel level;
+        level.level = int(uint32_t(readVarInt()));
+        level.subLevel = int(uint32_t(readVarInt()));
+        return level;
+    }
+
+    Tags readTags()
+    {
+        Tags tags;
+        tags.resize(readCount());
+
+        for (std::string& tag : tags)
+            tag = readString();
+
+        return tags;
+    }
+};
+
+struct TypeGraphWriter
+{
+    const DenseHashMap<TypeId, uint32_t>& globalTypeIndices;
+    const DenseHashMap<TypePackId, uint32_t>& globalTypePackIndices;
+
+    DenseHashMap<TypeId, uint32_t> typeIndices{nullptr};
+    DenseHashMap<TypePackId, uint32_t> typePackIndices{nullptr};
+
+    // Types and type packs in the order of discovery; exactly one element of the pair is set
+    std::vector<std::pair<TypeId, TypePackId>> nodes;
+
+    bool failed = false;
+
+    TypeGraphWriter(const DenseHashMap<TypeId, uint32_t>& globalTypeIndices, const DenseHashMap<TypePackId, uint32_t>& globalTypePackIndices)
+        : globalTypeIndices(globalTypeIndices)
+        , globalTypePackIndices(globalTypePackIndices)
+    {
+    }
+
+    uint64_t ref(TypeId ty)
+    {
+        ty = follow(ty);
+
+        if (const uint32_t* index = globalTypeIndices.find(ty))
+            return (uint64_t(*index) << 1) | 1;
+
+        if (const uint32_t* index = typeIndices.find(ty))
+            return uint64_t(*index) << 1;
+
+        // types that are shared between modules have to be reachable from the globals
+        if (ty->persistent || !ty->owningArena || !ty->owningArena->owningModule)
+        {
+            failed = true;
+            return 0;
+        }
+
+        uint32_t index = uint32_t(typeIndices.size());
+        typeIndices[ty] = index;
+        nodes.push_back({ty, nullptr});
+        return uint64_t(index) << 1;
+    }
+
+    uint64_t ref(TypePackId tp)
+    {
+        tp = follow(tp);
+
+        if (const uint32_t* index = globalTypePackIndices.find(tp))
+            return (uint64_t(*index) << 1) | 1;
+
+        if (const uint32_t* index = typePackIndices.find(tp))
+            return uint64_t(*index) << 1;
+
+        if (tp->persistent || !tp->owningArena || !tp->owningArena->owningModule)
+        {
+            failed = true;
+            return 0;
+        }
+
+        uint32_t index = uint32_t(typePackIndices.size());
+        typePackIndices[tp] = index;
+        nodes.push_back({nullptr, tp});
+        return uint64_t(index) << 1;
+    }
+
+    void writeRef(std::string& ss, TypeId ty)
+    {
+        writeVarInt(ss, ref(ty));
+    }
+
+    void writeRef(std::string& ss, TypePackId tp)
+    {
+        writeVarInt(ss, ref(tp));
+    }
+
+    template<typename T>
+    void writeRefs(std::string& ss, const std::vector<T>& list)
+    {
+        writeVarInt(ss, list.size());
+
+        for (T item : list)
+            writeRef(ss, item);
+    }
+
+    template<typename T>
+    void writeOptionalRef(std::string& ss, const std::optional<T>& item)
+    {
+        writeByte(ss, item.has_value());
+
+        if (item)
+            writeRef(ss, *item);
+    }
+
+    void writeIndexer(std::string& ss, const std::optional<TableIndexer>& indexer)
+    {
+        writeByte(ss, indexer.has_value());
+
+        if (indexer)
+        {
+            writeRef(ss, indexer->indexType);
+            writeRef(ss, indexer->indexResultType);
+        }
+    }
+
+    void writeNode(std::string& ss, TypeId ty)
+    {
+        if (const PrimitiveType* ptv = get<PrimitiveType>(ty))
+        {
+            writeByte(ss, uint8_t(CachedNodeKind::Primitive));
+            writeByte(ss, uint8_t(ptv->type));
+            writeOptionalRef(ss, ptv->metatable);
+        }
+        else if (const SingletonType* stv = get<SingletonType>(ty))
+        {
+            if (const BooleanSingleton* bs = get<BooleanSingleton>(stv))
+            {
+                writeByte(ss, uint8_t(CachedNodeKind::BooleanSingleton));
+                writeByte(ss, bs->value);
+            }
+            else if (const StringSingleton* str = get<StringSingleton>(stv))
+            {
+                writeByte(ss, uint8_t(CachedNodeKind::StringSingleton));
+                writeString(ss, str->value);
+            }
+            else
+            {
+                failed = true;
+            }
+        }
+        else if (const FunctionType* ftv = get<FunctionType>(ty))
+        {
+            // functions with custom type checking logic only come from the globals
+            if (ftv->magicFunction || ftv->dcrMagicFunction || ftv->dcrMagicRefinement)
+            {
+                failed = true;
+                return;
+            }
+
+            writeByte(ss, uint8_t(CachedNodeKind::Function));
+            writeRefs(ss, ftv->generics);
+            writeRefs(ss, ftv->genericPacks);
+            writeRef(ss, ftv->argTypes);
+            writeRef(ss, ftv->retTypes);
+            writeLevel(ss, ftv->level);
+            writeByte(ss, ftv->hasSelf);
+            writeByte(ss, ftv->hasNoFreeOrGenericTypes);
+
+            writeVarInt(ss, ftv->argNames.size());
+
+            for (const std::optional<FunctionArgument>& arg : ftv->argNames)
+            {
+                writeByte(ss, arg.has_value());
+
+                if (arg)
+                {
+                    writeString(ss, arg->name);
+                    writeLocation(ss, arg->location);
+                }
+            }
+
+            writeTags(ss, ftv->tags);
+
+            writeByte(ss, ftv->definition.has_value());
+
+            if (const std::optional<FunctionDefinition>& defn = ftv->definition)
+            {
+                writeOptionalString(ss, defn->definitionModuleName);
+                writeLocation(ss, defn->definitionLocation);
+                writeByte(ss, defn->varargLocation.has_value());
+
+                if (defn->varargLocation)
+                    writeLocation(ss, *defn->varargLocation);
+
+                writeLocation(ss, defn->originalNameLocation);
+            }
+        }
+        else if (const TableType* ttv = get<TableType>(ty))
+        {
+            writeByte(ss, uint8_t(CachedNodeKind::Table));
+            writeByte(ss, uint8_t(ttv->state));
+            writeLevel(ss, ttv->level);
+
+            writeVarInt(ss, ttv->props.size());
+
+            for (const auto& [name, prop] : ttv->props)
+            {
+                writeString(ss, name);
+                writeRef(ss, prop.type());
+                writeByte(ss, prop.deprecated);
+                writeString(ss, prop.deprecatedSuggestion);
+                writeByte(ss, prop.location.has_value());
+
+                if (prop.location)
+                    writeLocation(ss, *prop.location);
+
+                writeTags(ss, prop.tags);
+                writeOptionalString(ss, prop.documentationSymbol);
+            }
+
+            writeIndexer(ss, ttv->indexer);
+            writeOptionalString(ss, ttv->name);
+            writeOptionalString(ss, ttv->syntheticName);
+            writeRefs(ss, ttv->instantiatedTypeParams);
+            writeRefs(ss, ttv->instantiatedTypePackParams);
+            writeString(ss, ttv->definitionModuleName);
+            writeLocation(ss, ttv->definitionLocation);
+            writeTags(ss, ttv->tags);
+            writeOptionalRef(ss, ttv->selfTy);
+        }
+        else if (const MetatableType* mtv = get<MetatableType>(ty))
+        {
+            writeByte(ss, uint8_t(CachedNodeKind::Metatable));
+            writeRef(ss, mtv->table);
+            writeRef(ss, mtv->metatable);
+            writeOptionalString(ss, mtv->syntheticName);
+        }
+        else if (get<AnyType>(ty))
+        {
+            writeByte(ss, uint8_t(CachedNodeKind::Any));
+        }
+        else if (get<UnknownType>(ty))
+        {
+            writeByte(ss, uint8_t(CachedNodeKind::Unknown));
+        }
+        else if (get<NeverType>(ty))
+        {
+            writeByte(ss, uint8_t(CachedNodeKind::Never));
+        }
+        else if (get<ErrorType>(ty))
+        {
+            writeByte(ss, uint8_t(CachedNodeKind::Error));
+        }
+        else if (const UnionType* utv = get<UnionType>(ty))
+        {
+            writeByte(ss, uint8_t(CachedNodeKind::Union));
+            writeRefs(ss, utv->options);
+        }
+        else if (const IntersectionType* itv = get<IntersectionType>(ty))
+        {
+            writeByte(ss, uint8_t(CachedNodeKind::Intersection));
+            writeRefs(ss, itv->parts);
+        }
+        else if (const NegationType* ntv = get<NegationType>(ty))
+        {
+            writeByte(ss, uint8_t(CachedNodeKind::Negation));
+            writeRef(ss, ntv->ty);
+        }
+        else if (const GenericType* gtv = get<GenericType>(ty))
+        {
+            writeByte(ss, uint8_t(CachedNodeKind::Generic));
+            writeLevel(ss, gtv->level);
+            writeString(ss, gtv->name);
+            writeByte(ss, gtv->explicitName);
+        }
+        else
+        {
+            // free, blocked and other types that only exist while the module is checked, or classes that can only be declared in definitions
+            failed = true;
+            return;
+        }
+
+        writeOptionalString(ss, ty->documentationSymbol);
+    }
+
+    void writeNode(std::string& ss, TypePackId tp)
+    {
+        if (const TypePack* pack = get<TypePack>(tp))
+        {
+            writeByte(ss, uint8_t(CachedNodeKind::TypePack));
+            writeRefs(ss, pack->head);
+            writeOptionalRef(ss, pack->tail);
+        }
+        else if (const VariadicTypePack* vtp = get<VariadicTypePack>(tp))
+        {
+            writeByte(ss, uint8_t(CachedNodeKind::VariadicTypePack));
+            writeRef(ss, vtp->ty);
+            writeByte(ss, vtp->hidden);
+        }
+        else if (const GenericTypePack* gtp = get<GenericTypePack>(tp))
+        {
+            writeByte(ss, uint8_t(CachedNodeKind::GenericTypePack));
+            writeLevel(ss, gtp->level);
+            writeString(ss, gtp->name);
+            writeByte(ss, gtp->explicitName);
+        }
+        else if (get<ErrorTypePack>(tp))
+        {
+            writeByte(ss, uint8_t(CachedNodeKind::ErrorTypePack));
+        }
+        else
+        {
+            failed = true;
+        }
+    }
+
+    void writeTypeFun(std::string& ss, const TypeFun& tf)
+    {
+        writeVarInt(ss, tf.typeParams.size());
+
+        for (const GenericTypeDefinition& param : tf.typeParams)
+        {
+            writeRef(ss, param.ty);
+            writeOptionalRef(ss, param.defaultValue);
+        }
+
+        writeVarInt(ss, tf.typePackParams.size());
+
+        for (const GenericTypePackDefinition& param : tf.typePackParams)
+        {
+            writeRef(ss, param.tp);
+            writeOptionalRef(ss, param.defaultValue);
+        }
+
+        writeRef(ss, tf.type);
+    }
+};
+
+struct TypeGraphReader
+{
+    ModuleCacheReader& reader;
+
+    const std::vector<TypeId>& globalTypes;
+    const std::vector<TypePackId>& globalTypePacks;
+
+    std::vector<TypeId> types;
+    std::vector<TypePackId> typePacks;
+
+    TypeGraphReader(ModuleCacheReader& reader, const std::vector<TypeId>& globalTypes, const std::vector<TypePackId>& globalTypePacks)
+        : reader(reader)
+        , globalTypes(globalTypes)
+        , globalTypePacks(globalTypePacks)
+    {
+    }
+
+    template<typename T>
+    static T resolve(ModuleCacheReader& reader, uint64_t ref, const std::vector<T>& globals, const std::vector<T>& locals)
+    {
+        const std::vector<T>& list = (ref & 1) ? globals : locals;
+        uint64_t index = ref >> 1;
+
+        if (index >= list.size())
+        {
+            reader.failed = true;
+            return list.empty() ? nullptr : list[0];
+        }
+
+        return list[index];
+    }
+
+    // Returns nullptr after reading malformed data; every caller checks reader.failed before the graph is used
+    TypeId readType()
+    {
+        return resolve(reader, reader.readVarInt(), globalTypes, types);
+    }
+
+    TypePackId readTypePack()
+    {
+        return resolve(reader, reader.readVarInt(), globalTypePacks, typePacks);
+    }
+
+    std::vector<TypeId> readTypes()
+    {
+        std::vector<TypeId> result(reader.readCount());
+
+        for (TypeId& ty : result)
+            ty = readType();
+
+        return result;
+    }
+
+    std::vector<TypePackId> readTypePacks()
+    {
+        std::vector<TypePackId> result(reader.readCount());
+
+        for (TypePackId& tp : result)
+            tp = readTypePack();
+
+        return result;
+    }
+
+    std::optional<TypeId> readOptionalType()
+    {
+        if (reader.readBool())
+            return readType();
+
+        return std::nullopt;
+    }
+
+    std::optional<TypePackId> readOptionalTypePack()
+    {
+        if (reader.readBool())
+            return readTypePack();
+
+        return std::nullopt;
+    }
+
+    std::optional<TableIndexer> readIndexer()
+    {
+        if (!reader.readBool())
+            return std::nullopt;
+
+        TypeId indexType = readType();
+        TypeId indexResultType = readType();
+        return TableIndexer{indexType, indexResultType};
+    }
+
+    void readNode(TypeId ty, CachedNodeKind kind)
+    {
+        Type* mutableTy = asMutable(ty);
+
+        switch (kind)
+        {
+        case CachedNodeKind::Primitive:
+        {
+            uint8_t type = reader.readByte();
+
+            if (type > PrimitiveType::Table)
+            {
+                reader.failed = true;
+                return;
+            }
+
+            PrimitiveType ptv{PrimitiveType::Type(type)};
+            ptv.metatable = readOptionalType();
+            *mutableTy = std::move(ptv);
+            break;
+        }
+        case CachedNodeKind::BooleanSingleton:
+            *mutableTy = SingletonType{BooleanSingleton{reader.readBool()}};
+            break;
+        case CachedNodeKind::StringSingleton:
+            *mutableTy = SingletonType{StringSingleton{reader.readString()}};
+            break;
+        case CachedNodeKind::Function:
+        {
+            std::vector<TypeId> generics = readTypes();
+            std::vector<TypePackId> genericPacks = readTypePacks();
+            TypePackId argTypes = readTypePack();
+            TypePackId retTypes = readTypePack();
+            TypeLevel level = reader.readLevel();
+            bool hasSelf = reader.readBool();
+
+            FunctionType ftv{level, std::move(generics), std::move(genericPacks), argTypes, retTypes, std::nullopt, hasSelf};
+            ftv.hasNoFreeOrGenericTypes = reader.readBool();
+
+            ftv.argNames.resize(reader.readCount());
+
+            for (std::optional<FunctionArgument>& arg : ftv.argNames)
+            {
+                if (reader.readBool())
+                {
+                    std::string name = reader.readString();
+                    arg = FunctionArgument{std::move(name), reader.readLocation()};
+                }
+            }
+
+            ftv.tags = reader.readTags();
+
+            if (reader.readBool())
+            {
+                FunctionDefinition defn;
+                defn.definitionModuleName = reader.readOptionalString();
+                defn.definitionLocation = reader.readLocation();
+
+                if (reader.readBool())
+                    defn.varargLocation = reader.readLocation();
+
+                defn.originalNameLocation = reader.readLocation();
+                ftv.definition = std::move(defn);
+            }
+
+            *mutableTy = std::move(ftv);
+            break;
+        }
+        case CachedNodeKind::Table:
+        {
+            uint8_t state = reader.readByte();
+
+            if (state > uint8_t(TableState::Generic))
+            {
+                reader.failed = true;
+                return;
+            }
+
+            TypeLevel level = reader.readLevel();
+            TableType ttv{TableState(state), level};
+
+            for (uint32_t count = reader.readCount(); count > 0 && !reader.failed; --count)
+            {
+                std::string name = reader.readString();
+                TypeId propTy = readType();
+                bool deprecated = reader.readBool();
+                std::string deprecatedSuggestion = reader.readString();
+                std::optional<Location> location;
+
+                if (reader.readBool())
+                    location = reader.readLocation();
+
+                Tags tags = reader.readTags();
+                std::optional<std::string> documentationSymbol = reader.readOptionalString();
+
+                ttv.props[name] = Property{propTy, deprecated, deprecatedSuggestion, location, tags, documentationSymbol};
+            }
+
+            ttv.indexer = readIndexer();
+            ttv.name = reader.readOptionalString();
+            ttv.syntheticName = reader.readOptionalString();
+            ttv.instantiatedTypeParams = readTypes();
+            ttv.instantiatedTypePackParams = readTypePacks();
+            ttv.definitionModuleName = reader.readString();
+            ttv.definitionLocation = reader.readLocation();
+            ttv.tags = reader.readTags();
+            ttv.selfTy = readOptionalType();
+
+            *mutableTy = std::move(ttv);
+            break;
+        }
+        case CachedNodeKind::Metatable:
+        {
+            TypeId table = readType();
+            TypeId metatable = readType();
+            *mutableTy = MetatableType{table, metatable, reader.readOptionalString()};
+            break;
+        }
+        case CachedNodeKind::Any:
+            *mutableTy = AnyType{};
+            break;
+        case CachedNodeKind::Unknown:
+            *mutableTy = UnknownType{};
+            break;
+        case CachedNodeKind::Never:
+            *mutableTy = NeverType{};
+            break;
+        case CachedNodeKind::Error:
+            *mutableTy = ErrorType{};
+            break;
+        case CachedNodeKind::Union:
+            *mutableTy = UnionType{readTypes()};
+            break;
+        case CachedNodeKind::Intersection:
+            *mutableTy = IntersectionType{readTypes()};
+            break;
+        case CachedNodeKind::Negation:
+            *mutableTy = NegationType{readType()};
+            break;
+        case CachedNodeKind::Generic:
+        {
+            GenericType gtv{reader.readLevel()};
+            gtv.name = reader.readString();
+            gtv.explicitName = reader.readBool();
+            *mutableTy = std::move(gtv);
+            break;
+        }
+        default:
+            reader.failed = true;
+            return;
+        }
+
+        mutableTy->documentationSymbol = reader.readOptionalString();
+    }
+
+    void readNode(TypePackId tp, CachedNodeKind kind)
+    {
+        TypePackVar* mutableTp = asMutable(tp);
+
+        switch (kind)
+        {
+        case CachedNodeKind::TypePack:
+        {
+            std::vector<TypeId> head = readTypes();
+            *mutableTp = TypePack{std::move(head), readOptionalTypePack()};
+            break;
+        }
+        case CachedNodeKind::VariadicTypePack:
+        {
+            TypeId ty = readType();
+            *mutableTp = VariadicTypePack{ty, reader.readBool()};
+            break;
+        }
+        case CachedNodeKind::GenericTypePack:
+        {
+            GenericTypePack gtp{reader.readLevel()};
+            gtp.name = reader.readString();
+            gtp.explicitName = reader.readBool();
+            *mutableTp = std::move(gtp);
+            break;
+        }
+        case CachedNodeKind::ErrorTypePack:
+            *mutableTp = ErrorTypePack{};
+            break;
+        default:
+            reader.failed = true;
+            break;
+        }
+    }
+
+    TypeFun readTypeFun()
+    {
+        TypeFun tf;
+
+        tf.typeParams.resize(reader.readCount());
+
+        for (GenericTypeDefinition& param : tf.typeParams)
+        {
+            param.ty = readType();
+            param.defaultValue = readOptionalType();
+        }
+
+        tf.typePackParams.resize(reader.readCount());
+
+        for (GenericTypePackDefinition& param : tf.typePackParams)
+        {
+            param.tp = readTypePack();
+            param.defaultValue = readOptionalTypePack();
+        }
+
+        tf.type = readType();
+        return tf;
+    }
+};
+
+ModuleSerializer::ModuleSerializer(NotNull<BuiltinTypes> builtinTypes, const ScopePtr& globalScope)
+{
+    ModuleCacheHasher hasher;
+
+    for (TypeId ty : {builtinTypes->nilType, builtinTypes->numberType, builtinTypes->stringType, builtinTypes->booleanType, builtinTypes->threadType,
+             builtinTypes->functionType, builtinTypes->classType, builtinTypes->tableType, builtinTypes->emptyTableType, builtinTypes->trueType,
+             builtinTypes->falseType, builtinTypes->anyType, builtinTypes->unknownType, builtinTypes->neverType, builtinTypes->errorType,
+             builtinTypes->falsyType, builtinTypes->truthyType, builtinTypes->optionalNumberType, builtinTypes->optionalStringType})
+        addGlobal(ty);
+
+    for (TypePackId tp : {builtinTypes->emptyTypePack, builtinTypes->anyTypePack, builtinTypes->neverTypePack, builtinTypes->uninhabitableTypePack,
+             builtinTypes->errorTypePack})
+        addGlobal(tp);
+
+    // Scope bindings are visited in the order of their names to make the traversal independent of the hash table layout
+    std::vector<std::pair<std::string, TypeId>> bindings;
+
+    for (const auto& [symbol, binding] : globalScope->bindings)
+        bindings.emplace_back(toString(symbol), binding.typeId);
+
+    std::sort(bindings.begin(), bindings.end(), [](auto& lhs, auto& rhs) {
+        return lhs.first < rhs.first;
+    });
+
+    for (const auto& [name, ty] : bindings)
+    {
+        hasher.string(name);
+        addGlobal(ty);
+    }
+
+    for (const std::unordered_map<Name, TypeFun>* typeBindings : {&globalScope->exportedTypeBindings, &globalScope->privateTypeBindings})
+    {
+        for (const std::string& name : getSortedNames(*typeBindings))
+        {
+            const TypeFun& tf = typeBindings->at(name);
+
+            hasher.string(name);
+
+            for (const GenericTypeDefinition& param : tf.typeParams)
+            {
+                addGlobal(param.ty);
+
+                if (param.defaultValue)
+                    addGlobal(*param.defaultValue);
+            }
+
+            for (const GenericTypePackDefinition& param : tf.typePackParams)
+            {
+                addGlobal(param.tp);
+
+                if (param.defaultValue)
+                    addGlobal(*param.defaultValue);
+            }
+
+            addGlobal(tf.type);
+        }
+    }
+
+    size_t nextType = 0;
+    size_t nextTypePack = 0;
+
+    while (nextType < globalTypes.size() || nextTypePack < globalTypePacks.size())
+    {
+        for (; nextType < globalTypes.size(); ++nextType)
+        {
+            TypeId ty = globalTypes[nextType];
+
+            hasher.pod(ty->ty.index());
+
+            if (const PrimitiveType* ptv = get<PrimitiveType>(ty))
+            {
+                if (ptv->metatable)
+                    addGlobal(*ptv->metatable);
+            }
+            else if (const FunctionType* ftv = get<FunctionType>(ty))
+            {
+                for (TypeId generic : ftv->generics)
+                    addGlobal(generic);
+
+                for (TypePackId genericPack : ftv->genericPacks)
+                    addGlobal(genericPack);
+
+                addGlobal(ftv->argTypes);
+                addGlobal(ftv->retTypes);
+            }
+            else if (const TableType* ttv = get<TableType>(ty))
+            {
+                for (const auto& [name, prop] : ttv->props)
+                {
+                    hasher.string(name);
+                    addGlobal(prop.type());
+                }
+
+                if (ttv->indexer)
+                {
+                    addGlobal(ttv->indexer->indexType);
+                    addGlobal(ttv->indexer->indexResultType);
+                }
+            }
+            else if (const ClassType* ctv = get<ClassType>(ty))
+            {
+                hasher.string(ctv->name);
+
+                for (const auto& [name, prop] : ctv->props)
+                {
+                    hasher.string(name);
+                    addGlobal(prop.type());
+                }
+
+                if (ctv->parent)
+                    addGlobal(*ctv->parent);
+
+                if (ctv->metatable)
+                    addGlobal(*ctv->metatable);
+
+                if (ctv->indexer)
+                {
+                    addGlobal(ctv->indexer->indexType);
+                    addGlobal(ctv->indexer->indexResultType);
+                }
+            }
+            else if (const MetatableType* mtv = get<MetatableType>(ty))
+            {
+                addGlobal(mtv->table);
+                addGlobal(mtv->metatable);
+            }
+            else if (const UnionType* utv = get<UnionType>(ty))
+            {
+                for (TypeId option : utv->options)
+                    addGlobal(option);
+            }
+            else if (const IntersectionType* itv = get<IntersectionType>(ty))
+            {
+                for (TypeId part : itv->parts)
+                    addGlobal(part);
+            }
+            else if (const NegationType* ntv = get<NegationType>(ty))
+            {
+                addGlobal(ntv->ty);
+            }
+        }
+
+        for (; nextTypePack < globalTypePacks.size(); ++nextTypePack)
+        {
+            TypePackId tp = globalTypePacks[nextTypePack];
+
+            hasher.pod(tp->ty.index());
+
+            if (const TypePack* pack = get<TypePack>(tp))
+            {
+                for (TypeId ty : pack->head)
+                    addGlobal(ty);
+
+                if (pack->tail)
+                    addGlobal(*pack->tail);
+            }
+            else if (const VariadicTypePack* vtp = get<VariadicTypePack>(tp))
+            {
+                addGlobal(vtp->ty);
+            }
+        }
+    }
+
+    globalsHash = hasher.value;
+}
+
+void ModuleSerializer::addGlobal(TypeId ty)
+{
+    ty = follow(ty);
+
+    if (globalTypeIndices.contains(ty))
+        return;
+
+    globalTypeIndices[ty] = uint32_t(globalTypes.size());
+    globalTypes.push_back(ty);
+}
+
+void ModuleSerializer::addGlobal(TypePackId tp)
+{
+    tp = follow(tp);
+
+    if (globalTypePackIndices.contains(tp))
+        return;
+
+    globalTypePackIndices[tp] = uint32_t(globalTypePacks.size());
+    globalTypePacks.push_back(tp);
+}
+
+bool ModuleSerializer::serializeInterface(std::string& result, const Module& module) const
+{
+    if (!module.returnType || !module.declaredGlobals.empty())
+        return false;
+
+    TypeGraphWriter writer{globalTypeIndices, globalTypePackIndices};
+
+    // Roots are written first, which assigns the order of the nodes that they reach
+    std::string roots;
+
+    writer.writeRef(roots, module.returnType);
+
+    std::vector<std::string> exportedNames = getSortedNames(module.exportedTypeBindings);
+    writeVarInt(roots, exportedNames.size());
+
+    for (const std::string& name : exportedNames)
+    {
+        writeString(roots, name);
+        writer.writeTypeFun(roots, module.exportedTypeBindings.at(name));
+    }
+
+    std::string nodes;
+
+    // Writing a node can discover new nodes
+    for (size_t i = 0; i < writer.nodes.size() && !writer.failed; ++i)
+    {
+        auto [ty, tp] = writer.nodes[i];
+
+        if (ty)
+            writer.writeNode(nodes, ty);
+        else
+            writer.writeNode(nodes, tp);
+    }
+
+    if (writer.failed)
+        return false;
+
+    result.clear();
+    writeVarInt(result, writer.typeIndices.size());
+    writeVarInt(result, writer.typePackIndices.size());
+    result += nodes;
+    result += roots;
+
+    return true;
+}
+
+bool ModuleSerializer::hashInterface(uint64_t& interfaceHash, const Module& module) const
+{
+    std::string interface;
+
+    if (!serializeInterface(interface, module))
+        return false;
+
+    ModuleCacheHasher interfaceHasher;
+    interfaceHasher.bytes(interface.data(), interface.size());
+    interfaceHash = interfaceHasher.value;
+
+    return true;
+}
+
+bool ModuleSerializer::serialize(std::string& result, uint64_t& interfaceHash, uint64_t key, const Module& module) const
+{
+    // Type errors refer to types that aren't a part of the interface, so they can only be reported by checking the module again
+    if (!module.errors.empty())
+        return false;
+
+    std::string interface;
+
+    if (!serializeInterface(interface, module))
+        return false;
+
+    ModuleCacheHasher interfaceHasher;
+    interfaceHasher.bytes(interface.data(), interface.size());
+    interfaceHash = interfaceHasher.value;
+
+    std::string body;
+    writeString(body, interface);
+
+    for (const std::vector<LintWarning>* warnings : {&module.lintResult.errors, &module.lintResult.warnings})
+    {
+        writeVarInt(body, warnings->size());
+
+        for (const LintWarning& warning : *warnings)
+        {
+            writeVarInt(body, warning.code);
+            writeLocation(body, warning.location);
+            writeString(body, warning.text);
+        }
+    }
+
+    ModuleCacheHasher checksum;
+    checksum.bytes(body.data(), body.size());
+
+    result.clear();
+    result.append(kModuleCacheMagic, sizeof(kModuleCacheMagic));
+    writeByte(result, kModuleCacheVersion);
+    result.append(reinterpret_cast<const char*>(&key), sizeof(key));
+    result.append(reinterpret_cast<const char*>(&checksum.value), sizeof(checksum.value));
+    result += body;
+
+    return true;
+}
+
+bool ModuleSerializer::deserialize(Module& module, uint64_t& interfaceHash, uint64_t key, std::string_view data) const
+{
+    size_t headerSize = sizeof(kModuleCacheMagic) + 1 + sizeof(uint64_t) * 2;
+
+    if (data.size() < headerSize || memcmp(data.data(), kModuleCacheMagic, sizeof(kModuleCacheMagic)) != 0 ||
+        uint8_t(data[sizeof(kModuleCacheMagic)]) != kModuleCacheVersion)
+        return false;
+
+    uint64_t storedKey = 0;
+    uint64_t storedChecksum = 0;
+    memcpy(&storedKey, data.data() + sizeof(kModuleCacheMagic) + 1, sizeof(storedKey));
+    memcpy(&storedChecksum, data.data() + sizeof(kModuleCacheMagic) + 1 + sizeof(storedKey), sizeof(storedChecksum));
+
+    std::string_view body = data.substr(headerSize);
+
+    ModuleCacheHasher checksum;
+    checksum.bytes(body.data(), body.size());
+
+    // data can come from a different key on a hash collision of the store, or can be truncated
+    if (storedKey != key || storedChecksum != checksum.value)
+        return false;
+
+    ModuleCacheReader reader{body};
+
+    uint32_t interfaceSize = reader.readCount();
+
+    if (reader.failed)
+        return false;
+
+    size_t interfaceEnd = reader.offset + interfaceSize;
+
+    ModuleCacheHasher interfaceHasher;
+    interfaceHasher.bytes(body.data() + reader.offset, interfaceSize);
+    interfaceHash = interfaceHasher.value;
+
+    TypeGraphReader graph{reader, globalTypes, globalTypePacks};
+    TypeArena& arena = module.interfaceTypes;
+
+    uint32_t typeCount = reader.readCount();
+    uint32_t typePackCount = reader.readCount();
+
+    if (reader.failed)
+        return false;
+
+    // Nodes can refer to nodes that come after them, so all of them are allocated upfront
+    graph.types.reserve(typeCount);
+    graph.typePacks.reserve(typePackCount);
+
+    for (uint32_t i = 0; i < typeCount; ++i)
+        graph.types.push_back(arena.addType(AnyType{}));
+
+    for (uint32_t i = 0; i < typePackCount; ++i)
+        graph.typePacks.push_back(arena.addTypePack(TypePack{}));
+
+    size_t nextType = 0;
+    size_t nextTypePack = 0;
+
+    while ((nextType < typeCount || nextTypePack < typePackCount) && !reader.failed)
+    {
+        CachedNodeKind kind = CachedNodeKind(reader.readByte());
+
+        if (isTypePackNode(kind))
+        {
+            if (nextTypePack == typePackCount)
+                return false;
+
+            graph.readNode(graph.typePacks[nextTypePack++], kind);
+        }
+        else
+        {
+            if (nextType == typeCount)
+                return false;
+
+            graph.readNode(graph.types[nextType++], kind);
+        }
+    }
+
+    module.returnType = graph.readTypePack();
+
+    for (uint32_t count = reader.readCount(); count > 0 && !reader.failed; --count)
+    {
+        std::string name = reader.readString();
+        module.exportedTypeBindings[name] = graph.readTypeFun();
+    }
+
+    if (reader.offset != interfaceEnd)
+        return false;
+
+    for (std::vector<LintWarning>* warnings : {&module.lintResult.errors, &module.lintResult.warnings})
+    {
+        for (uint32_t count = reader.readCount(); count > 0 && !reader.failed; --count)
+        {
+            LintWarning warning;
+            warning.code = LintWarning::Code(reader.readVarInt());
+            warning.location = reader.readLocation();
+            warning.text = reader.readString();
+
+            if (warning.code >= LintWarning::Code__Count)
+                return false;
+
+            warnings->push_back(std::move(warning));
+        }
+    }
+
+    return !reader.failed && reader.offset == body.size();
+}
+
+} // namespace Luau
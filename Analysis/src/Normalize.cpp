@@ -4,10 +4,12 @@
 #include "Luau/ToString.h"
 
 #include <algorithm>
+#include <mutex>
 
 #include "Luau/Clone.h"
 #include "Luau/Common.h"
 #include "Luau/RecursionCounter.h"
+#include "Luau/TimeTrace.h"
 #include "Luau/Type.h"
 #include "Luau/Unifier.h"
 
@@ -685,6 +687,108 @@ static void assertInvariant(const NormalizedType& norm)
 #endif
 }
 
+NormalizerSharedCache::NormalizerSharedCache(std::vector<const TypeArena*> arenas)
+    : arenas(std::move(arenas))
+{
+}
+
+bool NormalizerSharedCache::isShared(TypeId ty) const
+{
+    return ty->persistent || std::find(arenas.begin(), arenas.end(), ty->owningArena) != arenas.end();
+}
+
+bool NormalizerSharedCache::isShared(const NormalizedType& norm) const
+{
+    for (TypeId ty : {norm.tops, norm.booleans, norm.errors, norm.nils, norm.numbers, norm.threads})
+    {
+        if (!isShared(ty))
+            return false;
+    }
+
+    for (const auto& [_, ty] : norm.strings.singletons)
+    {
+        if (!isShared(ty))
+            return false;
+    }
+
+    for (const auto& [ty, negations] : norm.classes.classes)
+    {
+        if (!isShared(ty))
+            return false;
+
+        for (TypeId negation : negations)
+        {
+            if (!isShared(negation))
+                return false;
+        }
+    }
+
+    for (TypeId ty : norm.tables)
+    {
+        if (!isShared(ty))
+            return false;
+    }
+
+    for (TypeId ty : norm.functions.parts)
+    {
+        if (!isShared(ty))
+            return false;
+    }
+
+    for (const auto& [ty, child] : norm.tyvars)
+    {
+        if (!isShared(ty) || !isShared(*child))
+            return false;
+    }
+
+    return true;
+}
+
+const NormalizedType* NormalizerSharedCache::find(TypeId ty)
+{
+    std::shared_lock lock(mutex);
+
+    auto it = entries.find(ty);
+
+    if (it == entries.end())
+    {
+        misses++;
+        return nullptr;
+    }
+
+    hits++;
+
+    double saved = timeSaved.load();
+    while (!timeSaved.compare_exchange_weak(saved, saved + it->second.cost))
+        ;
+
+    return it->second.norm.get();
+}
+
+const NormalizedType* NormalizerSharedCache::insert(TypeId ty, std::unique_ptr<NormalizedType> norm, double cost)
+{
+    std::unique_lock lock(mutex);
+
+    auto it = entries.try_emplace(ty, Entry{std::move(norm), cost}).first;
+    return it->second.norm.get();
+}
+
+void NormalizerSharedCache::clear()
+{
+    std::unique_lock lock(mutex);
+
+    entries.clear();
+}
+
+NormalizerSharedCache::Stats NormalizerSharedCache::takeStats()
+{
+    Stats result;
+    result.hits = hits.exchange(0);
+    result.misses = misses.exchange(0);
+    result.timeSaved = timeSaved.exchange(0);
+    return result;
+}
+
 Normalizer::Normalizer(TypeArena* arena, NotNull<BuiltinTypes> builtinTypes, NotNull<UnifierSharedState> sharedState, bool cacheInhabitance)
     : arena(arena)
     , builtinTypes(builtinTypes)
@@ -702,10 +806,37 @@ const NormalizedType* Normalizer::normalize(TypeId ty)
     if (found != cachedNormals.end())
         return found->second.get();
 
+    bool shared = sharedCache && sharedCache->isShared(ty);
+    double startTime = 0.0;
+
+    if (shared)
+    {
+        if (const NormalizedType** cached = cachedSharedNormals.find(ty))
+            return *cached;
+
+        if (const NormalizedType* cached = sharedCache->find(ty))
+        {
+            cachedSharedNormals[ty] = cached;
+            return cached;
+        }
+
+        startTime = TimeTrace::getClock();
+    }
+
     NormalizedType norm{builtinTypes};
     std::unordered_set<TypeId> seenSetTypes;
     if (!unionNormalWithTy(norm, ty, seenSetTypes))
         return nullptr;
+
+    // Normal forms that refer to the types created in this module's arena can't be shared
+    if (shared && sharedCache->isShared(norm))
+    {
+        double cost = TimeTrace::getClock() - startTime;
+        const NormalizedType* result = sharedCache->insert(ty, std::make_unique<NormalizedType>(std::move(norm)), cost);
+        cachedSharedNormals[ty] = result;
+        return result;
+    }
+
     std::unique_ptr<NormalizedType> uniq = std::make_unique<NormalizedType>(std::move(norm));
     const NormalizedType* result = uniq.get();
     cachedNormals[ty] = std::move(uniq);
@@ -861,6 +992,7 @@ void Normalizer::clearCaches()
     cachedIntersections.clear();
     cachedUnions.clear();
     cachedTypeIds.clear();
+    cachedSharedNormals.clear();
 }
 
 // ------- Normalizing unions
@@ -1438,7 +1570,7 @@ bool Normalizer::withinResourceLimits()
     if (FInt::LuauNormalizeCacheLimit > 0)
     {
         size_t cacheUsage = cachedNormals.size() + cachedIntersections.size() + cachedUnions.size() + cachedTypeIds.size() +
-                            cachedIsInhabited.size() + cachedIsInhabitedIntersection.size();
+                            cachedSharedNormals.size() + cachedIsInhabited.size() + cachedIsInhabitedIntersection.size();
         if (cacheUsage > size_t(FInt::LuauNormalizeCacheLimit))
         {
             clearCaches();
@@ -112,4 +112,196 @@ void unfreeze(TypeArena& arena)
     arena.typePacks.unfreeze();
 }
 
+// Memory owned by a string outside of the object, assuming 15 characters of small string storage
+static size_t getOwnedBytes(const std::string& s)
+{
+    return s.capacity() > 15 ? s.capacity() + 1 : 0;
+}
+
+static size_t getOwnedBytes(const std::optional<std::string>& s)
+{
+    return s ? getOwnedBytes(*s) : 0;
+}
+
+template<typename T>
+static size_t getOwnedBytes(const std::vector<T>& v)
+{
+    return v.capacity() * sizeof(T);
+}
+
+static size_t getOwnedBytes(const Tags& tags)
+{
+    size_t result = getOwnedBytes<std::string>(tags);
+
+    for (const std::string& tag : tags)
+        result += getOwnedBytes(tag);
+
+    return result;
+}
+
+static size_t getOwnedBytes(const TableType::Props& props)
+{
+    // Tree nodes have three pointers and a color in addition to the value
+    size_t result = props.size() * (sizeof(TableType::Props::value_type) + 32);
+
+    for (const auto& [name, prop] : props)
+    {
+        result += getOwnedBytes(name);
+        result += getOwnedBytes(prop.deprecatedSuggestion);
+        result += getOwnedBytes(prop.tags);
+        result += getOwnedBytes(prop.documentationSymbol);
+    }
+
+    return result;
+}
+
+template<typename T>
+static size_t getBoxedBytes()
+{
+    return TypeVariant::isBoxed<T> ? sizeof(T) : 0;
+}
+
+struct TypeOwnedBytes
+{
+    size_t operator()(const TypeId&) const
+    {
+        return 0;
+    }
+
+    size_t operator()(const GenericType& t) const
+    {
+        return getBoxedBytes<GenericType>() + getOwnedBytes(t.name);
+    }
+
+    size_t operator()(const SingletonType& t) const
+    {
+        size_t result = getBoxedBytes<SingletonType>();
+
+        if (const StringSingleton* ss = get<StringSingleton>(&t))
+            result += getOwnedBytes(ss->value);
+
+        return result;
+    }
+
+    size_t operator()(const FunctionType& t) const
+    {
+        size_t result = getBoxedBytes<FunctionType>();
+        result += getOwnedBytes(t.generics) + getOwnedBytes(t.genericPacks) + getOwnedBytes(t.argNames) + getOwnedBytes(t.tags);
+
+        for (const std::optional<FunctionArgument>& arg : t.argNames)
+            result += arg ? getOwnedBytes(arg->name) : 0;
+
+        if (t.definition)
+            result += getOwnedBytes(t.definition->definitionModuleName);
+
+        return result;
+    }
+
+    size_t operator()(const TableType& t) const
+    {
+        size_t result = getBoxedBytes<TableType>();
+        result += getOwnedBytes(t.props) + getOwnedBytes(t.name) + getOwnedBytes(t.syntheticName) + getOwnedBytes(t.definitionModuleName);
+        result += getOwnedBytes(t.instantiatedTypeParams) + getOwnedBytes(t.instantiatedTypePackParams) + getOwnedBytes(t.tags);
+        return result;
+    }
+
+    size_t operator()(const ClassType& t) const
+    {
+        size_t result = getBoxedBytes<ClassType>();
+        result += getOwnedBytes(t.name) + getOwnedBytes(t.props) + getOwnedBytes(t.tags) + getOwnedBytes(t.definitionModuleName);
+        return result;
+    }
+
+    size_t operator()(const UnionType& t) const
+    {
+        return getBoxedBytes<UnionType>() + getOwnedBytes(t.options);
+    }
+
+    size_t operator()(const IntersectionType& t) const
+    {
+        return getBoxedBytes<IntersectionType>() + getOwnedBytes(t.parts);
+    }
+
+    size_t operator()(const PendingExpansionType& t) const
+    {
+        return getBoxedBytes<PendingExpansionType>() + getOwnedBytes(t.typeArguments) + getOwnedBytes(t.packArguments);
+    }
+
+    size_t operator()(const TypeFamilyInstanceType& t) const
+    {
+        return getBoxedBytes<TypeFamilyInstanceType>() + getOwnedBytes(t.typeArguments) + getOwnedBytes(t.packArguments);
+    }
+
+    template<typename T>
+    size_t operator()(const T&) const
+    {
+        return getBoxedBytes<T>();
+    }
+};
+
+size_t TypeArenaMemoryUsage::getTotalBytes() const
+{
+    size_t result = typePackBytes;
+
+    for (size_t bytes : typeBytes)
+        result += bytes;
+
+    return result;
+}
+
+void TypeArenaMemoryUsage::add(const TypeArenaMemoryUsage& other)
+{
+    if (typeCounts.size() < other.typeCounts.size())
+    {
+        typeCounts.resize(other.typeCounts.size());
+        typeBytes.resize(other.typeBytes.size());
+    }
+
+    for (size_t i = 0; i < other.typeCounts.size(); ++i)
+    {
+        typeCounts[i] += other.typeCounts[i];
+        typeBytes[i] += other.typeBytes[i];
+    }
+
+    typePackCount += other.typePackCount;
+    typePackBytes += other.typePackBytes;
+}
+
+TypeArenaMemoryUsage getMemoryUsage(const TypeArena& arena)
+{
+    TypeArenaMemoryUsage result;
+
+    arena.types.forEach([&](const Type& ty) {
+        size_t kind = size_t(ty.ty.index());
+
+        if (result.typeCounts.size() <= kind)
+        {
+            result.typeCounts.resize(kind + 1);
+            result.typeBytes.resize(kind + 1);
+        }
+
+        result.typeCounts[kind]++;
+        result.typeBytes[kind] += sizeof(Type) + visit(TypeOwnedBytes{}, ty.ty) + getOwnedBytes(ty.documentationSymbol);
+    });
+
+    arena.typePacks.forEach([&](const TypePackVar& tp) {
+        result.typePackCount++;
+        result.typePackBytes += sizeof(TypePackVar);
+
+        if (const TypePack* pack = get_if<TypePack>(&tp.ty))
+            result.typePackBytes += getOwnedBytes(pack->head);
+    });
+
+    return result;
+}
+
+const char* getTypeKindName(size_t index)
+{
+    // Has to match the order of TypeVariant alternatives, which start with the ones that Unifiable::Variant adds
+    static const char* const kNames[] = {"bound", "error", "free", "generic", "primitive", "blocked", "pending expansion", "singleton", "function", "table",
+        "metatable", "class", "any", "union", "intersection", "lazy", "unknown", "never", "negation", "type family instance"};
+
+    return index < sizeof(kNames) / sizeof(kNames[0]) ? kNames[index] : "unknown kind";
+}
+
 } // namespace Luau
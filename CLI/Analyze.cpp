@@ -9,10 +9,7 @@
 #include "FileUtils.h"
 #include "Flags.h"
 
-#include <condition_variable>
 #include <functional>
-#include <mutex>
-#include <queue>
 #include <thread>
 #include <utility>
 
@@ -71,6 +68,45 @@ static void reportWarning(ReportFormat format, const char* name, const Luau::Lin
     report(format, name, warning.location, Luau::LintWarning::getName(warning.code), warning.text.c_str());
 }
 
+static void reportMemoryUsage(const char* name, const Luau::TypeArenaMemoryUsage& usage)
+{
+    size_t typeCount = 0;
+
+    for (size_t count : usage.typeCounts)
+        typeCount += count;
+
+    printf("%s: %d bytes in %d types and %d type packs", name, int(usage.getTotalBytes()), int(typeCount), int(usage.typePackCount));
+
+    const char* separator = " (";
+
+    for (size_t i = 0; i < usage.typeCounts.size(); ++i)
+    {
+        if (usage.typeCounts[i] == 0)
+            continue;
+
+        printf("%s%s %d", separator, Luau::getTypeKindName(i), int(usage.typeBytes[i]));
+        separator = ", ";
+    }
+
+    printf("%s\n", typeCount ? ")" : "");
+}
+
+static void reportModuleMemoryUsage(Luau::Frontend& frontend, const Luau::ModuleName& name, Luau::TypeArenaMemoryUsage& total)
+{
+    Luau::ModulePtr module = frontend.moduleResolver.getModule(name);
+
+    if (!module)
+        return;
+
+    Luau::TypeArenaMemoryUsage usage = Luau::getMemoryUsage(module->internalTypes);
+    usage.add(Luau::getMemoryUsage(module->interfaceTypes));
+
+    std::string humanReadableName = frontend.fileResolver->getHumanReadableModuleName(name);
+    reportMemoryUsage(humanReadableName.c_str(), usage);
+
+    total.add(usage);
+}
+
 static bool reportModuleResult(Luau::Frontend& frontend, const Luau::ModuleName& name, ReportFormat format, bool annotate)
 {
     std::optional<Luau::CheckResult> cr = frontend.getCheckResult(name, false);
@@ -124,6 +160,10 @@ static void displayHelp(const char* argv0)
     printf("  --formatter=gnu: report analysis errors in GNU-compatible format\n");
     printf("  --mode=strict: default to strict mode when typechecking\n");
     printf("  --timetrace: record compiler time tracing information into trace.json\n");
+    printf("  --cache-dir=<path>: store results of checking modules in a directory and skip modules that didn't change since the last run\n");
+    printf("  --stats: print the number of checked modules, time spent on each phase, module cache statistics and thread utilization\n");
+    printf("  --memory-report: keep full type graphs and print the memory used by the types of each module\n");
+    printf("  -j<n>: check modules on n threads, defaults to the number of hardware threads\n");
 }
 
 static int assertionHandler(const char* expr, const char* file, int line, const char* function)
@@ -226,68 +266,47 @@ struct CliConfigResolver : Luau::ConfigResolver
     }
 };
 
-struct TaskScheduler
+struct CliModuleCacheStore : Luau::ModuleCacheStore
 {
-    TaskScheduler(unsigned threadCount)
-        : threadCount(threadCount)
+    std::string directory;
+
+    CliModuleCacheStore(std::string directory)
+        : directory(std::move(directory))
     {
-        for (unsigned i = 0; i < threadCount; i++)
-        {
-            workers.emplace_back([this] {
-                workerFunction();
-            });
-        }
     }
 
-    ~TaskScheduler()
+    std::string getPath(uint64_t key) const
     {
-        for (unsigned i = 0; i < threadCount; i++)
-            push({});
+        char name[32];
+        snprintf(name, sizeof(name), "%016llx.lmod", (unsigned long long)key);
 
-        for (std::thread& worker : workers)
-            worker.join();
+        return joinPaths(directory, name);
     }
 
-    std::function<void()> pop()
+    std::optional<std::string> read(uint64_t key) override
     {
-        std::unique_lock guard(mtx);
-
-        cv.wait(guard, [this] {
-            return !tasks.empty();
-        });
-
-        std::function<void()> task = tasks.front();
-        tasks.pop();
-        return task;
+        return readFile(getPath(key));
     }
 
-    void push(std::function<void()> task)
+    void write(uint64_t key, const std::string& data) override
     {
-        {
-            std::unique_lock guard(mtx);
-            tasks.push(std::move(task));
-        }
+        // the file is written under a temporary name and renamed so that readers never observe a partial file
+        std::string path = getPath(key);
+        std::string tempPath = path + ".tmp";
 
-        cv.notify_one();
-    }
+        FILE* file = fopen(tempPath.c_str(), "wb");
 
-    static unsigned getThreadCount()
-    {
-        return std::max(std::thread::hardware_concurrency(), 1u);
-    }
+        if (!file)
+            return;
 
-private:
-    void workerFunction()
-    {
-        while (std::function<void()> task = pop())
-            task();
-    }
+        bool success = fwrite(data.data(), 1, data.size(), file) == data.size();
 
-    unsigned threadCount = 1;
-    std::mutex mtx;
-    std::condition_variable cv;
-    std::vector<std::thread> workers;
-    std::queue<std::function<void()>> tasks;
+        if (fclose(file) != 0)
+            success = false;
+
+        if (!success || rename(tempPath.c_str(), path.c_str()) != 0)
+            remove(tempPath.c_str());
+    }
 };
 
 int main(int argc, char** argv)
@@ -305,7 +324,10 @@ int main(int argc, char** argv)
     ReportFormat format = ReportFormat::Default;
     Luau::Mode mode = Luau::Mode::Nonstrict;
     bool annotate = false;
+    bool printStats = false;
+    bool memoryReport = false;
     int threadCount = 0;
+    std::string cacheDir;
 
     for (int i = 1; i < argc; ++i)
     {
@@ -322,6 +344,12 @@ int main(int argc, char** argv)
             annotate = true;
         else if (strcmp(argv[i], "--timetrace") == 0)
             FFlag::DebugLuauTimeTracing.value = true;
+        else if (strncmp(argv[i], "--cache-dir=", 12) == 0)
+            cacheDir = argv[i] + 12;
+        else if (strcmp(argv[i], "--stats") == 0)
+            printStats = true;
+        else if (strcmp(argv[i], "--memory-report") == 0)
+            memoryReport = true;
         else if (strncmp(argv[i], "--fflags=", 9) == 0)
             setLuauFlags(argv[i] + 9);
         else if (strncmp(argv[i], "-j", 2) == 0)
@@ -337,13 +365,27 @@ int main(int argc, char** argv)
 #endif
 
     Luau::FrontendOptions frontendOptions;
-    frontendOptions.retainFullTypeGraphs = annotate;
+    frontendOptions.retainFullTypeGraphs = annotate || memoryReport;
     frontendOptions.runLintChecks = true;
 
     CliFileResolver fileResolver;
     CliConfigResolver configResolver(mode);
     Luau::Frontend frontend(&fileResolver, &configResolver, frontendOptions);
 
+    std::optional<CliModuleCacheStore> moduleCacheStore;
+
+    if (!cacheDir.empty())
+    {
+        if (!isDirectory(cacheDir))
+        {
+            fprintf(stderr, "Cache directory %s doesn't exist\n", cacheDir.c_str());
+            return 1;
+        }
+
+        moduleCacheStore.emplace(cacheDir);
+        frontend.moduleCacheStore = &*moduleCacheStore;
+    }
+
     Luau::registerBuiltinGlobals(frontend, frontend.globals);
     Luau::freeze(frontend.globals.globalTypes);
 
@@ -358,24 +400,52 @@ int main(int argc, char** argv)
 
     std::vector<Luau::ModuleName> checkedModules;
 
-    // If thread count is not set, try to use HW thread count, but with an upper limit
-    // When we improve scalability of typechecking, upper limit can be adjusted/removed
+    // If thread count is not set, use HW thread count
     if (threadCount <= 0)
-        threadCount = std::min(TaskScheduler::getThreadCount(), 8u);
+        threadCount = std::max(std::thread::hardware_concurrency(), 1u);
 
-    {
-        TaskScheduler scheduler(threadCount);
-
-        checkedModules = frontend.checkQueuedModules(std::nullopt, [&](std::function<void()> f) {
-            scheduler.push(std::move(f));
-        });
-    }
+    checkedModules = frontend.checkQueuedModulesParallel(unsigned(threadCount));
 
     int failed = 0;
 
     for (const Luau::ModuleName& name : checkedModules)
         failed += !reportModuleResult(frontend, name, format, annotate);
 
+    if (memoryReport)
+    {
+        Luau::TypeArenaMemoryUsage total;
+
+        for (const Luau::ModuleName& name : checkedModules)
+            reportModuleMemoryUsage(frontend, name, total);
+
+        reportMemoryUsage("Total", total);
+    }
+
+    if (printStats)
+    {
+        const Luau::Frontend::Stats& stats = frontend.stats;
+
+        printf("Checked %d files (%d lines): read %.2fs, parse %.2fs, check %.2fs, lint %.2fs\n", int(stats.files), int(stats.lines), stats.timeRead,
+            stats.timeParse, stats.timeCheck, stats.timeLint);
+
+        if (moduleCacheStore)
+            printf("Module cache: %d hits, %d misses\n", int(stats.moduleCacheHits), int(stats.moduleCacheMisses));
+
+        if (stats.normalizerCacheHits != 0 || stats.normalizerCacheMisses != 0)
+            printf("Normalizer cache: %d hits, %d misses, %.2fs saved\n", int(stats.normalizerCacheHits), int(stats.normalizerCacheMisses),
+                stats.timeNormalizerCacheSaved);
+
+        if (!stats.timeThreadBusy.empty() && stats.timeParallelCheck > 0)
+        {
+            printf("Threads: %d, %.2fs total, busy", int(stats.timeThreadBusy.size()), stats.timeParallelCheck);
+
+            for (double busy : stats.timeThreadBusy)
+                printf(" %.0f%%", busy / stats.timeParallelCheck * 100.0);
+
+            printf("\n");
+        }
+    }
+
     if (!configResolver.configErrors.empty())
     {
         failed += int(configResolver.configErrors.size());
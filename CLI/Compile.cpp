@@ -5,12 +5,14 @@
 #include "Luau/CodeGen.h"
 #include "Luau/Compiler.h"
 #include "Luau/BytecodeBuilder.h"
+#include "Luau/BytecodeUtils.h"
 #include "Luau/Parser.h"
 #include "Luau/TimeTrace.h"
 
 #include "FileUtils.h"
 #include "Flags.h"
 
+#include <algorithm>
 #include <memory>
 
 #ifdef _WIN32
@@ -24,12 +26,15 @@ enum class CompileFormat
 {
     Text,
     Binary,
+    BinaryAligned, // Bytecode in the aligned layout that can be executed in place with luau_loadmapped
     Remarks,
     Codegen,        // Prints annotated native code including IR and assembly
     CodegenAsm,     // Prints annotated native code assembly
     CodegenIr,      // Prints annotated native code IR
     CodegenVerbose, // Prints annotated native code including IR, assembly and outlined code
+    CodegenCoverage, // Prints native code size and interpreter fallbacks for each opcode
     CodegenNull,
+    OpcodePairs, // Prints the most common pairs of adjacent opcodes across all files
     Null
 };
 
@@ -54,6 +59,8 @@ static std::optional<CompileFormat> getCompileFormat(const char* name)
         return CompileFormat::Text;
     else if (strcmp(name, "binary") == 0)
         return CompileFormat::Binary;
+    else if (strcmp(name, "binaryaligned") == 0)
+        return CompileFormat::BinaryAligned;
     else if (strcmp(name, "text") == 0)
         return CompileFormat::Text;
     else if (strcmp(name, "remarks") == 0)
@@ -66,8 +73,12 @@ static std::optional<CompileFormat> getCompileFormat(const char* name)
         return CompileFormat::CodegenIr;
     else if (strcmp(name, "codegenverbose") == 0)
         return CompileFormat::CodegenVerbose;
+    else if (strcmp(name, "codegencoverage") == 0)
+        return CompileFormat::CodegenCoverage;
     else if (strcmp(name, "codegennull") == 0)
         return CompileFormat::CodegenNull;
+    else if (strcmp(name, "oppairs") == 0)
+        return CompileFormat::OpcodePairs;
     else if (strcmp(name, "null") == 0)
         return CompileFormat::Null;
     else
@@ -119,6 +130,8 @@ struct CompileStats
     double parseTime;
     double compileTime;
     double codegenTime;
+
+    std::vector<uint64_t> opcodePairs;
 };
 
 static double recordDeltaTime(double& timer)
@@ -153,7 +166,11 @@ static bool compileFile(const char* name, CompileFormat format, Luau::CodeGen::A
         options.target = assemblyTarget;
         options.outputBinary = format == CompileFormat::CodegenNull;
 
-        if (!options.outputBinary)
+        if (format == CompileFormat::CodegenCoverage)
+        {
+            options.includeCoverage = true;
+        }
+        else if (!options.outputBinary)
         {
             options.includeAssembly = format != CompileFormat::CodegenIr;
             options.includeIr = format != CompileFormat::CodegenAsm;
@@ -163,6 +180,12 @@ static bool compileFile(const char* name, CompileFormat format, Luau::CodeGen::A
         options.annotator = annotateInstruction;
         options.annotatorContext = &bcb;
 
+        if (format == CompileFormat::BinaryAligned)
+            bcb.setAlignedLayout(true);
+
+        if (format == CompileFormat::OpcodePairs)
+            bcb.setOpcodePairCounts(stats.opcodePairs.data());
+
         if (format == CompileFormat::Text)
         {
             bcb.setDumpFlags(Luau::BytecodeBuilder::Dump_Code | Luau::BytecodeBuilder::Dump_Source | Luau::BytecodeBuilder::Dump_Locals |
@@ -207,18 +230,21 @@ static bool compileFile(const char* name, CompileFormat format, Luau::CodeGen::A
             printf("%s", bcb.dumpSourceRemarks().c_str());
             break;
         case CompileFormat::Binary:
+        case CompileFormat::BinaryAligned:
             fwrite(bcb.getBytecode().data(), 1, bcb.getBytecode().size(), stdout);
             break;
         case CompileFormat::Codegen:
         case CompileFormat::CodegenAsm:
         case CompileFormat::CodegenIr:
         case CompileFormat::CodegenVerbose:
+        case CompileFormat::CodegenCoverage:
             printf("%s", getCodegenAssembly(name, bcb.getBytecode(), options).c_str());
             break;
         case CompileFormat::CodegenNull:
             stats.codegen += getCodegenAssembly(name, bcb.getBytecode(), options).size();
             stats.codegenTime += recordDeltaTime(currts);
             break;
+        case CompileFormat::OpcodePairs:
         case CompileFormat::Null:
             break;
         }
@@ -238,12 +264,43 @@ static bool compileFile(const char* name, CompileFormat format, Luau::CodeGen::A
     }
 }
 
+static void reportOpcodePairs(const std::vector<uint64_t>& counts)
+{
+    const size_t kMaxPairs = 32;
+
+    uint64_t total = 0;
+    std::vector<std::pair<uint64_t, size_t>> pairs;
+
+    for (size_t i = 0; i < counts.size(); ++i)
+    {
+        total += counts[i];
+
+        if (counts[i])
+            pairs.push_back({counts[i], i});
+    }
+
+    std::sort(pairs.begin(), pairs.end(), [](auto& lhs, auto& rhs) {
+        return lhs.first > rhs.first;
+    });
+
+    printf("%-32s %10s %7s\n", "Pair", "Count", "Share");
+
+    for (size_t i = 0; i < pairs.size() && i < kMaxPairs; ++i)
+    {
+        auto [count, index] = pairs[i];
+
+        std::string name = std::string(Luau::getOpName(LuauOpcode(index / LOP__COUNT))) + "+" + Luau::getOpName(LuauOpcode(index % LOP__COUNT));
+
+        printf("%-32s %10lld %6.2f%%\n", name.c_str(), (long long)count, double(count) * 100.0 / double(total));
+    }
+}
+
 static void displayHelp(const char* argv0)
 {
     printf("Usage: %s [--mode] [options] [file list]\n", argv0);
     printf("\n");
     printf("Available modes:\n");
-    printf("   binary, text, remarks, codegen\n");
+    printf("   binary, binaryaligned, text, remarks, codegen, oppairs\n");
     printf("\n");
     printf("Available options:\n");
     printf("  -h, --help: Display this usage message.\n");
@@ -344,13 +401,16 @@ int main(int argc, char** argv)
     const std::vector<std::string> files = getSourceFiles(argc, argv);
 
 #ifdef _WIN32
-    if (compileFormat == CompileFormat::Binary)
+    if (compileFormat == CompileFormat::Binary || compileFormat == CompileFormat::BinaryAligned)
         _setmode(_fileno(stdout), _O_BINARY);
 #endif
 
     CompileStats stats = {};
     int failed = 0;
 
+    if (compileFormat == CompileFormat::OpcodePairs)
+        stats.opcodePairs.resize(LOP__COUNT * LOP__COUNT);
+
     for (const std::string& path : files)
         failed += !compileFile(path.c_str(), compileFormat, assemblyTarget, stats);
 
@@ -362,6 +422,8 @@ int main(int argc, char** argv)
             int(stats.lines / 1000), int(stats.bytecode / 1024), int(stats.codegen / 1024),
             stats.bytecode == 0 ? 0.0 : double(stats.codegen) / double(stats.bytecode), stats.readTime, stats.parseTime, stats.compileTime,
             stats.codegenTime);
+    else if (compileFormat == CompileFormat::OpcodePairs)
+        reportOpcodePairs(stats.opcodePairs);
 
     return failed ? 1 : 0;
 }
@@ -17,6 +17,8 @@
 #include "isocline.h"
 
 #include <memory>
+#include <thread>
+#include <vector>
 
 #ifdef _WIN32
 #include <io.h>
@@ -42,6 +44,9 @@ LUAU_FASTFLAG(DebugLuauTimeTracing)
 constexpr int MaxTraversalLimit = 50;
 
 static bool codegen = false;
+static bool codegenTiering = false;
+static int gcWorkers = 0;
+static int pageCache = -1;
 
 // Ctrl-C handling
 static void sigintCallback(lua_State* L, int gc)
@@ -151,7 +156,7 @@ static int lua_require(lua_State* L)
     std::string bytecode = Luau::compile(*source, copts());
     if (luau_load(ML, chunkname.c_str(), bytecode.data(), bytecode.size(), 0) == 0)
     {
-        if (codegen)
+        if (codegen && !codegenTiering)
             Luau::CodeGen::compile(ML, -1);
 
         if (coverageActive())
@@ -235,11 +240,36 @@ static int lua_callgrind(lua_State* L)
 }
 #endif
 
+static void gcParallel(lua_State* L, void (*task)(void* context, int worker), void* context, int workers)
+{
+    std::vector<std::thread> threads;
+
+    for (int i = 1; i < workers; ++i)
+        threads.emplace_back(task, context, i);
+
+    task(context, 0);
+
+    for (std::thread& thread : threads)
+        thread.join();
+}
+
 void setupState(lua_State* L)
 {
     if (codegen)
         Luau::CodeGen::create(L);
 
+    if (codegenTiering)
+        Luau::CodeGen::enableTiering(L, {});
+
+    if (gcWorkers > 1)
+    {
+        lua_callbacks(L)->gcparallel = gcParallel;
+        lua_gc(L, LUA_GCSETWORKERS, gcWorkers);
+    }
+
+    if (pageCache >= 0)
+        lua_gc(L, LUA_GCSETPAGECACHE, pageCache);
+
     luaL_openlibs(L);
 
     static const luaL_Reg funcs[] = {
@@ -603,7 +633,7 @@ static bool runFile(const char* name, lua_State* GL, bool repl)
 
     if (luau_load(L, chunkname.c_str(), bytecode.data(), bytecode.size(), 0) == 0)
     {
-        if (codegen)
+        if (codegen && !codegenTiering)
             Luau::CodeGen::compile(L, -1);
 
         if (coverageActive())
@@ -658,6 +688,9 @@ static void displayHelp(const char* argv0)
     printf("  --profile[=N]: profile the code using N Hz sampling (default 10000) and output results to profile.out\n");
     printf("  --timetrace: record compiler time tracing information into trace.json\n");
     printf("  --codegen: execute code using native code generation\n");
+    printf("  --codegen-tiering: start in the interpreter and compile functions and loops to native code once they are hot\n");
+    printf("  --gc-workers=N: use N threads to mark objects during the atomic stage of garbage collection\n");
+    printf("  --page-cache=N: keep up to N KB of empty memory pages for reuse (0 disables the page cache)\n");
 }
 
 static int assertionHandler(const char* expr, const char* file, int line, const char* function)
@@ -724,11 +757,24 @@ int replMain(int argc, char** argv)
         {
             codegen = true;
         }
+        else if (strcmp(argv[i], "--codegen-tiering") == 0)
+        {
+            codegen = true;
+            codegenTiering = true;
+        }
         else if (strcmp(argv[i], "--codegen-perf") == 0)
         {
             codegen = true;
             codegenPerf = true;
         }
+        else if (strncmp(argv[i], "--gc-workers=", 13) == 0)
+        {
+            gcWorkers = atoi(argv[i] + 13);
+        }
+        else if (strncmp(argv[i], "--page-cache=", 13) == 0)
+        {
+            pageCache = atoi(argv[i] + 13);
+        }
         else if (strcmp(argv[i], "--coverage") == 0)
         {
             coverage = true;
@@ -130,6 +130,7 @@ public:
     void fmov(RegisterA64 dst, double src);
 
     // Floating-point scalar math
+    // Note: fabs/fsqrt only support d registers; other instructions also accept q registers and operate on 4 single-precision lanes
     void fabs(RegisterA64 dst, RegisterA64 src);
     void fadd(RegisterA64 dst, RegisterA64 src1, RegisterA64 src2);
     void fdiv(RegisterA64 dst, RegisterA64 src1, RegisterA64 src2);
@@ -148,6 +149,11 @@ public:
     void scvtf(RegisterA64 dst, RegisterA64 src);
     void ucvtf(RegisterA64 dst, RegisterA64 src);
 
+    // Vector lane moves on 4 single-precision lanes
+    // dup_4s broadcasts lane 'index' of src into all lanes of dst; ins_4s replaces lane 'index' of dst with the w register src
+    void dup_4s(RegisterA64 dst, RegisterA64 src, uint8_t index);
+    void ins_4s(RegisterA64 dst, RegisterA64 src, uint8_t index);
+
     // Floating-point conversion to integer using JS rules (wrap around 2^32) and set Z flag
     // note: this is part of ARM8.3 (JSCVT feature); support of this instruction needs to be checked at runtime
     void fjcvtzs(RegisterA64 dst, RegisterA64 src);
@@ -205,6 +211,7 @@ private:
     void placeSR2(const char* name, RegisterA64 dst, RegisterA64 src, uint8_t op, uint8_t op2 = 0);
     void placeR3(const char* name, RegisterA64 dst, RegisterA64 src1, RegisterA64 src2, uint8_t op, uint8_t op2);
     void placeR1(const char* name, RegisterA64 dst, RegisterA64 src, uint32_t op);
+    void placeVR(const char* name, RegisterA64 dst, RegisterA64 src1, RegisterA64 src2, uint16_t op, uint8_t op2);
     void placeI12(const char* name, RegisterA64 dst, RegisterA64 src1, int src2, uint8_t op);
     void placeI16(const char* name, RegisterA64 dst, int src, uint8_t op, int shift = 0);
     void placeA(const char* name, RegisterA64 dst, AddressA64 src, uint16_t opsize, int sizelog);
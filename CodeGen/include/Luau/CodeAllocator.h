@@ -24,9 +24,23 @@ struct CodeAllocator
     // Places data and code into the executable page area
     // To allow allocation while previously allocated code is already running, allocation has page granularity
     // It's important to group functions together so that page alignment won't result in a lot of wasted space
+    // Ranges released by 'deallocate' are reused first, in address order
     bool allocate(
         const uint8_t* data, size_t dataSize, const uint8_t* code, size_t codeSize, uint8_t*& result, size_t& resultSize, uint8_t*& resultCodeStart);
 
+    // Places data and code into a released range that starts below 'limit'; the current block is not used and no new blocks are created
+    bool allocateBelow(const uint8_t* limit, const uint8_t* data, size_t dataSize, const uint8_t* code, size_t codeSize, uint8_t*& result,
+        size_t& resultSize, uint8_t*& resultCodeStart);
+
+    // Returns the pages of an allocation for reuse; code in them must not be running or be entered again
+    // Blocks that no longer have any allocations are returned to the system
+    void deallocate(uint8_t* result, size_t resultSize);
+
+    size_t getTotalSize() const
+    {
+        return blocks.size() * blockSize;
+    }
+
     // Provided to unwind info callbacks
     void* context = nullptr;
 
@@ -42,7 +56,19 @@ private:
     // But to simplify block space checks, we limit the max size of all that data
     static const size_t kMaxReservedDataSize = 256;
 
+    struct FreeRange
+    {
+        uint8_t* start;
+        uint8_t* end; // page aligned or the end of the block
+    };
+
+    void placeInFreeRange(size_t index, const uint8_t* data, size_t dataSize, const uint8_t* code, size_t codeSize, size_t totalSize,
+        uint8_t*& result, size_t& resultSize, uint8_t*& resultCodeStart);
     bool allocateNewBlock(size_t& unwindInfoSize);
+    void addFreeRange(size_t blockIndex, FreeRange range);
+    void releaseBlock(size_t index);
+
+    size_t findBlock(const uint8_t* pos) const;
 
     uint8_t* allocatePages(size_t size) const;
     void freePages(uint8_t* mem, size_t size) const;
@@ -55,6 +81,9 @@ private:
     std::vector<uint8_t*> blocks;
     std::vector<void*> unwindInfos;
 
+    // Released ranges sorted by address; adjacent ranges are merged unless they are in different blocks
+    std::vector<FreeRange> freeRanges;
+
     size_t blockSize = 0;
     size_t maxTotalSize = 0;
 
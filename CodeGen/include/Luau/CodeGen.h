@@ -36,6 +36,12 @@ struct CompilationStats
     size_t nativeMetadataSizeBytes = 0;
 
     uint32_t functionsCompiled = 0;
+    uint32_t functionsLoadedFromCache = 0;
+
+    // Making room for the new code can drop native code of functions that weren't entered recently and move code of other functions
+    uint32_t functionsEvicted = 0;
+    size_t nativeCodeEvictedBytes = 0;
+    size_t nativeCodeRepackedBytes = 0;
 };
 
 using AllocationCallback = void(void* context, void* oldPointer, size_t oldSize, void* newPointer, size_t newSize);
@@ -45,9 +51,48 @@ bool isSupported();
 void create(lua_State* L, AllocationCallback* allocationCallback, void* allocationCallbackContext);
 void create(lua_State* L);
 
+// Native code can also be generated for A64 and executed by an interpreter of A64 instructions on other hosts; this is much slower than the VM and
+// is only meant for testing the A64 code generator on x64 machines
+bool isA64EmulationSupported();
+void createA64Emulation(lua_State* L);
+
 // Builds target function and all inner functions
 CodeGenCompilationResult compile(lua_State* L, int idx, unsigned int flags = 0, CompilationStats* stats = nullptr);
 
+struct TieringOptions
+{
+    // Number of calls from the interpreter after which a function is compiled
+    uint32_t entryThreshold = 100;
+
+    // Number of loop iterations in the interpreter after which a function is compiled
+    uint32_t loopThreshold = 1000;
+};
+
+struct TieringStats
+{
+    uint32_t functionsPromoted = 0;
+    uint32_t functionsFailed = 0;
+    uint32_t callsInlined = 0; // calls that were replaced by the body of the expected callee behind a guard
+    uint32_t functionsEvicted = 0;
+
+    double compileTime = 0.0; // in seconds
+};
+
+// Enables tiered compilation: the interpreter counts calls and loop iterations of each function, and functions are compiled one at a time once they
+// cross one of the thresholds; this can be used instead of compile() or in addition to it
+// Loops that are running in the interpreter when their function gets native code continue in native code only while tiering is enabled
+void enableTiering(lua_State* L, const TieringOptions& options = {});
+TieringStats getTieringStats(lua_State* L);
+
+// Limits the executable memory used by native code of compiled functions; when new code doesn't fit, functions that weren't entered from the
+// interpreter recently continue in the interpreter and may be compiled again by tiering. Functions that have a call frame on any thread are kept.
+// When set to 0, code is only evicted when the code allocator runs out of space.
+void setNativeCodeLimit(lua_State* L, size_t limit);
+
+// Stores native code in the specified directory and reuses it when the same bytecode is compiled again with the same target and code generator
+// Pass nullptr to disable the cache
+void setCodeCacheDirectory(lua_State* L, const char* path);
+
 using AnnotatorFn = void (*)(void* context, std::string& result, int fid, int instpos);
 
 struct AssemblyOptions
@@ -69,6 +114,10 @@ struct AssemblyOptions
     bool includeIr = false;
     bool includeOutlinedCode = false;
 
+    // Appends a table with the number of bytecode instructions of each opcode, the instructions that are always handled by the interpreter
+    // implementation, and the size of native code generated for them inline and in outlined fallback blocks
+    bool includeCoverage = false;
+
     // Optional annotator function can be provided to describe each instruction, it takes function id and sequential instruction id
     AnnotatorFn annotator = nullptr;
     void* annotatorContext = nullptr;
@@ -97,6 +97,10 @@ struct CfgInfo
 void computeCfgImmediateDominators(IrFunction& function);
 void computeCfgDominanceTreeChildren(IrFunction& function);
 
+// Check if block 'a' dominates block 'b' (dominance tree has to be computed)
+// Blocks that are not reachable from the entry are not dominated by any block
+bool dominates(const CfgInfo& cfg, uint32_t a, uint32_t b);
+
 struct IdfContext
 {
     struct BlockAndOrdering
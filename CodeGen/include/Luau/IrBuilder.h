@@ -9,6 +9,7 @@
 #include <vector>
 
 struct Proto;
+struct Closure;
 typedef uint32_t Instruction;
 
 namespace Luau
@@ -43,6 +44,7 @@ struct IrBuilder
     IrOp constUint(unsigned value);
     IrOp constDouble(double value);
     IrOp constTag(uint8_t value);
+    IrOp constPointer(const void* value);
     IrOp constAny(IrConst constant, uint64_t asCommonKey);
 
     IrOp cond(IrCondition cond);
@@ -76,6 +78,15 @@ struct IrBuilder
 
     std::vector<uint32_t> instIndexToBlock; // Block index at the bytecode instruction
 
+    // Calls that are expected to reach a specific Lua closure; these are inlined behind a guard, see IrInlining.h
+    struct InlineTarget
+    {
+        uint32_t pcpos;
+        Closure* closure;
+    };
+
+    std::vector<InlineTarget> inlineTargets;
+
     // Similar to BytecodeBuilder, duplicate constants are removed used the same method
     struct ConstantKey
     {
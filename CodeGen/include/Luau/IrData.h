@@ -36,7 +36,7 @@ enum class IrCmd : uint8_t
     NOP,
 
     // Load a tag from TValue
-    // A: Rn or Kn
+    // A: Rn or Kn or pointer (TValue)
     LOAD_TAG,
 
     // Load a pointer (*) from TValue
@@ -44,7 +44,7 @@ enum class IrCmd : uint8_t
     LOAD_POINTER,
 
     // Load a double number from TValue
-    // A: Rn or Kn
+    // A: Rn or Kn or pointer (TValue)
     LOAD_DOUBLE,
 
     // Load an int from TValue
@@ -75,6 +75,11 @@ enum class IrCmd : uint8_t
     // B: unsigned int (hash)
     GET_HASH_NODE_ADDR,
 
+    // Get pointer (TValue) to table shape slot value at the active cached slot index
+    // A: pointer (Table)
+    // B: unsigned int (pcpos)
+    GET_SHAPE_SLOT_ADDR,
+
     // Get pointer (TValue) to Closure upvalue.
     // A: pointer or undef (Closure)
     // B: UPn
@@ -167,6 +172,27 @@ enum class IrCmd : uint8_t
     // A: double
     ABS_NUM,
 
+    // Add/Sub/Mul/Div two vectors component-wise
+    // A, B: TValue (vector)
+    // Lanes of the result that don't hold vector components are unspecified, TAG_VECTOR has to be used to make a valid TValue
+    ADD_VEC,
+    SUB_VEC,
+    MUL_VEC,
+    DIV_VEC,
+
+    // Negate a vector component-wise
+    // A: TValue (vector)
+    // Lanes of the result that don't hold vector components are unspecified
+    UNM_VEC,
+
+    // Convert a number to a single-precision vector with all components set to that number
+    // A: double
+    NUM_TO_VEC,
+
+    // Place a vector tag into the TValue lanes of the vector value
+    // A: TValue (vector)
+    TAG_VECTOR,
+
     // Compute Luau 'not' operation on destructured TValue
     // A: tag
     // B: int (value)
@@ -219,7 +245,8 @@ enum class IrCmd : uint8_t
     JUMP_GE_UINT,
 
     // Jump if pointers are equal
-    // A, B: pointer (*)
+    // A: pointer (*)
+    // B: pointer (*) or pointer constant
     // C: block (if true)
     // D: block (if false)
     JUMP_EQ_POINTER,
@@ -249,6 +276,7 @@ enum class IrCmd : uint8_t
     // Allocate new table
     // A: unsigned int (array element count)
     // B: unsigned int (node element count)
+    // C: int (1 if the table gets a shape with room for B string keys, see luaH_newshaped)/undef
     NEW_TABLE,
 
     // Duplicate a table
@@ -407,11 +435,19 @@ enum class IrCmd : uint8_t
 
     // Guard against cached table node slot not matching the actual table node slot for a key
     // A: pointer (LuaNode)
-    // B: Kn
+    // B: Kn or pointer constant (TString)
     // C: block/undef
     // When undef is specified instead of a block, execution is aborted on check failure
     CHECK_SLOT_MATCH,
 
+    // Guard against table not having a shape or cached shape slot not holding a non-nil value for a key
+    // A: pointer (Table)
+    // B: unsigned int (pcpos)
+    // C: Kn
+    // D: block/undef
+    // When undef is specified instead of a block, execution is aborted on check failure
+    CHECK_SHAPE_SLOT_MATCH,
+
     // Guard against table node with a linked next node to ensure that our lookup hits the main position of the key
     // A: pointer (LuaNode)
     // B: block/vmexit/undef
@@ -424,6 +460,11 @@ enum class IrCmd : uint8_t
     // When undef is specified instead of a block, execution is aborted on check failure
     CHECK_NODE_VALUE,
 
+    // Guard against an interrupt handler being installed
+    // A: block/vmexit/undef
+    // When undef is specified instead of a block, execution is aborted on check failure
+    CHECK_NO_INTERRUPT,
+
     // Special operations
 
     // Check interrupt handler
@@ -629,6 +670,7 @@ enum class IrConstKind : uint8_t
     Uint,
     Double,
     Tag,
+    Pointer, // address of a VM object that generated code depends on; only used when that object is kept alive by the function
 };
 
 struct IrConst
@@ -641,6 +683,7 @@ struct IrConst
         unsigned valueUint;
         double valueDouble;
         uint8_t valueTag;
+        const void* valuePointer;
     };
 };
 
@@ -848,6 +891,9 @@ struct IrBlock
     uint32_t chainkey = 0;
     uint32_t expectedNextBlock = ~0u;
 
+    // Interpreter can enter native code at the start of this block (on-stack replacement), so optimizations can't carry state into it
+    bool loopEntry = false;
+
     Label label;
 };
 
@@ -986,6 +1032,14 @@ struct IrFunction
         return value.valueDouble;
     }
 
+    const void* pointerOp(IrOp op)
+    {
+        IrConst& value = constOp(op);
+
+        LUAU_ASSERT(value.kind == IrConstKind::Pointer);
+        return value.valuePointer;
+    }
+
     uint32_t getBlockIndex(const IrBlock& block) const
     {
         // Can only be called with blocks from our vector
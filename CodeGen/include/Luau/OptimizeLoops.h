@@ -0,0 +1,18 @@
+// This file is part of the Luau programming language and is licensed under MIT License; see LICENSE.txt for details
+#pragma once
+
+#include "Luau/IrData.h"
+
+namespace Luau
+{
+namespace CodeGen
+{
+
+struct IrBuilder;
+
+// Creates a copy of simple loops without the guards that check loop-invariant facts and checks these facts once in a loop preheader
+// For numeric for loops, array bound checks that use the loop variable are replaced with a single check of the loop range
+void hoistLoopInvariantGuards(IrBuilder& build);
+
+} // namespace CodeGen
+} // namespace Luau
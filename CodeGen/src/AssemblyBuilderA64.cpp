@@ -63,6 +63,19 @@ AssemblyBuilderA64::~AssemblyBuilderA64()
 
 void AssemblyBuilderA64::mov(RegisterA64 dst, RegisterA64 src)
 {
+    if (dst.kind == KindA64::q)
+    {
+        LUAU_ASSERT(src.kind == KindA64::q);
+
+        if (logText)
+            log("mov", dst, src);
+
+        // orr dst.16b, src.16b, src.16b
+        place(dst.index | (src.index << 5) | (0b00011'1 << 10) | (src.index << 16) | (0b0'01110'1'0'1 << 21) | (1 << 30));
+        commit();
+        return;
+    }
+
     LUAU_ASSERT(dst.kind == KindA64::w || dst.kind == KindA64::x || dst == sp);
     LUAU_ASSERT(dst.kind == src.kind || (dst.kind == KindA64::x && src == sp) || (dst == sp && src.kind == KindA64::x));
 
@@ -561,30 +574,66 @@ void AssemblyBuilderA64::fabs(RegisterA64 dst, RegisterA64 src)
 
 void AssemblyBuilderA64::fadd(RegisterA64 dst, RegisterA64 src1, RegisterA64 src2)
 {
-    LUAU_ASSERT(dst.kind == KindA64::d && src1.kind == KindA64::d && src2.kind == KindA64::d);
+    if (dst.kind == KindA64::d)
+    {
+        LUAU_ASSERT(src1.kind == KindA64::d && src2.kind == KindA64::d);
 
-    placeR3("fadd", dst, src1, src2, 0b11110'01'1, 0b0010'10);
+        placeR3("fadd", dst, src1, src2, 0b11110'01'1, 0b0010'10);
+    }
+    else
+    {
+        LUAU_ASSERT(dst.kind == KindA64::q && src1.kind == KindA64::q && src2.kind == KindA64::q);
+
+        placeVR("fadd", dst, src1, src2, 0b0'01110'0'0'1, 0b11010'1);
+    }
 }
 
 void AssemblyBuilderA64::fdiv(RegisterA64 dst, RegisterA64 src1, RegisterA64 src2)
 {
-    LUAU_ASSERT(dst.kind == KindA64::d && src1.kind == KindA64::d && src2.kind == KindA64::d);
+    if (dst.kind == KindA64::d)
+    {
+        LUAU_ASSERT(src1.kind == KindA64::d && src2.kind == KindA64::d);
 
-    placeR3("fdiv", dst, src1, src2, 0b11110'01'1, 0b0001'10);
+        placeR3("fdiv", dst, src1, src2, 0b11110'01'1, 0b0001'10);
+    }
+    else
+    {
+        LUAU_ASSERT(dst.kind == KindA64::q && src1.kind == KindA64::q && src2.kind == KindA64::q);
+
+        placeVR("fdiv", dst, src1, src2, 0b1'01110'0'0'1, 0b11111'1);
+    }
 }
 
 void AssemblyBuilderA64::fmul(RegisterA64 dst, RegisterA64 src1, RegisterA64 src2)
 {
-    LUAU_ASSERT(dst.kind == KindA64::d && src1.kind == KindA64::d && src2.kind == KindA64::d);
+    if (dst.kind == KindA64::d)
+    {
+        LUAU_ASSERT(src1.kind == KindA64::d && src2.kind == KindA64::d);
+
+        placeR3("fmul", dst, src1, src2, 0b11110'01'1, 0b0000'10);
+    }
+    else
+    {
+        LUAU_ASSERT(dst.kind == KindA64::q && src1.kind == KindA64::q && src2.kind == KindA64::q);
 
-    placeR3("fmul", dst, src1, src2, 0b11110'01'1, 0b0000'10);
+        placeVR("fmul", dst, src1, src2, 0b1'01110'0'0'1, 0b11011'1);
+    }
 }
 
 void AssemblyBuilderA64::fneg(RegisterA64 dst, RegisterA64 src)
 {
-    LUAU_ASSERT(dst.kind == KindA64::d && src.kind == KindA64::d);
+    if (dst.kind == KindA64::d)
+    {
+        LUAU_ASSERT(src.kind == KindA64::d);
+
+        placeR1("fneg", dst, src, 0b000'11110'01'1'0000'10'10000);
+    }
+    else
+    {
+        LUAU_ASSERT(dst.kind == KindA64::q && src.kind == KindA64::q);
 
-    placeR1("fneg", dst, src, 0b000'11110'01'1'0000'10'10000);
+        placeR1("fneg", dst, src, 0b0'1'1'01110'1'0'10000'01111'10);
+    }
 }
 
 void AssemblyBuilderA64::fsqrt(RegisterA64 dst, RegisterA64 src)
@@ -596,9 +645,18 @@ void AssemblyBuilderA64::fsqrt(RegisterA64 dst, RegisterA64 src)
 
 void AssemblyBuilderA64::fsub(RegisterA64 dst, RegisterA64 src1, RegisterA64 src2)
 {
-    LUAU_ASSERT(dst.kind == KindA64::d && src1.kind == KindA64::d && src2.kind == KindA64::d);
+    if (dst.kind == KindA64::d)
+    {
+        LUAU_ASSERT(src1.kind == KindA64::d && src2.kind == KindA64::d);
+
+        placeR3("fsub", dst, src1, src2, 0b11110'01'1, 0b0011'10);
+    }
+    else
+    {
+        LUAU_ASSERT(dst.kind == KindA64::q && src1.kind == KindA64::q && src2.kind == KindA64::q);
 
-    placeR3("fsub", dst, src1, src2, 0b11110'01'1, 0b0011'10);
+        placeVR("fsub", dst, src1, src2, 0b0'01110'1'0'1, 0b11010'1);
+    }
 }
 
 void AssemblyBuilderA64::frinta(RegisterA64 dst, RegisterA64 src)
@@ -664,6 +722,30 @@ void AssemblyBuilderA64::ucvtf(RegisterA64 dst, RegisterA64 src)
     placeR1("ucvtf", dst, src, 0b000'11110'01'1'00'011'000000);
 }
 
+void AssemblyBuilderA64::dup_4s(RegisterA64 dst, RegisterA64 src, uint8_t index)
+{
+    LUAU_ASSERT(dst.kind == KindA64::q && src.kind == KindA64::q);
+    LUAU_ASSERT(index < 4);
+
+    if (logText)
+        logAppend(" %-12sv%d.4s,v%d.s[%d]\n", "dup", dst.index, src.index, index);
+
+    place(dst.index | (src.index << 5) | (0b0'0000'1 << 10) | (((index << 3) | 0b100) << 16) | (0b0'1'0'01110000 << 21));
+    commit();
+}
+
+void AssemblyBuilderA64::ins_4s(RegisterA64 dst, RegisterA64 src, uint8_t index)
+{
+    LUAU_ASSERT(dst.kind == KindA64::q && src.kind == KindA64::w);
+    LUAU_ASSERT(index < 4);
+
+    if (logText)
+        logAppend(" %-12sv%d.s[%d],w%d\n", "ins", dst.index, index, src.index);
+
+    place(dst.index | (src.index << 5) | (0b0'0011'1 << 10) | (((index << 3) | 0b100) << 16) | (0b0'1'0'01110000 << 21));
+    commit();
+}
+
 void AssemblyBuilderA64::fjcvtzs(RegisterA64 dst, RegisterA64 src)
 {
     LUAU_ASSERT(dst.kind == KindA64::w);
@@ -846,6 +928,17 @@ void AssemblyBuilderA64::placeR1(const char* name, RegisterA64 dst, RegisterA64
     commit();
 }
 
+void AssemblyBuilderA64::placeVR(const char* name, RegisterA64 dst, RegisterA64 src1, RegisterA64 src2, uint16_t op, uint8_t op2)
+{
+    if (logText)
+        log(name, dst, src1, src2);
+
+    LUAU_ASSERT(dst.kind == KindA64::q && dst.kind == src1.kind && dst.kind == src2.kind);
+
+    place(dst.index | (src1.index << 5) | (op2 << 10) | (src2.index << 16) | (op << 21) | (1 << 30));
+    commit();
+}
+
 void AssemblyBuilderA64::placeI12(const char* name, RegisterA64 dst, RegisterA64 src1, int src2, uint8_t op)
 {
     if (logText)
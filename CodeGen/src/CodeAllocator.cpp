@@ -3,6 +3,8 @@
 
 #include "Luau/Common.h"
 
+#include <algorithm>
+
 #include <string.h>
 
 #if defined(_WIN32)
@@ -32,6 +34,11 @@ static size_t alignToPageSize(size_t size)
     return (size + kPageSize - 1) & ~(kPageSize - 1);
 }
 
+static uint8_t* alignToPage(uint8_t* pos)
+{
+    return reinterpret_cast<uint8_t*>(alignToPageSize(uintptr_t(pos)));
+}
+
 #if defined(_WIN32)
 static uint8_t* allocatePagesImpl(size_t size)
 {
@@ -58,6 +65,16 @@ static void makePagesExecutable(uint8_t* mem, size_t size)
         LUAU_ASSERT(!"Failed to change page protection");
 }
 
+static void makePagesWritable(uint8_t* mem, size_t size)
+{
+    LUAU_ASSERT((uintptr_t(mem) & (kPageSize - 1)) == 0);
+    LUAU_ASSERT(size == alignToPageSize(size));
+
+    DWORD oldProtect;
+    if (VirtualProtect(mem, size, PAGE_READWRITE, &oldProtect) == 0)
+        LUAU_ASSERT(!"Failed to change page protection");
+}
+
 static void flushInstructionCache(uint8_t* mem, size_t size)
 {
 #if WINAPI_FAMILY_PARTITION(WINAPI_PARTITION_APP | WINAPI_PARTITION_SYSTEM)
@@ -96,6 +113,15 @@ static void makePagesExecutable(uint8_t* mem, size_t size)
         LUAU_ASSERT(!"Failed to change page protection");
 }
 
+static void makePagesWritable(uint8_t* mem, size_t size)
+{
+    LUAU_ASSERT((uintptr_t(mem) & (kPageSize - 1)) == 0);
+    LUAU_ASSERT(size == alignToPageSize(size));
+
+    if (mprotect(mem, size, PROT_READ | PROT_WRITE) != 0)
+        LUAU_ASSERT(!"Failed to change page protection");
+}
+
 static void flushInstructionCache(uint8_t* mem, size_t size)
 {
     __builtin___clear_cache((char*)mem, (char*)mem + size);
@@ -146,11 +172,31 @@ bool CodeAllocator::allocate(
     if (totalSize > blockSize - kMaxReservedDataSize)
         return false;
 
+    // Released ranges are reused first
+    for (size_t i = 0; i < freeRanges.size(); ++i)
+    {
+        if (totalSize <= size_t(freeRanges[i].end - freeRanges[i].start))
+        {
+            placeInFreeRange(i, data, dataSize, code, codeSize, totalSize, result, resultSize, resultCodeStart);
+            return true;
+        }
+    }
+
     size_t startOffset = 0;
 
     // We might need a new block
     if (totalSize > size_t(blockEnd - blockPos))
     {
+        // Rest of the current block can still be used through the free ranges
+        if (blockPos != blockEnd)
+        {
+            uint8_t* block = blockEnd - blockSize;
+            FreeRange rest = {blockPos, blockEnd};
+
+            blockPos = blockEnd;
+            addFreeRange(findBlock(block), rest);
+        }
+
         if (!allocateNewBlock(startOffset))
             return false;
 
@@ -194,6 +240,106 @@ bool CodeAllocator::allocate(
     return true;
 }
 
+bool CodeAllocator::allocateBelow(const uint8_t* limit, const uint8_t* data, size_t dataSize, const uint8_t* code, size_t codeSize, uint8_t*& result,
+    size_t& resultSize, uint8_t*& resultCodeStart)
+{
+    size_t alignedDataSize = (dataSize + (kCodeAlignment - 1)) & ~(kCodeAlignment - 1);
+
+    size_t totalSize = alignedDataSize + codeSize;
+
+    // Ranges are sorted by address, so the first one that fits is the lowest
+    for (size_t i = 0; i < freeRanges.size() && freeRanges[i].start < limit; ++i)
+    {
+        if (totalSize <= size_t(freeRanges[i].end - freeRanges[i].start))
+        {
+            placeInFreeRange(i, data, dataSize, code, codeSize, totalSize, result, resultSize, resultCodeStart);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void CodeAllocator::deallocate(uint8_t* result, size_t resultSize)
+{
+    size_t blockIndex = findBlock(result);
+    LUAU_ASSERT(blockIndex < blocks.size());
+
+    uint8_t* block = blocks[blockIndex];
+
+    // Allocations from the current block always end on a page boundary, unless that is past the end of the block
+    addFreeRange(blockIndex, {result, std::min(alignToPage(result + resultSize), block + blockSize)});
+}
+
+void CodeAllocator::addFreeRange(size_t blockIndex, FreeRange range)
+{
+    uint8_t* block = blocks[blockIndex];
+
+    auto it = std::lower_bound(freeRanges.begin(), freeRanges.end(), range.start, [](const FreeRange& lhs, uint8_t* rhs) {
+        return lhs.start < rhs;
+    });
+
+    LUAU_ASSERT(it == freeRanges.end() || range.end <= it->start);
+    LUAU_ASSERT(it == freeRanges.begin() || (it - 1)->end <= range.start);
+
+    it = freeRanges.insert(it, range);
+
+    // Blocks can be adjacent in memory, but a range can't span several of them since each one has its own unwinding information
+    if (it + 1 != freeRanges.end() && it->end == (it + 1)->start && it->end != block + blockSize)
+    {
+        it->end = (it + 1)->end;
+        freeRanges.erase(it + 1);
+    }
+
+    if (it != freeRanges.begin() && (it - 1)->end == it->start && it->start != block)
+    {
+        (it - 1)->end = it->end;
+        it = freeRanges.erase(it) - 1;
+    }
+
+    // A range that covers the block up to the reserved data at the start is the last allocation in it
+    if (it->start < block + kPageSize && it->end == block + blockSize)
+    {
+        freeRanges.erase(it);
+        releaseBlock(blockIndex);
+    }
+}
+
+void CodeAllocator::placeInFreeRange(size_t index, const uint8_t* data, size_t dataSize, const uint8_t* code, size_t codeSize, size_t totalSize,
+    uint8_t*& result, size_t& resultSize, uint8_t*& resultCodeStart)
+{
+    FreeRange range = freeRanges[index];
+    LUAU_ASSERT(totalSize <= size_t(range.end - range.start));
+
+    size_t alignedDataSize = totalSize - codeSize;
+
+    // Released ranges have the page protection of the code that was placed there before
+    // Only the first range of a block doesn't start on a page boundary, the page before it holds unwinding information
+    uint8_t* pageStart = range.start - (uintptr_t(range.start) & (kPageSize - 1));
+    uint8_t* pageEnd = alignToPage(range.start + totalSize);
+
+    makePagesWritable(pageStart, pageEnd - pageStart);
+
+    size_t dataOffset = alignedDataSize - dataSize;
+
+    if (dataSize)
+        memcpy(range.start + dataOffset, data, dataSize);
+    if (codeSize)
+        memcpy(range.start + alignedDataSize, code, codeSize);
+
+    makePagesExecutable(pageStart, pageEnd - pageStart);
+    flushInstructionCache(range.start + alignedDataSize, codeSize);
+
+    result = range.start;
+    resultSize = totalSize;
+    resultCodeStart = range.start + alignedDataSize;
+
+    if (pageEnd < range.end)
+        freeRanges[index].start = pageEnd;
+    else
+        freeRanges.erase(freeRanges.begin() + index);
+}
+
 bool CodeAllocator::allocateNewBlock(size_t& unwindInfoSize)
 {
     // Stop allocating once we reach a global limit
@@ -228,6 +374,41 @@ bool CodeAllocator::allocateNewBlock(size_t& unwindInfoSize)
     return true;
 }
 
+void CodeAllocator::releaseBlock(size_t index)
+{
+    uint8_t* block = blocks[index];
+
+    // Allocations continue in a new block if the current one is released after it was filled
+    if (blockEnd == block + blockSize)
+    {
+        LUAU_ASSERT(blockPos == blockEnd);
+
+        blockPos = nullptr;
+        blockEnd = nullptr;
+    }
+
+    if (destroyBlockUnwindInfo && index < unwindInfos.size())
+        destroyBlockUnwindInfo(context, unwindInfos[index]);
+
+    if (index < unwindInfos.size())
+        unwindInfos.erase(unwindInfos.begin() + index);
+
+    blocks.erase(blocks.begin() + index);
+
+    freePages(block, blockSize);
+}
+
+size_t CodeAllocator::findBlock(const uint8_t* pos) const
+{
+    for (size_t i = 0; i < blocks.size(); ++i)
+    {
+        if (pos >= blocks[i] && pos < blocks[i] + blockSize)
+            return i;
+    }
+
+    return blocks.size();
+}
+
 uint8_t* CodeAllocator::allocatePages(size_t size) const
 {
     const size_t pageAlignedSize = alignToPageSize(size);
@@ -0,0 +1,426 @@
+// This file is part of the Luau programming language and is licensed under MIT License; see LICENSE.txt for details
+#include "CodeCache.h"
+
+#include "Luau/BytecodeUtils.h"
+#include "Luau/Common.h"
+
+#include "lstring.h"
+
+#include <atomic>
+
+#include <stdio.h>
+#include <string.h>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace Luau
+{
+namespace CodeGen
+{
+
+// Has to be incremented whenever the code generator changes in a way that isn't reflected by the fast flags
+constexpr uint32_t kCodeCacheVersion = 7;
+
+constexpr char kCodeCacheMagic[4] = {'L', 'N', 'C', 'C'};
+
+struct CodeCacheHeader
+{
+    char magic[4];
+    uint32_t version;
+    uint64_t key;
+    uint64_t checksum; // covers everything after the header
+    uint32_t protoCount;
+    uint32_t dataSize;
+    uint32_t codeSize;
+};
+
+// FNV-1a
+struct CodeCacheHasher
+{
+    uint64_t value = 14695981039346656037ull;
+
+    void bytes(const void* data, size_t size)
+    {
+        const uint8_t* ptr = static_cast<const uint8_t*>(data);
+
+        for (size_t i = 0; i < size; ++i)
+            value = (value ^ ptr[i]) * 1099511628211ull;
+    }
+
+    template<typename T>
+    void pod(const T& v)
+    {
+        bytes(&v, sizeof(v));
+    }
+
+    void string(const char* s)
+    {
+        bytes(s, strlen(s) + 1);
+    }
+};
+
+static uint32_t getCodeCacheTarget(bool emulatedA64)
+{
+    // emulated code is generated without optional A64 features
+    if (emulatedA64)
+        return 4;
+
+#if defined(__aarch64__)
+    return 1;
+#elif defined(_WIN32)
+    return 2;
+#else
+    return 3;
+#endif
+}
+
+// Instruction with the fields that the VM patches at runtime masked out; native code reads these fields from the bytecode at runtime
+static Instruction getStableInstruction(Instruction insn)
+{
+    switch (LUAU_INSN_OP(insn))
+    {
+    case LOP_GETGLOBAL:
+    case LOP_SETGLOBAL:
+    case LOP_GETTABLEKS:
+    case LOP_SETTABLEKS:
+    case LOP_NAMECALL:
+        return insn & 0x00ffffff;
+
+    case LOP_COVERAGE:
+        return insn & 0xff;
+
+    default:
+        return insn;
+    }
+}
+
+// Second hash of the same data with a different function; stored for each function, so that a collision of the keys can't load code
+// that was generated for other bytecode
+struct CodeCacheDigest
+{
+    uint64_t value = 0x9e3779b97f4a7c15ull;
+
+    void bytes(const void* data, size_t size)
+    {
+        const uint8_t* ptr = static_cast<const uint8_t*>(data);
+
+        for (size_t i = 0; i < size; ++i)
+        {
+            value = ((value << 5) | (value >> 59)) ^ ptr[i];
+            value *= 0xff51afd7ed558ccdull;
+        }
+    }
+
+    template<typename T>
+    void pod(const T& v)
+    {
+        bytes(&v, sizeof(v));
+    }
+};
+
+template<typename Hasher>
+static void hashProto(Hasher& hasher, Proto* p)
+{
+    hasher.pod(p->bytecodeid);
+    hasher.pod(p->nups);
+    hasher.pod(p->numparams);
+    hasher.pod(p->is_vararg);
+    hasher.pod(p->maxstacksize);
+    hasher.pod(p->flags);
+
+    if (p->typeinfo)
+        hasher.bytes(p->typeinfo, p->numparams + 2);
+
+    // speculation depends on the type feedback recorded by the interpreter
+    hasher.pod(p->typeprofile != nullptr);
+
+    if (p->typeprofile)
+        hasher.bytes(p->typeprofile, p->sizecode);
+
+    hasher.pod(p->sizecode);
+
+    for (int i = 0; i < p->sizecode;)
+    {
+        Instruction insn = p->code[i];
+        int length = getOpLength(LuauOpcode(LUAU_INSN_OP(insn)));
+
+        hasher.pod(getStableInstruction(insn));
+
+        for (int j = 1; j < length; ++j)
+            hasher.pod(p->code[i + j]);
+
+        i += length;
+    }
+
+    // constants values are only used for the types that can come from the source; other constants only affect code through their type
+    hasher.pod(p->sizek);
+
+    for (int i = 0; i < p->sizek; ++i)
+    {
+        const TValue& k = p->k[i];
+
+        hasher.pod(k.tt);
+
+        switch (k.tt)
+        {
+        case LUA_TBOOLEAN:
+            hasher.pod(k.value.b);
+            break;
+        case LUA_TNUMBER:
+            hasher.pod(k.value.n);
+            break;
+        case LUA_TVECTOR:
+            hasher.bytes(k.value.v, sizeof(k.value.v));
+            hasher.pod(k.extra);
+            break;
+        case LUA_TSTRING:
+            hasher.pod(tsvalue(&k)->len);
+            hasher.bytes(getstr(tsvalue(&k)), tsvalue(&k)->len);
+            break;
+        default:
+            break;
+        }
+    }
+
+    hasher.pod(p->sizep);
+
+    for (int i = 0; i < p->sizep; ++i)
+        hasher.pod(p->p[i]->bytecodeid);
+}
+
+uint64_t getCodeCacheKey(const std::vector<Proto*>& protos, bool emulatedA64, unsigned int cpuFeatures)
+{
+    CodeCacheHasher hasher;
+
+    hasher.pod(kCodeCacheVersion);
+    hasher.pod(getCodeCacheTarget(emulatedA64));
+    hasher.pod(cpuFeatures);
+    hasher.pod(LUA_VECTOR_SIZE);
+
+    // fast flags change code generation as well as the shape of runtime structures
+    for (FValue<bool>* flag = FValue<bool>::list; flag; flag = flag->next)
+    {
+        hasher.string(flag->name);
+        hasher.pod(flag->value);
+    }
+
+    for (FValue<int>* flag = FValue<int>::list; flag; flag = flag->next)
+    {
+        hasher.string(flag->name);
+        hasher.pod(flag->value);
+    }
+
+    hasher.pod(protos.size());
+
+    for (Proto* p : protos)
+        hashProto(hasher, p);
+
+    return hasher.value;
+}
+
+static uint64_t getProtoDigest(Proto* p)
+{
+    CodeCacheDigest digest;
+    hashProto(digest, p);
+    return digest.value;
+}
+
+static std::string getCodeCachePath(const std::string& directory, uint64_t key)
+{
+    char name[32];
+    snprintf(name, sizeof(name), "%016llx.lncc", (unsigned long long)key);
+
+    if (directory.empty() || directory.back() == '/' || directory.back() == '\\')
+        return directory + name;
+
+    return directory + "/" + name;
+}
+
+static long long getProcessId()
+{
+#if defined(_WIN32)
+    return GetCurrentProcessId();
+#else
+    return getpid();
+#endif
+}
+
+// Unlike rename on Windows, replaces the existing file
+static bool replaceFile(const std::string& from, const std::string& to)
+{
+#if defined(_WIN32)
+    return MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+    return rename(from.c_str(), to.c_str()) == 0;
+#endif
+}
+
+static void appendBytes(std::string& result, const void* data, size_t size)
+{
+    result.append(static_cast<const char*>(data), size);
+}
+
+template<typename T>
+static bool readBytes(const std::string& source, size_t& offset, T* data, size_t count)
+{
+    if (source.size() - offset < count * sizeof(T))
+        return false;
+
+    memcpy(data, source.data() + offset, count * sizeof(T));
+    offset += count * sizeof(T);
+    return true;
+}
+
+static bool readFile(const std::string& path, std::string& result)
+{
+    FILE* file = fopen(path.c_str(), "rb");
+
+    if (!file)
+        return false;
+
+    fseek(file, 0, SEEK_END);
+    long length = ftell(file);
+
+    if (length < 0)
+    {
+        fclose(file);
+        return false;
+    }
+
+    fseek(file, 0, SEEK_SET);
+
+    result.resize(length);
+    bool success = fread(result.data(), 1, length, file) == size_t(length);
+
+    fclose(file);
+    return success;
+}
+
+bool loadCodeCache(const std::string& directory, uint64_t key, const std::vector<Proto*>& protos, CachedNativeModule& result)
+{
+    std::string contents;
+
+    if (!readFile(getCodeCachePath(directory, key), contents))
+        return false;
+
+    size_t offset = 0;
+    CodeCacheHeader header = {};
+
+    if (!readBytes(contents, offset, &header, 1))
+        return false;
+
+    if (memcmp(header.magic, kCodeCacheMagic, sizeof(kCodeCacheMagic)) != 0 || header.version != kCodeCacheVersion || header.key != key)
+        return false;
+
+    CodeCacheHasher hasher;
+    hasher.bytes(contents.data() + offset, contents.size() - offset);
+
+    // files may be truncated or written concurrently by another process
+    if (hasher.value != header.checksum)
+        return false;
+
+    CachedNativeModule module;
+    module.protos.resize(header.protoCount);
+
+    for (CachedNativeProto& cached : module.protos)
+    {
+        uint32_t sizecode = 0;
+        uint64_t digest = 0;
+
+        if (!readBytes(contents, offset, &cached.index, 1) || !readBytes(contents, offset, &cached.exectarget, 1) ||
+            !readBytes(contents, offset, &sizecode, 1) || !readBytes(contents, offset, &digest, 1))
+            return false;
+
+        if (cached.index >= protos.size() || sizecode != uint32_t(protos[cached.index]->sizecode) || cached.exectarget > header.codeSize)
+            return false;
+
+        if (digest != getProtoDigest(protos[cached.index]))
+            return false;
+
+        cached.instOffsets.resize(sizecode);
+
+        if (!readBytes(contents, offset, cached.instOffsets.data(), sizecode))
+            return false;
+    }
+
+    module.data.resize(header.dataSize);
+    module.code.resize(header.codeSize);
+
+    if (!readBytes(contents, offset, module.data.data(), header.dataSize) || !readBytes(contents, offset, module.code.data(), header.codeSize))
+        return false;
+
+    if (offset != contents.size())
+        return false;
+
+    // entries that are rejected leave the result untouched, since the module is generated into it instead
+    result = std::move(module);
+    return true;
+}
+
+void storeCodeCache(const std::string& directory, uint64_t key, const std::vector<Proto*>& protos, const CachedNativeModule& module)
+{
+    std::string body;
+
+    for (const CachedNativeProto& cached : module.protos)
+    {
+        uint32_t sizecode = uint32_t(cached.instOffsets.size());
+        uint64_t digest = getProtoDigest(protos[cached.index]);
+
+        appendBytes(body, &cached.index, sizeof(cached.index));
+        appendBytes(body, &cached.exectarget, sizeof(cached.exectarget));
+        appendBytes(body, &sizecode, sizeof(sizecode));
+        appendBytes(body, &digest, sizeof(digest));
+        appendBytes(body, cached.instOffsets.data(), sizecode * sizeof(uint32_t));
+    }
+
+    appendBytes(body, module.data.data(), module.data.size());
+    appendBytes(body, module.code.data(), module.code.size());
+
+    CodeCacheHasher hasher;
+    hasher.bytes(body.data(), body.size());
+
+    CodeCacheHeader header = {};
+    memcpy(header.magic, kCodeCacheMagic, sizeof(kCodeCacheMagic));
+    header.version = kCodeCacheVersion;
+    header.key = key;
+    header.checksum = hasher.value;
+    header.protoCount = uint32_t(module.protos.size());
+    header.dataSize = uint32_t(module.data.size());
+    header.codeSize = uint32_t(module.code.size());
+
+    // the file is written under a temporary name and renamed so that readers never observe a partial file; the name is unique to the
+    // writer, since other threads and processes can store the same entry at the same time
+    static std::atomic<uint32_t> tempCounter{0};
+
+    char tempSuffix[48];
+    snprintf(tempSuffix, sizeof(tempSuffix), ".%lld-%u.tmp", (long long)getProcessId(), unsigned(tempCounter.fetch_add(1)));
+
+    std::string path = getCodeCachePath(directory, key);
+    std::string tempPath = path + tempSuffix;
+
+    FILE* file = fopen(tempPath.c_str(), "wb");
+
+    if (!file)
+        return;
+
+    bool success = fwrite(&header, sizeof(header), 1, file) == 1 && fwrite(body.data(), 1, body.size(), file) == body.size();
+
+    if (fclose(file) != 0)
+        success = false;
+
+    if (!success || !replaceFile(tempPath, path))
+        remove(tempPath.c_str());
+}
+
+} // namespace CodeGen
+} // namespace Luau
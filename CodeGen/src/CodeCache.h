@@ -0,0 +1,40 @@
+// This file is part of the Luau programming language and is licensed under MIT License; see LICENSE.txt for details
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <stdint.h>
+
+#include "lobject.h"
+
+namespace Luau
+{
+namespace CodeGen
+{
+
+// Native code doesn't refer to absolute addresses: runtime functions are called through NativeContext and data is addressed relative to code.
+// This allows a module to be cached in the form produced by the assembler, along with the offsets that are needed to enter each function.
+struct CachedNativeProto
+{
+    uint32_t index; // index in the list of functions that were compiled
+    uint32_t exectarget;
+    std::vector<uint32_t> instOffsets;
+};
+
+struct CachedNativeModule
+{
+    std::vector<uint8_t> data;
+    std::vector<uint8_t> code;
+    std::vector<CachedNativeProto> protos;
+};
+
+// Key covers the bytecode of the functions, the target, its optional features and everything else that affects the generated code
+uint64_t getCodeCacheKey(const std::vector<Proto*>& protos, bool emulatedA64, unsigned int cpuFeatures);
+
+// Entries also keep a digest of each function's bytecode, which is compared on load in case of a key collision
+bool loadCodeCache(const std::string& directory, uint64_t key, const std::vector<Proto*>& protos, CachedNativeModule& module);
+void storeCodeCache(const std::string& directory, uint64_t key, const std::vector<Proto*>& protos, const CachedNativeModule& module);
+
+} // namespace CodeGen
+} // namespace Luau
@@ -1,7 +1,9 @@
 // This file is part of the Luau programming language and is licensed under MIT License; see LICENSE.txt for details
 #include "Luau/CodeGen.h"
 
+#include "CodeCache.h"
 #include "CodeGenLower.h"
+#include "IrInlining.h"
 
 #include "Luau/Common.h"
 #include "Luau/CodeAllocator.h"
@@ -19,9 +21,13 @@
 
 #include "CodeGenA64.h"
 #include "CodeGenX64.h"
+#include "EmulatorA64.h"
 
 #include "lapi.h"
+#include "lgc.h"
+#include "lmem.h"
 
+#include <algorithm>
 #include <memory>
 #include <optional>
 
@@ -42,6 +48,7 @@
 LUAU_FASTFLAGVARIABLE(DebugCodegenNoOpt, false)
 LUAU_FASTFLAGVARIABLE(DebugCodegenOptSize, false)
 LUAU_FASTFLAGVARIABLE(DebugCodegenSkipNumbering, false)
+LUAU_FASTFLAGVARIABLE(DebugCodegenRepack, false)
 
 namespace Luau
 {
@@ -50,6 +57,11 @@ namespace CodeGen
 
 static const Instruction kCodeEntryInsn = LOP_NATIVECALL;
 
+static const uint32_t kInvalidInstOffset = ~0u;
+
+// Most allocations that are skipped without looking for code to evict after repeated failures to make room
+static const unsigned kMaxReclaimBackoff = 256;
+
 static void* gPerfLogContext = nullptr;
 static PerfLogFn gPerfLogFn = nullptr;
 
@@ -60,18 +72,43 @@ struct NativeProto
     uintptr_t exectarget;
 };
 
+static uint32_t* createExecData(int sizecode)
+{
+    static_assert(sizeof(NativeProtoHeader) % sizeof(uint32_t) == 0, "instruction offsets have to stay aligned after the header");
+    const size_t headerSize = sizeof(NativeProtoHeader) / sizeof(uint32_t);
+
+    uint32_t* storage = new uint32_t[headerSize + sizecode];
+    new (storage) NativeProtoHeader();
+
+    return storage + headerSize;
+}
+
+static void destroyExecData(void* execdata)
+{
+    delete[] (static_cast<uint32_t*>(execdata) - sizeof(NativeProtoHeader) / sizeof(uint32_t));
+}
+
 static NativeProto createNativeProto(Proto* proto, const IrBuilder& ir)
 {
     int sizecode = proto->sizecode;
 
-    uint32_t* instOffsets = new uint32_t[sizecode];
+    uint32_t* instOffsets = createExecData(sizecode);
     uint32_t instTarget = ir.function.entryLocation;
 
     for (int i = 0; i < sizecode; i++)
     {
-        LUAU_ASSERT(ir.function.bcMapping[i].asmLocation >= instTarget);
+        uint32_t asmLocation = ir.function.bcMapping[i].asmLocation;
+
+        // Instructions in blocks that were removed as unreachable can't be entered
+        if (asmLocation == ~0u)
+        {
+            instOffsets[i] = kInvalidInstOffset;
+            continue;
+        }
+
+        LUAU_ASSERT(asmLocation >= instTarget);
 
-        instOffsets[i] = ir.function.bcMapping[i].asmLocation - instTarget;
+        instOffsets[i] = asmLocation - instTarget;
     }
 
     // Set first instruction offset to 0 so that entering this function still executes any generated entry code.
@@ -81,11 +118,6 @@ static NativeProto createNativeProto(Proto* proto, const IrBuilder& ir)
     return {proto, instOffsets, instTarget};
 }
 
-static void destroyExecData(void* execdata)
-{
-    delete[] static_cast<uint32_t*>(execdata);
-}
-
 static void logPerfFunction(Proto* p, uintptr_t addr, unsigned size)
 {
     LUAU_ASSERT(p->source);
@@ -101,9 +133,11 @@ static void logPerfFunction(Proto* p, uintptr_t addr, unsigned size)
 }
 
 template<typename AssemblyBuilder>
-static std::optional<NativeProto> createNativeFunction(AssemblyBuilder& build, ModuleHelpers& helpers, Proto* proto)
+static std::optional<NativeProto> createNativeFunction(
+    AssemblyBuilder& build, ModuleHelpers& helpers, Proto* proto, const std::vector<IrBuilder::InlineTarget>& inlineTargets)
 {
     IrBuilder ir;
+    ir.inlineTargets = inlineTargets;
     ir.buildFunctionIr(proto);
 
     if (!lowerFunction(ir, build, helpers, proto, {}))
@@ -123,7 +157,19 @@ static void onCloseState(lua_State* L)
     L->global->ecb = lua_ExecutionCallbacks();
 }
 
-static void onDestroyFunction(lua_State* L, Proto* proto)
+static void destroyModule(NativeState* data, NativeModule* module)
+{
+    data->codeAllocator.deallocate(module->allocation, module->allocationSize);
+    data->codeUsed -= module->allocationSize;
+
+    size_t index = module->index;
+
+    std::swap(data->modules[index], data->modules.back());
+    data->modules[index]->index = index;
+    data->modules.pop_back();
+}
+
+static void resetNativeProto(Proto* proto)
 {
     destroyExecData(proto->execdata);
     proto->execdata = nullptr;
@@ -131,6 +177,19 @@ static void onDestroyFunction(lua_State* L, Proto* proto)
     proto->codeentry = proto->code;
 }
 
+static void onDestroyFunction(lua_State* L, Proto* proto)
+{
+    NativeProtoHeader* header = getNativeProtoHeader(proto->execdata);
+    NativeModule* module = header->module;
+
+    module->protos[header->index] = nullptr;
+
+    resetNativeProto(proto);
+
+    if (--module->liveProtos == 0)
+        destroyModule(getNativeState(L), module);
+}
+
 static int onEnter(lua_State* L, Proto* proto)
 {
     NativeState* data = getNativeState(L);
@@ -138,7 +197,19 @@ static int onEnter(lua_State* L, Proto* proto)
     LUAU_ASSERT(proto->execdata);
     LUAU_ASSERT(L->ci->savedpc >= proto->code && L->ci->savedpc < proto->code + proto->sizecode);
 
-    uintptr_t target = proto->exectarget + static_cast<uint32_t*>(proto->execdata)[L->ci->savedpc - proto->code];
+    uint32_t offset = static_cast<uint32_t*>(proto->execdata)[L->ci->savedpc - proto->code];
+
+    // Loop back edge that the interpreter reached can be unreachable in native code, so the function continues in the VM
+    // The frame keeps the native flag, like frames that exit native code midway, so the interpreter doesn't try to enter at the back edge again
+    if (offset == kInvalidInstOffset)
+        return 1;
+
+    uintptr_t target = proto->exectarget + offset;
+
+    getNativeProtoHeader(proto->execdata)->module->lastEntered = ++data->entryClock;
+
+    if (data->emulatedA64)
+        return A64::emulateGate(L, proto, target, &data->context);
 
     // Returns 1 to finish the function in the VM
     return GateFn(data->context.gateEntry)(L, proto, target, &data->context);
@@ -160,6 +231,26 @@ unsigned int getCpuFeaturesA64()
 }
 #endif
 
+// Features of the host that can change the generated code; code cache entries are only reused on hosts with the same features
+static unsigned int getCpuFeatures()
+{
+#if defined(__aarch64__)
+    static unsigned int cpuFeatures = getCpuFeaturesA64();
+    return cpuFeatures;
+#elif defined(__x86_64__) || defined(_M_X64)
+    int cpuinfo[4] = {};
+#ifdef _MSC_VER
+    __cpuid(cpuinfo, 1);
+#else
+    __cpuid(1, cpuinfo[0], cpuinfo[1], cpuinfo[2], cpuinfo[3]);
+#endif
+
+    return unsigned(cpuinfo[2]);
+#else
+    return 0;
+#endif
+}
+
 bool isSupported()
 {
     if (LUA_EXTRA_SIZE != 1)
@@ -202,6 +293,30 @@ bool isSupported()
 #endif
 }
 
+bool isA64EmulationSupported()
+{
+    if (LUA_EXTRA_SIZE != 1)
+        return false;
+
+    if (sizeof(TValue) != 16)
+        return false;
+
+    if (sizeof(LuaNode) != 32)
+        return false;
+
+    return A64::isEmulationSupported();
+}
+
+static void setExecutionCallbacks(lua_State* L, std::unique_ptr<NativeState> data)
+{
+    lua_ExecutionCallbacks* ecb = &L->global->ecb;
+
+    ecb->context = data.release();
+    ecb->close = onCloseState;
+    ecb->destroy = onDestroyFunction;
+    ecb->enter = onEnter;
+}
+
 void create(lua_State* L, AllocationCallback* allocationCallback, void* allocationCallbackContext)
 {
     LUAU_ASSERT(isSupported());
@@ -231,12 +346,7 @@ void create(lua_State* L, AllocationCallback* allocationCallback, void* allocati
     if (gPerfLogFn)
         gPerfLogFn(gPerfLogContext, uintptr_t(data->context.gateEntry), 4096, "<luau gate>");
 
-    lua_ExecutionCallbacks* ecb = &L->global->ecb;
-
-    ecb->context = data.release();
-    ecb->close = onCloseState;
-    ecb->destroy = onDestroyFunction;
-    ecb->enter = onEnter;
+    setExecutionCallbacks(L, std::move(data));
 }
 
 void create(lua_State* L)
@@ -244,53 +354,39 @@ void create(lua_State* L)
     create(L, nullptr, nullptr);
 }
 
-CodeGenCompilationResult compile(lua_State* L, int idx, unsigned int flags, CompilationStats* stats)
+void createA64Emulation(lua_State* L)
 {
-    LUAU_ASSERT(lua_isLfunction(L, idx));
-    const TValue* func = luaA_toobject(L, idx);
-
-    Proto* root = clvalue(func)->l.p;
-    if ((flags & CodeGen_OnlyNativeModules) != 0 && (root->flags & LPF_NATIVE_MODULE) == 0)
-        return CodeGenCompilationResult::NothingToCompile;
+    LUAU_ASSERT(isA64EmulationSupported());
 
-    // If initialization has failed, do not compile any functions
-    NativeState* data = getNativeState(L);
-    if (!data)
-        return CodeGenCompilationResult::CodeGenNotInitialized;
+    std::unique_ptr<NativeState> data = std::make_unique<NativeState>();
+    data->emulatedA64 = true;
 
-    std::vector<Proto*> protos;
-    gatherFunctions(protos, root);
+    // unwind information is built for the entry function but it's not registered with the host since the code never runs natively
+    data->unwindBuilder = std::make_unique<UnwindBuilderDwarf2>();
 
-    // Skip protos that have been compiled during previous invocations of CodeGen::compile
-    protos.erase(std::remove_if(protos.begin(), protos.end(),
-                     [](Proto* p) {
-                         return p == nullptr || p->execdata != nullptr;
-                     }),
-        protos.end());
+    initFunctions(*data);
 
-    if (protos.empty())
-        return CodeGenCompilationResult::NothingToCompile;
+    if (!A64::initHeaderFunctions(*data))
+        return;
 
-#if defined(__aarch64__)
-    static unsigned int cpuFeatures = getCpuFeaturesA64();
-    A64::AssemblyBuilderA64 build(/* logText= */ false, cpuFeatures);
-#else
-    X64::AssemblyBuilderX64 build(/* logText= */ false);
-#endif
+    setExecutionCallbacks(L, std::move(data));
+}
 
+template<typename AssemblyBuilder>
+static CodeGenCompilationResult assembleModule(AssemblyBuilder& build, const std::vector<Proto*>& protos,
+    const std::vector<IrBuilder::InlineTarget>& inlineTargets, std::vector<NativeProto>& results, CachedNativeModule& module)
+{
     ModuleHelpers helpers;
-#if defined(__aarch64__)
-    A64::assembleHelpers(build, helpers);
-#else
-    X64::assembleHelpers(build, helpers);
-#endif
+    assembleHelpers(build, helpers);
 
-    std::vector<NativeProto> results;
-    results.reserve(protos.size());
-
-    for (Proto* p : protos)
-        if (std::optional<NativeProto> np = createNativeFunction(build, helpers, p))
+    for (size_t i = 0; i < protos.size(); ++i)
+    {
+        if (std::optional<NativeProto> np = createNativeFunction(build, helpers, protos[i], inlineTargets))
+        {
             results.push_back(*np);
+            module.protos.push_back({uint32_t(i), 0, {}});
+        }
+    }
 
     // Very large modules might result in overflowing a jump offset; in this case we currently abandon the entire module
     if (!build.finalize())
@@ -305,11 +401,271 @@ CodeGenCompilationResult compile(lua_State* L, int idx, unsigned int flags, Comp
     if (results.empty())
         return CodeGenCompilationResult::CodeGenFailed;
 
-    uint8_t* nativeData = nullptr;
-    size_t sizeNativeData = 0;
-    uint8_t* codeStart = nullptr;
-    if (!data->codeAllocator.allocate(build.data.data(), int(build.data.size()), reinterpret_cast<const uint8_t*>(build.code.data()),
-            int(build.code.size() * sizeof(build.code[0])), nativeData, sizeNativeData, codeStart))
+    const uint8_t* code = reinterpret_cast<const uint8_t*>(build.code.data());
+
+    module.data.assign(build.data.begin(), build.data.end());
+    module.code.assign(code, code + build.code.size() * sizeof(build.code[0]));
+
+    return CodeGenCompilationResult::Success;
+}
+
+static void markActiveThread(lua_State* thread)
+{
+    for (CallInfo* ci = thread->base_ci; ci <= thread->ci; ++ci)
+    {
+        if ((ci->flags & LUA_CALLINFO_NATIVE) && isLua(ci))
+        {
+            Proto* proto = clvalue(ci->func)->l.p;
+            LUAU_ASSERT(proto->execdata);
+
+            getNativeProtoHeader(proto->execdata)->module->active = true;
+        }
+    }
+}
+
+static bool markActiveThreadVisitor(void* context, lua_Page* page, GCObject* gco)
+{
+    global_State* g = static_cast<global_State*>(context);
+
+    // threads that are about to be freed are never resumed
+    if (gco->gch.tt == LUA_TTHREAD && !isdead(g, gco))
+        markActiveThread(gco2th(gco));
+
+    return false;
+}
+
+// Code of modules with call frames on any thread is never moved or evicted, since the frame might be in the middle of a call from native code
+static void markActiveModules(lua_State* L)
+{
+    markActiveThread(L->global->mainthread);
+    luaM_visitgco(L, L->global, markActiveThreadVisitor);
+}
+
+static void evictModule(lua_State* L, NativeState* data, NativeModule* module, CompilationStats& stats)
+{
+    LUAU_ASSERT(!module->active);
+
+    for (Proto* proto : module->protos)
+    {
+        if (!proto)
+            continue;
+
+        resetNativeProto(proto);
+
+        // inlined closures are only kept alive for native code
+        luaM_freearray(L, proto->nativerefs, proto->sizenativerefs, GCObject*, proto->memcat);
+        proto->nativerefs = nullptr;
+        proto->sizenativerefs = 0;
+
+        // function can be compiled again if it becomes hot
+        proto->tierentries = 0;
+        proto->tierloops = 0;
+
+        stats.functionsEvicted++;
+    }
+
+    stats.nativeCodeEvictedBytes += module->allocationSize;
+
+    destroyModule(data, module);
+}
+
+// Moves inactive modules to lower free ranges of executable memory to join the holes that are left between modules
+static size_t repackModules(NativeState* data, CompilationStats& stats)
+{
+    std::vector<NativeModule*> order;
+
+    for (const std::unique_ptr<NativeModule>& module : data->modules)
+    {
+        if (!module->active)
+            order.push_back(module.get());
+    }
+
+    std::sort(order.begin(), order.end(), [](NativeModule* a, NativeModule* b) {
+        return a->allocation < b->allocation;
+    });
+
+    size_t moved = 0;
+
+    for (NativeModule* module : order)
+    {
+        uint8_t* oldCodeStart = module->allocation + module->codeOffset;
+
+        // data is copied together with the padding before the code, so that the code keeps the same offset from it
+        uint8_t* allocation = nullptr;
+        size_t allocationSize = 0;
+        uint8_t* codeStart = nullptr;
+
+        // only holes in memory that is already mapped are filled, moving a module never takes a new block
+        if (!data->codeAllocator.allocateBelow(module->allocation, module->allocation, module->codeOffset, oldCodeStart,
+                module->allocationSize - module->codeOffset, allocation, allocationSize, codeStart))
+            continue;
+
+        LUAU_ASSERT(allocationSize == module->allocationSize && codeStart == allocation + module->codeOffset);
+
+        data->codeAllocator.deallocate(module->allocation, module->allocationSize);
+        module->allocation = allocation;
+
+        for (Proto* proto : module->protos)
+        {
+            if (proto)
+                proto->exectarget = proto->exectarget - uintptr_t(oldCodeStart) + uintptr_t(codeStart);
+        }
+
+        moved += allocationSize;
+    }
+
+    stats.nativeCodeRepackedBytes += moved;
+    return moved;
+}
+
+// Least recently entered modules are evicted while the new code doesn't fit under the limit; when executable memory runs out, other modules are
+// moved to join free ranges first and evicted only if that isn't enough
+static bool allocateModule(lua_State* L, NativeState* data, const CachedNativeModule& module, NativeModule& result, CompilationStats& stats)
+{
+    size_t size = module.data.size() + module.code.size();
+
+    auto allocate = [&]() {
+        uint8_t* codeStart = nullptr;
+        if (!data->codeAllocator.allocate(
+                module.data.data(), module.data.size(), module.code.data(), module.code.size(), result.allocation, result.allocationSize, codeStart))
+            return false;
+
+        result.codeOffset = codeStart - result.allocation;
+        return true;
+    };
+
+    auto overLimit = [&]() {
+        return data->codeLimit != 0 && data->codeUsed + size > data->codeLimit;
+    };
+
+    if (!overLimit() && !FFlag::DebugCodegenRepack && allocate())
+        return true;
+
+    // looking for call frames visits every object, so after an attempt that couldn't make room the following ones are skipped with a backoff
+    if (data->reclaimSkips != 0)
+    {
+        data->reclaimSkips--;
+        return false;
+    }
+
+    markActiveModules(L);
+
+    std::vector<NativeModule*> candidates;
+
+    for (const std::unique_ptr<NativeModule>& candidate : data->modules)
+    {
+        if (!candidate->active)
+            candidates.push_back(candidate.get());
+    }
+
+    std::sort(candidates.begin(), candidates.end(), [](NativeModule* a, NativeModule* b) {
+        return a->lastEntered < b->lastEntered;
+    });
+
+    size_t next = 0;
+
+    while (next < candidates.size() && overLimit())
+        evictModule(L, data, candidates[next++], stats);
+
+    if (FFlag::DebugCodegenRepack)
+        repackModules(data, stats);
+
+    bool success = allocate() || (repackModules(data, stats) != 0 && allocate());
+
+    while (!success && next < candidates.size())
+    {
+        evictModule(L, data, candidates[next++], stats);
+        success = allocate();
+    }
+
+    for (const std::unique_ptr<NativeModule>& candidate : data->modules)
+        candidate->active = false;
+
+    data->reclaimBackoff = success ? 0 : std::min(std::max(data->reclaimBackoff * 2, 1u), kMaxReclaimBackoff);
+    data->reclaimSkips = data->reclaimBackoff;
+
+    return success;
+}
+
+static CodeGenCompilationResult compileProtos(lua_State* L, NativeState* data, const std::vector<Proto*>& protos, CompilationStats* stats,
+    const std::vector<IrBuilder::InlineTarget>& inlineTargets = {})
+{
+    // inlined calls depend on the closures that the caller sees at runtime, so they only apply to a single function and can't be cached
+    LUAU_ASSERT(inlineTargets.empty() || (protos.size() == 1 && data->cacheDirectory.empty()));
+
+    std::vector<NativeProto> results;
+    results.reserve(protos.size());
+
+    CachedNativeModule module;
+    uint64_t cacheKey = 0;
+    bool cached = false;
+
+    if (!data->cacheDirectory.empty())
+    {
+        cacheKey = getCodeCacheKey(protos, data->emulatedA64, data->emulatedA64 ? 0 : getCpuFeatures());
+        cached = loadCodeCache(data->cacheDirectory, cacheKey, protos, module);
+    }
+
+    if (cached)
+    {
+        for (const CachedNativeProto& cp : module.protos)
+        {
+            uint32_t* instOffsets = createExecData(int(cp.instOffsets.size()));
+            std::copy(cp.instOffsets.begin(), cp.instOffsets.end(), instOffsets);
+
+            results.push_back({protos[cp.index], instOffsets, cp.exectarget});
+        }
+    }
+    else
+    {
+        CodeGenCompilationResult result = CodeGenCompilationResult::Success;
+
+        if (data->emulatedA64)
+        {
+            A64::AssemblyBuilderA64 build(/* logText= */ false, /* features= */ 0);
+            result = assembleModule(build, protos, inlineTargets, results, module);
+        }
+        else
+        {
+#if defined(__aarch64__)
+            A64::AssemblyBuilderA64 build(/* logText= */ false, getCpuFeatures());
+#else
+            X64::AssemblyBuilderX64 build(/* logText= */ false);
+#endif
+            result = assembleModule(build, protos, inlineTargets, results, module);
+        }
+
+        if (result != CodeGenCompilationResult::Success)
+            return result;
+
+        if (!data->cacheDirectory.empty())
+        {
+            for (size_t i = 0; i < results.size(); ++i)
+            {
+                const uint32_t* instOffsets = static_cast<uint32_t*>(results[i].execdata);
+                module.protos[i].exectarget = uint32_t(results[i].exectarget);
+                module.protos[i].instOffsets.assign(instOffsets, instOffsets + results[i].p->sizecode);
+            }
+
+            storeCodeCache(data->cacheDirectory, cacheKey, protos, module);
+        }
+    }
+
+    std::unique_ptr<NativeModule> nativeModule = std::make_unique<NativeModule>();
+    CompilationStats allocationStats;
+
+    bool allocated = allocateModule(L, data, module, *nativeModule, allocationStats);
+
+    data->tieringStats.functionsEvicted += allocationStats.functionsEvicted;
+
+    if (stats != nullptr)
+    {
+        stats->functionsEvicted += allocationStats.functionsEvicted;
+        stats->nativeCodeEvictedBytes += allocationStats.nativeCodeEvictedBytes;
+        stats->nativeCodeRepackedBytes += allocationStats.nativeCodeRepackedBytes;
+    }
+
+    if (!allocated)
     {
         for (NativeProto result : results)
             destroyExecData(result.execdata);
@@ -317,6 +673,8 @@ CodeGenCompilationResult compile(lua_State* L, int idx, unsigned int flags, Comp
         return CodeGenCompilationResult::AllocationFailed;
     }
 
+    uint8_t* codeStart = nativeModule->allocation + nativeModule->codeOffset;
+
     if (gPerfLogFn && results.size() > 0)
     {
         gPerfLogFn(gPerfLogContext, uintptr_t(codeStart), uint32_t(results[0].exectarget), "<luau helpers>");
@@ -324,7 +682,7 @@ CodeGenCompilationResult compile(lua_State* L, int idx, unsigned int flags, Comp
         for (size_t i = 0; i < results.size(); ++i)
         {
             uint32_t begin = uint32_t(results[i].exectarget);
-            uint32_t end = i + 1 < results.size() ? uint32_t(results[i + 1].exectarget) : uint32_t(build.code.size() * sizeof(build.code[0]));
+            uint32_t end = i + 1 < results.size() ? uint32_t(results[i + 1].exectarget) : uint32_t(module.code.size());
             LUAU_ASSERT(begin < end);
 
             logPerfFunction(results[i].p, uintptr_t(codeStart) + begin, end - begin);
@@ -333,12 +691,25 @@ CodeGenCompilationResult compile(lua_State* L, int idx, unsigned int flags, Comp
 
     for (const NativeProto& result : results)
     {
+        NativeProtoHeader* header = getNativeProtoHeader(result.execdata);
+        header->module = nativeModule.get();
+        header->index = uint32_t(nativeModule->protos.size());
+
+        nativeModule->protos.push_back(result.p);
+
         // the memory is now managed by VM and will be freed via onDestroyFunction
         result.p->execdata = result.execdata;
         result.p->exectarget = uintptr_t(codeStart) + result.exectarget;
         result.p->codeentry = &kCodeEntryInsn;
     }
 
+    nativeModule->liveProtos = results.size();
+    nativeModule->lastEntered = data->entryClock;
+    nativeModule->index = data->modules.size();
+
+    data->codeUsed += nativeModule->allocationSize;
+    data->modules.push_back(std::move(nativeModule));
+
     if (stats != nullptr)
     {
         for (const NativeProto& result : results)
@@ -350,13 +721,123 @@ CodeGenCompilationResult compile(lua_State* L, int idx, unsigned int flags, Comp
         }
 
         stats->functionsCompiled += uint32_t(results.size());
-        stats->nativeCodeSizeBytes += build.code.size();
-        stats->nativeDataSizeBytes += build.data.size();
+        stats->functionsLoadedFromCache += cached ? uint32_t(results.size()) : 0;
+        stats->nativeCodeSizeBytes += module.code.size();
+        stats->nativeDataSizeBytes += module.data.size();
     }
 
     return CodeGenCompilationResult::Success;
 }
 
+static void onTierUp(lua_State* L, Proto* proto)
+{
+    NativeState* data = getNativeState(L);
+
+    // function might have been compiled by a call to compile() since it started counting
+    if (proto->execdata)
+        return;
+
+    double start = lua_clock();
+
+    std::vector<IrBuilder::InlineTarget> inlineTargets;
+
+    // functions only have native references while they have native code
+    LUAU_ASSERT(!proto->nativerefs);
+
+    if (data->cacheDirectory.empty())
+        findInlineTargets(L, proto, inlineTargets);
+
+    // native code compares callees against the inlined closures by address, so the function keeps them alive; the array is allocated
+    // up front, so that code can't be installed without it, and it's only attached to the function once the code is installed
+    int sizerefs = int(inlineTargets.size());
+    GCObject** refs = luaM_newarray(L, sizerefs, GCObject*, proto->memcat);
+
+    if (compileProtos(L, data, {proto}, nullptr, inlineTargets) == CodeGenCompilationResult::Success)
+    {
+        proto->nativerefs = refs;
+        proto->sizenativerefs = sizerefs;
+
+        for (int i = 0; i < sizerefs; ++i)
+        {
+            refs[i] = obj2gco(inlineTargets[i].closure);
+            luaC_objbarrier(L, proto, inlineTargets[i].closure);
+        }
+
+        data->tieringStats.functionsPromoted++;
+        data->tieringStats.callsInlined += uint32_t(inlineTargets.size());
+    }
+    else
+    {
+        luaM_freearray(L, refs, sizerefs, GCObject*, proto->memcat);
+
+        data->tieringStats.functionsFailed++;
+    }
+
+    data->tieringStats.compileTime += lua_clock() - start;
+}
+
+CodeGenCompilationResult compile(lua_State* L, int idx, unsigned int flags, CompilationStats* stats)
+{
+    LUAU_ASSERT(lua_isLfunction(L, idx));
+    const TValue* func = luaA_toobject(L, idx);
+
+    Proto* root = clvalue(func)->l.p;
+    if ((flags & CodeGen_OnlyNativeModules) != 0 && (root->flags & LPF_NATIVE_MODULE) == 0)
+        return CodeGenCompilationResult::NothingToCompile;
+
+    // If initialization has failed, do not compile any functions
+    NativeState* data = getNativeState(L);
+    if (!data)
+        return CodeGenCompilationResult::CodeGenNotInitialized;
+
+    std::vector<Proto*> protos;
+    gatherFunctions(protos, root);
+
+    // Skip protos that have been compiled during previous invocations of CodeGen::compile
+    protos.erase(std::remove_if(protos.begin(), protos.end(),
+                     [](Proto* p) {
+                         return p == nullptr || p->execdata != nullptr;
+                     }),
+        protos.end());
+
+    if (protos.empty())
+        return CodeGenCompilationResult::NothingToCompile;
+
+    return compileProtos(L, data, protos, stats);
+}
+
+void enableTiering(lua_State* L, const TieringOptions& options)
+{
+    NativeState* data = getNativeState(L);
+    if (!data)
+        return;
+
+    LUAU_ASSERT(options.entryThreshold > 0 && options.loopThreshold > 0);
+
+    lua_ExecutionCallbacks* ecb = &L->global->ecb;
+    ecb->tierup = onTierUp;
+    ecb->tierentrythreshold = options.entryThreshold;
+    ecb->tierloopthreshold = options.loopThreshold;
+}
+
+TieringStats getTieringStats(lua_State* L)
+{
+    NativeState* data = getNativeState(L);
+    return data ? data->tieringStats : TieringStats();
+}
+
+void setNativeCodeLimit(lua_State* L, size_t limit)
+{
+    if (NativeState* data = getNativeState(L))
+        data->codeLimit = limit;
+}
+
+void setCodeCacheDirectory(lua_State* L, const char* path)
+{
+    if (NativeState* data = getNativeState(L))
+        data->cacheDirectory = path ? path : "";
+}
+
 void setPerfLog(void* context, PerfLogFn logFn)
 {
     gPerfLogContext = context;
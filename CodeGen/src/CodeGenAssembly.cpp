@@ -1,6 +1,8 @@
 // This file is part of the Luau programming language and is licensed under MIT License; see LICENSE.txt for details
 #include "Luau/CodeGen.h"
 
+#include "Luau/BytecodeUtils.h"
+
 #include "CodeGenLower.h"
 
 #include "CodeGenA64.h"
@@ -8,6 +10,8 @@
 
 #include "lapi.h"
 
+#include <algorithm>
+
 namespace Luau
 {
 namespace CodeGen
@@ -42,6 +46,161 @@ static void logFunctionHeader(AssemblyBuilder& build, Proto* proto)
         build.logAppend("\n");
 }
 
+struct OpcodeCoverage
+{
+    uint32_t count = 0;
+    uint32_t skipped = 0; // in functions that couldn't be lowered
+    uint32_t generic = 0; // always handled by a call to the interpreter implementation
+
+    uint32_t inlineSize = 0;
+    uint32_t outlinedSize = 0;
+};
+
+static bool isInterpreterFallback(IrCmd cmd)
+{
+    switch (cmd)
+    {
+    case IrCmd::FALLBACK_GETGLOBAL:
+    case IrCmd::FALLBACK_SETGLOBAL:
+    case IrCmd::FALLBACK_GETTABLEKS:
+    case IrCmd::FALLBACK_SETTABLEKS:
+    case IrCmd::FALLBACK_NAMECALL:
+    case IrCmd::FALLBACK_PREPVARARGS:
+    case IrCmd::FALLBACK_GETVARARGS:
+    case IrCmd::FALLBACK_DUPCLOSURE:
+    case IrCmd::FALLBACK_FORGPREP:
+        return true;
+    default:
+        return false;
+    }
+}
+
+template<typename AssemblyBuilder>
+static void gatherCoverage(AssemblyBuilder& build, const IrFunction& function, Proto* proto, uint32_t translatedSize, uint32_t functionEnd,
+    bool lowered, std::vector<OpcodeCoverage>& coverage)
+{
+    std::vector<bool> generic(proto->sizecode, false);
+
+    if (lowered)
+    {
+        // IR is translated in bytecode order, so each bytecode instruction owns the IR instructions up to the start of the next one
+        // Instructions that optimizations create after translation are attributed by their placement in native code
+        std::vector<int> owners(translatedSize, -1);
+        int owner = -1;
+
+        for (int pc = 0, irLocation = 0; uint32_t(irLocation) < translatedSize; ++irLocation)
+        {
+            while (pc < proto->sizecode && (function.bcMapping[pc].irLocation == ~0u || function.bcMapping[pc].irLocation <= uint32_t(irLocation)))
+            {
+                if (function.bcMapping[pc].irLocation != ~0u)
+                    owner = pc;
+
+                pc++;
+            }
+
+            owners[irLocation] = owner;
+        }
+
+        enum BoundaryKind
+        {
+            InlineBlock,
+            OutlinedBlock,
+            Instruction,
+        };
+
+        struct Boundary
+        {
+            uint32_t offset;
+            int owner;
+            BoundaryKind kind;
+        };
+
+        std::vector<Boundary> boundaries;
+
+        for (const IrBlock& block : function.blocks)
+        {
+            if (block.kind == IrBlockKind::Dead || block.label.location == ~0u)
+                continue;
+
+            boundaries.push_back({build.getLabelOffset(block.label), block.start < translatedSize ? owners[block.start] : -1,
+                block.kind == IrBlockKind::Fallback ? OutlinedBlock : InlineBlock});
+
+            // interpreter fallbacks in outlined blocks are only taken on slow paths
+            if (block.kind != IrBlockKind::Fallback)
+            {
+                for (uint32_t index = block.start; index <= block.finish && index < translatedSize; ++index)
+                {
+                    if (owners[index] >= 0 && isInterpreterFallback(function.instructions[index].cmd))
+                        generic[owners[index]] = true;
+                }
+            }
+        }
+
+        for (int pc = 0; pc < proto->sizecode; ++pc)
+        {
+            if (function.bcMapping[pc].asmLocation != ~0u)
+                boundaries.push_back({function.bcMapping[pc].asmLocation, pc, Instruction});
+        }
+
+        std::sort(boundaries.begin(), boundaries.end(), [](const Boundary& a, const Boundary& b) {
+            return a.offset != b.offset ? a.offset < b.offset : a.kind < b.kind;
+        });
+
+        owner = -1;
+        bool outlined = false;
+
+        for (size_t i = 0; i < boundaries.size(); ++i)
+        {
+            const Boundary& boundary = boundaries[i];
+
+            if (boundary.kind != Instruction)
+                outlined = boundary.kind == OutlinedBlock;
+
+            if (boundary.owner >= 0)
+                owner = boundary.owner;
+
+            if (owner < 0)
+                continue;
+
+            uint32_t end = i + 1 < boundaries.size() ? boundaries[i + 1].offset : functionEnd;
+            OpcodeCoverage& entry = coverage[getUnfusedOp(LuauOpcode(LUAU_INSN_OP(proto->code[owner])))];
+
+            if (outlined)
+                entry.outlinedSize += end - boundary.offset;
+            else
+                entry.inlineSize += end - boundary.offset;
+        }
+    }
+
+    for (int pc = 0; pc < proto->sizecode;)
+    {
+        // fused instructions are compiled as their first instruction
+        LuauOpcode op = getUnfusedOp(LuauOpcode(LUAU_INSN_OP(proto->code[pc])));
+        OpcodeCoverage& entry = coverage[op];
+
+        entry.count++;
+        entry.skipped += !lowered;
+        entry.generic += generic[pc];
+
+        pc += getOpLength(op);
+    }
+}
+
+template<typename AssemblyBuilder>
+static void logCoverage(AssemblyBuilder& build, const std::vector<OpcodeCoverage>& coverage)
+{
+    build.logAppend("; %-16s %8s %8s %8s %8s %8s\n", "opcode", "count", "skipped", "generic", "inline", "outlined");
+
+    for (int op = 0; op < LOP__COUNT; ++op)
+    {
+        const OpcodeCoverage& entry = coverage[op];
+
+        if (entry.count != 0)
+            build.logAppend("; %-16s %8u %8u %8u %8u %8u\n", getOpName(LuauOpcode(op)), entry.count, entry.skipped, entry.generic, entry.inlineSize,
+                entry.outlinedSize);
+    }
+}
+
 template<typename AssemblyBuilder>
 static std::string getAssemblyImpl(AssemblyBuilder& build, const TValue* func, AssemblyOptions options)
 {
@@ -57,21 +216,30 @@ static std::string getAssemblyImpl(AssemblyBuilder& build, const TValue* func, A
         build.logAppend("; skipping %u bytes of outlined helpers\n", unsigned(build.getCodeSize() * sizeof(build.code[0])));
     }
 
+    std::vector<OpcodeCoverage> coverage(LOP__COUNT);
+
     for (Proto* p : protos)
         if (p)
         {
             IrBuilder ir;
             ir.buildFunctionIr(p);
 
+            uint32_t translatedSize = uint32_t(ir.function.instructions.size());
+
             if (options.includeAssembly || options.includeIr)
                 logFunctionHeader(build, p);
 
-            if (!lowerFunction(ir, build, helpers, p, options))
+            bool lowered = lowerFunction(ir, build, helpers, p, options);
+
+            if (!lowered)
             {
                 if (build.logText)
                     build.logAppend("; skipping (can't lower)\n");
             }
 
+            if (options.includeCoverage)
+                gatherCoverage(build, ir.function, p, translatedSize, uint32_t(build.getCodeSize() * sizeof(build.code[0])), lowered, coverage);
+
             if (build.logText)
                 build.logAppend("\n");
         }
@@ -79,6 +247,9 @@ static std::string getAssemblyImpl(AssemblyBuilder& build, const TValue* func, A
     if (!build.finalize())
         return std::string();
 
+    if (options.includeCoverage)
+        logCoverage(build, coverage);
+
     if (options.outputBinary)
         return std::string(reinterpret_cast<const char*>(build.code.data()), reinterpret_cast<const char*>(build.code.data() + build.code.size())) +
                std::string(build.data.begin(), build.data.end());
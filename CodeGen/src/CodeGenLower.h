@@ -8,7 +8,9 @@
 #include "Luau/IrDump.h"
 #include "Luau/IrUtils.h"
 #include "Luau/OptimizeConstProp.h"
+#include "Luau/OptimizeDeadStore.h"
 #include "Luau/OptimizeFinalX64.h"
+#include "Luau/OptimizeLoops.h"
 
 #include "EmitCommon.h"
 #include "IrLoweringA64.h"
@@ -258,10 +260,16 @@ inline bool lowerFunction(IrBuilder& ir, AssemblyBuilder& build, ModuleHelpers&
     {
         bool useValueNumbering = !FFlag::DebugCodegenSkipNumbering;
 
+        // Loop versioning duplicates the code of the loop body
+        if (!FFlag::DebugCodegenOptSize)
+            hoistLoopInvariantGuards(ir);
+
         constPropInBlockChains(ir, useValueNumbering);
 
         if (!FFlag::DebugCodegenOptSize)
             createLinearBlocks(ir, useValueNumbering);
+
+        markDeadStoresInBlockChains(ir);
     }
 
     return lowerIr(build, ir, helpers, proto, options);
@@ -60,6 +60,32 @@ namespace Luau
 namespace CodeGen
 {
 
+// slots of a table with a shape are numbered after the node that holds the shape
+static bool forgLoopSlotIter(lua_State* L, Table* h, int index, TValue* ra)
+{
+    TableShape* shape = gshape(h);
+    TValue* slots = gslots(h);
+    int base = h->sizearray + sizenode(h);
+
+    while (unsigned(index - base) < unsigned(shape->count))
+    {
+        TValue* e = &slots[index - base];
+
+        if (!ttisnil(e))
+        {
+            setpvalue(ra + 2, reinterpret_cast<void*>(uintptr_t(index + 1)));
+            setsvalue(L, ra + 3, shape->keys[index - base]);
+            setobj(L, ra + 4, e);
+
+            return true;
+        }
+
+        index++;
+    }
+
+    return false;
+}
+
 bool forgLoopTableIter(lua_State* L, Table* h, int index, TValue* ra)
 {
     int sizearray = h->sizearray;
@@ -100,7 +126,7 @@ bool forgLoopTableIter(lua_State* L, Table* h, int index, TValue* ra)
         index++;
     }
 
-    return false;
+    return isshaped(h) && forgLoopSlotIter(L, h, index, ra);
 }
 
 bool forgLoopNodeIter(lua_State* L, Table* h, int index, TValue* ra)
@@ -125,7 +151,7 @@ bool forgLoopNodeIter(lua_State* L, Table* h, int index, TValue* ra)
         index++;
     }
 
-    return false;
+    return isshaped(h) && forgLoopSlotIter(L, h, index, ra);
 }
 
 bool forgLoopNonTableFallback(lua_State* L, int insnA, int aux)
@@ -192,6 +218,10 @@ Closure* callProlog(lua_State* L, TValue* ra, StkId argtop, int nresults)
     // crucially, we can't use ra/argtop after this line
     luaD_checkstack(L, ccl->stacksize);
 
+    // calls from native code into interpreted functions count towards tiering as well
+    if (!ccl->isC && !ccl->l.p->execdata)
+        luaV_tierentry(L, ccl->l.p);
+
     return ccl;
 }
 
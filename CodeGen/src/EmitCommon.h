@@ -18,6 +18,9 @@ constexpr unsigned kTKeyTagMask = (1 << kTKeyTagBits) - 1;
 
 constexpr unsigned kOffsetOfInstructionC = 3;
 
+// Slots of a table with a shape follow the two nodes that hold the shape
+constexpr unsigned kOffsetOfShapeSlots = 2 << kLuaNodeSizeLog2;
+
 // Leaf functions that are placed in every module to perform common instruction sequences
 struct ModuleHelpers
 {
@@ -0,0 +1,980 @@
+// This file is part of the Luau programming language and is licensed under MIT License; see LICENSE.txt for details
+#include "EmulatorA64.h"
+
+#include "Luau/Common.h"
+
+#include "BitUtils.h"
+#include "NativeState.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+namespace Luau
+{
+namespace CodeGen
+{
+namespace A64
+{
+
+// Emulated code only uses the stack in the gate entry function, see kStackSize in EmitCommonA64.h
+constexpr size_t kEmulatorStackSize = 1024;
+
+// Return address of the gate entry function; when 'ret' reaches it, the emulation is over
+static const uint32_t kEmulatorExit = 0;
+
+union VectorRegister
+{
+    uint64_t u64[2];
+    uint32_t u32[4];
+    double f64[2];
+    float f32[4];
+};
+
+struct EmulatorState
+{
+    uint64_t x[32]; // x[31] holds sp; the zero register that shares the encoding is handled by register accessors
+    VectorRegister v[32];
+
+    bool flagN, flagZ, flagC, flagV;
+
+    const uint32_t* pc;
+    const NativeContext* context;
+    lua_State* L;
+};
+
+#if defined(__x86_64__) && !defined(_WIN32)
+// System V assigns integer and floating-point arguments to registers independently, so a call with 8 integer and 8 floating-point arguments can
+// invoke any function that AAPCS64 passes in x0-x7 and d0-d7: the last 2 integer arguments are passed on the stack, where a host function
+// that takes them expects them; a structure with an integer and a double is returned in rax and xmm0
+struct HostResult
+{
+    uint64_t x0;
+    double d0;
+};
+
+using HostFunction = HostResult (*)(uint64_t, uint64_t, uint64_t, uint64_t, uint64_t, uint64_t, uint64_t, uint64_t, double, double, double,
+    double, double, double, double, double);
+#endif
+
+// Emulation can't continue past an instruction it doesn't support; the failure goes to the assertion handler, which test harnesses use to
+// report it, and the emulated function is abandoned with an error
+[[noreturn]] LUAU_NOINLINE static void trap(const EmulatorState& s, const char* message)
+{
+    const uint32_t* pc = s.pc - 1;
+
+    char description[128];
+    snprintf(description, sizeof(description), "A64 emulator: %s at %p (%08x)", message, (const void*)pc, *pc);
+
+    Luau::assertCallHandler(description, __FILE__, __LINE__, __FUNCTION__);
+    luaG_runerror(s.L, "%s", description);
+}
+
+static uint64_t ones(int width)
+{
+    return width >= 64 ? ~0ull : (1ull << width) - 1;
+}
+
+static int64_t signExtend(uint64_t value, int width)
+{
+    return int64_t(value << (64 - width)) >> (64 - width);
+}
+
+static uint64_t truncate(uint64_t value, bool sf)
+{
+    return sf ? value : uint32_t(value);
+}
+
+static uint64_t readReg(const EmulatorState& s, uint32_t index, bool sf)
+{
+    return index == 31 ? 0 : truncate(s.x[index], sf);
+}
+
+static uint64_t readRegSp(const EmulatorState& s, uint32_t index, bool sf)
+{
+    return truncate(s.x[index], sf);
+}
+
+static void writeReg(EmulatorState& s, uint32_t index, uint64_t value, bool sf)
+{
+    if (index != 31)
+        s.x[index] = truncate(value, sf);
+}
+
+static void writeRegSp(EmulatorState& s, uint32_t index, uint64_t value, bool sf)
+{
+    s.x[index] = truncate(value, sf);
+}
+
+static void writeDouble(EmulatorState& s, uint32_t index, double value)
+{
+    // scalar writes clear the rest of the vector register
+    s.v[index] = VectorRegister();
+    s.v[index].f64[0] = value;
+}
+
+static void writeFloat(EmulatorState& s, uint32_t index, float value)
+{
+    s.v[index] = VectorRegister();
+    s.v[index].f32[0] = value;
+}
+
+template<typename T>
+static T load(uint64_t address)
+{
+    T value;
+    memcpy(&value, reinterpret_cast<const void*>(uintptr_t(address)), sizeof(T));
+    return value;
+}
+
+template<typename T>
+static void store(uint64_t address, T value)
+{
+    memcpy(reinterpret_cast<void*>(uintptr_t(address)), &value, sizeof(T));
+}
+
+static uint64_t addWithCarry(EmulatorState& s, uint64_t a, uint64_t b, bool carry, bool sf, bool setFlags)
+{
+    a = truncate(a, sf);
+    b = truncate(b, sf);
+
+    uint64_t result = truncate(a + b + carry, sf);
+
+    if (setFlags)
+    {
+        int sign = sf ? 63 : 31;
+
+        s.flagN = (result >> sign) & 1;
+        s.flagZ = result == 0;
+        s.flagC = sf ? (result < a || (carry && result == a)) : ((a + b + carry) >> 32) != 0;
+        s.flagV = (((a ^ result) & (b ^ result)) >> sign) & 1;
+    }
+
+    return result;
+}
+
+static void setLogicalFlags(EmulatorState& s, uint64_t result, bool sf)
+{
+    s.flagN = (result >> (sf ? 63 : 31)) & 1;
+    s.flagZ = result == 0;
+    s.flagC = false;
+    s.flagV = false;
+}
+
+static bool checkCondition(const EmulatorState& s, uint32_t cond)
+{
+    bool result = true;
+
+    switch (cond >> 1)
+    {
+    case 0:
+        result = s.flagZ;
+        break;
+    case 1:
+        result = s.flagC;
+        break;
+    case 2:
+        result = s.flagN;
+        break;
+    case 3:
+        result = s.flagV;
+        break;
+    case 4:
+        result = s.flagC && !s.flagZ;
+        break;
+    case 5:
+        result = s.flagN == s.flagV;
+        break;
+    case 6:
+        result = s.flagN == s.flagV && !s.flagZ;
+        break;
+    case 7:
+        return true;
+    }
+
+    return (cond & 1) ? !result : result;
+}
+
+static uint64_t shiftValue(uint64_t value, uint32_t type, uint32_t amount, bool sf)
+{
+    int size = sf ? 64 : 32;
+
+    amount &= size - 1;
+    value = truncate(value, sf);
+
+    if (amount == 0)
+        return value;
+
+    switch (type)
+    {
+    case 0: // lsl
+        return truncate(value << amount, sf);
+    case 1: // lsr
+        return value >> amount;
+    case 2: // asr
+        return truncate(uint64_t(signExtend(value, size) >> amount), sf);
+    default: // ror
+        return truncate((value >> amount) | (value << (size - amount)), sf);
+    }
+}
+
+static uint64_t extendValue(uint64_t value, uint32_t option)
+{
+    switch (option)
+    {
+    case 0b000: // uxtb
+        return uint8_t(value);
+    case 0b001: // uxth
+        return uint16_t(value);
+    case 0b010: // uxtw
+        return uint32_t(value);
+    case 0b100: // sxtb
+        return uint64_t(int64_t(int8_t(value)));
+    case 0b101: // sxth
+        return uint64_t(int64_t(int16_t(value)));
+    case 0b110: // sxtw
+        return uint64_t(int64_t(int32_t(value)));
+    default: // uxtx/sxtx
+        return value;
+    }
+}
+
+// Immediate of logical instructions is an element of 2..64 bits with a rotated run of 1s that is replicated across the register
+static uint64_t decodeBitMask(uint32_t n, uint32_t immr, uint32_t imms, bool sf)
+{
+    int len = 31 - countlz((n << 6) | (~imms & 0x3f));
+    int esize = 1 << len;
+
+    uint32_t r = immr & (esize - 1);
+    uint32_t s = imms & (esize - 1);
+
+    uint64_t welem = ones(s + 1);
+    uint64_t elem = r == 0 ? welem : ((welem >> r) | (welem << (esize - r))) & ones(esize);
+
+    uint64_t result = 0;
+
+    for (int i = 0; i < 64; i += esize)
+        result |= elem << i;
+
+    return truncate(result, sf);
+}
+
+// Covers ubfx/ubfiz/sbfx/sbfiz as well as shifts by an immediate
+static uint64_t bitfieldMove(uint64_t src, uint32_t immr, uint32_t imms, bool sf, bool isSigned)
+{
+    int size = sf ? 64 : 32;
+
+    if (imms >= immr)
+    {
+        int width = imms - immr + 1;
+        uint64_t field = (src >> immr) & ones(width);
+
+        return truncate(isSigned ? uint64_t(signExtend(field, width)) : field, sf);
+    }
+    else
+    {
+        int width = imms + 1;
+        uint64_t field = src & ones(width);
+
+        return truncate((isSigned ? uint64_t(signExtend(field, width)) : field) << (size - immr), sf);
+    }
+}
+
+static int64_t convertToSigned(double value, bool sf)
+{
+    double limit = sf ? 9223372036854775808.0 : 2147483648.0;
+
+    if (value != value)
+        return 0;
+
+    if (value >= limit)
+        return sf ? INT64_MAX : INT32_MAX;
+
+    if (value <= -limit)
+        return sf ? INT64_MIN : INT32_MIN;
+
+    return int64_t(value);
+}
+
+static uint64_t convertToUnsigned(double value, bool sf)
+{
+    double limit = sf ? 18446744073709551616.0 : 4294967296.0;
+
+    if (value != value || value <= -1.0)
+        return 0;
+
+    if (value >= limit)
+        return sf ? UINT64_MAX : UINT32_MAX;
+
+    return uint64_t(value);
+}
+
+static double expandFmovImm(uint32_t imm)
+{
+    // inverse of getFmovImm in AssemblyBuilderA64.cpp
+    uint64_t bits = uint64_t(((imm & 0x80) << 8) | ((imm & 0x40) ? 0b00111111'11000000 : 0b01000000'00000000) | (imm & 0x3f)) << 48;
+
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static void callHost(EmulatorState& s, uint64_t target)
+{
+#if defined(__x86_64__) && !defined(_WIN32)
+    HostFunction function = reinterpret_cast<HostFunction>(uintptr_t(target));
+
+    HostResult result = function(s.x[0], s.x[1], s.x[2], s.x[3], s.x[4], s.x[5], s.x[6], s.x[7], s.v[0].f64[0], s.v[1].f64[0], s.v[2].f64[0],
+        s.v[3].f64[0], s.v[4].f64[0], s.v[5].f64[0], s.v[6].f64[0], s.v[7].f64[0]);
+
+    // only the low 8 bits of a bool result are defined by the host ABI, while native code checks the whole register
+    const NativeContext* context = s.context;
+    bool boolResult = target == reinterpret_cast<uintptr_t>(context->forgLoopTableIter) ||
+                      target == reinterpret_cast<uintptr_t>(context->forgLoopNodeIter) ||
+                      target == reinterpret_cast<uintptr_t>(context->forgLoopNonTableFallback);
+
+    s.x[0] = boolResult ? uint8_t(result.x0) : result.x0;
+    writeDouble(s, 0, result.d0);
+#else
+    trap(s, "calls to host functions are not supported on this platform");
+#endif
+}
+
+static void executeLoadStore(EmulatorState& s, uint32_t insn, uint64_t address)
+{
+    uint32_t size = insn >> 30;
+    uint32_t opc = (insn >> 22) & 3;
+    uint32_t rt = insn & 31;
+
+    if (insn & (1 << 26))
+    {
+        // q registers use size 0 with the high bit of opc set
+        size_t bytes = (size == 0 && (opc & 2)) ? 16 : size_t(1) << size;
+
+        if (opc & 1)
+        {
+            s.v[rt] = VectorRegister();
+            memcpy(&s.v[rt], reinterpret_cast<const void*>(uintptr_t(address)), bytes);
+        }
+        else
+        {
+            memcpy(reinterpret_cast<void*>(uintptr_t(address)), &s.v[rt], bytes);
+        }
+
+        return;
+    }
+
+    switch (opc)
+    {
+    case 0:
+    {
+        uint64_t value = readReg(s, rt, true);
+
+        if (size == 0)
+            store<uint8_t>(address, uint8_t(value));
+        else if (size == 1)
+            store<uint16_t>(address, uint16_t(value));
+        else if (size == 2)
+            store<uint32_t>(address, uint32_t(value));
+        else
+            store<uint64_t>(address, value);
+        break;
+    }
+    case 1:
+    {
+        uint64_t value = size == 0 ? load<uint8_t>(address) : size == 1 ? load<uint16_t>(address) : size == 2 ? load<uint32_t>(address) : load<uint64_t>(address);
+
+        writeReg(s, rt, value, true);
+        break;
+    }
+    default:
+    {
+        if (size == 3)
+            trap(s, "unsupported load");
+
+        int64_t value = size == 0 ? load<int8_t>(address) : size == 1 ? load<int16_t>(address) : load<int32_t>(address);
+
+        // opc 2 extends to 64 bits, opc 3 extends to 32 bits
+        writeReg(s, rt, uint64_t(value), opc == 2);
+        break;
+    }
+    }
+}
+
+static uint64_t run(EmulatorState& s)
+{
+    for (;;)
+    {
+        const uint32_t* pc = s.pc;
+        uint32_t insn = *pc;
+
+        s.pc = pc + 1;
+
+        uint32_t rd = insn & 31;
+        uint32_t rn = (insn >> 5) & 31;
+        uint32_t rm = (insn >> 16) & 31;
+        bool sf = (insn >> 31) != 0;
+
+        if ((insn & 0x3b000000) == 0x39000000)
+        {
+            // load/store with unsigned scaled offset
+            uint32_t size = insn >> 30;
+            uint32_t scale = ((insn & (1 << 26)) && size == 0 && (insn & (1 << 23))) ? 4 : size;
+
+            executeLoadStore(s, insn, readRegSp(s, rn, true) + (uint64_t((insn >> 10) & 0xfff) << scale));
+        }
+        else if ((insn & 0x3b200c00) == 0x38200800)
+        {
+            // load/store with register offset
+            uint32_t size = insn >> 30;
+            uint32_t scale = ((insn & (1 << 26)) && size == 0 && (insn & (1 << 23))) ? 4 : size;
+            uint64_t offset = extendValue(readReg(s, rm, true), (insn >> 13) & 7) << ((insn & (1 << 12)) ? scale : 0);
+
+            executeLoadStore(s, insn, readRegSp(s, rn, true) + offset);
+        }
+        else if ((insn & 0x3b200000) == 0x38000000)
+        {
+            // load/store with unscaled offset, pre-index or post-index
+            uint64_t base = readRegSp(s, rn, true);
+            uint64_t offset = uint64_t(signExtend((insn >> 12) & 0x1ff, 9));
+
+            switch ((insn >> 10) & 3)
+            {
+            case 0b00:
+                executeLoadStore(s, insn, base + offset);
+                break;
+            case 0b01:
+                executeLoadStore(s, insn, base);
+                writeRegSp(s, rn, base + offset, true);
+                break;
+            case 0b11:
+                executeLoadStore(s, insn, base + offset);
+                writeRegSp(s, rn, base + offset, true);
+                break;
+            default:
+                trap(s, "unsupported addressing mode");
+            }
+        }
+        else if ((insn & 0x3e000000) == 0x28000000)
+        {
+            // ldp/stp of general purpose registers
+            uint32_t mode = (insn >> 23) & 3;
+            bool is64 = (insn >> 30) == 2;
+            uint32_t rt2 = (insn >> 10) & 31;
+            uint64_t base = readRegSp(s, rn, true);
+            uint64_t offset = uint64_t(signExtend((insn >> 15) & 0x7f, 7)) << (is64 ? 3 : 2);
+            uint64_t address = mode == 0b01 ? base : base + offset;
+
+            if ((insn >> 30) != 0 && !is64)
+                trap(s, "unsupported pair size");
+
+            if (mode == 0b00)
+                trap(s, "unsupported addressing mode");
+
+            if (insn & (1 << 22))
+            {
+                uint64_t first = is64 ? load<uint64_t>(address) : load<uint32_t>(address);
+                uint64_t second = is64 ? load<uint64_t>(address + 8) : load<uint32_t>(address + 4);
+
+                writeReg(s, rd, first, true);
+                writeReg(s, rt2, second, true);
+            }
+            else if (is64)
+            {
+                store<uint64_t>(address, readReg(s, rd, true));
+                store<uint64_t>(address + 8, readReg(s, rt2, true));
+            }
+            else
+            {
+                store<uint32_t>(address, uint32_t(readReg(s, rd, false)));
+                store<uint32_t>(address + 4, uint32_t(readReg(s, rt2, false)));
+            }
+
+            if (mode != 0b10)
+                writeRegSp(s, rn, base + offset, true);
+        }
+        else if ((insn & 0x1f000000) == 0x11000000)
+        {
+            // add/sub immediate; register 31 is sp unless flags are set
+            bool sub = (insn >> 30) & 1;
+            bool setFlags = (insn >> 29) & 1;
+            uint64_t imm = uint64_t((insn >> 10) & 0xfff) << ((insn & (1 << 22)) ? 12 : 0);
+            uint64_t a = readRegSp(s, rn, sf);
+            uint64_t result = addWithCarry(s, a, sub ? ~imm : imm, sub, sf, setFlags);
+
+            if (setFlags)
+                writeReg(s, rd, result, sf);
+            else
+                writeRegSp(s, rd, result, sf);
+        }
+        else if ((insn & 0x1f200000) == 0x0b000000)
+        {
+            // add/sub shifted register
+            bool sub = (insn >> 30) & 1;
+            bool setFlags = (insn >> 29) & 1;
+            uint64_t a = readReg(s, rn, sf);
+            uint64_t b = shiftValue(readReg(s, rm, sf), (insn >> 22) & 3, (insn >> 10) & 63, sf);
+
+            writeReg(s, rd, addWithCarry(s, a, sub ? ~b : b, sub, sf, setFlags), sf);
+        }
+        else if ((insn & 0x1f200000) == 0x0b200000)
+        {
+            // add/sub extended register; register 31 is sp for the first source and for the result unless flags are set
+            bool sub = (insn >> 30) & 1;
+            bool setFlags = (insn >> 29) & 1;
+            uint64_t a = readRegSp(s, rn, sf);
+            uint64_t b = extendValue(readReg(s, rm, true), (insn >> 13) & 7) << ((insn >> 10) & 7);
+            uint64_t result = addWithCarry(s, a, sub ? ~b : b, sub, sf, setFlags);
+
+            if (setFlags)
+                writeReg(s, rd, result, sf);
+            else
+                writeRegSp(s, rd, result, sf);
+        }
+        else if ((insn & 0x1f000000) == 0x0a000000)
+        {
+            // logical shifted register; N inverts the second operand
+            uint64_t a = readReg(s, rn, sf);
+            uint64_t b = shiftValue(readReg(s, rm, sf), (insn >> 22) & 3, (insn >> 10) & 63, sf);
+
+            if (insn & (1 << 21))
+                b = truncate(~b, sf);
+
+            uint64_t result = 0;
+
+            switch ((insn >> 29) & 3)
+            {
+            case 0b00:
+            case 0b11:
+                result = a & b;
+                break;
+            case 0b01:
+                result = a | b;
+                break;
+            case 0b10:
+                result = a ^ b;
+                break;
+            }
+
+            if (((insn >> 29) & 3) == 0b11)
+                setLogicalFlags(s, result, sf);
+
+            writeReg(s, rd, result, sf);
+        }
+        else if ((insn & 0x1f800000) == 0x12000000)
+        {
+            // logical immediate; register 31 is sp unless flags are set
+            uint64_t a = readReg(s, rn, sf);
+            uint64_t b = decodeBitMask((insn >> 22) & 1, (insn >> 16) & 63, (insn >> 10) & 63, sf);
+
+            switch ((insn >> 29) & 3)
+            {
+            case 0b00:
+                writeRegSp(s, rd, a & b, sf);
+                break;
+            case 0b01:
+                writeRegSp(s, rd, a | b, sf);
+                break;
+            case 0b10:
+                writeRegSp(s, rd, a ^ b, sf);
+                break;
+            case 0b11:
+                setLogicalFlags(s, a & b, sf);
+                writeReg(s, rd, a & b, sf);
+                break;
+            }
+        }
+        else if ((insn & 0x1f800000) == 0x12800000)
+        {
+            // movn/movz/movk
+            uint32_t shift = ((insn >> 21) & 3) * 16;
+            uint64_t imm = uint64_t((insn >> 5) & 0xffff) << shift;
+
+            switch ((insn >> 29) & 3)
+            {
+            case 0b00:
+                writeReg(s, rd, ~imm, sf);
+                break;
+            case 0b10:
+                writeReg(s, rd, imm, sf);
+                break;
+            case 0b11:
+                writeReg(s, rd, (readReg(s, rd, sf) & ~(uint64_t(0xffff) << shift)) | imm, sf);
+                break;
+            default:
+                trap(s, "unsupported move");
+            }
+        }
+        else if ((insn & 0x1f800000) == 0x13000000)
+        {
+            // sbfm/ubfm
+            uint32_t opc = (insn >> 29) & 3;
+
+            if (opc == 0b01 || opc == 0b11)
+                trap(s, "unsupported bitfield move");
+
+            writeReg(s, rd, bitfieldMove(readReg(s, rn, sf), (insn >> 16) & 63, (insn >> 10) & 63, sf, opc == 0b00), sf);
+        }
+        else if ((insn & 0x1f800000) == 0x13800000)
+        {
+            // extr, which is used for rotates by an immediate
+            uint32_t lsb = (insn >> 10) & 63;
+            uint64_t high = readReg(s, rn, sf);
+            uint64_t low = readReg(s, rm, sf);
+
+            if (sf)
+                writeReg(s, rd, lsb == 0 ? low : (low >> lsb) | (high << (64 - lsb)), sf);
+            else
+                writeReg(s, rd, ((high << 32) | low) >> lsb, sf);
+        }
+        else if ((insn & 0x1fe00000) == 0x1a800000)
+        {
+            // csel/csinc
+            uint32_t op2 = (insn >> 10) & 3;
+
+            if ((insn & (1 << 30)) || op2 > 1)
+                trap(s, "unsupported conditional select");
+
+            if (checkCondition(s, (insn >> 12) & 15))
+                writeReg(s, rd, readReg(s, rn, sf), sf);
+            else
+                writeReg(s, rd, readReg(s, rm, sf) + op2, sf);
+        }
+        else if ((insn & 0x5fe00000) == 0x1ac00000)
+        {
+            // data processing with two sources
+            uint32_t opcode = (insn >> 10) & 63;
+            uint64_t a = readReg(s, rn, sf);
+            uint64_t b = readReg(s, rm, sf);
+
+            if (opcode >= 0b001000 && opcode <= 0b001011)
+                writeReg(s, rd, shiftValue(a, opcode & 3, uint32_t(b), sf), sf);
+            else
+                trap(s, "unsupported data processing instruction");
+        }
+        else if ((insn & 0x5fe00000) == 0x5ac00000)
+        {
+            // data processing with one source
+            uint32_t opcode = (insn >> 10) & 63;
+            uint64_t a = readReg(s, rn, sf);
+            int size = sf ? 64 : 32;
+
+            if (opcode == 0b000100)
+            {
+                int count = 0;
+
+                while (count < size && ((a >> (size - 1 - count)) & 1) == 0)
+                    count++;
+
+                writeReg(s, rd, count, sf);
+            }
+            else if (opcode == 0b000000)
+            {
+                uint64_t result = 0;
+
+                for (int i = 0; i < size; ++i)
+                    result |= ((a >> i) & 1) << (size - 1 - i);
+
+                writeReg(s, rd, result, sf);
+            }
+            else
+            {
+                trap(s, "unsupported data processing instruction");
+            }
+        }
+        else if ((insn & 0xfc000000) == 0x14000000 || (insn & 0xfc000000) == 0x94000000)
+        {
+            // b/bl
+            if (sf)
+                s.x[30] = uintptr_t(pc + 1);
+
+            s.pc = pc + signExtend(insn & 0x3ffffff, 26);
+        }
+        else if ((insn & 0xff000010) == 0x54000000)
+        {
+            // b.cond
+            if (checkCondition(s, insn & 15))
+                s.pc = pc + signExtend((insn >> 5) & 0x7ffff, 19);
+        }
+        else if ((insn & 0x7e000000) == 0x34000000)
+        {
+            // cbz/cbnz
+            bool zero = readReg(s, rd, sf) == 0;
+
+            if (zero != bool(insn & (1 << 24)))
+                s.pc = pc + signExtend((insn >> 5) & 0x7ffff, 19);
+        }
+        else if ((insn & 0x7e000000) == 0x36000000)
+        {
+            // tbz/tbnz
+            uint32_t bit = ((insn >> 31) << 5) | ((insn >> 19) & 31);
+            bool set = (readReg(s, rd, true) >> bit) & 1;
+
+            if (set == bool(insn & (1 << 24)))
+                s.pc = pc + signExtend((insn >> 5) & 0x3fff, 14);
+        }
+        else if ((insn & 0xff9ffc1f) == 0xd61f0000)
+        {
+            // br/blr/ret
+            uint64_t target = readReg(s, rn, true);
+
+            switch ((insn >> 21) & 3)
+            {
+            case 0b00:
+                s.pc = reinterpret_cast<const uint32_t*>(uintptr_t(target));
+                break;
+            case 0b01:
+                // code that is called through a register is always a C function
+                s.x[30] = uintptr_t(pc + 1);
+                callHost(s, target);
+                break;
+            case 0b10:
+                if (target == uintptr_t(&kEmulatorExit))
+                    return s.x[0];
+
+                s.pc = reinterpret_cast<const uint32_t*>(uintptr_t(target));
+                break;
+            default:
+                trap(s, "unsupported branch");
+            }
+        }
+        else if ((insn & 0x9f000000) == 0x10000000)
+        {
+            // adr
+            int64_t offset = signExtend((((insn >> 5) & 0x7ffff) << 2) | ((insn >> 29) & 3), 21);
+
+            writeReg(s, rd, uintptr_t(pc) + offset, true);
+        }
+        else if ((insn & 0xff207c00) == 0x1e204000)
+        {
+            // floating-point data processing with one source
+            uint32_t ftype = (insn >> 22) & 3;
+            uint32_t opcode = (insn >> 15) & 63;
+
+            if (ftype == 0 && opcode == 0b000101)
+            {
+                writeDouble(s, rd, double(s.v[rn].f32[0]));
+                continue;
+            }
+
+            if (ftype != 1)
+                trap(s, "unsupported floating-point type");
+
+            double a = s.v[rn].f64[0];
+
+            switch (opcode)
+            {
+            case 0b000000:
+                writeDouble(s, rd, a);
+                break;
+            case 0b000001:
+                writeDouble(s, rd, fabs(a));
+                break;
+            case 0b000010:
+                writeDouble(s, rd, -a);
+                break;
+            case 0b000011:
+                writeDouble(s, rd, sqrt(a));
+                break;
+            case 0b000100:
+                writeFloat(s, rd, float(a));
+                break;
+            case 0b001001:
+                writeDouble(s, rd, ceil(a));
+                break;
+            case 0b001010:
+                writeDouble(s, rd, floor(a));
+                break;
+            case 0b001100:
+                writeDouble(s, rd, round(a));
+                break;
+            default:
+                trap(s, "unsupported floating-point instruction");
+            }
+        }
+        else if ((insn & 0xffe00c00) == 0x1e600800)
+        {
+            // floating-point data processing with two sources
+            double a = s.v[rn].f64[0];
+            double b = s.v[rm].f64[0];
+
+            switch ((insn >> 12) & 15)
+            {
+            case 0b0000:
+                writeDouble(s, rd, a * b);
+                break;
+            case 0b0001:
+                writeDouble(s, rd, a / b);
+                break;
+            case 0b0010:
+                writeDouble(s, rd, a + b);
+                break;
+            case 0b0011:
+                writeDouble(s, rd, a - b);
+                break;
+            default:
+                trap(s, "unsupported floating-point instruction");
+            }
+        }
+        else if ((insn & 0xffe03c07) == 0x1e602000)
+        {
+            // fcmp, with the second operand replaced by zero when bit 3 is set
+            double a = s.v[rn].f64[0];
+            double b = (insn & (1 << 3)) ? 0.0 : s.v[rm].f64[0];
+
+            if (a != a || b != b)
+            {
+                s.flagN = false;
+                s.flagZ = false;
+                s.flagC = true;
+                s.flagV = true;
+            }
+            else
+            {
+                s.flagN = a < b;
+                s.flagZ = a == b;
+                s.flagC = a >= b;
+                s.flagV = false;
+            }
+        }
+        else if ((insn & 0xffe00c00) == 0x1e600c00)
+        {
+            // fcsel
+            writeDouble(s, rd, checkCondition(s, (insn >> 12) & 15) ? s.v[rn].f64[0] : s.v[rm].f64[0]);
+        }
+        else if ((insn & 0xffe01fe0) == 0x1e601000)
+        {
+            // fmov with an immediate
+            writeDouble(s, rd, expandFmovImm((insn >> 13) & 0xff));
+        }
+        else if ((insn & 0xffffffe0) == 0x2f00e400)
+        {
+            // movi d, #0
+            s.v[rd] = VectorRegister();
+        }
+        else if ((insn & 0x7fe0fc00) == 0x1e600000)
+        {
+            // conversions between floating-point and integer registers
+            uint32_t type = (insn >> 16) & 31; // rmode and opcode
+
+            switch (type)
+            {
+            case 0b11'000:
+                writeReg(s, rd, uint64_t(convertToSigned(s.v[rn].f64[0], sf)), sf);
+                break;
+            case 0b11'001:
+                writeReg(s, rd, convertToUnsigned(s.v[rn].f64[0], sf), sf);
+                break;
+            case 0b00'010:
+                writeDouble(s, rd, sf ? double(int64_t(readReg(s, rn, true))) : double(int32_t(readReg(s, rn, false))));
+                break;
+            case 0b00'011:
+                writeDouble(s, rd, sf ? double(readReg(s, rn, true)) : double(uint32_t(readReg(s, rn, false))));
+                break;
+            case 0b00'110:
+                writeReg(s, rd, s.v[rn].u64[0], true);
+                break;
+            case 0b00'111:
+                s.v[rd] = VectorRegister();
+                s.v[rd].u64[0] = readReg(s, rn, true);
+                break;
+            default:
+                trap(s, "unsupported conversion");
+            }
+        }
+        else if ((insn & 0xffe0fc00) == 0x4e20d400 || (insn & 0xffe0fc00) == 0x4ea0d400 || (insn & 0xffe0fc00) == 0x6e20dc00 ||
+                 (insn & 0xffe0fc00) == 0x6e20fc00)
+        {
+            // fadd/fsub/fmul/fdiv on 4 single-precision lanes
+            VectorRegister a = s.v[rn];
+            VectorRegister b = s.v[rm];
+            VectorRegister& r = s.v[rd];
+
+            for (int i = 0; i < 4; ++i)
+            {
+                switch (insn & 0xffe0fc00)
+                {
+                case 0x4e20d400:
+                    r.f32[i] = a.f32[i] + b.f32[i];
+                    break;
+                case 0x4ea0d400:
+                    r.f32[i] = a.f32[i] - b.f32[i];
+                    break;
+                case 0x6e20dc00:
+                    r.f32[i] = a.f32[i] * b.f32[i];
+                    break;
+                default:
+                    r.f32[i] = a.f32[i] / b.f32[i];
+                    break;
+                }
+            }
+        }
+        else if ((insn & 0xfffffc00) == 0x6ea0f800)
+        {
+            // fneg on 4 single-precision lanes
+            for (int i = 0; i < 4; ++i)
+                s.v[rd].u32[i] = s.v[rn].u32[i] ^ 0x80000000;
+        }
+        else if ((insn & 0xffe0fc00) == 0x4ea01c00)
+        {
+            // orr on 16 bytes, which is used for vector register moves
+            VectorRegister a = s.v[rn];
+            VectorRegister b = s.v[rm];
+
+            s.v[rd].u64[0] = a.u64[0] | b.u64[0];
+            s.v[rd].u64[1] = a.u64[1] | b.u64[1];
+        }
+        else if ((insn & 0xffe7fc00) == 0x4e040400)
+        {
+            // dup of a single-precision lane
+            uint32_t value = s.v[rn].u32[(insn >> 19) & 3];
+
+            for (int i = 0; i < 4; ++i)
+                s.v[rd].u32[i] = value;
+        }
+        else if ((insn & 0xffe7fc00) == 0x4e041c00)
+        {
+            // ins of a w register into a single-precision lane
+            s.v[rd].u32[(insn >> 19) & 3] = uint32_t(readReg(s, rn, false));
+        }
+        else if (insn == 0)
+        {
+            trap(s, "udf");
+        }
+        else
+        {
+            trap(s, "unsupported instruction");
+        }
+    }
+}
+
+bool isEmulationSupported()
+{
+#if defined(__x86_64__) && !defined(_WIN32)
+    return true;
+#else
+    return false;
+#endif
+}
+
+int emulateGate(lua_State* L, Proto* proto, uintptr_t target, NativeContext* context)
+{
+    alignas(16) uint8_t stack[kEmulatorStackSize];
+
+    EmulatorState state = {};
+    state.x[0] = uintptr_t(L);
+    state.x[1] = uintptr_t(proto);
+    state.x[2] = target;
+    state.x[3] = uintptr_t(context);
+    state.x[30] = uintptr_t(&kEmulatorExit);
+    state.x[31] = uintptr_t(stack + sizeof(stack));
+    state.pc = reinterpret_cast<const uint32_t*>(context->gateEntry);
+    state.context = context;
+    state.L = L;
+
+    return int(run(state));
+}
+
+} // namespace A64
+} // namespace CodeGen
+} // namespace Luau
@@ -0,0 +1,29 @@
+// This file is part of the Luau programming language and is licensed under MIT License; see LICENSE.txt for details
+#pragma once
+
+#include <stdint.h>
+
+struct lua_State;
+struct Proto;
+
+namespace Luau
+{
+namespace CodeGen
+{
+
+struct NativeContext;
+
+namespace A64
+{
+
+// Checks if calls from emulated code to C functions can be forwarded to the host
+// This requires a host ABI that assigns integer and floating-point arguments to registers independently, as AAPCS64 does
+bool isEmulationSupported();
+
+// Runs the gate entry function from the context in an interpreter of the A64 instructions that AssemblyBuilderA64 can produce
+// This has the signature of GateFn; code can't be mixed with native code of the host and branches through 'blr' are calls to C functions
+int emulateGate(lua_State* L, Proto* proto, uintptr_t target, NativeContext* context);
+
+} // namespace A64
+} // namespace CodeGen
+} // namespace Luau
@@ -889,6 +889,20 @@ void computeCfgDominanceTreeChildren(IrFunction& function)
     computeBlockOrdering<domChildren>(function, info.domOrdering, /* preOrder */ nullptr, /* postOrder */ nullptr);
 }
 
+bool dominates(const CfgInfo& cfg, uint32_t a, uint32_t b)
+{
+    LUAU_ASSERT(a < cfg.domOrdering.size() && b < cfg.domOrdering.size());
+
+    const BlockOrdering& dom = cfg.domOrdering[a];
+    const BlockOrdering& target = cfg.domOrdering[b];
+
+    if (!dom.visited || !target.visited)
+        return false;
+
+    // Node is a descendant in a tree if it's visited after the ancestor and finished before it
+    return dom.preOrder <= target.preOrder && target.postOrder <= dom.postOrder;
+}
+
 // This algorithm is based on 'A Linear Time Algorithm for Placing Phi-Nodes' [Vugranam C.Sreedhar]
 // It uses the optimized form from LLVM that relies an implicit DJ-graph (join edges are edges of the CFG that are not part of the dominance tree)
 void computeIteratedDominanceFrontierForDefs(
@@ -6,6 +6,7 @@
 #include "Luau/IrData.h"
 #include "Luau/IrUtils.h"
 
+#include "IrInlining.h"
 #include "IrTranslation.h"
 
 #include "lapi.h"
@@ -135,7 +136,7 @@ void IrBuilder::buildFunctionIr(Proto* proto)
     for (int i = 0; i < proto->sizecode;)
     {
         const Instruction* pc = &proto->code[i];
-        LuauOpcode op = LuauOpcode(LUAU_INSN_OP(*pc));
+        LuauOpcode op = getUnfusedOp(LuauOpcode(LUAU_INSN_OP(*pc)));
 
         int nexti = i + getOpLength(op);
         LUAU_ASSERT(nexti <= proto->sizecode);
@@ -179,6 +180,7 @@ void IrBuilder::rebuildBytecodeBasicBlocks(Proto* proto)
 
     // Mark jump targets
     std::vector<uint8_t> jumpTargets(proto->sizecode, 0);
+    std::vector<uint8_t> loopEntries(proto->sizecode, 0);
 
     for (int i = 0; i < proto->sizecode;)
     {
@@ -190,6 +192,13 @@ void IrBuilder::rebuildBytecodeBasicBlocks(Proto* proto)
         if (target >= 0 && !isFastCall(op))
             jumpTargets[target] = true;
 
+        // Loops that are running in the interpreter enter native code at the back edge
+        if (op == LOP_JUMPBACK || op == LOP_FORNLOOP || op == LOP_FORGLOOP)
+        {
+            jumpTargets[i] = true;
+            loopEntries[i] = true;
+        }
+
         i += getOpLength(op);
         LUAU_ASSERT(i <= proto->sizecode);
     }
@@ -204,6 +213,8 @@ void IrBuilder::rebuildBytecodeBasicBlocks(Proto* proto)
         {
             IrOp b = block(IrBlockKind::Bytecode);
             instIndexToBlock[i] = b.index;
+
+            function.blocks[b.index].loopEntry = loopEntries[i] != 0;
         }
     }
 }
@@ -239,6 +250,10 @@ void IrBuilder::translateInst(LuauOpcode op, const Instruction* pc, int i)
         translateInstSetGlobal(*this, pc, i);
         break;
     case LOP_CALL:
+    {
+        // When the callee body is inlined, the regular call is only made by other closures
+        IrOp inlinedNext = activeFastcallFallback ? IrOp{} : translateInlinedCall(*this, pc, i);
+
         inst(IrCmd::INTERRUPT, constUint(i));
         inst(IrCmd::SET_SAVEDPC, constUint(i + 1));
 
@@ -252,7 +267,14 @@ void IrBuilder::translateInst(LuauOpcode op, const Instruction* pc, int i)
 
             activeFastcallFallback = false;
         }
+        else if (inlinedNext.kind != IrOpKind::None)
+        {
+            inst(IrCmd::JUMP, inlinedNext);
+
+            beginBlock(inlinedNext);
+        }
         break;
+    }
     case LOP_RETURN:
         inst(IrCmd::INTERRUPT, constUint(i));
 
@@ -638,6 +660,14 @@ IrOp IrBuilder::constTag(uint8_t value)
     return constAny(constant, uint64_t(value));
 }
 
+IrOp IrBuilder::constPointer(const void* value)
+{
+    IrConst constant;
+    constant.kind = IrConstKind::Pointer;
+    constant.valuePointer = value;
+    return constAny(constant, uint64_t(uintptr_t(value)));
+}
+
 IrOp IrBuilder::constAny(IrConst constant, uint64_t asCommonKey)
 {
     ConstantKey key{constant.kind, asCommonKey};
@@ -97,6 +97,8 @@ const char* getCmdName(IrCmd cmd)
         return "GET_SLOT_NODE_ADDR";
     case IrCmd::GET_HASH_NODE_ADDR:
         return "GET_HASH_NODE_ADDR";
+    case IrCmd::GET_SHAPE_SLOT_ADDR:
+        return "GET_SHAPE_SLOT_ADDR";
     case IrCmd::GET_CLOSURE_UPVAL_ADDR:
         return "GET_CLOSURE_UPVAL_ADDR";
     case IrCmd::STORE_TAG:
@@ -145,6 +147,20 @@ const char* getCmdName(IrCmd cmd)
         return "SQRT_NUM";
     case IrCmd::ABS_NUM:
         return "ABS_NUM";
+    case IrCmd::ADD_VEC:
+        return "ADD_VEC";
+    case IrCmd::SUB_VEC:
+        return "SUB_VEC";
+    case IrCmd::MUL_VEC:
+        return "MUL_VEC";
+    case IrCmd::DIV_VEC:
+        return "DIV_VEC";
+    case IrCmd::UNM_VEC:
+        return "UNM_VEC";
+    case IrCmd::NUM_TO_VEC:
+        return "NUM_TO_VEC";
+    case IrCmd::TAG_VECTOR:
+        return "TAG_VECTOR";
     case IrCmd::NOT_ANY:
         return "NOT_ANY";
     case IrCmd::CMP_ANY:
@@ -231,10 +247,14 @@ const char* getCmdName(IrCmd cmd)
         return "CHECK_ARRAY_SIZE";
     case IrCmd::CHECK_SLOT_MATCH:
         return "CHECK_SLOT_MATCH";
+    case IrCmd::CHECK_SHAPE_SLOT_MATCH:
+        return "CHECK_SHAPE_SLOT_MATCH";
     case IrCmd::CHECK_NODE_NO_NEXT:
         return "CHECK_NODE_NO_NEXT";
     case IrCmd::CHECK_NODE_VALUE:
         return "CHECK_NODE_VALUE";
+    case IrCmd::CHECK_NO_INTERRUPT:
+        return "CHECK_NO_INTERRUPT";
     case IrCmd::INTERRUPT:
         return "INTERRUPT";
     case IrCmd::CHECK_GC:
@@ -428,6 +448,9 @@ void toString(std::string& result, IrConst constant)
     case IrConstKind::Tag:
         result.append(getTagName(constant.valueTag));
         break;
+    case IrConstKind::Pointer:
+        append(result, "%p", constant.valuePointer);
+        break;
     }
 }
 
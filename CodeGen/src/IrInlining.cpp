@@ -0,0 +1,551 @@
+// This file is part of the Luau programming language and is licensed under MIT License; see LICENSE.txt for details
+#include "IrInlining.h"
+
+#include "Luau/Bytecode.h"
+#include "Luau/BytecodeUtils.h"
+#include "Luau/IrBuilder.h"
+
+#include "lobject.h"
+#include "lstate.h"
+#include "ltable.h"
+#include "ltm.h"
+
+#include <algorithm>
+
+// Maximum cost of a callee body that is inlined into native code; 0 disables inlining
+LUAU_FASTINTVARIABLE(LuauCodeGenInlineThreshold, 16)
+
+namespace Luau
+{
+namespace CodeGen
+{
+
+// Approximate cost of the inlined instruction, measured in the number of native instructions it's going to take after optimizations
+static int getInlinedInstCost(LuauOpcode op)
+{
+    switch (op)
+    {
+    case LOP_NOP:
+        return 0;
+    case LOP_GETTABLEKS:
+        return 3;
+    case LOP_SETTABLEKS:
+        return 4;
+    default:
+        return 1;
+    }
+}
+
+// Value of a callee register; the callee frame is never created, so registers only exist during translation
+struct InlineValue
+{
+    enum Kind : uint8_t
+    {
+        Unknown,
+        Nil,
+        Boolean,
+        Number,  // 'value' is a double
+        Param,   // argument stored in the caller register 'reg'
+        Field,   // 'value' is a pointer to the TValue in a table node
+        TValue,  // 'value' is a TValue
+    };
+
+    Kind kind = Unknown;
+    bool boolean = false;
+    uint8_t reg = 0;
+    IrOp value;
+};
+
+// The same walk over the callee is used to check that it can be inlined and to emit it, so that both always agree on what's supported
+// All guards branch to 'callBlock', which makes a regular call; for that to be correct, the only side effect of the callee has to come after them
+struct CalleeInliner
+{
+    CalleeInliner(IrBuilder* build, Proto* callee, int ra, IrOp callBlock)
+        : build(build)
+        , callee(callee)
+        , ra(ra)
+        , callBlock(callBlock)
+        , regs(callee->maxstacksize)
+    {
+        for (int i = 0; i < callee->numparams; ++i)
+        {
+            regs[i].kind = InlineValue::Param;
+            regs[i].reg = uint8_t(ra + 1 + i);
+        }
+    }
+
+    bool loadNumber(InlineValue& v, IrOp& result)
+    {
+        if (v.kind == InlineValue::Number)
+        {
+            result = v.value;
+            return true;
+        }
+
+        if (v.kind != InlineValue::Param && v.kind != InlineValue::Field)
+            return false;
+
+        if (build)
+        {
+            IrOp source = v.kind == InlineValue::Param ? build->vmReg(v.reg) : v.value;
+
+            IrOp tag = build->inst(IrCmd::LOAD_TAG, source);
+            build->inst(IrCmd::CHECK_TAG, tag, build->constTag(LUA_TNUMBER), callBlock);
+            result = build->inst(IrCmd::LOAD_DOUBLE, source);
+        }
+
+        return true;
+    }
+
+    bool loadTable(InlineValue& v, IrOp& result)
+    {
+        if (v.kind != InlineValue::Param)
+            return false;
+
+        if (build)
+        {
+            IrOp tag = build->inst(IrCmd::LOAD_TAG, build->vmReg(v.reg));
+            build->inst(IrCmd::CHECK_TAG, tag, build->constTag(LUA_TTABLE), callBlock);
+            result = build->inst(IrCmd::LOAD_POINTER, build->vmReg(v.reg));
+        }
+
+        return true;
+    }
+
+    // Slot hints of the callee are not updated for tables with a metatable, so the node is expected at the main position of the key instead
+    IrOp getFieldAddr(IrOp table, const Instruction* pc)
+    {
+        TString* key = tsvalue(&callee->k[pc[1]]);
+
+        IrOp addr = build->inst(IrCmd::GET_HASH_NODE_ADDR, table, build->constUint(key->hash));
+        build->inst(IrCmd::CHECK_SLOT_MATCH, addr, build->constPointer(key), callBlock);
+        return addr;
+    }
+
+    bool loadConstant(const TValue* k, InlineValue& result)
+    {
+        switch (ttype(k))
+        {
+        case LUA_TNIL:
+            result.kind = InlineValue::Nil;
+            return true;
+        case LUA_TBOOLEAN:
+            result.kind = InlineValue::Boolean;
+            result.boolean = bvalue(k) != 0;
+            return true;
+        case LUA_TNUMBER:
+            result.kind = InlineValue::Number;
+            result.value = build ? build->constDouble(nvalue(k)) : IrOp{};
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    bool translateArith(const Instruction* pc, IrCmd cmd, bool constantRhs)
+    {
+        IrOp lhs, rhs;
+
+        if (!loadNumber(regs[LUAU_INSN_B(*pc)], lhs))
+            return false;
+
+        if (constantRhs)
+        {
+            const TValue* k = &callee->k[LUAU_INSN_C(*pc)];
+
+            if (!ttisnumber(k))
+                return false;
+
+            rhs = build ? build->constDouble(nvalue(k)) : IrOp{};
+        }
+        else if (!loadNumber(regs[LUAU_INSN_C(*pc)], rhs))
+        {
+            return false;
+        }
+
+        InlineValue& result = regs[LUAU_INSN_A(*pc)];
+        result.kind = InlineValue::Number;
+        result.value = build ? build->inst(cmd, lhs, rhs) : IrOp{};
+        return true;
+    }
+
+    bool translateGetTableKS(const Instruction* pc)
+    {
+        IrOp table;
+
+        if (!ttisstring(&callee->k[pc[1]]) || !loadTable(regs[LUAU_INSN_B(*pc)], table))
+            return false;
+
+        // The field is only read when it's used, so that values that end up unused don't have to be loaded
+        InlineValue& result = regs[LUAU_INSN_A(*pc)];
+        result.kind = InlineValue::Field;
+        result.value = build ? getFieldAddr(table, pc) : IrOp{};
+        return true;
+    }
+
+    bool translateSetTableKS(const Instruction* pc)
+    {
+        const InlineValue& value = regs[LUAU_INSN_A(*pc)];
+
+        // Only values that don't need a temporary copy in a VM register for the write barrier are supported
+        if (value.kind != InlineValue::Number && value.kind != InlineValue::Boolean && value.kind != InlineValue::Param)
+            return false;
+
+        IrOp table, number;
+
+        if (!ttisstring(&callee->k[pc[1]]) || !loadTable(regs[LUAU_INSN_B(*pc)], table))
+            return false;
+
+        if (value.kind == InlineValue::Number && !loadNumber(regs[LUAU_INSN_A(*pc)], number))
+            return false;
+
+        if (!build)
+            return true;
+
+        IrOp addr = getFieldAddr(table, pc);
+        build->inst(IrCmd::CHECK_READONLY, table, callBlock);
+
+        // Fields that are returned have to be read before the store, which can overwrite them
+        const Instruction* ret = pc + 2;
+        LUAU_ASSERT(LUAU_INSN_OP(*ret) == LOP_RETURN);
+
+        for (int i = 0; i < int(LUAU_INSN_B(*ret)) - 1; ++i)
+        {
+            InlineValue& field = regs[LUAU_INSN_A(*ret) + i];
+
+            if (field.kind == InlineValue::Field)
+            {
+                field.kind = InlineValue::TValue;
+                field.value = build->inst(IrCmd::LOAD_TVALUE, field.value, build->constInt(0));
+            }
+        }
+
+        IrOp valueOffset = build->constInt(offsetof(LuaNode, val));
+
+        if (value.kind == InlineValue::Number)
+        {
+            build->inst(IrCmd::STORE_SPLIT_TVALUE, addr, build->constTag(LUA_TNUMBER), number, valueOffset);
+        }
+        else if (value.kind == InlineValue::Boolean)
+        {
+            build->inst(IrCmd::STORE_SPLIT_TVALUE, addr, build->constTag(LUA_TBOOLEAN), build->constInt(value.boolean), valueOffset);
+        }
+        else
+        {
+            IrOp tv = build->inst(IrCmd::LOAD_TVALUE, build->vmReg(value.reg));
+            build->inst(IrCmd::STORE_TVALUE, addr, tv, valueOffset);
+            build->inst(IrCmd::BARRIER_TABLE_FORWARD, table, build->vmReg(value.reg), build->undef());
+        }
+
+        return true;
+    }
+
+    bool translateReturn(const Instruction* pc, int nresults)
+    {
+        int rr = LUAU_INSN_A(*pc);
+        int count = int(LUAU_INSN_B(*pc)) - 1;
+
+        if (count < 0)
+            return false;
+
+        for (int i = 0; i < std::min(count, nresults); ++i)
+            if (regs[rr + i].kind == InlineValue::Unknown)
+                return false;
+
+        if (!build)
+            return true;
+
+        // Results overwrite the arguments, so all values that are still in VM registers or table nodes are loaded first
+        std::vector<IrOp> values(nresults);
+
+        for (int i = 0; i < std::min(count, nresults); ++i)
+        {
+            InlineValue& v = regs[rr + i];
+
+            if (v.kind == InlineValue::Param)
+                values[i] = build->inst(IrCmd::LOAD_TVALUE, build->vmReg(v.reg));
+            else if (v.kind == InlineValue::Field)
+                values[i] = build->inst(IrCmd::LOAD_TVALUE, v.value, build->constInt(0));
+        }
+
+        for (int i = 0; i < nresults; ++i)
+        {
+            IrOp target = build->vmReg(uint8_t(ra + i));
+            InlineValue::Kind kind = i < count ? regs[rr + i].kind : InlineValue::Nil;
+
+            switch (kind)
+            {
+            case InlineValue::Nil:
+                build->inst(IrCmd::STORE_TAG, target, build->constTag(LUA_TNIL));
+                break;
+            case InlineValue::Boolean:
+                build->inst(IrCmd::STORE_INT, target, build->constInt(regs[rr + i].boolean));
+                build->inst(IrCmd::STORE_TAG, target, build->constTag(LUA_TBOOLEAN));
+                break;
+            case InlineValue::Number:
+                build->inst(IrCmd::STORE_DOUBLE, target, regs[rr + i].value);
+                build->inst(IrCmd::STORE_TAG, target, build->constTag(LUA_TNUMBER));
+                break;
+            case InlineValue::TValue:
+                build->inst(IrCmd::STORE_TVALUE, target, regs[rr + i].value);
+                break;
+            case InlineValue::Param:
+            case InlineValue::Field:
+                build->inst(IrCmd::STORE_TVALUE, target, values[i]);
+                break;
+            case InlineValue::Unknown:
+                LUAU_ASSERT(!"Unknown values are rejected above");
+                break;
+            }
+        }
+
+        return true;
+    }
+
+    // Returns the cost of the inlined callee or -1 if it can't be inlined
+    int run(int nresults)
+    {
+        int cost = 0;
+
+        for (int i = 0; i < callee->sizecode;)
+        {
+            const Instruction* pc = &callee->code[i];
+            LuauOpcode op = getUnfusedOp(LuauOpcode(LUAU_INSN_OP(*pc)));
+
+            cost += getInlinedInstCost(op);
+
+            if (cost > FInt::LuauCodeGenInlineThreshold)
+                return -1;
+
+            bool success = false;
+
+            switch (op)
+            {
+            case LOP_NOP:
+                success = true;
+                break;
+            case LOP_LOADNIL:
+                regs[LUAU_INSN_A(*pc)] = InlineValue{InlineValue::Nil};
+                success = true;
+                break;
+            case LOP_LOADB:
+                // conditional jumps are not supported
+                if (LUAU_INSN_C(*pc) == 0)
+                {
+                    regs[LUAU_INSN_A(*pc)] = InlineValue{InlineValue::Boolean, LUAU_INSN_B(*pc) != 0};
+                    success = true;
+                }
+                break;
+            case LOP_LOADN:
+                regs[LUAU_INSN_A(*pc)] = InlineValue{InlineValue::Number, false, 0, build ? build->constDouble(LUAU_INSN_D(*pc)) : IrOp{}};
+                success = true;
+                break;
+            case LOP_LOADK:
+                success = loadConstant(&callee->k[LUAU_INSN_D(*pc)], regs[LUAU_INSN_A(*pc)]);
+                break;
+            case LOP_MOVE:
+                regs[LUAU_INSN_A(*pc)] = regs[LUAU_INSN_B(*pc)];
+                success = true;
+                break;
+            case LOP_GETTABLEKS:
+                success = translateGetTableKS(pc);
+                break;
+            case LOP_SETTABLEKS:
+                // the store is the only side effect of the callee and it has to be followed by the return
+                if (i + 2 < callee->sizecode && LUAU_INSN_OP(pc[2]) == LOP_RETURN)
+                    success = translateSetTableKS(pc);
+                break;
+            case LOP_ADD:
+                success = translateArith(pc, IrCmd::ADD_NUM, false);
+                break;
+            case LOP_SUB:
+                success = translateArith(pc, IrCmd::SUB_NUM, false);
+                break;
+            case LOP_MUL:
+                success = translateArith(pc, IrCmd::MUL_NUM, false);
+                break;
+            case LOP_DIV:
+                success = translateArith(pc, IrCmd::DIV_NUM, false);
+                break;
+            case LOP_ADDK:
+                success = translateArith(pc, IrCmd::ADD_NUM, true);
+                break;
+            case LOP_SUBK:
+                success = translateArith(pc, IrCmd::SUB_NUM, true);
+                break;
+            case LOP_MULK:
+                success = translateArith(pc, IrCmd::MUL_NUM, true);
+                break;
+            case LOP_DIVK:
+                success = translateArith(pc, IrCmd::DIV_NUM, true);
+                break;
+            case LOP_RETURN:
+                return translateReturn(pc, nresults) ? cost : -1;
+            default:
+                break;
+            }
+
+            if (!success)
+                return -1;
+
+            i += getOpLength(op);
+        }
+
+        return -1;
+    }
+
+    IrBuilder* build;
+    Proto* callee;
+    int ra;
+    IrOp callBlock;
+
+    std::vector<InlineValue> regs;
+};
+
+static bool canInline(Proto* callee, int nparams, int nresults)
+{
+    if (callee->is_vararg || callee->nups != 0 || callee->numparams != nparams || nresults < 0)
+        return false;
+
+    CalleeInliner inliner(nullptr, callee, 0, IrOp{});
+    return inliner.run(nresults) >= 0;
+}
+
+// Reads the current value of the instruction that loads the called function
+static const TValue* getCalleeValue(lua_State* L, Closure* cl, const Instruction* pc)
+{
+    switch (getUnfusedOp(LuauOpcode(LUAU_INSN_OP(*pc))))
+    {
+    case LOP_GETUPVAL:
+    {
+        TValue* uv = &cl->l.uprefs[LUAU_INSN_B(*pc)];
+        return ttisupval(uv) ? upvalue(uv)->v : uv;
+    }
+    case LOP_GETIMPORT:
+        return &cl->l.p->k[LUAU_INSN_D(*pc)];
+    case LOP_NAMECALL:
+    {
+        StkId rb = L->ci->base + LUAU_INSN_B(*pc);
+        const TValue* kv = &cl->l.p->k[pc[1]];
+
+        // registers above the stack top might not be kept alive by the GC
+        if (rb >= L->top || !ttistable(rb) || !ttisstring(kv))
+            return nullptr;
+
+        Table* h = hvalue(rb);
+        const TValue* value = luaH_getstr(h, tsvalue(kv));
+
+        // methods are usually found through the __index table of the metatable
+        if (ttisnil(value) && h->metatable)
+        {
+            const TValue* index = luaH_getstr(h->metatable, L->global->tmname[TM_INDEX]);
+
+            if (ttistable(index))
+                value = luaH_getstr(hvalue(index), tsvalue(kv));
+        }
+
+        return value;
+    }
+    default:
+        LUAU_ASSERT(!"Unsupported callee load");
+        return nullptr;
+    }
+}
+
+void findInlineTargets(lua_State* L, Proto* proto, std::vector<IrBuilder::InlineTarget>& targets)
+{
+    if (FInt::LuauCodeGenInlineThreshold <= 0 || !ttisfunction(L->ci->func))
+        return;
+
+    Closure* cl = clvalue(L->ci->func);
+
+    if (cl->isC || cl->l.p != proto)
+        return;
+
+    // Last instruction that loaded a function into each register; it's only a hint, so control flow is ignored
+    std::vector<int> loads(proto->maxstacksize, -1);
+    int fastcallFallback = -1;
+
+    for (int i = 0; i < proto->sizecode;)
+    {
+        const Instruction* pc = &proto->code[i];
+        LuauOpcode op = getUnfusedOp(LuauOpcode(LUAU_INSN_OP(*pc)));
+
+        switch (op)
+        {
+        case LOP_GETUPVAL:
+        case LOP_GETIMPORT:
+        case LOP_NAMECALL:
+            loads[LUAU_INSN_A(*pc)] = i;
+            break;
+        case LOP_FASTCALL:
+        case LOP_FASTCALL1:
+        case LOP_FASTCALL2:
+        case LOP_FASTCALL2K:
+            fastcallFallback = i + LUAU_INSN_C(*pc) + 1;
+            break;
+        case LOP_CALL:
+        {
+            int ra = LUAU_INSN_A(*pc);
+
+            if (i == fastcallFallback || loads[ra] < 0)
+                break;
+
+            const TValue* func = getCalleeValue(L, cl, &proto->code[loads[ra]]);
+
+            if (!func || !ttisfunction(func) || clvalue(func)->isC)
+                break;
+
+            Closure* target = clvalue(func);
+
+            if (canInline(target->l.p, int(LUAU_INSN_B(*pc)) - 1, int(LUAU_INSN_C(*pc)) - 1))
+                targets.push_back({uint32_t(i), target});
+            break;
+        }
+        default:
+            break;
+        }
+
+        i += getOpLength(op);
+    }
+}
+
+IrOp translateInlinedCall(IrBuilder& build, const Instruction* pc, int pcpos)
+{
+    auto it = std::find_if(build.inlineTargets.begin(), build.inlineTargets.end(),
+        [&](const IrBuilder::InlineTarget& target)
+        {
+            return target.pcpos == uint32_t(pcpos);
+        });
+
+    if (it == build.inlineTargets.end())
+        return {};
+
+    int ra = LUAU_INSN_A(*pc);
+
+    IrOp next = build.blockAtInst(pcpos + 1);
+    IrOp checkClosure = build.block(IrBlockKind::Internal);
+    IrOp inlineBody = build.block(IrBlockKind::Internal);
+    IrOp callBlock = build.block(IrBlockKind::Fallback);
+
+    IrOp tag = build.inst(IrCmd::LOAD_TAG, build.vmReg(ra));
+    build.inst(IrCmd::JUMP_EQ_TAG, tag, build.constTag(LUA_TFUNCTION), checkClosure, callBlock);
+
+    build.beginBlock(checkClosure);
+    IrOp func = build.inst(IrCmd::LOAD_POINTER, build.vmReg(ra));
+    build.inst(IrCmd::JUMP_EQ_POINTER, func, build.constPointer(it->closure), inlineBody, callBlock);
+
+    build.beginBlock(inlineBody);
+
+    CalleeInliner inliner(&build, it->closure->l.p, ra, callBlock);
+    [[maybe_unused]] int cost = inliner.run(int(LUAU_INSN_C(*pc)) - 1);
+    LUAU_ASSERT(cost >= 0);
+
+    build.inst(IrCmd::JUMP, next);
+
+    build.beginBlock(callBlock);
+    return next;
+}
+
+} // namespace CodeGen
+} // namespace Luau
@@ -0,0 +1,24 @@
+// This file is part of the Luau programming language and is licensed under MIT License; see LICENSE.txt for details
+#pragma once
+
+#include "Luau/IrBuilder.h"
+
+#include <vector>
+
+struct lua_State;
+
+namespace Luau
+{
+namespace CodeGen
+{
+
+// Finds calls in the function that is running in the interpreter frame 'L->ci' that are likely to reach small Lua closures
+// Candidates come from the current values of upvalues, imports and method tables; native code only trusts them after a guard on closure identity
+void findInlineTargets(lua_State* L, Proto* proto, std::vector<IrBuilder::InlineTarget>& targets);
+
+// Emits the body of the expected callee of the call at 'pcpos' when it's in the inline target list; other callees and failed guards branch to the
+// block that the caller continues in with a regular call. Returns the block that follows the call or undef when the call wasn't inlined
+IrOp translateInlinedCall(IrBuilder& build, const Instruction* pc, int pcpos);
+
+} // namespace CodeGen
+} // namespace Luau
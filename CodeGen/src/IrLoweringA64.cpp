@@ -74,6 +74,21 @@ static void emitAddOffset(AssemblyBuilderA64& build, RegisterA64 dst, RegisterA6
     }
 }
 
+static void emitPointerConstant(AssemblyBuilderA64& build, RegisterA64 dst, const void* value)
+{
+    LUAU_ASSERT(dst.kind == KindA64::x);
+
+    uint64_t bits = uint64_t(uintptr_t(value));
+
+    build.movz(dst, uint16_t(bits));
+
+    for (int shift = 16; shift < 64; shift += 16)
+    {
+        if (uint16_t part = uint16_t(bits >> shift))
+            build.movk(dst, part, shift);
+    }
+}
+
 static void checkObjectBarrierConditions(AssemblyBuilderA64& build, RegisterA64 object, RegisterA64 temp, IrOp ra, int ratag, Label& skip)
 {
     RegisterA64 tempw = castReg(KindA64::w, temp);
@@ -328,6 +343,31 @@ void IrLoweringA64::lowerInst(IrInst& inst, uint32_t index, const IrBlock& next)
         build.add(inst.regA64, inst.regA64, temp2x, kLuaNodeSizeLog2); // "zero extend" temp2 to get a larger shift (top 32 bits are zero)
         break;
     }
+    case IrCmd::GET_SHAPE_SLOT_ADDR:
+    {
+        inst.regA64 = regs.allocReuse(KindA64::x, index, {inst.a});
+        RegisterA64 temp1 = regs.allocTemp(KindA64::x);
+        RegisterA64 temp1w = castReg(KindA64::w, temp1);
+
+        // note: since the stride of the load is the same as the destination register size, we can range check the array index, not the byte offset
+        if (uintOp(inst.b) <= AddressA64::kMaxOffset)
+            build.ldr(temp1w, mem(rCode, uintOp(inst.b) * sizeof(Instruction)));
+        else
+        {
+            build.mov(temp1, uintOp(inst.b) * sizeof(Instruction));
+            build.ldr(temp1w, mem(rCode, temp1));
+        }
+
+        // C field is the most significant byte of the instruction word
+        LUAU_ASSERT(kOffsetOfInstructionC == 3);
+        build.lsr(temp1w, temp1w, 24);
+
+        // note: this may clobber inst.a, so it's important that we don't use it after this
+        build.ldr(inst.regA64, mem(regOp(inst.a), offsetof(Table, node)));
+        build.add(inst.regA64, inst.regA64, temp1, kTValueSizeLog2); // top 32 bits of temp1 are zero
+        build.add(inst.regA64, inst.regA64, uint16_t(kOffsetOfShapeSlots));
+        break;
+    }
     case IrCmd::GET_CLOSURE_UPVAL_ADDR:
     {
         inst.regA64 = regs.allocReuse(KindA64::x, index, {inst.a});
@@ -576,6 +616,57 @@ void IrLoweringA64::lowerInst(IrInst& inst, uint32_t index, const IrBlock& next)
         build.fabs(inst.regA64, temp);
         break;
     }
+    case IrCmd::ADD_VEC:
+    {
+        inst.regA64 = regs.allocReuse(KindA64::q, index, {inst.a, inst.b});
+        build.fadd(inst.regA64, regOp(inst.a), regOp(inst.b));
+        break;
+    }
+    case IrCmd::SUB_VEC:
+    {
+        inst.regA64 = regs.allocReuse(KindA64::q, index, {inst.a, inst.b});
+        build.fsub(inst.regA64, regOp(inst.a), regOp(inst.b));
+        break;
+    }
+    case IrCmd::MUL_VEC:
+    {
+        inst.regA64 = regs.allocReuse(KindA64::q, index, {inst.a, inst.b});
+        build.fmul(inst.regA64, regOp(inst.a), regOp(inst.b));
+        break;
+    }
+    case IrCmd::DIV_VEC:
+    {
+        inst.regA64 = regs.allocReuse(KindA64::q, index, {inst.a, inst.b});
+        build.fdiv(inst.regA64, regOp(inst.a), regOp(inst.b));
+        break;
+    }
+    case IrCmd::UNM_VEC:
+    {
+        inst.regA64 = regs.allocReuse(KindA64::q, index, {inst.a});
+        build.fneg(inst.regA64, regOp(inst.a));
+        break;
+    }
+    case IrCmd::NUM_TO_VEC:
+    {
+        inst.regA64 = regs.allocReg(KindA64::q, index);
+        RegisterA64 temp1 = tempDouble(inst.a);
+        RegisterA64 temp2 = regs.allocTemp(KindA64::s);
+        build.fcvt(temp2, temp1);
+        build.dup_4s(inst.regA64, castReg(KindA64::q, temp2), 0);
+        break;
+    }
+    case IrCmd::TAG_VECTOR:
+    {
+        inst.regA64 = regs.allocReuse(KindA64::q, index, {inst.a});
+        RegisterA64 temp = regs.allocTemp(KindA64::w);
+
+        if (inst.regA64 != regOp(inst.a))
+            build.mov(inst.regA64, regOp(inst.a));
+
+        build.mov(temp, LUA_TVECTOR);
+        build.ins_4s(inst.regA64, temp, 3);
+        break;
+    }
     case IrCmd::NOT_ANY:
     {
         inst.regA64 = regs.allocReuse(KindA64::w, index, {inst.a, inst.b});
@@ -742,7 +833,16 @@ void IrLoweringA64::lowerInst(IrInst& inst, uint32_t index, const IrBlock& next)
         break;
     }
     case IrCmd::JUMP_EQ_POINTER:
-        build.cmp(regOp(inst.a), regOp(inst.b));
+        if (inst.b.kind == IrOpKind::Constant)
+        {
+            RegisterA64 temp = regs.allocTemp(KindA64::x);
+            emitPointerConstant(build, temp, pointerOp(inst.b));
+            build.cmp(regOp(inst.a), temp);
+        }
+        else
+        {
+            build.cmp(regOp(inst.a), regOp(inst.b));
+        }
         build.b(ConditionA64::Equal, labelOp(inst.c));
         jumpOrFallthrough(blockOp(inst.d), next);
         break;
@@ -818,9 +918,19 @@ void IrLoweringA64::lowerInst(IrInst& inst, uint32_t index, const IrBlock& next)
     {
         regs.spill(build, index);
         build.mov(x0, rState);
-        build.mov(x1, uintOp(inst.a));
-        build.mov(x2, uintOp(inst.b));
-        build.ldr(x3, mem(rNativeContext, offsetof(NativeContext, luaH_new)));
+
+        if (inst.c.kind != IrOpKind::Undef)
+        {
+            build.mov(x1, uintOp(inst.b));
+            build.ldr(x3, mem(rNativeContext, offsetof(NativeContext, luaH_newshaped)));
+        }
+        else
+        {
+            build.mov(x1, uintOp(inst.a));
+            build.mov(x2, uintOp(inst.b));
+            build.ldr(x3, mem(rNativeContext, offsetof(NativeContext, luaH_new)));
+        }
+
         build.blr(x3);
         inst.regA64 = regs.takeReg(x0, index);
         break;
@@ -1267,8 +1377,16 @@ void IrLoweringA64::lowerInst(IrInst& inst, uint32_t index, const IrBlock& next)
         build.cmp(temp2, LUA_TSTRING);
         build.b(ConditionA64::NotEqual, mismatch);
 
-        AddressA64 addr = tempAddr(inst.b, offsetof(TValue, value));
-        build.ldr(temp2, addr);
+        if (inst.b.kind == IrOpKind::Constant)
+        {
+            emitPointerConstant(build, temp2, pointerOp(inst.b));
+        }
+        else
+        {
+            AddressA64 addr = tempAddr(inst.b, offsetof(TValue, value));
+            build.ldr(temp2, addr);
+        }
+
         build.cmp(temp1, temp2);
         build.b(ConditionA64::NotEqual, mismatch);
 
@@ -1282,6 +1400,62 @@ void IrLoweringA64::lowerInst(IrInst& inst, uint32_t index, const IrBlock& next)
             emitAbort(build, abort);
         break;
     }
+    case IrCmd::CHECK_SHAPE_SLOT_MATCH:
+    {
+        Label abort; // used when guard aborts execution
+        Label& mismatch = inst.d.kind == IrOpKind::Undef ? abort : labelOp(inst.d);
+
+        RegisterA64 temp1 = regs.allocTemp(KindA64::x);
+        RegisterA64 temp1w = castReg(KindA64::w, temp1);
+        RegisterA64 temp2 = regs.allocTemp(KindA64::x);
+        RegisterA64 temp2w = castReg(KindA64::w, temp2);
+        RegisterA64 temp3 = regs.allocTemp(KindA64::x);
+        RegisterA64 temp3w = castReg(KindA64::w, temp3);
+
+        // shape is held by the key of the first node
+        build.ldr(temp1, mem(regOp(inst.a), offsetof(Table, node)));
+        build.ldr(temp3w, mem(temp1, offsetof(LuaNode, key) + kOffsetOfTKeyTagNext));
+        build.ubfx(temp3w, temp3w, 0, kTKeyTagBits);
+        build.cmp(temp3w, LUA_TSHAPE);
+        build.b(ConditionA64::NotEqual, mismatch);
+        build.ldr(temp1, mem(temp1, offsetof(LuaNode, key.value)));
+
+        // note: since the stride of the load is the same as the destination register size, we can range check the array index, not the byte offset
+        if (uintOp(inst.b) <= AddressA64::kMaxOffset)
+            build.ldr(temp2w, mem(rCode, uintOp(inst.b) * sizeof(Instruction)));
+        else
+        {
+            build.mov(temp2, uintOp(inst.b) * sizeof(Instruction));
+            build.ldr(temp2w, mem(rCode, temp2));
+        }
+
+        // C field is the most significant byte of the instruction word
+        LUAU_ASSERT(kOffsetOfInstructionC == 3);
+        build.lsr(temp2w, temp2w, 24);
+
+        build.ldrb(temp3w, mem(temp1, offsetof(TableShape, count)));
+        build.cmp(temp3w, temp2w);
+        build.b(ConditionA64::UnsignedLessEqual, mismatch);
+
+        LUAU_ASSERT(sizeof(TString*) == 8);
+        build.add(temp1, temp1, temp2, 3); // top 32 bits of temp2 are zero
+        build.ldr(temp1, mem(temp1, offsetof(TableShape, keys)));
+
+        AddressA64 addr = tempAddr(inst.c, offsetof(TValue, value));
+        build.ldr(temp3, addr);
+        build.cmp(temp1, temp3);
+        build.b(ConditionA64::NotEqual, mismatch);
+
+        build.ldr(temp1, mem(regOp(inst.a), offsetof(Table, node)));
+        build.add(temp1, temp1, temp2, kTValueSizeLog2);
+        build.ldr(temp1w, mem(temp1, kOffsetOfShapeSlots + offsetof(TValue, tt)));
+        LUAU_ASSERT(LUA_TNIL == 0);
+        build.cbz(temp1w, mismatch);
+
+        if (abort.id)
+            emitAbort(build, abort);
+        break;
+    }
     case IrCmd::CHECK_NODE_NO_NEXT:
     {
         Label fresh; // used when guard aborts execution or jumps to a VM exit
@@ -1304,6 +1478,15 @@ void IrLoweringA64::lowerInst(IrInst& inst, uint32_t index, const IrBlock& next)
         finalizeTargetLabel(inst.b, fresh);
         break;
     }
+    case IrCmd::CHECK_NO_INTERRUPT:
+    {
+        Label fresh; // used when guard aborts execution or jumps to a VM exit
+        RegisterA64 temp = regs.allocTemp(KindA64::x);
+        build.ldr(temp, mem(rGlobalState, offsetof(global_State, cb.interrupt)));
+        build.cbnz(temp, getTargetLabel(inst.a, fresh));
+        finalizeTargetLabel(inst.a, fresh);
+        break;
+    }
     case IrCmd::INTERRUPT:
     {
         regs.spill(build, index);
@@ -2172,6 +2355,11 @@ double IrLoweringA64::doubleOp(IrOp op) const
     return function.doubleOp(op);
 }
 
+const void* IrLoweringA64::pointerOp(IrOp op) const
+{
+    return function.pointerOp(op);
+}
+
 IrBlock& IrLoweringA64::blockOp(IrOp op) const
 {
     return function.blockOp(op);
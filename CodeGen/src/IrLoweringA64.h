@@ -53,6 +53,7 @@ struct IrLoweringA64
     int intOp(IrOp op) const;
     unsigned uintOp(IrOp op) const;
     double doubleOp(IrOp op) const;
+    const void* pointerOp(IrOp op) const;
 
     IrBlock& blockOp(IrOp op) const;
     Label& labelOp(IrOp op) const;
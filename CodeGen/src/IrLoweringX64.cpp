@@ -102,6 +102,8 @@ void IrLoweringX64::lowerInst(IrInst& inst, uint32_t index, const IrBlock& next)
             build.vmovsd(inst.regX64, luauRegValue(vmRegOp(inst.a)));
         else if (inst.a.kind == IrOpKind::VmConst)
             build.vmovsd(inst.regX64, luauConstantValue(vmConstOp(inst.a)));
+        else if (inst.a.kind == IrOpKind::Inst)
+            build.vmovsd(inst.regX64, qword[regOp(inst.a) + offsetof(TValue, value)]);
         else
             LUAU_ASSERT(!"Unsupported instruction form");
         break;
@@ -185,6 +187,20 @@ void IrLoweringX64::lowerInst(IrInst& inst, uint32_t index, const IrBlock& next)
         build.add(inst.regX64, tmp.reg);
         break;
     };
+    case IrCmd::GET_SHAPE_SLOT_ADDR:
+    {
+        inst.regX64 = regs.allocReg(SizeX64::qword, index);
+
+        ScopedRegX64 tmp{regs, SizeX64::qword};
+
+        build.mov(inst.regX64, qword[regOp(inst.a) + offsetof(Table, node)]);
+
+        build.mov(tmp.reg, sCode);
+        build.movzx(dwordReg(tmp.reg), byte[tmp.reg + uintOp(inst.b) * sizeof(Instruction) + kOffsetOfInstructionC]);
+        build.shl(dwordReg(tmp.reg), kTValueSizeLog2);
+        build.lea(inst.regX64, addr[inst.regX64 + tmp.reg + kOffsetOfShapeSlots]);
+        break;
+    }
     case IrCmd::GET_CLOSURE_UPVAL_ADDR:
     {
         inst.regX64 = regs.allocRegOrReuse(SizeX64::qword, index, {inst.a});
@@ -556,6 +572,59 @@ void IrLoweringX64::lowerInst(IrInst& inst, uint32_t index, const IrBlock& next)
 
         build.vandpd(inst.regX64, inst.regX64, build.i64(~(1LL << 63)));
         break;
+    case IrCmd::ADD_VEC:
+    case IrCmd::SUB_VEC:
+    case IrCmd::MUL_VEC:
+    case IrCmd::DIV_VEC:
+    {
+        inst.regX64 = regs.allocRegOrReuse(SizeX64::xmmword, index, {inst.a, inst.b});
+
+        ScopedRegX64 tmp1{regs};
+        ScopedRegX64 tmp2{regs};
+
+        RegisterX64 tmpa = vecOp(inst.a, tmp1);
+        RegisterX64 tmpb = inst.a == inst.b ? tmpa : vecOp(inst.b, tmp2);
+
+        if (inst.cmd == IrCmd::ADD_VEC)
+            build.vaddps(inst.regX64, tmpa, tmpb);
+        else if (inst.cmd == IrCmd::SUB_VEC)
+            build.vsubps(inst.regX64, tmpa, tmpb);
+        else if (inst.cmd == IrCmd::MUL_VEC)
+            build.vmulps(inst.regX64, tmpa, tmpb);
+        else
+            build.vdivps(inst.regX64, tmpa, tmpb);
+        break;
+    }
+    case IrCmd::UNM_VEC:
+        inst.regX64 = regs.allocRegOrReuse(SizeX64::xmmword, index, {inst.a});
+
+        build.vxorpd(inst.regX64, regOp(inst.a), build.f32x4(-0.0f, -0.0f, -0.0f, -0.0f));
+        break;
+    case IrCmd::NUM_TO_VEC:
+        if (inst.a.kind == IrOpKind::Constant)
+        {
+            inst.regX64 = regs.allocReg(SizeX64::xmmword, index);
+
+            float value = float(doubleOp(inst.a));
+            build.vmovups(inst.regX64, build.f32x4(value, value, value, value));
+        }
+        else
+        {
+            inst.regX64 = regs.allocRegOrReuse(SizeX64::xmmword, index, {inst.a});
+
+            build.vcvtsd2ss(inst.regX64, inst.regX64, memRegDoubleOp(inst.a));
+            build.vshufps(inst.regX64, inst.regX64, inst.regX64, 0);
+        }
+        break;
+    case IrCmd::TAG_VECTOR:
+    {
+        inst.regX64 = regs.allocRegOrReuse(SizeX64::xmmword, index, {inst.a});
+
+        ScopedRegX64 tmp{regs, SizeX64::dword};
+        build.mov(tmp.reg, LUA_TVECTOR);
+        build.vpinsrd(inst.regX64, regOp(inst.a), tmp.reg, 3);
+        break;
+    }
     case IrCmd::NOT_ANY:
     {
         // TODO: if we have a single user which is a STORE_INT, we are missing the opportunity to write directly to target
@@ -692,7 +761,17 @@ void IrLoweringX64::lowerInst(IrInst& inst, uint32_t index, const IrBlock& next)
         jumpOrFallthrough(blockOp(inst.d), next);
         break;
     case IrCmd::JUMP_EQ_POINTER:
-        build.cmp(regOp(inst.a), regOp(inst.b));
+        if (inst.b.kind == IrOpKind::Constant)
+        {
+            ScopedRegX64 tmp{regs, SizeX64::qword};
+
+            build.mov64(tmp.reg, int64_t(uintptr_t(pointerOp(inst.b))));
+            build.cmp(regOp(inst.a), tmp.reg);
+        }
+        else
+        {
+            build.cmp(regOp(inst.a), regOp(inst.b));
+        }
 
         build.jcc(ConditionX64::Equal, labelOp(inst.c));
         jumpOrFallthrough(blockOp(inst.d), next);
@@ -737,9 +816,19 @@ void IrLoweringX64::lowerInst(IrInst& inst, uint32_t index, const IrBlock& next)
     {
         IrCallWrapperX64 callWrap(regs, build, index);
         callWrap.addArgument(SizeX64::qword, rState);
-        callWrap.addArgument(SizeX64::dword, int32_t(uintOp(inst.a)));
-        callWrap.addArgument(SizeX64::dword, int32_t(uintOp(inst.b)));
-        callWrap.call(qword[rNativeContext + offsetof(NativeContext, luaH_new)]);
+
+        if (inst.c.kind != IrOpKind::Undef)
+        {
+            callWrap.addArgument(SizeX64::dword, int32_t(uintOp(inst.b)));
+            callWrap.call(qword[rNativeContext + offsetof(NativeContext, luaH_newshaped)]);
+        }
+        else
+        {
+            callWrap.addArgument(SizeX64::dword, int32_t(uintOp(inst.a)));
+            callWrap.addArgument(SizeX64::dword, int32_t(uintOp(inst.b)));
+            callWrap.call(qword[rNativeContext + offsetof(NativeContext, luaH_new)]);
+        }
+
         inst.regX64 = regs.takeReg(rax, index);
         break;
     }
@@ -1099,7 +1188,10 @@ void IrLoweringX64::lowerInst(IrInst& inst, uint32_t index, const IrBlock& next)
         build.jcc(ConditionX64::NotEqual, mismatch);
 
         // Check that node key value matches the expected one
-        build.mov(tmp.reg, luauConstantValue(vmConstOp(inst.b)));
+        if (inst.b.kind == IrOpKind::Constant)
+            build.mov64(tmp.reg, int64_t(uintptr_t(pointerOp(inst.b))));
+        else
+            build.mov(tmp.reg, luauConstantValue(vmConstOp(inst.b)));
         build.cmp(tmp.reg, luauNodeKeyValue(regOp(inst.a)));
         build.jcc(ConditionX64::NotEqual, mismatch);
 
@@ -1121,6 +1213,49 @@ void IrLoweringX64::lowerInst(IrInst& inst, uint32_t index, const IrBlock& next)
         }
         break;
     }
+    case IrCmd::CHECK_SHAPE_SLOT_MATCH:
+    {
+        Label abort; // Used when guard aborts execution
+        Label& mismatch = inst.d.kind == IrOpKind::Undef ? abort : labelOp(inst.d);
+
+        ScopedRegX64 tmp{regs, SizeX64::qword};
+        ScopedRegX64 slot{regs, SizeX64::qword};
+
+        // Check that table has a shape, which is held by the key of its first node
+        build.mov(tmp.reg, qword[regOp(inst.a) + offsetof(Table, node)]);
+        build.mov(dwordReg(slot.reg), luauNodeKeyTag(tmp.reg));
+        build.and_(dwordReg(slot.reg), kTKeyTagMask);
+        build.cmp(dwordReg(slot.reg), LUA_TSHAPE);
+        build.jcc(ConditionX64::NotEqual, mismatch);
+        build.mov(tmp.reg, luauNodeKeyValue(tmp.reg));
+
+        // Check that cached slot is used by the shape
+        build.mov(slot.reg, sCode);
+        build.movzx(dwordReg(slot.reg), byte[slot.reg + uintOp(inst.b) * sizeof(Instruction) + kOffsetOfInstructionC]);
+        build.cmp(byte[tmp.reg + offsetof(TableShape, count)], byteReg(slot.reg));
+        build.jcc(ConditionX64::BelowEqual, mismatch);
+
+        // Check that shape key at cached slot matches the expected one
+        build.mov(tmp.reg, qword[tmp.reg + slot.reg * sizeof(TString*) + offsetof(TableShape, keys)]);
+        build.cmp(tmp.reg, luauConstantValue(vmConstOp(inst.c)));
+        build.jcc(ConditionX64::NotEqual, mismatch);
+
+        // Check that slot value is not nil
+        build.mov(tmp.reg, qword[regOp(inst.a) + offsetof(Table, node)]);
+        build.shl(dwordReg(slot.reg), kTValueSizeLog2);
+        build.cmp(dword[tmp.reg + slot.reg + kOffsetOfShapeSlots + offsetof(TValue, tt)], LUA_TNIL);
+        build.jcc(ConditionX64::Equal, mismatch);
+
+        if (inst.d.kind == IrOpKind::Undef)
+        {
+            Label skip;
+            build.jmp(skip);
+            build.setLabel(abort);
+            build.ud2();
+            build.setLabel(skip);
+        }
+        break;
+    }
     case IrCmd::CHECK_NODE_NO_NEXT:
     {
         ScopedRegX64 tmp{regs, SizeX64::dword};
@@ -1136,6 +1271,15 @@ void IrLoweringX64::lowerInst(IrInst& inst, uint32_t index, const IrBlock& next)
         jumpOrAbortOnUndef(ConditionX64::Equal, inst.b, next);
         break;
     }
+    case IrCmd::CHECK_NO_INTERRUPT:
+    {
+        ScopedRegX64 tmp{regs, SizeX64::qword};
+
+        build.mov(tmp.reg, qword[rState + offsetof(lua_State, global)]);
+        build.cmp(qword[tmp.reg + offsetof(global_State, cb.interrupt)], 0);
+        jumpOrAbortOnUndef(ConditionX64::NotEqual, inst.a, next);
+        break;
+    }
     case IrCmd::INTERRUPT:
     {
         unsigned pcpos = uintOp(inst.a);
@@ -1794,6 +1938,30 @@ OperandX64 IrLoweringX64::memRegTagOp(IrOp op)
     return noreg;
 }
 
+RegisterX64 IrLoweringX64::vecOp(IrOp op, ScopedRegX64& tmp)
+{
+    // Vectors made from numbers hold a number in the last lane, which doesn't need the mask below
+    if (function.instOp(op).cmd == IrCmd::NUM_TO_VEC)
+        return regOp(op);
+
+    // The lane with the TValue tag is cleared to avoid slow arithmetic on denormal values
+    tmp.alloc(SizeX64::xmmword);
+    build.vandpd(tmp.reg, regOp(op), vectorAndMaskOp());
+    return tmp.reg;
+}
+
+OperandX64 IrLoweringX64::vectorAndMaskOp()
+{
+    if (vectorAndMask.base == noreg)
+    {
+        static const uint32_t mask[4] = {~0u, ~0u, ~0u, 0};
+        vectorAndMask = build.bytes(mask, sizeof(mask), 16);
+        vectorAndMask.memSize = SizeX64::xmmword;
+    }
+
+    return vectorAndMask;
+}
+
 RegisterX64 IrLoweringX64::regOp(IrOp op)
 {
     IrInst& inst = function.instOp(op);
@@ -1830,6 +1998,11 @@ double IrLoweringX64::doubleOp(IrOp op) const
     return function.doubleOp(op);
 }
 
+const void* IrLoweringX64::pointerOp(IrOp op) const
+{
+    return function.pointerOp(op);
+}
+
 IrBlock& IrLoweringX64::blockOp(IrOp op) const
 {
     return function.blockOp(op);
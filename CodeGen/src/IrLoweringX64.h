@@ -49,12 +49,15 @@ struct IrLoweringX64
     OperandX64 memRegUintOp(IrOp op);
     OperandX64 memRegTagOp(IrOp op);
     RegisterX64 regOp(IrOp op);
+    RegisterX64 vecOp(IrOp op, ScopedRegX64& tmp);
+    OperandX64 vectorAndMaskOp();
 
     IrConst constOp(IrOp op) const;
     uint8_t tagOp(IrOp op) const;
     int intOp(IrOp op) const;
     unsigned uintOp(IrOp op) const;
     double doubleOp(IrOp op) const;
+    const void* pointerOp(IrOp op) const;
 
     IrBlock& blockOp(IrOp op) const;
     Label& labelOp(IrOp op) const;
@@ -84,6 +87,8 @@ struct IrLoweringX64
     std::vector<InterruptHandler> interruptHandlers;
     std::vector<ExitHandler> exitHandlers;
     DenseHashMap<uint32_t, uint32_t> exitHandlerMap;
+
+    OperandX64 vectorAndMask = noreg;
 };
 
 } // namespace X64
@@ -12,6 +12,8 @@
 #include "lstate.h"
 #include "ltm.h"
 
+LUAU_FASTFLAG(LuauTableShapes)
+
 namespace Luau
 {
 namespace CodeGen
@@ -40,6 +42,14 @@ struct FallbackStreamScope
     IrOp next;
 };
 
+// Interpreter never saw the instruction leave its fast path (see Proto::typeprofile), so a failed guard can exit to VM instead of taking a fallback
+static bool canSpeculate(IrBuilder& build, int pcpos, uint8_t slowPaths)
+{
+    Proto* proto = build.function.proto;
+
+    return proto && proto->typeprofile && (proto->typeprofile[pcpos] & slowPaths) == 0;
+}
+
 void translateInstLoadNil(IrBuilder& build, const Instruction* pc)
 {
     int ra = LUAU_INSN_A(*pc);
@@ -323,10 +333,92 @@ void translateInstJumpxEqS(IrBuilder& build, const Instruction* pc, int pcpos)
         build.beginBlock(next);
 }
 
-static void translateInstBinaryNumeric(IrBuilder& build, int ra, int rb, int rc, IrOp opc, int pcpos, TMS tm)
+// Interpreter computed vector arithmetic in the instruction, operands that were seen as vectors are passed in the flags
+// Vector components and the tag share a 16-byte register, so this is only done when vectors have 3 components
+static bool translateInstBinaryVector(IrBuilder& build, int ra, int rb, int rc, IrOp opc, int pcpos, TMS tm)
 {
+    Proto* proto = build.function.proto;
+
+    if (LUA_VECTOR_SIZE != 3 || !proto || !proto->typeprofile)
+        return false;
+
+    uint8_t profile = proto->typeprofile[pcpos];
+    bool vecb = (profile & LUA_TYPEPROFILE_VECTORB) != 0;
+    bool vecc = (profile & LUA_TYPEPROFILE_VECTORC) != 0;
+
+    // VM fast paths only support vector addition and subtraction with two vectors, multiplication and division can also take a number
+    if (tm == TM_ADD || tm == TM_SUB)
+    {
+        if (!vecb || !vecc)
+            return false;
+    }
+    else if (tm == TM_MUL || tm == TM_DIV)
+    {
+        if (!vecb && !vecc)
+            return false;
+    }
+    else
+    {
+        return false;
+    }
+
     IrOp fallback = build.block(IrBlockKind::Fallback);
 
+    IrOp tb = build.inst(IrCmd::LOAD_TAG, build.vmReg(rb));
+    build.inst(IrCmd::CHECK_TAG, tb, build.constTag(vecb ? LUA_TVECTOR : LUA_TNUMBER), fallback);
+
+    if (rc != -1 && rc != rb)
+    {
+        IrOp tc = build.inst(IrCmd::LOAD_TAG, build.vmReg(rc));
+        build.inst(IrCmd::CHECK_TAG, tc, build.constTag(vecc ? LUA_TVECTOR : LUA_TNUMBER), fallback);
+    }
+
+    IrOp vb = vecb ? build.inst(IrCmd::LOAD_TVALUE, build.vmReg(rb))
+                   : build.inst(IrCmd::NUM_TO_VEC, build.inst(IrCmd::LOAD_DOUBLE, build.vmReg(rb)));
+    IrOp vc;
+
+    if (opc.kind == IrOpKind::VmConst)
+    {
+        TValue protok = proto->k[vmConstOp(opc)];
+        LUAU_ASSERT(protok.tt == LUA_TNUMBER);
+
+        vc = build.inst(IrCmd::NUM_TO_VEC, build.constDouble(protok.value.n));
+    }
+    else if (rc == rb)
+    {
+        vc = vb;
+    }
+    else
+    {
+        vc = vecc ? build.inst(IrCmd::LOAD_TVALUE, build.vmReg(rc))
+                  : build.inst(IrCmd::NUM_TO_VEC, build.inst(IrCmd::LOAD_DOUBLE, build.vmReg(rc)));
+    }
+
+    IrCmd cmd = tm == TM_ADD ? IrCmd::ADD_VEC : tm == TM_SUB ? IrCmd::SUB_VEC : tm == TM_MUL ? IrCmd::MUL_VEC : IrCmd::DIV_VEC;
+
+    IrOp result = build.inst(cmd, vb, vc);
+    result = build.inst(IrCmd::TAG_VECTOR, result);
+
+    build.inst(IrCmd::STORE_TVALUE, build.vmReg(ra), result);
+
+    IrOp next = build.blockAtInst(pcpos + 1);
+    FallbackStreamScope scope(build, fallback, next);
+
+    build.inst(IrCmd::SET_SAVEDPC, build.constUint(pcpos + 1));
+    build.inst(IrCmd::DO_ARITH, build.vmReg(ra), build.vmReg(rb), opc, build.constInt(tm));
+    build.inst(IrCmd::JUMP, next);
+    return true;
+}
+
+static void translateInstBinaryNumeric(IrBuilder& build, int ra, int rb, int rc, IrOp opc, int pcpos, TMS tm)
+{
+    if (translateInstBinaryVector(build, ra, rb, rc, opc, pcpos, tm))
+        return;
+
+    // Without a fallback path joining the fast path, the result is known to be a number in the instructions that follow
+    bool speculate = canSpeculate(build, pcpos, LUA_TYPEPROFILE_NONNUMBER);
+    IrOp fallback = speculate ? build.vmExit(pcpos) : build.block(IrBlockKind::Fallback);
+
     // fast-path: number
     IrOp tb = build.inst(IrCmd::LOAD_TAG, build.vmReg(rb));
     build.inst(IrCmd::CHECK_TAG, tb, build.constTag(LUA_TNUMBER), fallback);
@@ -401,6 +493,9 @@ static void translateInstBinaryNumeric(IrBuilder& build, int ra, int rb, int rc,
     if (ra != rb && ra != rc) // TODO: optimization should handle second check, but we'll test this later
         build.inst(IrCmd::STORE_TAG, build.vmReg(ra), build.constTag(LUA_TNUMBER));
 
+    if (speculate)
+        return;
+
     IrOp next = build.blockAtInst(pcpos + 1);
     FallbackStreamScope scope(build, fallback, next);
 
@@ -438,19 +533,33 @@ void translateInstMinus(IrBuilder& build, const Instruction* pc, int pcpos)
     int ra = LUAU_INSN_A(*pc);
     int rb = LUAU_INSN_B(*pc);
 
+    Proto* proto = build.function.proto;
+    bool vector = LUA_VECTOR_SIZE == 3 && proto && proto->typeprofile && (proto->typeprofile[pcpos] & LUA_TYPEPROFILE_VECTORB) != 0;
+
     IrOp fallback = build.block(IrBlockKind::Fallback);
 
     IrOp tb = build.inst(IrCmd::LOAD_TAG, build.vmReg(rb));
-    build.inst(IrCmd::CHECK_TAG, tb, build.constTag(LUA_TNUMBER), fallback);
+    build.inst(IrCmd::CHECK_TAG, tb, build.constTag(vector ? LUA_TVECTOR : LUA_TNUMBER), fallback);
 
-    // fast-path: number
-    IrOp vb = build.inst(IrCmd::LOAD_DOUBLE, build.vmReg(rb));
-    IrOp va = build.inst(IrCmd::UNM_NUM, vb);
+    if (vector)
+    {
+        // fast-path: vector, as seen by the interpreter
+        IrOp vb = build.inst(IrCmd::LOAD_TVALUE, build.vmReg(rb));
+        IrOp va = build.inst(IrCmd::TAG_VECTOR, build.inst(IrCmd::UNM_VEC, vb));
 
-    build.inst(IrCmd::STORE_DOUBLE, build.vmReg(ra), va);
+        build.inst(IrCmd::STORE_TVALUE, build.vmReg(ra), va);
+    }
+    else
+    {
+        // fast-path: number
+        IrOp vb = build.inst(IrCmd::LOAD_DOUBLE, build.vmReg(rb));
+        IrOp va = build.inst(IrCmd::UNM_NUM, vb);
 
-    if (ra != rb)
-        build.inst(IrCmd::STORE_TAG, build.vmReg(ra), build.constTag(LUA_TNUMBER));
+        build.inst(IrCmd::STORE_DOUBLE, build.vmReg(ra), va);
+
+        if (ra != rb)
+            build.inst(IrCmd::STORE_TAG, build.vmReg(ra), build.constTag(LUA_TNUMBER));
+    }
 
     IrOp next = build.blockAtInst(pcpos + 1);
     FallbackStreamScope scope(build, fallback, next);
@@ -492,11 +601,12 @@ void translateInstNewTable(IrBuilder& build, const Instruction* pc, int pcpos)
 {
     int ra = LUAU_INSN_A(*pc);
     int b = LUAU_INSN_B(*pc);
+    int c = LUAU_INSN_C(*pc);
     uint32_t aux = pc[1];
 
     build.inst(IrCmd::SET_SAVEDPC, build.constUint(pcpos + 1));
 
-    IrOp va = build.inst(IrCmd::NEW_TABLE, build.constUint(aux), build.constUint(b == 0 ? 0 : 1 << (b - 1)));
+    IrOp va = build.inst(IrCmd::NEW_TABLE, build.constUint(aux), build.constUint(b == 0 ? 0 : 1 << (b - 1)), c ? build.constInt(1) : build.undef());
     build.inst(IrCmd::STORE_POINTER, build.vmReg(ra), va);
     build.inst(IrCmd::STORE_TAG, build.vmReg(ra), build.constTag(LUA_TTABLE));
 
@@ -975,19 +1085,46 @@ void translateInstGetTableKS(IrBuilder& build, const Instruction* pc, int pcpos)
 
     IrOp fallback = build.block(IrBlockKind::Fallback);
 
+    // Slot mismatches still use the fallback, which updates the slot hint
+    bool speculate = canSpeculate(build, pcpos, LUA_TYPEPROFILE_NONTABLE);
+
     IrOp tb = build.inst(IrCmd::LOAD_TAG, build.vmReg(rb));
-    build.inst(IrCmd::CHECK_TAG, tb, build.constTag(LUA_TTABLE), fallback);
+    build.inst(IrCmd::CHECK_TAG, tb, build.constTag(LUA_TTABLE), speculate ? build.vmExit(pcpos) : fallback);
 
     IrOp vb = build.inst(IrCmd::LOAD_POINTER, build.vmReg(rb));
 
     IrOp addrSlotEl = build.inst(IrCmd::GET_SLOT_NODE_ADDR, vb, build.constUint(pcpos), build.vmConst(aux));
 
-    build.inst(IrCmd::CHECK_SLOT_MATCH, addrSlotEl, build.vmConst(aux), fallback);
+    IrOp next = build.blockAtInst(pcpos + 2);
 
-    IrOp tvn = build.inst(IrCmd::LOAD_TVALUE, addrSlotEl, build.constInt(offsetof(LuaNode, val)));
-    build.inst(IrCmd::STORE_TVALUE, build.vmReg(ra), tvn);
+    if (FFlag::LuauTableShapes)
+    {
+        IrOp nodeMatch = build.block(IrBlockKind::Internal);
+        IrOp shapePath = build.block(IrBlockKind::Internal);
+
+        // Both blocks define the same registers, so we use 'jump' version instead of 'check' guard (see translateInstNamecall)
+        build.inst(IrCmd::JUMP_SLOT_MATCH, addrSlotEl, build.vmConst(aux), nodeMatch, shapePath);
+
+        build.beginBlock(nodeMatch);
+        IrOp tvn = build.inst(IrCmd::LOAD_TVALUE, addrSlotEl, build.constInt(offsetof(LuaNode, val)));
+        build.inst(IrCmd::STORE_TVALUE, build.vmReg(ra), tvn);
+        build.inst(IrCmd::JUMP, next);
+
+        build.beginBlock(shapePath);
+        build.inst(IrCmd::CHECK_SHAPE_SLOT_MATCH, vb, build.constUint(pcpos), build.vmConst(aux), fallback);
+
+        IrOp addrShapeSlotEl = build.inst(IrCmd::GET_SHAPE_SLOT_ADDR, vb, build.constUint(pcpos));
+        IrOp tvs = build.inst(IrCmd::LOAD_TVALUE, addrShapeSlotEl, build.constInt(0));
+        build.inst(IrCmd::STORE_TVALUE, build.vmReg(ra), tvs);
+    }
+    else
+    {
+        build.inst(IrCmd::CHECK_SLOT_MATCH, addrSlotEl, build.vmConst(aux), fallback);
+
+        IrOp tvn = build.inst(IrCmd::LOAD_TVALUE, addrSlotEl, build.constInt(offsetof(LuaNode, val)));
+        build.inst(IrCmd::STORE_TVALUE, build.vmReg(ra), tvn);
+    }
 
-    IrOp next = build.blockAtInst(pcpos + 2);
     FallbackStreamScope scope(build, fallback, next);
 
     build.inst(IrCmd::FALLBACK_GETTABLEKS, build.constUint(pcpos), build.vmReg(ra), build.vmReg(rb), build.vmConst(aux));
@@ -1009,15 +1146,45 @@ void translateInstSetTableKS(IrBuilder& build, const Instruction* pc, int pcpos)
 
     IrOp addrSlotEl = build.inst(IrCmd::GET_SLOT_NODE_ADDR, vb, build.constUint(pcpos), build.vmConst(aux));
 
-    build.inst(IrCmd::CHECK_SLOT_MATCH, addrSlotEl, build.vmConst(aux), fallback);
-    build.inst(IrCmd::CHECK_READONLY, vb, fallback);
+    IrOp next = build.blockAtInst(pcpos + 2);
 
-    IrOp tva = build.inst(IrCmd::LOAD_TVALUE, build.vmReg(ra));
-    build.inst(IrCmd::STORE_TVALUE, addrSlotEl, tva, build.constInt(offsetof(LuaNode, val)));
+    if (FFlag::LuauTableShapes)
+    {
+        IrOp nodeMatch = build.block(IrBlockKind::Internal);
+        IrOp shapePath = build.block(IrBlockKind::Internal);
 
-    build.inst(IrCmd::BARRIER_TABLE_FORWARD, vb, build.vmReg(ra), build.undef());
+        build.inst(IrCmd::JUMP_SLOT_MATCH, addrSlotEl, build.vmConst(aux), nodeMatch, shapePath);
+
+        build.beginBlock(nodeMatch);
+        build.inst(IrCmd::CHECK_READONLY, vb, fallback);
+
+        IrOp tva = build.inst(IrCmd::LOAD_TVALUE, build.vmReg(ra));
+        build.inst(IrCmd::STORE_TVALUE, addrSlotEl, tva, build.constInt(offsetof(LuaNode, val)));
+
+        build.inst(IrCmd::BARRIER_TABLE_FORWARD, vb, build.vmReg(ra), build.undef());
+        build.inst(IrCmd::JUMP, next);
+
+        build.beginBlock(shapePath);
+        build.inst(IrCmd::CHECK_SHAPE_SLOT_MATCH, vb, build.constUint(pcpos), build.vmConst(aux), fallback);
+        build.inst(IrCmd::CHECK_READONLY, vb, fallback);
+
+        IrOp addrShapeSlotEl = build.inst(IrCmd::GET_SHAPE_SLOT_ADDR, vb, build.constUint(pcpos));
+        IrOp tvs = build.inst(IrCmd::LOAD_TVALUE, build.vmReg(ra));
+        build.inst(IrCmd::STORE_TVALUE, addrShapeSlotEl, tvs, build.constInt(0));
+
+        build.inst(IrCmd::BARRIER_TABLE_FORWARD, vb, build.vmReg(ra), build.undef());
+    }
+    else
+    {
+        build.inst(IrCmd::CHECK_SLOT_MATCH, addrSlotEl, build.vmConst(aux), fallback);
+        build.inst(IrCmd::CHECK_READONLY, vb, fallback);
+
+        IrOp tva = build.inst(IrCmd::LOAD_TVALUE, build.vmReg(ra));
+        build.inst(IrCmd::STORE_TVALUE, addrSlotEl, tva, build.constInt(offsetof(LuaNode, val)));
+
+        build.inst(IrCmd::BARRIER_TABLE_FORWARD, vb, build.vmReg(ra), build.undef());
+    }
 
-    IrOp next = build.blockAtInst(pcpos + 2);
     FallbackStreamScope scope(build, fallback, next);
 
     build.inst(IrCmd::FALLBACK_SETTABLEKS, build.constUint(pcpos), build.vmReg(ra), build.vmReg(rb), build.vmConst(aux));
@@ -1118,7 +1285,9 @@ void translateInstNamecall(IrBuilder& build, const Instruction* pc, int pcpos)
     IrOp firstFastPathSuccess = build.block(IrBlockKind::Internal);
     IrOp secondFastPath = build.block(IrBlockKind::Internal);
 
-    build.loadAndCheckTag(build.vmReg(rb), LUA_TTABLE, fallback);
+    bool speculate = canSpeculate(build, pcpos, LUA_TYPEPROFILE_NONTABLE);
+
+    build.loadAndCheckTag(build.vmReg(rb), LUA_TTABLE, speculate ? build.vmExit(pcpos) : fallback);
     IrOp table = build.inst(IrCmd::LOAD_POINTER, build.vmReg(rb));
 
     LUAU_ASSERT(build.function.proto);
@@ -1146,7 +1315,19 @@ void translateInstNamecall(IrBuilder& build, const Instruction* pc, int pcpos)
     IrOp index = build.inst(IrCmd::LOAD_POINTER, indexPtr);
 
     IrOp addrIndexNodeEl = build.inst(IrCmd::GET_SLOT_NODE_ADDR, index, build.constUint(pcpos), build.vmConst(aux));
-    build.inst(IrCmd::CHECK_SLOT_MATCH, addrIndexNodeEl, build.vmConst(aux), fallback);
+    IrOp indexShapePath = FFlag::LuauTableShapes ? build.block(IrBlockKind::Internal) : build.undef();
+
+    if (FFlag::LuauTableShapes)
+    {
+        IrOp indexNodeMatch = build.block(IrBlockKind::Internal);
+
+        build.inst(IrCmd::JUMP_SLOT_MATCH, addrIndexNodeEl, build.vmConst(aux), indexNodeMatch, indexShapePath);
+        build.beginBlock(indexNodeMatch);
+    }
+    else
+    {
+        build.inst(IrCmd::CHECK_SLOT_MATCH, addrIndexNodeEl, build.vmConst(aux), fallback);
+    }
 
     // TODO: original 'table' was clobbered by a call inside 'FASTGETTM'
     // Ideally, such calls should have to effect on SSA IR values, but simple register allocator doesn't support it
@@ -1158,6 +1339,21 @@ void translateInstNamecall(IrBuilder& build, const Instruction* pc, int pcpos)
     build.inst(IrCmd::STORE_TVALUE, build.vmReg(ra), indexNodeEl);
     build.inst(IrCmd::JUMP, next);
 
+    if (FFlag::LuauTableShapes)
+    {
+        build.beginBlock(indexShapePath);
+        build.inst(IrCmd::CHECK_SHAPE_SLOT_MATCH, index, build.constUint(pcpos), build.vmConst(aux), fallback);
+
+        IrOp table3 = build.inst(IrCmd::LOAD_POINTER, build.vmReg(rb));
+        build.inst(IrCmd::STORE_POINTER, build.vmReg(ra + 1), table3);
+        build.inst(IrCmd::STORE_TAG, build.vmReg(ra + 1), build.constTag(LUA_TTABLE));
+
+        IrOp addrIndexShapeSlotEl = build.inst(IrCmd::GET_SHAPE_SLOT_ADDR, index, build.constUint(pcpos));
+        IrOp indexShapeSlotEl = build.inst(IrCmd::LOAD_TVALUE, addrIndexShapeSlotEl, build.constInt(0));
+        build.inst(IrCmd::STORE_TVALUE, build.vmReg(ra), indexShapeSlotEl);
+        build.inst(IrCmd::JUMP, next);
+    }
+
     build.beginBlock(fallback);
     build.inst(IrCmd::FALLBACK_NAMECALL, build.constUint(pcpos), build.vmReg(ra), build.vmReg(rb), build.vmConst(aux));
     build.inst(IrCmd::JUMP, next);
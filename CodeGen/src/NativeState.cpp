@@ -51,6 +51,7 @@ void initFunctions(NativeState& data)
 
     data.context.luaH_getn = luaH_getn;
     data.context.luaH_new = luaH_new;
+    data.context.luaH_newshaped = luaH_newshaped;
     data.context.luaH_clone = luaH_clone;
     data.context.luaH_resizearray = luaH_resizearray;
     data.context.luaH_setnum = luaH_setnum;
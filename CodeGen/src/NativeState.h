@@ -3,9 +3,12 @@
 
 #include "Luau/Bytecode.h"
 #include "Luau/CodeAllocator.h"
+#include "Luau/CodeGen.h"
 #include "Luau/Label.h"
 
 #include <memory>
+#include <string>
+#include <vector>
 
 #include <stdint.h>
 
@@ -42,6 +45,7 @@ struct NativeContext
 
     int (*luaH_getn)(Table* t) = nullptr;
     Table* (*luaH_new)(lua_State* L, int narray, int lnhash) = nullptr;
+    Table* (*luaH_newshaped)(lua_State* L, int nkeys) = nullptr;
     Table* (*luaH_clone)(lua_State* L, Table* tt) = nullptr;
     void (*luaH_resizearray)(lua_State* L, Table* t, int nasize) = nullptr;
     TValue* (*luaH_setnum)(lua_State* L, Table* t, int key);
@@ -109,6 +113,33 @@ struct NativeContext
 
 using GateFn = int (*)(lua_State*, Proto*, uintptr_t, NativeContext*);
 
+// Functions compiled together share one allocation of data and code, since their code also calls the helpers assembled with them
+struct NativeModule
+{
+    uint8_t* allocation = nullptr; // from CodeAllocator::allocate, data is followed by code
+    size_t allocationSize = 0;
+    size_t codeOffset = 0;
+
+    std::vector<Proto*> protos; // entries are cleared when functions are destroyed; the allocation is released after the last one is gone
+    size_t liveProtos = 0;
+
+    uint64_t lastEntered = 0; // NativeState::entryClock when the VM last entered one of the functions
+    size_t index = 0;         // position in NativeState::modules
+    bool active = false;      // set while the module is pinned by a call frame, see markActiveModules
+};
+
+// Execution data of native functions starts with a header that is placed before the instruction offsets that proto->execdata points to
+struct NativeProtoHeader
+{
+    NativeModule* module;
+    uint32_t index; // in NativeModule::protos
+};
+
+inline NativeProtoHeader* getNativeProtoHeader(void* execdata)
+{
+    return reinterpret_cast<NativeProtoHeader*>(static_cast<uint8_t*>(execdata) - sizeof(NativeProtoHeader));
+}
+
 struct NativeState
 {
     NativeState();
@@ -121,6 +152,22 @@ struct NativeState
     uint8_t* gateData = nullptr;
     size_t gateDataSize = 0;
 
+    std::string cacheDirectory; // native code cache is disabled when empty, see setCodeCacheDirectory
+
+    bool emulatedA64 = false; // code is generated for A64 and runs in the emulator from EmulatorA64.h, see createA64Emulation
+
+    std::vector<std::unique_ptr<NativeModule>> modules;
+    uint64_t entryClock = 0;
+
+    size_t codeLimit = 0; // modules are evicted when their total allocation size would exceed it, see setNativeCodeLimit
+    size_t codeUsed = 0;
+
+    // allocations that skip eviction after one that failed to make room; the backoff doubles with each failure, see allocateModule
+    unsigned reclaimSkips = 0;
+    unsigned reclaimBackoff = 0;
+
+    TieringStats tieringStats;
+
     NativeContext context;
 };
 
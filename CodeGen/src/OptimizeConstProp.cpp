@@ -636,6 +636,10 @@ static void constPropInInst(ConstPropState& state, IrBuilder& build, IrFunction&
             uint8_t tag = state.tryGetTag(inst.b);
             IrOp value = state.tryGetValue(inst.b);
 
+            // Vector values computed in registers have a known tag
+            if (IrInst* arg = function.asInstOp(inst.b); arg && arg->cmd == IrCmd::TAG_VECTOR)
+                tag = LUA_TVECTOR;
+
             if (inst.a.kind == IrOpKind::VmReg)
             {
                 if (tag != 0xff)
@@ -910,6 +914,7 @@ static void constPropInInst(ConstPropState& state, IrBuilder& build, IrFunction&
             state.getSlotNodeCache.push_back(index);
         break;
     case IrCmd::GET_HASH_NODE_ADDR:
+    case IrCmd::GET_SHAPE_SLOT_ADDR:
     case IrCmd::GET_CLOSURE_UPVAL_ADDR:
         break;
     case IrCmd::ADD_INT:
@@ -928,6 +933,13 @@ static void constPropInInst(ConstPropState& state, IrBuilder& build, IrFunction&
     case IrCmd::ROUND_NUM:
     case IrCmd::SQRT_NUM:
     case IrCmd::ABS_NUM:
+    case IrCmd::ADD_VEC:
+    case IrCmd::SUB_VEC:
+    case IrCmd::MUL_VEC:
+    case IrCmd::DIV_VEC:
+    case IrCmd::UNM_VEC:
+    case IrCmd::NUM_TO_VEC:
+    case IrCmd::TAG_VECTOR:
     case IrCmd::NOT_ANY:
         state.substituteOrRecord(inst, index);
         break;
@@ -1006,8 +1018,10 @@ static void constPropInInst(ConstPropState& state, IrBuilder& build, IrFunction&
         if (int(state.checkSlotMatchCache.size()) < FInt::LuauCodeGenReuseSlotLimit)
             state.checkSlotMatchCache.push_back(index);
         break;
+    case IrCmd::CHECK_SHAPE_SLOT_MATCH:
     case IrCmd::CHECK_NODE_NO_NEXT:
     case IrCmd::CHECK_NODE_VALUE:
+    case IrCmd::CHECK_NO_INTERRUPT:
     case IrCmd::BARRIER_TABLE_BACK:
     case IrCmd::RETURN:
     case IrCmd::COVERAGE:
@@ -1207,7 +1221,7 @@ static void constPropInBlockChain(IrBuilder& build, std::vector<uint8_t>& visite
             IrBlock& target = function.blockOp(termInst.a);
             uint32_t targetIdx = function.getBlockIndex(target);
 
-            if (target.useCount == 1 && !visited[targetIdx] && target.kind != IrBlockKind::Fallback)
+            if (target.useCount == 1 && !visited[targetIdx] && target.kind != IrBlockKind::Fallback && !target.loopEntry)
             {
                 // Make sure block ordering guarantee is checked at lowering time
                 block->expectedNextBlock = function.getBlockIndex(target);
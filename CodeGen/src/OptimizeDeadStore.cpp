@@ -0,0 +1,418 @@
+// This file is part of the Luau programming language and is licensed under MIT License; see LICENSE.txt for details
+#include "Luau/OptimizeDeadStore.h"
+
+#include "Luau/IrAnalysis.h"
+#include "Luau/IrBuilder.h"
+#include "Luau/IrUtils.h"
+
+#include "lobject.h"
+
+#include <vector>
+
+// The pass tracks stores into VM registers that haven't been observed yet along a chain of blocks (blocks with a single predecessor that are
+// placed one after another). A store is removed when all parts of the register it has written are overwritten before anything could read
+// them, or when the chain ends and the register is not live in any of the successors.
+// VM state has to be complete whenever native code can leave to the VM or call into code that can observe it: VM exits, interrupts and calls
+// read all registers and keep all stores above them. Blocks from which a VM exit is reachable are also considered to read all registers.
+// Guards that jump into fallback blocks only keep the registers that are live in the fallback. GC can only run inside instructions that read
+// all registers, so the tag and the value in the register memory stay consistent.
+
+namespace Luau
+{
+namespace CodeGen
+{
+
+// Parts of a register TValue that are written separately
+constexpr uint8_t kPartTag = 1 << 0;
+constexpr uint8_t kPartValueLow = 1 << 1;
+constexpr uint8_t kPartValueHigh = 1 << 2;
+constexpr uint8_t kPartExtra = 1 << 3;
+
+constexpr uint8_t kPartValue = kPartValueLow | kPartValueHigh;
+constexpr uint8_t kPartAll = kPartTag | kPartValue | kPartExtra;
+
+struct PendingStore
+{
+    uint32_t instIdx;
+    uint8_t reg;
+
+    // Parts written by the store that haven't been overwritten yet
+    uint8_t parts;
+};
+
+struct RemoveDeadStoreState
+{
+    RemoveDeadStoreState(IrFunction& function)
+        : function(function)
+    {
+    }
+
+    void removeStores(uint8_t reg)
+    {
+        for (size_t i = 0; i < pending.size();)
+        {
+            if (pending[i].reg == reg)
+            {
+                pending[i] = pending.back();
+                pending.pop_back();
+            }
+            else
+            {
+                i++;
+            }
+        }
+    }
+
+    void def(uint8_t reg, uint8_t parts, uint32_t instIdx)
+    {
+        // Captured registers can be read through the upvalue, we don't track them
+        if (function.cfg.captured.regs.test(reg))
+            return;
+
+        for (size_t i = 0; i < pending.size();)
+        {
+            PendingStore& store = pending[i];
+
+            if (store.reg == reg)
+                store.parts &= ~parts;
+
+            if (store.reg == reg && store.parts == 0)
+            {
+                kill(function, function.instructions[store.instIdx]);
+
+                pending[i] = pending.back();
+                pending.pop_back();
+            }
+            else
+            {
+                i++;
+            }
+        }
+
+        pending.push_back({instIdx, reg, parts});
+    }
+
+    void use(IrOp op)
+    {
+        if (op.kind == IrOpKind::VmReg)
+            removeStores(vmRegOp(op));
+    }
+
+    void useRange(int start, int count)
+    {
+        int end = count == -1 ? 255 : start + count - 1;
+
+        for (size_t i = 0; i < pending.size();)
+        {
+            if (pending[i].reg >= start && pending[i].reg <= end)
+            {
+                pending[i] = pending.back();
+                pending.pop_back();
+            }
+            else
+            {
+                i++;
+            }
+        }
+    }
+
+    void useAll()
+    {
+        pending.clear();
+    }
+
+    void useLiveIns(IrOp target)
+    {
+        // Liveness is not available for blocks that were created after the analysis
+        // It also doesn't cover the registers that the VM reads when native code exits to it, so any register can be read if an exit is reachable
+        if (target.index >= function.cfg.in.size() || reachesVmExit[target.index])
+        {
+            useAll();
+            return;
+        }
+
+        const RegisterSet& in = function.cfg.in[target.index];
+
+        for (size_t i = 0; i < pending.size();)
+        {
+            uint8_t reg = pending[i].reg;
+
+            if (in.regs.test(reg) || (in.varargSeq && reg >= in.varargStart))
+            {
+                pending[i] = pending.back();
+                pending.pop_back();
+            }
+            else
+            {
+                i++;
+            }
+        }
+    }
+
+    // Exits to a block keep the registers that are live in it, exits to the VM keep everything
+    void useExit(IrOp op)
+    {
+        if (op.kind == IrOpKind::Block)
+            useLiveIns(op);
+        else if (op.kind == IrOpKind::VmExit)
+            useAll();
+    }
+
+    void useExits(const IrInst& inst)
+    {
+        useExit(inst.a);
+        useExit(inst.b);
+        useExit(inst.c);
+        useExit(inst.d);
+        useExit(inst.e);
+        useExit(inst.f);
+    }
+
+    // Remaining stores are not observed on any path
+    void killPending()
+    {
+        for (const PendingStore& store : pending)
+            kill(function, function.instructions[store.instIdx]);
+
+        pending.clear();
+    }
+
+    IrFunction& function;
+
+    std::vector<uint8_t> reachesVmExit;
+
+    std::vector<PendingStore> pending;
+};
+
+static void markDeadStoresInInst(RemoveDeadStoreState& state, IrFunction& function, uint32_t index)
+{
+    IrInst& inst = function.instructions[index];
+
+    switch (inst.cmd)
+    {
+    case IrCmd::STORE_TAG:
+        if (inst.a.kind == IrOpKind::VmReg)
+            state.def(vmRegOp(inst.a), kPartTag, index);
+        break;
+    case IrCmd::STORE_POINTER:
+    case IrCmd::STORE_DOUBLE:
+        if (inst.a.kind == IrOpKind::VmReg)
+            state.def(vmRegOp(inst.a), kPartValue, index);
+        break;
+    case IrCmd::STORE_INT:
+        if (inst.a.kind == IrOpKind::VmReg)
+            state.def(vmRegOp(inst.a), kPartValueLow, index);
+        break;
+    case IrCmd::STORE_VECTOR:
+        if (inst.a.kind == IrOpKind::VmReg)
+            state.def(vmRegOp(inst.a), kPartValue | kPartExtra, index);
+        break;
+    case IrCmd::STORE_TVALUE:
+        if (inst.a.kind == IrOpKind::VmReg)
+            state.def(vmRegOp(inst.a), kPartAll, index);
+        break;
+    case IrCmd::STORE_SPLIT_TVALUE:
+        if (inst.a.kind == IrOpKind::VmReg)
+            state.def(vmRegOp(inst.a), function.tagOp(inst.b) == LUA_TBOOLEAN ? kPartTag | kPartValueLow : kPartTag | kPartValue, index);
+        break;
+    case IrCmd::LOAD_TAG:
+    case IrCmd::LOAD_POINTER:
+    case IrCmd::LOAD_DOUBLE:
+    case IrCmd::LOAD_INT:
+    case IrCmd::LOAD_TVALUE:
+        state.use(inst.a);
+        break;
+
+        // Instructions that don't read VM registers and don't leave native code
+    case IrCmd::NOP:
+    case IrCmd::SUBSTITUTE:
+    case IrCmd::LOAD_ENV:
+    case IrCmd::GET_ARR_ADDR:
+    case IrCmd::GET_SLOT_NODE_ADDR:
+    case IrCmd::GET_HASH_NODE_ADDR:
+    case IrCmd::GET_SHAPE_SLOT_ADDR:
+    case IrCmd::GET_CLOSURE_UPVAL_ADDR:
+    case IrCmd::ADD_INT:
+    case IrCmd::SUB_INT:
+    case IrCmd::ADD_NUM:
+    case IrCmd::SUB_NUM:
+    case IrCmd::MUL_NUM:
+    case IrCmd::DIV_NUM:
+    case IrCmd::IDIV_NUM:
+    case IrCmd::MOD_NUM:
+    case IrCmd::MIN_NUM:
+    case IrCmd::MAX_NUM:
+    case IrCmd::UNM_NUM:
+    case IrCmd::FLOOR_NUM:
+    case IrCmd::CEIL_NUM:
+    case IrCmd::ROUND_NUM:
+    case IrCmd::SQRT_NUM:
+    case IrCmd::ABS_NUM:
+    case IrCmd::ADD_VEC:
+    case IrCmd::SUB_VEC:
+    case IrCmd::MUL_VEC:
+    case IrCmd::DIV_VEC:
+    case IrCmd::UNM_VEC:
+    case IrCmd::NUM_TO_VEC:
+    case IrCmd::TAG_VECTOR:
+    case IrCmd::NOT_ANY:
+    case IrCmd::TABLE_LEN:
+    case IrCmd::STRING_LEN:
+    case IrCmd::INT_TO_NUM:
+    case IrCmd::UINT_TO_NUM:
+    case IrCmd::NUM_TO_INT:
+    case IrCmd::NUM_TO_UINT:
+    case IrCmd::SET_SAVEDPC:
+    case IrCmd::COVERAGE:
+    case IrCmd::BITAND_UINT:
+    case IrCmd::BITXOR_UINT:
+    case IrCmd::BITOR_UINT:
+    case IrCmd::BITNOT_UINT:
+    case IrCmd::BITLSHIFT_UINT:
+    case IrCmd::BITRSHIFT_UINT:
+    case IrCmd::BITARSHIFT_UINT:
+    case IrCmd::BITLROTATE_UINT:
+    case IrCmd::BITRROTATE_UINT:
+    case IrCmd::BITCOUNTLZ_UINT:
+    case IrCmd::BITCOUNTRZ_UINT:
+    case IrCmd::INVOKE_LIBM:
+    case IrCmd::GET_TYPE:
+        break;
+
+    case IrCmd::TRY_NUM_TO_INDEX:
+    case IrCmd::TRY_CALL_FASTGETTM:
+    case IrCmd::CHECK_FASTCALL_RES:
+    case IrCmd::CHECK_TAG:
+    case IrCmd::CHECK_TRUTHY:
+    case IrCmd::CHECK_READONLY:
+    case IrCmd::CHECK_NO_METATABLE:
+    case IrCmd::CHECK_SAFE_ENV:
+    case IrCmd::CHECK_ARRAY_SIZE:
+    case IrCmd::CHECK_SLOT_MATCH:
+    case IrCmd::CHECK_SHAPE_SLOT_MATCH:
+    case IrCmd::CHECK_NODE_NO_NEXT:
+    case IrCmd::CHECK_NODE_VALUE:
+    case IrCmd::CHECK_NO_INTERRUPT:
+        state.useExits(inst);
+        break;
+
+    case IrCmd::JUMP:
+    case IrCmd::JUMP_IF_TRUTHY:
+    case IrCmd::JUMP_IF_FALSY:
+    case IrCmd::JUMP_EQ_TAG:
+    case IrCmd::JUMP_EQ_INT:
+    case IrCmd::JUMP_LT_INT:
+    case IrCmd::JUMP_GE_UINT:
+    case IrCmd::JUMP_EQ_POINTER:
+    case IrCmd::JUMP_CMP_NUM:
+    case IrCmd::JUMP_SLOT_MATCH:
+        state.use(inst.a);
+        state.use(inst.b);
+        state.useExits(inst);
+
+        state.killPending();
+        break;
+    case IrCmd::RETURN:
+        // Registers outside of the returned range are not observable after the frame is gone
+        if (inst.a.kind == IrOpKind::VmReg)
+            state.useRange(vmRegOp(inst.a), function.intOp(inst.b));
+        else
+            state.useAll();
+
+        state.killPending();
+        break;
+
+    default:
+        // Other instructions can read VM registers, leave native code or call into code that can observe VM state
+        state.useAll();
+        break;
+    }
+}
+
+static void markDeadStoresInBlockChain(RemoveDeadStoreState& state, IrFunction& function, IrBlock* block)
+{
+    state.useAll();
+
+    while (block)
+    {
+        IrInst& termInst = function.instructions[block->finish];
+
+        // Blocks in a chain are entered only from the previous block, so unobserved stores can be carried into the next one
+        bool continues = block->expectedNextBlock != ~0u && termInst.cmd == IrCmd::JUMP && termInst.a.kind == IrOpKind::Block &&
+                         termInst.a.index == block->expectedNextBlock;
+
+        uint32_t end = continues ? block->finish : block->finish + 1;
+
+        for (uint32_t index = block->start; index < end; index++)
+        {
+            LUAU_ASSERT(index < function.instructions.size());
+
+            markDeadStoresInInst(state, function, index);
+        }
+
+        block = continues ? &function.blocks[block->expectedNextBlock] : nullptr;
+    }
+}
+
+void markDeadStoresInBlockChains(IrBuilder& build)
+{
+    IrFunction& function = build.function;
+
+    std::vector<uint8_t> chainContinuation(function.blocks.size(), false);
+
+    for (IrBlock& block : function.blocks)
+    {
+        if (block.kind != IrBlockKind::Dead && block.expectedNextBlock != ~0u)
+            chainContinuation[block.expectedNextBlock] = true;
+    }
+
+    RemoveDeadStoreState state{function};
+
+    // Find the blocks from which execution can exit to the VM
+    state.reachesVmExit.resize(function.blocks.size(), false);
+
+    for (bool changed = true; changed;)
+    {
+        changed = false;
+
+        for (size_t i = 0; i < function.blocks.size(); i++)
+        {
+            IrBlock& block = function.blocks[i];
+
+            if (block.kind == IrBlockKind::Dead || state.reachesVmExit[i])
+                continue;
+
+            auto check = [&](IrOp op) {
+                return op.kind == IrOpKind::VmExit || (op.kind == IrOpKind::Block && state.reachesVmExit[op.index]);
+            };
+
+            for (uint32_t index = block.start; index <= block.finish; index++)
+            {
+                IrInst& inst = function.instructions[index];
+
+                if (check(inst.a) || check(inst.b) || check(inst.c) || check(inst.d) || check(inst.e) || check(inst.f))
+                {
+                    state.reachesVmExit[i] = true;
+                    changed = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    for (size_t i = 0; i < function.blocks.size(); i++)
+    {
+        IrBlock& block = function.blocks[i];
+
+        if (block.kind == IrBlockKind::Fallback || block.kind == IrBlockKind::Dead)
+            continue;
+
+        if (chainContinuation[i])
+            continue;
+
+        markDeadStoresInBlockChain(state, function, &block);
+    }
+}
+
+} // namespace CodeGen
+} // namespace Luau
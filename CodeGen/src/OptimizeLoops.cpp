@@ -0,0 +1,775 @@
+// This file is part of the Luau programming language and is licensed under MIT License; see LICENSE.txt for details
+#include "Luau/OptimizeLoops.h"
+
+#include "Luau/IrAnalysis.h"
+#include "Luau/IrBuilder.h"
+#include "Luau/IrUtils.h"
+
+#include "lobject.h"
+
+#include <algorithm>
+#include <bitset>
+#include <utility>
+#include <vector>
+
+// Loop-invariant guards can't simply be moved out of the loop body: loop back edges run the interrupt handler, fallbacks in the body can call
+// user code and the interpreter can enter native code at the loop latch, skipping anything placed before the loop.
+// Instead, the loop is versioned. Blocks on the main path of the loop body are cloned and guards that check loop-invariant facts are removed
+// from the copy. All edges into the loop header are redirected to a preheader that checks these facts once and enters the copy on success,
+// or the original loop on failure.
+// The copy only contains instructions that can't call user code, change metatables or resize tables, so the facts are preserved by it.
+// Fallbacks of the copy are shared with the original loop, the copy of the latch goes to the original latch when an interrupt handler is
+// installed and original latch jumps to the preheader, which means that the copy is entered again only after all facts are checked.
+// For numeric for loops with a step of 1, loop variable is an integer in the range that is checked by the preheader. This replaces array bound
+// checks that use loop variable as an index with a single check of the loop limit.
+
+namespace Luau
+{
+namespace CodeGen
+{
+
+// Loop copies increase the code size, so only small loops are versioned
+constexpr uint32_t kMaxVersionedLoopSize = 256;
+
+struct LoopInfo
+{
+    uint32_t header = ~0u;
+    uint32_t latch = ~0u;
+
+    // Blocks with the back edge into the header
+    std::vector<uint32_t> backEdges;
+
+    // Numeric for loop registers (limit, step and loop variable follow each other), -1 for other loops
+    int forReg = -1;
+    uint32_t reverseBlock = ~0u;
+
+    // Blocks that are cloned, in the order of their instructions
+    std::vector<uint32_t> blocks;
+
+    // Registers that are written to by the loop blocks
+    std::bitset<256> tagWritten;
+    std::bitset<256> valueWritten;
+    bool loopVarWritten = false;
+};
+
+struct LoopFacts
+{
+    // Register and its tag
+    std::vector<std::pair<uint8_t, uint8_t>> tags;
+
+    std::bitset<256> noMetatable;
+    std::bitset<256> notReadonly;
+
+    // Table register and the array index that is known to be in bounds
+    std::vector<std::pair<uint8_t, int>> arraySizes;
+
+    // Table registers that have array elements for every value of the loop variable
+    std::bitset<256> arrayRange;
+
+    // Loop variable is an integer value and the step is 1
+    bool loopVarRange = false;
+
+    bool empty() const
+    {
+        return tags.empty() && !loopVarRange;
+    }
+};
+
+static int getLoadedReg(IrFunction& function, IrOp op, IrCmd cmd)
+{
+    IrInst* inst = function.asInstOp(op);
+
+    if (!inst || inst->cmd != cmd || inst->a.kind != IrOpKind::VmReg)
+        return -1;
+
+    return vmRegOp(inst->a);
+}
+
+static bool isLoopVarToIndex(IrFunction& function, const LoopInfo& loop, const IrInst& inst)
+{
+    return loop.forReg >= 0 && inst.cmd == IrCmd::TRY_NUM_TO_INDEX && getLoadedReg(function, inst.a, IrCmd::LOAD_DOUBLE) == loop.forReg + 2;
+}
+
+// Zero-based array index computed from the loop variable
+static bool isLoopVarArrayIndex(IrFunction& function, const LoopInfo& loop, IrOp op)
+{
+    IrInst* inst = function.asInstOp(op);
+
+    if (!inst || inst->cmd != IrCmd::SUB_INT || function.asIntOp(inst->b) != 1)
+        return false;
+
+    IrInst* index = function.asInstOp(inst->a);
+    return index && isLoopVarToIndex(function, loop, *index);
+}
+
+static bool isVersionableInst(IrCmd cmd)
+{
+    switch (cmd)
+    {
+    case IrCmd::NOP:
+    case IrCmd::LOAD_TAG:
+    case IrCmd::LOAD_POINTER:
+    case IrCmd::LOAD_DOUBLE:
+    case IrCmd::LOAD_INT:
+    case IrCmd::LOAD_TVALUE:
+    case IrCmd::LOAD_ENV:
+    case IrCmd::GET_ARR_ADDR:
+    case IrCmd::GET_SLOT_NODE_ADDR:
+    case IrCmd::GET_HASH_NODE_ADDR:
+    case IrCmd::GET_SHAPE_SLOT_ADDR:
+    case IrCmd::GET_CLOSURE_UPVAL_ADDR:
+    case IrCmd::STORE_TAG:
+    case IrCmd::STORE_POINTER:
+    case IrCmd::STORE_DOUBLE:
+    case IrCmd::STORE_INT:
+    case IrCmd::STORE_VECTOR:
+    case IrCmd::STORE_TVALUE:
+    case IrCmd::STORE_SPLIT_TVALUE:
+    case IrCmd::ADD_INT:
+    case IrCmd::SUB_INT:
+    case IrCmd::ADD_NUM:
+    case IrCmd::SUB_NUM:
+    case IrCmd::MUL_NUM:
+    case IrCmd::DIV_NUM:
+    case IrCmd::IDIV_NUM:
+    case IrCmd::MOD_NUM:
+    case IrCmd::MIN_NUM:
+    case IrCmd::MAX_NUM:
+    case IrCmd::UNM_NUM:
+    case IrCmd::FLOOR_NUM:
+    case IrCmd::CEIL_NUM:
+    case IrCmd::ROUND_NUM:
+    case IrCmd::SQRT_NUM:
+    case IrCmd::ABS_NUM:
+    case IrCmd::ADD_VEC:
+    case IrCmd::SUB_VEC:
+    case IrCmd::MUL_VEC:
+    case IrCmd::DIV_VEC:
+    case IrCmd::UNM_VEC:
+    case IrCmd::NUM_TO_VEC:
+    case IrCmd::TAG_VECTOR:
+    case IrCmd::NOT_ANY:
+    case IrCmd::JUMP:
+    case IrCmd::JUMP_IF_TRUTHY:
+    case IrCmd::JUMP_IF_FALSY:
+    case IrCmd::JUMP_EQ_TAG:
+    case IrCmd::JUMP_EQ_INT:
+    case IrCmd::JUMP_LT_INT:
+    case IrCmd::JUMP_GE_UINT:
+    case IrCmd::JUMP_EQ_POINTER:
+    case IrCmd::JUMP_CMP_NUM:
+    case IrCmd::JUMP_SLOT_MATCH:
+    case IrCmd::TABLE_LEN:
+    case IrCmd::STRING_LEN:
+    case IrCmd::TRY_NUM_TO_INDEX:
+    case IrCmd::INT_TO_NUM:
+    case IrCmd::UINT_TO_NUM:
+    case IrCmd::NUM_TO_INT:
+    case IrCmd::NUM_TO_UINT:
+    case IrCmd::GET_UPVALUE:
+    case IrCmd::CHECK_TAG:
+    case IrCmd::CHECK_TRUTHY:
+    case IrCmd::CHECK_READONLY:
+    case IrCmd::CHECK_NO_METATABLE:
+    case IrCmd::CHECK_SAFE_ENV:
+    case IrCmd::CHECK_ARRAY_SIZE:
+    case IrCmd::CHECK_SLOT_MATCH:
+    case IrCmd::CHECK_SHAPE_SLOT_MATCH:
+    case IrCmd::CHECK_NODE_NO_NEXT:
+    case IrCmd::CHECK_NODE_VALUE:
+    case IrCmd::BARRIER_OBJ:
+    case IrCmd::BARRIER_TABLE_BACK:
+    case IrCmd::BARRIER_TABLE_FORWARD:
+    case IrCmd::SET_SAVEDPC:
+    case IrCmd::BITAND_UINT:
+    case IrCmd::BITXOR_UINT:
+    case IrCmd::BITOR_UINT:
+    case IrCmd::BITNOT_UINT:
+    case IrCmd::BITLSHIFT_UINT:
+    case IrCmd::BITRSHIFT_UINT:
+    case IrCmd::BITARSHIFT_UINT:
+    case IrCmd::BITLROTATE_UINT:
+    case IrCmd::BITRROTATE_UINT:
+    case IrCmd::BITCOUNTLZ_UINT:
+    case IrCmd::BITCOUNTRZ_UINT:
+    case IrCmd::INVOKE_LIBM:
+    case IrCmd::GET_TYPE:
+        return true;
+    default:
+        break;
+    }
+
+    return false;
+}
+
+static void recordRegisterWrites(LoopInfo& loop, const IrInst& inst)
+{
+    if (inst.a.kind != IrOpKind::VmReg)
+        return;
+
+    int reg = vmRegOp(inst.a);
+
+    switch (inst.cmd)
+    {
+    case IrCmd::STORE_TAG:
+        loop.tagWritten.set(reg);
+        break;
+    case IrCmd::STORE_POINTER:
+    case IrCmd::STORE_DOUBLE:
+    case IrCmd::STORE_INT:
+    case IrCmd::STORE_VECTOR:
+        loop.valueWritten.set(reg);
+        break;
+    case IrCmd::STORE_TVALUE:
+    case IrCmd::STORE_SPLIT_TVALUE:
+    case IrCmd::GET_UPVALUE:
+        loop.tagWritten.set(reg);
+        loop.valueWritten.set(reg);
+        break;
+    default:
+        break;
+    }
+}
+
+// Latch is a block that starts with an interrupt and jumps back to the loop header
+static bool findLoopLatch(IrFunction& function, uint32_t latchIdx, LoopInfo& loop)
+{
+    IrBlock& latch = function.blocks[latchIdx];
+
+    if (latch.kind == IrBlockKind::Dead || latch.kind == IrBlockKind::Fallback || !latch.loopEntry)
+        return false;
+
+    if (function.instructions[latch.start].cmd != IrCmd::INTERRUPT)
+        return false;
+
+    IrInst& term = function.instructions[latch.finish];
+
+    // JUMPBACK
+    if (latch.finish == latch.start + 1 && term.cmd == IrCmd::JUMP && term.a.kind == IrOpKind::Block)
+    {
+        loop.latch = latchIdx;
+        loop.header = term.a.index;
+        loop.backEdges.push_back(latchIdx);
+        return true;
+    }
+
+    // FORNLOOP: limit, step and loop variable are loaded, loop variable is updated and step sign selects one of the two comparisons
+    if (latch.finish != latch.start + 6 || term.cmd != IrCmd::JUMP_CMP_NUM || term.d.kind != IrOpKind::Block || term.e.kind != IrOpKind::Block)
+        return false;
+
+    IrInst& store = function.instructions[latch.finish - 1];
+
+    if (store.cmd != IrCmd::STORE_DOUBLE || store.a.kind != IrOpKind::VmReg || vmRegOp(store.a) < 2)
+        return false;
+
+    int forReg = vmRegOp(store.a) - 2;
+
+    if (getLoadedReg(function, term.a, IrCmd::LOAD_DOUBLE) != forReg + 1 || function.asDoubleOp(term.b) != 0.0 ||
+        conditionOp(term.c) != IrCondition::LessEqual)
+        return false;
+
+    IrBlock& reverse = function.blockOp(term.d);
+    IrBlock& direct = function.blockOp(term.e);
+
+    if (reverse.start != reverse.finish || direct.start != direct.finish)
+        return false;
+
+    IrInst& reverseCmp = function.instructions[reverse.finish];
+    IrInst& directCmp = function.instructions[direct.finish];
+
+    if (reverseCmp.cmd != IrCmd::JUMP_CMP_NUM || directCmp.cmd != IrCmd::JUMP_CMP_NUM || reverseCmp.d.kind != IrOpKind::Block ||
+        reverseCmp.d != directCmp.d || reverseCmp.e != directCmp.e)
+        return false;
+
+    loop.latch = latchIdx;
+    loop.header = directCmp.d.index;
+    loop.backEdges.push_back(term.d.index);
+    loop.backEdges.push_back(term.e.index);
+    loop.forReg = forReg;
+    loop.reverseBlock = term.d.index;
+    return true;
+}
+
+static bool findLoopBlocks(IrFunction& function, LoopInfo& loop)
+{
+    CfgInfo& cfg = function.cfg;
+
+    if (loop.header == loop.latch || function.blocks[loop.header].loopEntry || function.blocks[loop.header].kind == IrBlockKind::Fallback)
+        return false;
+
+    // Natural loop of the back edges consists of the blocks that can reach them without going through the header
+    std::vector<uint8_t> inLoop(function.blocks.size(), false);
+    std::vector<uint32_t> worklist;
+
+    inLoop[loop.header] = true;
+
+    for (uint32_t blockIdx : loop.backEdges)
+    {
+        if (!inLoop[blockIdx])
+        {
+            inLoop[blockIdx] = true;
+            worklist.push_back(blockIdx);
+        }
+    }
+
+    while (!worklist.empty())
+    {
+        uint32_t blockIdx = worklist.back();
+        worklist.pop_back();
+
+        for (uint32_t predIdx : predecessors(cfg, blockIdx))
+        {
+            if (!inLoop[predIdx])
+            {
+                inLoop[predIdx] = true;
+                worklist.push_back(predIdx);
+            }
+        }
+    }
+
+    for (uint32_t predIdx : predecessors(cfg, loop.header))
+    {
+        // Other jumps back to the header would bypass the latch
+        if (inLoop[predIdx] && std::find(loop.backEdges.begin(), loop.backEdges.end(), predIdx) == loop.backEdges.end())
+            return false;
+    }
+
+    for (size_t i = 0; i < function.blocks.size(); i++)
+    {
+        if (!inLoop[i])
+            continue;
+
+        // Loop has to be entered through the header
+        if (!dominates(cfg, loop.header, uint32_t(i)))
+            return false;
+
+        IrBlockKind kind = function.blocks[i].kind;
+
+        if (kind != IrBlockKind::Fallback && kind != IrBlockKind::Dead && i != loop.reverseBlock)
+            loop.blocks.push_back(uint32_t(i));
+    }
+
+    std::sort(loop.blocks.begin(), loop.blocks.end(), [&](uint32_t a, uint32_t b) {
+        return function.blocks[a].start < function.blocks[b].start;
+    });
+
+    // Check that the copy can be made and that it preserves the facts checked by the preheader
+    std::vector<uint8_t> instInLoop(function.instructions.size(), false);
+    uint32_t size = 0;
+
+    for (uint32_t blockIdx : loop.blocks)
+    {
+        IrBlock& block = function.blocks[blockIdx];
+
+        for (uint32_t index = block.start; index <= block.finish; index++)
+            instInLoop[index] = true;
+
+        size += block.finish - block.start + 1;
+    }
+
+    if (size > kMaxVersionedLoopSize)
+        return false;
+
+    auto isLocalValue = [&](IrOp op) {
+        return op.kind != IrOpKind::Inst || instInLoop[op.index];
+    };
+
+    for (uint32_t blockIdx : loop.blocks)
+    {
+        IrBlock& block = function.blocks[blockIdx];
+
+        for (uint32_t index = block.start; index <= block.finish; index++)
+        {
+            IrInst& inst = function.instructions[index];
+
+            // Latch interrupt is replaced in the copy
+            if (index == function.blocks[loop.latch].start)
+                continue;
+
+            if (!isVersionableInst(inst.cmd))
+                return false;
+
+            if (!isLocalValue(inst.a) || !isLocalValue(inst.b) || !isLocalValue(inst.c) || !isLocalValue(inst.d) || !isLocalValue(inst.e) ||
+                !isLocalValue(inst.f))
+                return false;
+
+            if (blockIdx != loop.latch)
+                recordRegisterWrites(loop, inst);
+        }
+    }
+
+    if (loop.forReg >= 0)
+    {
+        loop.loopVarWritten = loop.tagWritten.test(loop.forReg + 2) || loop.valueWritten.test(loop.forReg + 2);
+
+        // Latch updates the value of the loop variable
+        loop.valueWritten.set(loop.forReg + 2);
+    }
+
+    return true;
+}
+
+static bool isInvariantReg(IrFunction& function, const LoopInfo& loop, int reg)
+{
+    return reg >= 0 && !loop.tagWritten.test(reg) && !loop.valueWritten.test(reg) && !function.cfg.captured.regs.test(reg);
+}
+
+static bool hasTag(const LoopFacts& facts, int reg, uint8_t tag)
+{
+    return std::find(facts.tags.begin(), facts.tags.end(), std::make_pair(uint8_t(reg), tag)) != facts.tags.end();
+}
+
+static bool canCheckLoopRange(IrFunction& function, const LoopInfo& loop)
+{
+    if (loop.forReg < 0 || loop.loopVarWritten)
+        return false;
+
+    return isInvariantReg(function, loop, loop.forReg) && isInvariantReg(function, loop, loop.forReg + 1) &&
+           !function.cfg.captured.regs.test(loop.forReg + 2);
+}
+
+static void collectLoopFacts(IrFunction& function, const LoopInfo& loop, LoopFacts& facts)
+{
+    CfgInfo& cfg = function.cfg;
+
+    // Only the guards that are executed on every iteration are hoisted, these are in the blocks that dominate the latch
+    std::vector<uint32_t> dominators;
+
+    for (uint32_t blockIdx = cfg.idoms[loop.latch]; blockIdx != ~0u; blockIdx = cfg.idoms[blockIdx])
+    {
+        if (function.blocks[blockIdx].kind != IrBlockKind::Fallback)
+            dominators.push_back(blockIdx);
+
+        if (blockIdx == loop.header)
+            break;
+    }
+
+    std::sort(dominators.begin(), dominators.end(), [&](uint32_t a, uint32_t b) {
+        return function.blocks[a].start < function.blocks[b].start;
+    });
+
+    bool loopRange = canCheckLoopRange(function, loop);
+
+    for (uint32_t blockIdx : dominators)
+    {
+        IrBlock& block = function.blocks[blockIdx];
+
+        for (uint32_t index = block.start; index <= block.finish; index++)
+        {
+            IrInst& inst = function.instructions[index];
+
+            switch (inst.cmd)
+            {
+            case IrCmd::CHECK_TAG:
+            {
+                int reg = getLoadedReg(function, inst.a, IrCmd::LOAD_TAG);
+
+                if (reg < 0 || loop.tagWritten.test(reg) || cfg.captured.regs.test(reg))
+                    break;
+
+                if (std::optional<uint8_t> tag = function.asTagOp(inst.b); tag && !hasTag(facts, reg, *tag))
+                    facts.tags.push_back({uint8_t(reg), *tag});
+                break;
+            }
+            case IrCmd::CHECK_NO_METATABLE:
+            case IrCmd::CHECK_READONLY:
+            {
+                int reg = getLoadedReg(function, inst.a, IrCmd::LOAD_POINTER);
+
+                if (!isInvariantReg(function, loop, reg) || !hasTag(facts, reg, LUA_TTABLE))
+                    break;
+
+                if (inst.cmd == IrCmd::CHECK_NO_METATABLE)
+                    facts.noMetatable.set(reg);
+                else
+                    facts.notReadonly.set(reg);
+                break;
+            }
+            case IrCmd::CHECK_ARRAY_SIZE:
+            {
+                int reg = getLoadedReg(function, inst.a, IrCmd::LOAD_POINTER);
+
+                if (!isInvariantReg(function, loop, reg) || !hasTag(facts, reg, LUA_TTABLE))
+                    break;
+
+                if (std::optional<int> index = function.asIntOp(inst.b); index && *index >= 0)
+                {
+                    facts.arraySizes.push_back({uint8_t(reg), *index});
+                }
+                else if (loopRange && isLoopVarArrayIndex(function, loop, inst.b))
+                {
+                    facts.arrayRange.set(reg);
+                    facts.loopVarRange = true;
+                }
+                break;
+            }
+            default:
+                break;
+            }
+        }
+    }
+}
+
+static bool isImpliedByFacts(IrFunction& function, const LoopFacts& facts, const LoopInfo& loop, const IrInst& inst)
+{
+    switch (inst.cmd)
+    {
+    case IrCmd::CHECK_TAG:
+    {
+        int reg = getLoadedReg(function, inst.a, IrCmd::LOAD_TAG);
+        std::optional<uint8_t> tag = function.asTagOp(inst.b);
+
+        return reg >= 0 && tag && hasTag(facts, reg, *tag);
+    }
+    case IrCmd::CHECK_NO_METATABLE:
+    {
+        int reg = getLoadedReg(function, inst.a, IrCmd::LOAD_POINTER);
+
+        return reg >= 0 && facts.noMetatable.test(reg);
+    }
+    case IrCmd::CHECK_READONLY:
+    {
+        int reg = getLoadedReg(function, inst.a, IrCmd::LOAD_POINTER);
+
+        return reg >= 0 && facts.notReadonly.test(reg);
+    }
+    case IrCmd::CHECK_ARRAY_SIZE:
+    {
+        int reg = getLoadedReg(function, inst.a, IrCmd::LOAD_POINTER);
+
+        if (reg < 0)
+            return false;
+
+        if (std::optional<int> index = function.asIntOp(inst.b))
+        {
+            for (auto [tableReg, knownIndex] : facts.arraySizes)
+            {
+                if (tableReg == reg && *index >= 0 && *index <= knownIndex)
+                    return true;
+            }
+
+            return false;
+        }
+
+        return facts.arrayRange.test(reg) && isLoopVarArrayIndex(function, loop, inst.b);
+    }
+    default:
+        break;
+    }
+
+    return false;
+}
+
+static void buildPreheader(IrBuilder& build, const LoopInfo& loop, const LoopFacts& facts, IrOp loopCopy)
+{
+    IrOp header = IrOp{IrOpKind::Block, loop.header};
+
+    for (auto [reg, tag] : facts.tags)
+    {
+        IrOp value = build.inst(IrCmd::LOAD_TAG, build.vmReg(reg));
+        build.inst(IrCmd::CHECK_TAG, value, build.constTag(tag), header);
+    }
+
+    for (int reg = 0; reg < 256; reg++)
+    {
+        bool hasArraySize = std::any_of(facts.arraySizes.begin(), facts.arraySizes.end(), [&](auto&& el) {
+            return el.first == reg;
+        });
+
+        if (!facts.noMetatable.test(reg) && !facts.notReadonly.test(reg) && !hasArraySize)
+            continue;
+
+        IrOp table = build.inst(IrCmd::LOAD_POINTER, build.vmReg(uint8_t(reg)));
+
+        if (facts.noMetatable.test(reg))
+            build.inst(IrCmd::CHECK_NO_METATABLE, table, header);
+
+        if (facts.notReadonly.test(reg))
+            build.inst(IrCmd::CHECK_READONLY, table, header);
+
+        for (auto [tableReg, index] : facts.arraySizes)
+        {
+            if (tableReg == reg)
+                build.inst(IrCmd::CHECK_ARRAY_SIZE, table, build.constInt(index), header);
+        }
+    }
+
+    if (!facts.loopVarRange)
+    {
+        build.inst(IrCmd::JUMP, loopCopy);
+        return;
+    }
+
+    // Loop variable keeps an integer value when the step is 1 and both the current value and the limit are integers
+    IrOp step = build.inst(IrCmd::LOAD_DOUBLE, build.vmReg(uint8_t(loop.forReg + 1)));
+
+    IrOp next = build.block(IrBlockKind::Internal);
+    build.inst(IrCmd::JUMP_CMP_NUM, step, build.constDouble(1.0), build.cond(IrCondition::NotEqual), header, next);
+    build.beginBlock(next);
+
+    IrOp limit = build.inst(IrCmd::LOAD_DOUBLE, build.vmReg(uint8_t(loop.forReg)));
+    IrOp limitIndex = build.inst(IrCmd::TRY_NUM_TO_INDEX, limit, header);
+
+    IrOp index = build.inst(IrCmd::LOAD_DOUBLE, build.vmReg(uint8_t(loop.forReg + 2)));
+    IrOp startIndex = build.inst(IrCmd::TRY_NUM_TO_INDEX, index, header);
+
+    // Array elements are in bounds for all indices in the range when they are in bounds for both ends of it
+    IrOp first = build.inst(IrCmd::SUB_INT, startIndex, build.constInt(1));
+    IrOp last = build.inst(IrCmd::SUB_INT, limitIndex, build.constInt(1));
+
+    for (int reg = 0; reg < 256; reg++)
+    {
+        if (facts.arrayRange.test(reg))
+        {
+            IrOp table = build.inst(IrCmd::LOAD_POINTER, build.vmReg(uint8_t(reg)));
+            build.inst(IrCmd::CHECK_ARRAY_SIZE, table, first, header);
+            build.inst(IrCmd::CHECK_ARRAY_SIZE, table, last, header);
+        }
+    }
+
+    // Loop body is only entered with a non-empty range, but the check keeps the original loop responsible for any other case
+    build.inst(IrCmd::JUMP_CMP_NUM, index, limit, build.cond(IrCondition::LessEqual), loopCopy, header);
+}
+
+static void versionLoop(IrBuilder& build, const LoopInfo& loop, const LoopFacts& facts)
+{
+    IrFunction& function = build.function;
+
+    uint32_t originalBlockCount = uint32_t(function.blocks.size());
+
+    std::vector<uint32_t> blockRedir(originalBlockCount, ~0u);
+    std::vector<uint32_t> instRedir(function.instructions.size(), ~0u);
+
+    for (uint32_t blockIdx : loop.blocks)
+        blockRedir[blockIdx] = build.block(IrBlockKind::Internal).index;
+
+    uint32_t cloneStart = uint32_t(function.instructions.size());
+
+    auto redirect = [&](IrOp& op) {
+        if (op.kind == IrOpKind::Inst)
+        {
+            LUAU_ASSERT(instRedir[op.index] != ~0u);
+            op.index = instRedir[op.index];
+        }
+        else if (op.kind == IrOpKind::Block && op.index < originalBlockCount && blockRedir[op.index] != ~0u)
+        {
+            op.index = blockRedir[op.index];
+        }
+    };
+
+    for (uint32_t blockIdx : loop.blocks)
+    {
+        uint32_t start = function.blocks[blockIdx].start;
+        uint32_t finish = function.blocks[blockIdx].finish;
+
+        build.beginBlock(IrOp{IrOpKind::Block, blockRedir[blockIdx]});
+
+        for (uint32_t index = start; index <= finish; index++)
+        {
+            IrInst clone = function.instructions[index];
+
+            if (isPseudo(clone.cmd))
+                continue;
+
+            if (clone.cmd == IrCmd::INTERRUPT)
+            {
+                // Interrupt handler can invalidate the facts, so the original latch is used to run it
+                LUAU_ASSERT(blockIdx == loop.latch);
+                build.inst(IrCmd::CHECK_NO_INTERRUPT, IrOp{IrOpKind::Block, loop.latch});
+                continue;
+            }
+
+            if (isImpliedByFacts(function, facts, loop, clone))
+                continue;
+
+            if (facts.loopVarRange && isLoopVarToIndex(function, loop, clone))
+            {
+                clone.cmd = IrCmd::NUM_TO_INT;
+                clone.b = {};
+            }
+
+            // With a step of 1, only the direct comparison remains
+            if (facts.loopVarRange && index == finish && blockIdx == loop.latch)
+                clone = {IrCmd::JUMP, clone.e};
+
+            redirect(clone.a);
+            redirect(clone.b);
+            redirect(clone.c);
+            redirect(clone.d);
+            redirect(clone.e);
+            redirect(clone.f);
+
+            instRedir[index] = build.inst(clone.cmd, clone.a, clone.b, clone.c, clone.d, clone.e, clone.f).index;
+        }
+    }
+
+    uint32_t cloneEnd = uint32_t(function.instructions.size());
+
+    IrOp preheader = build.block(IrBlockKind::Internal);
+
+    // All existing edges into the loop header now go through the preheader
+    for (uint32_t blockIdx = 0; blockIdx < originalBlockCount; blockIdx++)
+    {
+        IrBlock& block = function.blocks[blockIdx];
+
+        if (block.kind == IrBlockKind::Dead)
+            continue;
+
+        for (uint32_t index = block.start; index <= block.finish; index++)
+        {
+            IrInst& inst = function.instructions[index];
+
+            for (IrOp* op : {&inst.a, &inst.b, &inst.c, &inst.d, &inst.e, &inst.f})
+            {
+                if (op->kind == IrOpKind::Block && op->index == loop.header)
+                    *op = preheader;
+            }
+        }
+    }
+
+    build.beginBlock(preheader);
+    buildPreheader(build, loop, facts, IrOp{IrOpKind::Block, blockRedir[loop.header]});
+
+    updateUseCounts(function);
+
+    // Values that were only used by the removed guards are not needed in the copy
+    for (uint32_t index = cloneEnd; index > cloneStart; index--)
+    {
+        IrInst& inst = function.instructions[index - 1];
+
+        if (inst.cmd != IrCmd::NOP && inst.useCount == 0 && !hasSideEffects(inst.cmd) && !isNonTerminatingJump(inst.cmd))
+            kill(function, inst);
+    }
+}
+
+void hoistLoopInvariantGuards(IrBuilder& build)
+{
+    IrFunction& function = build.function;
+
+    uint32_t originalBlockCount = uint32_t(function.blocks.size());
+
+    for (uint32_t latchIdx = 0; latchIdx < originalBlockCount; latchIdx++)
+    {
+        LoopInfo loop;
+
+        if (!findLoopLatch(function, latchIdx, loop))
+            continue;
+
+        if (!findLoopBlocks(function, loop))
+            continue;
+
+        LoopFacts facts;
+        collectLoopFacts(function, loop, facts);
+
+        if (facts.empty())
+            continue;
+
+        versionLoop(build, loop, facts);
+
+        // Analysis of the next loop requires up-to-date control flow information
+        computeCfgInfo(function);
+    }
+}
+
+} // namespace CodeGen
+} // namespace Luau
@@ -45,6 +45,12 @@
 // Version 2: Adds Proto::linedefined. Supported until 0.544.
 // Version 3: Adds FORGPREP/JUMPXEQK* and enhances AUX encoding for FORGLOOP. Removes FORGLOOP_NEXT/INEXT and JUMPIFEQK/JUMPIFNOTEQK. Currently supported.
 // Version 4: Adds Proto::flags, typeinfo, and floor division opcodes IDIV/IDIVK. Currently supported.
+// Version 5: Adds fused instructions (MOVE_MOVE, MOVE_CALL, LOADN_LOADN, LOADN_CALL, LOADK_LOADK, LOADK_CALL, GETIMPORT_CALL). Currently supported.
+
+// # Aligned layout
+// Bytecode can be serialized in an aligned layout that the runtime can execute in place (see luau_loadmapped). Such bytecode starts with LBC_ALIGNED_MARKER followed by the
+// regular version byte; the rest of the format is the same except that each function, its instructions and its line info start at 4-byte aligned offsets, and line info is
+// stored decoded (as 8-bit offsets from the baseline padded to 4 bytes, followed by absolute baselines).
 
 // Bytecode opcode, part of the instruction header
 enum LuauOpcode
@@ -256,6 +262,7 @@ enum LuauOpcode
     // NEWTABLE: create table in target register
     // A: target register
     // B: table size, stored as 0 for v=0 and ceil(log2(v))+1 for v!=0
+    // C: 1 if the table is created empty and the table size is the number of string fields that are assigned to it later, 0 otherwise
     // AUX: array size
     LOP_NEWTABLE,
 
@@ -402,6 +409,32 @@ enum LuauOpcode
     // C: constant table index (0..255)
     LOP_IDIVK,
 
+    // Fused instructions: perform the first instruction of a common pair and continue with the second one without a separate dispatch
+    // Each fused instruction uses the encoding of its first instruction (including AUX) and is followed by the second instruction that is left unchanged,
+    // so jumps to the second instruction, line info and breakpoints keep working; the runtime executes the second instruction normally if it doesn't match
+    // The pairs are the most common ones in the compiled code, see --oppairs mode of luau-compile
+
+    // MOVE_MOVE: MOVE followed by MOVE
+    LOP_MOVE_MOVE,
+
+    // MOVE_CALL: MOVE followed by CALL
+    LOP_MOVE_CALL,
+
+    // LOADN_LOADN: LOADN followed by LOADN
+    LOP_LOADN_LOADN,
+
+    // LOADN_CALL: LOADN followed by CALL
+    LOP_LOADN_CALL,
+
+    // LOADK_LOADK: LOADK followed by LOADK
+    LOP_LOADK_LOADK,
+
+    // LOADK_CALL: LOADK followed by CALL
+    LOP_LOADK_CALL,
+
+    // GETIMPORT_CALL: GETIMPORT followed by CALL
+    LOP_GETIMPORT_CALL,
+
     // Enum entry for number of opcodes, not a valid opcode by itself!
     LOP__COUNT
 };
@@ -426,10 +459,12 @@ enum LuauBytecodeTag
 {
     // Bytecode version; runtime supports [MIN, MAX], compiler emits TARGET by default but may emit a higher version when flags are enabled
     LBC_VERSION_MIN = 3,
-    LBC_VERSION_MAX = 4,
+    LBC_VERSION_MAX = 5,
     LBC_VERSION_TARGET = 3,
     // Type encoding version
     LBC_TYPE_VERSION = 1,
+    // First byte of bytecode in aligned layout
+    LBC_ALIGNED_MARKER = 0xff,
     // Types of constant table entries
     LBC_CONSTANT_NIL = 0,
     LBC_CONSTANT_BOOLEAN,
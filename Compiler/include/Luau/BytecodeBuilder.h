@@ -74,6 +74,9 @@ public:
     void foldJumps();
     void expandJumps();
 
+    // Replaces common pairs of instructions with fused instructions, see LOP_MOVE_MOVE; has to be called after the code is final
+    void fuseInstructions();
+
     void setFunctionTypeInfo(std::string value);
 
     void setDebugFunctionName(StringRef name);
@@ -89,6 +92,13 @@ public:
 
     void finalize();
 
+    // Makes finalize() produce the aligned layout that luau_loadmapped can execute in place; must be set before any function is built
+    void setAlignedLayout(bool value)
+    {
+        LUAU_ASSERT(functions.empty());
+        alignedLayout = value;
+    }
+
     enum DumpFlags
     {
         Dump_Code = 1 << 0,
@@ -106,6 +116,13 @@ public:
 
     void setDumpSource(const std::string& source);
 
+    // Counts adjacent instructions in functions that are built after the call, when the first one can fall through to the second one
+    // counts[a * LOP__COUNT + b] is incremented for every such pair of opcodes a and b; used to pick the pairs for fused instructions
+    void setOpcodePairCounts(uint64_t* counts)
+    {
+        opcodePairCounts = counts;
+    }
+
     bool needsDebugRemarks() const
     {
         return (dumpFlags & Dump_Remarks) != 0;
@@ -259,6 +276,7 @@ private:
 
     BytecodeEncoder* encoder = nullptr;
     std::string bytecode;
+    bool alignedLayout = false;
 
     uint32_t dumpFlags = 0;
     std::vector<std::string> dumpSource;
@@ -266,10 +284,14 @@ private:
 
     std::string (BytecodeBuilder::*dumpFunctionPtr)(std::vector<int>&) const = nullptr;
 
+    uint64_t* opcodePairCounts = nullptr;
+
     void validate() const;
     void validateInstructions() const;
     void validateVariadic() const;
 
+    void countOpcodePairs() const;
+
     std::string dumpCurrentFunction(std::vector<int>& dumpinstoffs) const;
     void dumpConstant(std::string& result, int k) const;
     void dumpInstruction(const uint32_t* opcode, std::string& output, int targetLabel) const;
@@ -8,6 +8,7 @@
 #include <string.h>
 
 LUAU_FASTFLAGVARIABLE(BytecodeVersion4, false)
+LUAU_FASTFLAGVARIABLE(LuauCompileFusedInstructions, false)
 
 LUAU_FASTFLAG(LuauFloorDivision)
 
@@ -49,6 +50,12 @@ static void writeDouble(std::string& ss, double value)
     ss.append(reinterpret_cast<const char*>(&value), sizeof(value));
 }
 
+static void writeAlignment(std::string& ss)
+{
+    while (ss.size() % 4 != 0)
+        writeByte(ss, 0);
+}
+
 static void writeVarInt(std::string& ss, unsigned int value)
 {
     do
@@ -116,6 +123,24 @@ inline bool isFastCall(LuauOpcode op)
     }
 }
 
+inline bool canFallThrough(LuauOpcode op)
+{
+    switch (op)
+    {
+    case LOP_JUMP:
+    case LOP_JUMPBACK:
+    case LOP_JUMPX:
+    case LOP_RETURN:
+    case LOP_FORGPREP:
+    case LOP_FORGPREP_INEXT:
+    case LOP_FORGPREP_NEXT:
+        return false;
+
+    default:
+        return true;
+    }
+}
+
 static int getJumpTarget(uint32_t insn, uint32_t pc)
 {
     LuauOpcode op = LuauOpcode(LUAU_INSN_OP(insn));
@@ -232,6 +257,9 @@ void BytecodeBuilder::endFunction(uint8_t maxstacksize, uint8_t numupvalues, uin
     validate();
 #endif
 
+    if (opcodePairCounts)
+        countOpcodePairs();
+
     // this call is indirect to make sure we only gain link time dependency on dumpCurrentFunction when needed
     if (dumpFunctionPtr)
         func.dump = (this->*dumpFunctionPtr)(func.dumpinstoffs);
@@ -584,9 +612,12 @@ void BytecodeBuilder::finalize()
     uint8_t version = getVersion();
     LUAU_ASSERT(version >= LBC_VERSION_MIN && version <= LBC_VERSION_MAX);
 
-    bytecode = char(version);
+    if (alignedLayout)
+        writeByte(bytecode, LBC_ALIGNED_MARKER);
 
-    if (FFlag::BytecodeVersion4)
+    writeByte(bytecode, version);
+
+    if (version >= 4)
     {
         uint8_t typesversion = getTypeEncodingVersion();
         LUAU_ASSERT(typesversion == 1);
@@ -598,7 +629,13 @@ void BytecodeBuilder::finalize()
     writeVarInt(bytecode, uint32_t(functions.size()));
 
     for (const Function& func : functions)
+    {
+        // function data is aligned internally relative to its start
+        if (alignedLayout)
+            writeAlignment(bytecode);
+
         bytecode += func.data;
+    }
 
     LUAU_ASSERT(mainFunction < functions.size());
     writeVarInt(bytecode, mainFunction);
@@ -615,7 +652,7 @@ void BytecodeBuilder::writeFunction(std::string& ss, uint32_t id, uint8_t flags)
     writeByte(ss, func.numupvalues);
     writeByte(ss, func.isvararg);
 
-    if (FFlag::BytecodeVersion4)
+    if (getVersion() >= 4)
     {
         writeByte(ss, flags);
 
@@ -626,6 +663,9 @@ void BytecodeBuilder::writeFunction(std::string& ss, uint32_t id, uint8_t flags)
     // instructions
     writeVarInt(ss, uint32_t(insns.size()));
 
+    if (alignedLayout)
+        writeAlignment(ss);
+
     for (uint32_t insn : insns)
         writeInt(ss, insn);
 
@@ -802,6 +842,22 @@ void BytecodeBuilder::writeLineInfo(std::string& ss) const
 
     writeByte(ss, uint8_t(logspan));
 
+    // aligned layout stores line info exactly as the VM keeps it in memory: offsets from the baseline, padded to 4 bytes, followed by absolute baselines
+    if (alignedLayout)
+    {
+        writeAlignment(ss);
+
+        for (size_t i = 0; i < lines.size(); ++i)
+            writeByte(ss, uint8_t(lines[i] - baseline[i >> logspan]));
+
+        writeAlignment(ss);
+
+        for (size_t i = 0; i < baselineSize; ++i)
+            writeInt(ss, baseline[i]);
+
+        return;
+    }
+
     uint8_t lastOffset = 0;
 
     for (size_t i = 0; i < lines.size(); ++i)
@@ -1061,6 +1117,54 @@ void BytecodeBuilder::expandJumps()
     lines.swap(newlines);
 }
 
+void BytecodeBuilder::fuseInstructions()
+{
+    // fused instructions keep the encoding of the first instruction and the second instruction is left as is, so code layout doesn't change
+    // this only replaces the opcode of the first instruction, which makes it safe to run after jumps are patched
+    // both instructions have to be on the same line: breakpoints replace the first instruction of a line, and the VM runs the second
+    // instruction of a fused pair without looking at its opcode
+    for (size_t i = 0; i < insns.size();)
+    {
+        LuauOpcode op = LuauOpcode(LUAU_INSN_OP(insns[i]));
+        size_t next = i + getOpLength(op);
+
+        if (next < insns.size() && lines[i] == lines[next])
+        {
+            LuauOpcode nextop = LuauOpcode(LUAU_INSN_OP(insns[next]));
+            LuauOpcode fusedop = getFusedOp(op, nextop);
+
+            if (fusedop != LOP__COUNT)
+            {
+                insns[i] &= ~0xffu;
+                insns[i] |= fusedop;
+
+                // second instruction is executed as part of the fused one, so it's not fused with the instruction after it
+                next += getOpLength(nextop);
+            }
+        }
+
+        i = next;
+    }
+}
+
+void BytecodeBuilder::countOpcodePairs() const
+{
+    for (size_t i = 0; i < insns.size();)
+    {
+        LuauOpcode op = getUnfusedOp(LuauOpcode(LUAU_INSN_OP(insns[i])));
+        size_t next = i + getOpLength(op);
+
+        if (next < insns.size() && canFallThrough(op))
+        {
+            LuauOpcode nextop = getUnfusedOp(LuauOpcode(LUAU_INSN_OP(insns[next])));
+
+            opcodePairCounts[op * LOP__COUNT + nextop]++;
+        }
+
+        i = next;
+    }
+}
+
 std::string BytecodeBuilder::getError(const std::string& message)
 {
     // 0 acts as a special marker for error bytecode (it's equal to LBC_VERSION_TARGET for valid bytecode blobs)
@@ -1075,6 +1179,9 @@ uint8_t BytecodeBuilder::getVersion()
 {
     // This function usually returns LBC_VERSION_TARGET but may sometimes return a higher number (within LBC_VERSION_MIN/MAX) under fast flags
 
+    if (FFlag::LuauCompileFusedInstructions)
+        return 5;
+
     if (FFlag::BytecodeVersion4)
         return 4;
 
@@ -1126,7 +1233,14 @@ void BytecodeBuilder::validateInstructions() const
     for (size_t i = 0; i < insns.size();)
     {
         uint32_t insn = insns[i];
-        LuauOpcode op = LuauOpcode(LUAU_INSN_OP(insn));
+        LuauOpcode op = getUnfusedOp(LuauOpcode(LUAU_INSN_OP(insn)));
+
+        // fused instruction is validated as its first instruction and has to be followed by the second one
+        if (op != LUAU_INSN_OP(insn))
+        {
+            size_t next = i + getOpLength(op);
+            LUAU_ASSERT(next < insns.size() && getFusedOp(op, LuauOpcode(LUAU_INSN_OP(insns[next]))) == LUAU_INSN_OP(insn));
+        }
 
         switch (op)
         {
@@ -1533,7 +1647,7 @@ void BytecodeBuilder::validateVariadic() const
     for (size_t i = 0; i < insns.size();)
     {
         uint32_t insn = insns[i];
-        LuauOpcode op = LuauOpcode(LUAU_INSN_OP(insn));
+        LuauOpcode op = getUnfusedOp(LuauOpcode(LUAU_INSN_OP(insn)));
 
         if (variadicSeq)
         {
@@ -2088,6 +2202,30 @@ void BytecodeBuilder::dumpInstruction(const uint32_t* code, std::string& result,
         code++;
         break;
 
+    case LOP_MOVE_MOVE:
+    case LOP_MOVE_CALL:
+        formatAppend(result, "%s R%d R%d\n", getOpName(LuauOpcode(LUAU_INSN_OP(insn))), LUAU_INSN_A(insn), LUAU_INSN_B(insn));
+        break;
+
+    case LOP_LOADN_LOADN:
+    case LOP_LOADN_CALL:
+        formatAppend(result, "%s R%d %d\n", getOpName(LuauOpcode(LUAU_INSN_OP(insn))), LUAU_INSN_A(insn), LUAU_INSN_D(insn));
+        break;
+
+    case LOP_LOADK_LOADK:
+    case LOP_LOADK_CALL:
+        formatAppend(result, "%s R%d K%d [", getOpName(LuauOpcode(LUAU_INSN_OP(insn))), LUAU_INSN_A(insn), LUAU_INSN_D(insn));
+        dumpConstant(result, LUAU_INSN_D(insn));
+        result.append("]\n");
+        break;
+
+    case LOP_GETIMPORT_CALL:
+        formatAppend(result, "GETIMPORT_CALL R%d %d [", LUAU_INSN_A(insn), LUAU_INSN_D(insn));
+        dumpConstant(result, LUAU_INSN_D(insn));
+        result.append("]\n");
+        code++; // AUX
+        break;
+
     default:
         LUAU_ASSERT(!"Unsupported opcode");
     }
@@ -27,6 +27,7 @@ LUAU_FASTINTVARIABLE(LuauCompileInlineThresholdMaxBoost, 300)
 LUAU_FASTINTVARIABLE(LuauCompileInlineDepth, 5)
 
 LUAU_FASTFLAG(LuauFloorDivision)
+LUAU_FASTFLAG(LuauCompileFusedInstructions)
 
 namespace Luau
 {
@@ -254,6 +255,9 @@ struct Compiler
 
         bytecode.expandJumps();
 
+        if (options.optimizationLevel >= 2 && FFlag::LuauCompileFusedInstructions)
+            bytecode.fuseInstructions();
+
         popLocals(0);
 
         if (bytecode.getInstructionCount() > kMaxInstructionCount)
@@ -1668,7 +1672,8 @@ struct Compiler
 
             bytecode.addDebugRemark("allocation: table hash %d", shape.hashSize);
 
-            bytecode.emitABC(LOP_NEWTABLE, target, encodeHashSize(shape.hashSize), 0);
+            // hash size of an empty table only counts the fields assigned to it by name, which lets the VM give it a shape for them
+            bytecode.emitABC(LOP_NEWTABLE, target, encodeHashSize(shape.hashSize), shape.hashSize > 0 && shape.arraySize == 0);
             bytecode.emitAux(shape.arraySize);
             return;
         }
@@ -85,7 +85,9 @@ target_sources(Luau.CodeGen PRIVATE
     CodeGen/include/Luau/Label.h
     CodeGen/include/Luau/OperandX64.h
     CodeGen/include/Luau/OptimizeConstProp.h
+    CodeGen/include/Luau/OptimizeDeadStore.h
     CodeGen/include/Luau/OptimizeFinalX64.h
+    CodeGen/include/Luau/OptimizeLoops.h
     CodeGen/include/Luau/RegisterA64.h
     CodeGen/include/Luau/RegisterX64.h
     CodeGen/include/Luau/UnwindBuilder.h
@@ -97,6 +99,7 @@ target_sources(Luau.CodeGen PRIVATE
     CodeGen/src/AssemblyBuilderX64.cpp
     CodeGen/src/CodeAllocator.cpp
     CodeGen/src/CodeBlockUnwind.cpp
+    CodeGen/src/CodeCache.cpp
     CodeGen/src/CodeGen.cpp
     CodeGen/src/CodeGenAssembly.cpp
     CodeGen/src/CodeGenUtils.cpp
@@ -105,10 +108,12 @@ target_sources(Luau.CodeGen PRIVATE
     CodeGen/src/EmitBuiltinsX64.cpp
     CodeGen/src/EmitCommonX64.cpp
     CodeGen/src/EmitInstructionX64.cpp
+    CodeGen/src/EmulatorA64.cpp
     CodeGen/src/IrAnalysis.cpp
     CodeGen/src/IrBuilder.cpp
     CodeGen/src/IrCallWrapperX64.cpp
     CodeGen/src/IrDump.cpp
+    CodeGen/src/IrInlining.cpp
     CodeGen/src/IrLoweringA64.cpp
     CodeGen/src/IrLoweringX64.cpp
     CodeGen/src/IrRegAllocA64.cpp
@@ -120,12 +125,15 @@ target_sources(Luau.CodeGen PRIVATE
     CodeGen/src/lcodegen.cpp
     CodeGen/src/NativeState.cpp
     CodeGen/src/OptimizeConstProp.cpp
+    CodeGen/src/OptimizeDeadStore.cpp
     CodeGen/src/OptimizeFinalX64.cpp
+    CodeGen/src/OptimizeLoops.cpp
     CodeGen/src/UnwindBuilderDwarf2.cpp
     CodeGen/src/UnwindBuilderWin.cpp
 
     CodeGen/src/BitUtils.h
     CodeGen/src/ByteUtils.h
+    CodeGen/src/CodeCache.h
     CodeGen/src/CodeGenLower.h
     CodeGen/src/CodeGenUtils.h
     CodeGen/src/CodeGenA64.h
@@ -135,6 +143,8 @@ target_sources(Luau.CodeGen PRIVATE
     CodeGen/src/EmitCommonA64.h
     CodeGen/src/EmitCommonX64.h
     CodeGen/src/EmitInstructionX64.h
+    CodeGen/src/EmulatorA64.h
+    CodeGen/src/IrInlining.h
     CodeGen/src/IrLoweringA64.h
     CodeGen/src/IrLoweringX64.h
     CodeGen/src/IrRegAllocA64.h
@@ -175,6 +185,7 @@ target_sources(Luau.Analysis PRIVATE
     Analysis/include/Luau/LValue.h
     Analysis/include/Luau/Metamethods.h
     Analysis/include/Luau/Module.h
+    Analysis/include/Luau/ModuleCache.h
     Analysis/include/Luau/ModuleResolver.h
     Analysis/include/Luau/Normalize.h
     Analysis/include/Luau/Predicate.h
@@ -232,6 +243,7 @@ target_sources(Luau.Analysis PRIVATE
     Analysis/src/Linter.cpp
     Analysis/src/LValue.cpp
     Analysis/src/Module.cpp
+    Analysis/src/ModuleCache.cpp
     Analysis/src/Normalize.cpp
     Analysis/src/Quantify.cpp
     Analysis/src/Refinement.cpp
@@ -223,6 +223,27 @@ LUA_API int luau_load(lua_State* L, const char* chunkname, const char* data, siz
 LUA_API void lua_call(lua_State* L, int nargs, int nresults);
 LUA_API int lua_pcall(lua_State* L, int nargs, int nresults, int errfunc);
 
+/*
+** bytecode images: bytecode decoded once that can be loaded into many states, even from multiple threads
+** images are immutable and reference counted; each state that loads an image keeps it alive until the state is closed
+** images are allocated with the allocator of the state that decodes them, which has to stay usable until the image is released
+** the last release frees the image from whichever thread closes the last state or calls luau_releaseimage, so when an image is shared
+** between threads that allocator has to be thread-safe
+*/
+typedef struct lua_BytecodeImage lua_BytecodeImage;
+
+LUA_API lua_BytecodeImage* luau_decode(lua_State* L, const char* data, size_t size);
+LUA_API void luau_retainimage(lua_BytecodeImage* image);
+LUA_API void luau_releaseimage(lua_BytecodeImage* image);
+LUA_API int luau_loadimage(lua_State* L, const char* chunkname, lua_BytecodeImage* image, int env);
+
+/*
+** mapped bytecode: bytecode in the aligned layout (see BytecodeBuilder::setAlignedLayout) is executed in place, without copying instructions and line info
+** data must be 4-byte aligned and writable since instructions are patched at runtime, e.g. a private copy-on-write file mapping
+** the state takes ownership of data even if loading fails, and calls release(ud) when it's closed; bytecode in the regular layout is copied as with luau_load
+*/
+LUA_API int luau_loadmapped(lua_State* L, const char* chunkname, char* data, size_t size, int env, void (*release)(void* ud), void* ud);
+
 /*
 ** coroutine functions
 */
@@ -285,6 +306,54 @@ enum lua_GCOp
     LUA_GCSETGOAL,
     LUA_GCSETSTEPMUL,
     LUA_GCSETSTEPSIZE,
+
+    /*
+    ** switch between incremental (default) and generational collection modes; both options return the previous mode
+    **
+    ** in generational mode, objects that survive a collection become old and keep their marks; frequent minor collections only
+    ** traverse young objects and old objects that were modified since (as recorded by write barriers), and only free young objects.
+    ** a minor collection starts after the heap grows by N% (minor multiplier, 50% by default) since the end of the last collection.
+    ** once the heap after a minor collection grows by M% (major multiplier, 100% by default) over the heap size after the last major
+    ** collection, the collector runs a major collection that traverses the entire heap and frees old objects as well.
+    **
+    ** note that minor collections still sweep the entire heap, but sweeping an old object is much cheaper than traversing it.
+    */
+    LUA_GCGEN,
+    LUA_GCINC,
+    LUA_GCSETGENMINORMUL,
+    LUA_GCSETGENMAJORMUL,
+
+    /*
+    ** set the number of worker threads used to mark objects during the atomic stage; returns the previous value
+    **
+    ** atomic stage of the collector is indivisible, and its marking work can be split across multiple threads if the host
+    ** provides a 'gcparallel' callback (see lua_Callbacks); the default value of 0 disables parallel marking
+    */
+    LUA_GCSETWORKERS,
+
+    /*
+    ** tune the cache of empty pages kept by the page allocator; sizes are specified in KB
+    **
+    ** when all blocks in a page are freed, the page is kept in the cache to serve future allocations instead of being freed,
+    ** as long as the cache size doesn't exceed the limit (LUA_PAGECACHESIZE by default); pages that haven't been reused for an
+    ** entire GC cycle are freed automatically.
+    ** LUA_GCSETPAGECACHE sets the limit and returns the previous one; LUA_GCTRIMPAGECACHE frees cached pages until the cache
+    ** size doesn't exceed the specified size, and returns the number of KB that were freed
+    */
+    LUA_GCSETPAGECACHE,
+    LUA_GCTRIMPAGECACHE,
+
+    /*
+    ** set the occupancy threshold (in percent) below which pages with collectable objects are considered sparse; returns the previous value
+    **
+    ** objects are never moved: their addresses are used as table keys and returned by lua_topointer, lua_tostring, lua_touserdata and
+    ** lua_tovector, and VM and native code frames hold raw pointers to them across GC steps. a page can therefore only be freed when all
+    ** objects in it die; after a spike in memory use, many pages might be left with a few live objects each. when the sweep leaves a page
+    ** sparse, the page is moved to the end of the allocation order, so that new objects fill denser pages first and sparse pages get a
+    ** chance to become empty. 0 (default) disables this.
+    ** see lua_gcpagestats for measuring fragmentation.
+    */
+    LUA_GCSETSPARSEPAGE,
 };
 
 LUA_API int lua_gc(lua_State* L, int what, int data);
@@ -294,9 +363,19 @@ LUA_API int lua_gc(lua_State* L, int what, int data);
 ** all allocated bytes are attributed to the memory category of the running thread (0..LUA_MEMORY_CATEGORIES-1)
 */
 
+// pseudo-category for lua_totalbytes that returns the size of empty pages kept by the allocator for reuse (see LUA_GCSETPAGECACHE)
+#define LUA_MEMCACHED (-2)
+
 LUA_API void lua_setmemcat(lua_State* L, int category);
 LUA_API size_t lua_totalbytes(lua_State* L, int category);
 
+/*
+** fragmentation statistics for pages that store collectable objects of the given size class (0..LUA_SIZECLASSES-1), or all pages when
+** the size class is negative; 'usedbytes' receives the size of live objects and 'pagebytes' the total size of pages, so the ratio
+** between them is the page occupancy. returns the object size for the size class, or 0 if the size class isn't used or is negative
+*/
+LUA_API int lua_gcpagestats(lua_State* L, int sizeclass, size_t* usedbytes, size_t* pagebytes);
+
 /*
 ** miscellaneous functions
 */
@@ -437,6 +516,9 @@ struct lua_Callbacks
     void (*debugstep)(lua_State* L, lua_Debug* ar);      // gets called after each instruction in single step mode
     void (*debuginterrupt)(lua_State* L, lua_Debug* ar); // gets called when thread execution is interrupted by break in another thread
     void (*debugprotectederror)(lua_State* L);           // gets called when protected call results in an error
+
+    // gets called by GC to run 'workers' instances of 'task' concurrently, passing worker index from 0 to workers-1; must return after all complete
+    void (*gcparallel)(lua_State* L, void (*task)(void* context, int worker), void* context, int workers);
 };
 typedef struct lua_Callbacks lua_Callbacks;
 
@@ -66,6 +66,11 @@
 #define LUA_USE_LONGJMP 0
 #endif
 
+// Can be used to remove the interpreter support for tiered compilation: call and loop counters and entering native code at loop back edges
+#ifndef LUA_USE_TIERING
+#define LUA_USE_TIERING 1
+#endif
+
 // LUA_IDSIZE gives the maximum size for the description of the source
 #ifndef LUA_IDSIZE
 #define LUA_IDSIZE 256
@@ -106,6 +111,11 @@
 #define LUA_SIZECLASSES 32
 #endif
 
+// maximum size of empty pages that the page allocator keeps for reuse instead of freeing them, in bytes
+#ifndef LUA_PAGECACHESIZE
+#define LUA_PAGECACHESIZE (256 * 1024)
+#endif
+
 // available number of separate memory categories
 #ifndef LUA_MEMORY_CATEGORIES
 #define LUA_MEMORY_CATEGORIES 256
@@ -116,6 +126,21 @@
 #define LUA_MINSTRTABSIZE 32
 #endif
 
+// maximum number of worker threads that the garbage collector can use for parallel marking
+#ifndef LUA_GCMAXWORKERS
+#define LUA_GCMAXWORKERS 64
+#endif
+
+// maximum number of string keys that a table can store using a shared shape before switching to a hash part (must be <= 255)
+#ifndef LUA_MAXSHAPEKEYS
+#define LUA_MAXSHAPEKEYS 32
+#endif
+
+// maximum number of table shapes that can exist at the same time; tables that need new shapes past the limit use a hash part
+#ifndef LUA_MAXSHAPES
+#define LUA_MAXSHAPES 4096
+#endif
+
 // maximum number of captures supported by pattern matching
 #ifndef LUA_MAXCAPTURES
 #define LUA_MAXCAPTURES 32
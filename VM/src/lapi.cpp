@@ -7,6 +7,7 @@
 #include "ltable.h"
 #include "lfunc.h"
 #include "lgc.h"
+#include "lmem.h"
 #include "ldo.h"
 #include "ludata.h"
 #include "lvm.h"
@@ -1150,6 +1151,51 @@ int lua_gc(lua_State* L, int what, int data)
         g->gcstepsize = data << 10;
         break;
     }
+    case LUA_GCGEN:
+    case LUA_GCINC:
+    {
+        // mode switch takes effect at the end of the current mark phase; old objects left by generational mode are
+        // freed by the first major collection after that
+        res = g->gcgen ? LUA_GCGEN : LUA_GCINC;
+        g->gcgen = (what == LUA_GCGEN);
+        break;
+    }
+    case LUA_GCSETGENMINORMUL:
+    {
+        res = g->gcgenminormul;
+        g->gcgenminormul = data;
+        break;
+    }
+    case LUA_GCSETGENMAJORMUL:
+    {
+        res = g->gcgenmajormul;
+        g->gcgenmajormul = data;
+        break;
+    }
+    case LUA_GCSETWORKERS:
+    {
+        res = g->gcworkers;
+        g->gcworkers = data < 0 ? 0 : data > LUA_GCMAXWORKERS ? LUA_GCMAXWORKERS : data;
+        break;
+    }
+    case LUA_GCSETPAGECACHE:
+    {
+        res = int(g->pagecachelimit >> 10);
+        g->pagecachelimit = size_t(data < 0 ? 0 : data) << 10;
+        luaM_trimpagecache(L, g->pagecachelimit);
+        break;
+    }
+    case LUA_GCTRIMPAGECACHE:
+    {
+        res = int(luaM_trimpagecache(L, size_t(data < 0 ? 0 : data) << 10) >> 10);
+        break;
+    }
+    case LUA_GCSETSPARSEPAGE:
+    {
+        res = g->gcsparsepage;
+        g->gcsparsepage = data < 0 ? 0 : data > 100 ? 100 : data;
+        break;
+    }
     default:
         res = -1; // invalid option
     }
@@ -1224,6 +1270,28 @@ int lua_rawiter(lua_State* L, int idx, int iter)
         }
     }
 
+    if (isshaped(h))
+    {
+        TableShape* shape = gshape(h);
+        TValue* slots = gslots(h);
+        int base = sizearray + sizenode;
+
+        // then we advance iter through the slots, which are numbered after the node that holds the shape
+        for (; unsigned(iter - base) < unsigned(shape->count); ++iter)
+        {
+            TValue* e = &slots[iter - base];
+
+            if (!ttisnil(e))
+            {
+                StkId top = L->top;
+                setsvalue(L, top + 0, shape->keys[iter - base]);
+                setobj2s(L, top + 1, e);
+                api_update_top(L, top + 2);
+                return iter + 1;
+            }
+        }
+    }
+
     // traversal finished
     return -1;
 }
@@ -1430,5 +1498,25 @@ void lua_setmemcat(lua_State* L, int category)
 size_t lua_totalbytes(lua_State* L, int category)
 {
     api_check(L, category < LUA_MEMORY_CATEGORIES);
+    if (category == LUA_MEMCACHED)
+        return L->global->pagecachebytes;
+
     return category < 0 ? L->global->totalbytes : L->global->memcatbytes[category];
 }
+
+int lua_gcpagestats(lua_State* L, int sizeclass, size_t* usedbytes, size_t* pagebytes)
+{
+    api_check(L, sizeclass < LUA_SIZECLASSES);
+
+    int blocksize = sizeclass < 0 ? 0 : luaM_getsizeclasssize(sizeclass);
+
+    if (sizeclass >= 0 && blocksize == 0)
+    {
+        *usedbytes = 0;
+        *pagebytes = 0;
+        return 0;
+    }
+
+    luaM_getpagestats(L, sizeclass, usedbytes, pagebytes);
+    return blocksize;
+}
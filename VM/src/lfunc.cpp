@@ -36,7 +36,14 @@ Proto* luaF_newproto(lua_State* L)
     f->execdata = NULL;
     f->exectarget = 0;
     f->typeinfo = NULL;
+    f->typeprofile = NULL;
+    f->nativerefs = NULL;
+    f->sizenativerefs = 0;
     f->userdata = NULL;
+    f->sharedinfo = 0;
+    f->sharedcode = 0;
+    f->tierentries = 0;
+    f->tierloops = 0;
 
     return f;
 }
@@ -147,10 +154,11 @@ void luaF_closeupval(lua_State* L, UpVal* uv, bool dead)
 
 void luaF_freeproto(lua_State* L, Proto* f, lua_Page* page)
 {
-    luaM_freearray(L, f->code, f->sizecode, Instruction, f->memcat);
+    if (!f->sharedcode)
+        luaM_freearray(L, f->code, f->sizecode, Instruction, f->memcat);
     luaM_freearray(L, f->p, f->sizep, Proto*, f->memcat);
     luaM_freearray(L, f->k, f->sizek, TValue, f->memcat);
-    if (f->lineinfo)
+    if (f->lineinfo && !f->sharedinfo)
         luaM_freearray(L, f->lineinfo, f->sizelineinfo, uint8_t, f->memcat);
     luaM_freearray(L, f->locvars, f->sizelocvars, struct LocVar, f->memcat);
     luaM_freearray(L, f->upvalues, f->sizeupvalues, TString*, f->memcat);
@@ -160,9 +168,14 @@ void luaF_freeproto(lua_State* L, Proto* f, lua_Page* page)
     if (f->execdata)
         L->global->ecb.destroy(L, f);
 
-    if (f->typeinfo)
+    if (f->typeinfo && !f->sharedinfo)
         luaM_freearray(L, f->typeinfo, f->numparams + 2, uint8_t, f->memcat);
 
+    if (f->typeprofile)
+        luaM_freearray(L, f->typeprofile, f->sizecode, uint8_t, f->memcat);
+
+    luaM_freearray(L, f->nativerefs, f->sizenativerefs, GCObject*, f->memcat);
+
     luaM_freegco(L, f, sizeof(Proto), f->memcat, page);
 }
 
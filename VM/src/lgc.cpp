@@ -13,8 +13,15 @@
 
 #include <string.h>
 
+#include <atomic>
+#include <thread>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
 /*
- * Luau uses an incremental non-generational non-moving mark&sweep garbage collector.
+ * Luau uses an incremental non-moving mark&sweep garbage collector, with an optional generational mode described below.
  *
  * The collector runs in three stages: mark, atomic and sweep. Mark and sweep are incremental and try to do a limited amount
  * of work every GC step; atomic is ran once per the GC cycle and is indivisible. In either case, the work happens during GC
@@ -114,6 +121,19 @@
  * as black (doing so would violate the GC invariant), and they are kept in a special global list (global_State::uvhead) which is traversed
  * during atomic phase. This is needed because an open upvalue might point to a stack location in a dead thread that never marked the stack
  * slot - upvalues like this are identified since they don't have `markedopen` bit set during thread traversal and closed in `clearupvals`.
+ *
+ * In generational mode (see LUA_GCGEN), the sweep may keep the marks of surviving objects instead of turning them white ("sticky" marks);
+ * such objects get the old bit set. The following collection is then a minor one: old objects are black (or gray, for objects that are
+ * never black), so marking never reaches them and only traverses young objects. This is correct because the tri-color invariant is kept
+ * all the time after a sticky sweep starts - any reference from an old black object to a young white object has to go through one of the
+ * existing write barriers, which either mark the young object or turn the old object gray and queue it on `grayagain`. As such, `gray`
+ * and `grayagain` lists are not reset when a minor collection starts, and act as a remembered set. Minor collections only free young
+ * objects, since old objects are never white; periodically, the collector runs a major collection by making the sweep before it reset
+ * the marks, which results in a regular collection cycle that traverses the entire heap.
+ *
+ * Old objects that are traversed on every cycle in incremental mode need special care: weak tables are kept on `grayagain` so that
+ * their entries are cleared on every minor collection, and open upvalues of old threads that were not traversed are still considered
+ * to be alive by `clearupvals`.
  */
 
 #define GC_SWEEPPAGESTEPCOST 16
@@ -125,7 +145,7 @@
             interrupt(L, state); \
     }
 
-#define maskmarks cast_byte(~(bitmask(BLACKBIT) | WHITEBITS))
+#define maskmarks cast_byte(~(bitmask(BLACKBIT) | WHITEBITS | bitmask(OLDBIT)))
 
 #define makewhite(g, x) ((x)->gch.marked = cast_byte(((x)->gch.marked & maskmarks) | luaC_white(g)))
 
@@ -134,6 +154,20 @@
 
 #define stringmark(s) reset2bits((s)->marked, WHITE0BIT, WHITE1BIT)
 
+/*
+** mark bits may be changed by multiple threads when marking runs in parallel (see GCParallelWorker::markobj), so all updates of
+** GCheader::marked that can happen during parallel marking use atomic operations
+*/
+#ifdef _MSC_VER
+#define gcatomicand(p, v) uint8_t(_InterlockedAnd8((volatile char*)(p), char(v)))
+#define gcatomicor(p, v) uint8_t(_InterlockedOr8((volatile char*)(p), char(v)))
+#define gcatomicload(p) (*(volatile uint8_t*)(p))
+#else
+#define gcatomicand(p, v) __atomic_fetch_and((p), uint8_t(v), __ATOMIC_RELAXED)
+#define gcatomicor(p, v) __atomic_fetch_or((p), uint8_t(v), __ATOMIC_RELAXED)
+#define gcatomicload(p) __atomic_load_n((p), __ATOMIC_RELAXED)
+#endif
+
 #define markvalue(g, o) \
     { \
         checkconsistency(o); \
@@ -216,6 +250,11 @@ static void finishGcCycleMetrics(global_State* g)
     g->gcmetrics.currcycle.endtotalsizebytes = g->totalbytes;
 
     g->gcmetrics.completedcycles++;
+
+    if (g->gcminor)
+        g->gcmetrics.completedminorcycles++;
+    else
+        g->gcmetrics.completedmajorcycles++;
     g->gcmetrics.lastcycle = g->gcmetrics.currcycle;
     g->gcmetrics.currcycle = GCCycleMetrics();
 
@@ -296,24 +335,91 @@ static const char* gettablemode(global_State* g, Table* h)
     return NULL;
 }
 
-static int traversetable(global_State* g, Table* h)
+/*
+** Traversal of gray objects is shared between incremental marking and the parallel marking of the atomic stage (see
+** GCParallelWorker); the marker provides the operations that differ between the two: marking an object, queueing
+** objects on gray and weak lists, and updating the color of an object that is being traversed.
+*/
+struct GCMarker
+{
+    global_State* g;
+
+    void markobj(GCObject* o)
+    {
+        if (iswhite(o))
+            reallymarkobject(g, o);
+    }
+
+    // values and node keys (TKey) share the layout of type tag and value
+    template<typename T>
+    void markval(const T* o)
+    {
+        markvalue(g, o);
+    }
+
+    void markstr(TString* s)
+    {
+        stringmark(s);
+    }
+
+    const char* tablemode(Table* h)
+    {
+        return gettablemode(g, h);
+    }
+
+    void popgray(GCObject* next)
+    {
+        g->gray = next;
+    }
+
+    void pushgrayagain(lua_State* th)
+    {
+        th->gclist = g->grayagain;
+        g->grayagain = obj2gco(th);
+    }
+
+    void pushweak(Table* h)
+    {
+        h->gclist = g->weak;
+        g->weak = obj2gco(h);
+    }
+
+    void blacken(GCObject* o)
+    {
+        gray2black(o);
+    }
+
+    void keepgray(GCObject* o)
+    {
+        black2gray(o);
+    }
+};
+
+template<typename Marker>
+static int traversetable(Marker& m, Table* h)
 {
     int i;
     int weakkey = 0;
     int weakvalue = 0;
     if (h->metatable)
-        markobject(g, cast_to(Table*, h->metatable));
+        m.markobj(obj2gco(h->metatable));
+
+    // shape keys are strings, which are never removed from weak tables, so they are marked regardless of the mode
+    if (isshaped(h))
+    {
+        TableShape* s = gshape(h);
+        i = s->count;
+        while (i--)
+            m.markobj(obj2gco(s->keys[i]));
+    }
 
     // is there a weak mode?
-    if (const char* modev = gettablemode(g, h))
+    if (const char* modev = m.tablemode(h))
     {
         weakkey = (strchr(modev, 'k') != NULL);
         weakvalue = (strchr(modev, 'v') != NULL);
-        if (weakkey || weakvalue)
-        {                         // is really weak?
-            h->gclist = g->weak;  // must be cleared after GC, ...
-            g->weak = obj2gco(h); // ... so put in the appropriate list
-        }
+        if (weakkey || weakvalue) // is really weak?
+            m.pushweak(h);        // must be cleared after GC
     }
 
     if (weakkey && weakvalue)
@@ -322,9 +428,13 @@ static int traversetable(global_State* g, Table* h)
     {
         i = h->sizearray;
         while (i--)
-            markvalue(g, &h->array[i]);
+            m.markval(&h->array[i]);
+        i = isshaped(h) ? gshape(h)->count : 0;
+        while (i--)
+            m.markval(&gslots(h)[i]);
     }
-    i = sizenode(h);
+    // nodes of tables with a shape only hold the shape
+    i = isshaped(h) ? 0 : sizenode(h);
     while (i--)
     {
         LuaNode* n = gnode(h, i);
@@ -335,9 +445,9 @@ static int traversetable(global_State* g, Table* h)
         {
             LUAU_ASSERT(!ttisnil(gkey(n)));
             if (!weakkey)
-                markvalue(g, gkey(n));
+                m.markval(gkey(n));
             if (!weakvalue)
-                markvalue(g, gval(n));
+                m.markval(gval(n));
         }
     }
     return weakkey || weakvalue;
@@ -347,63 +457,68 @@ static int traversetable(global_State* g, Table* h)
 ** All marks are conditional because a GC may happen while the
 ** prototype is still being created
 */
-static void traverseproto(global_State* g, Proto* f)
+template<typename Marker>
+static void traverseproto(Marker& m, Proto* f)
 {
     int i;
     if (f->source)
-        stringmark(f->source);
+        m.markstr(f->source);
     if (f->debugname)
-        stringmark(f->debugname);
+        m.markstr(f->debugname);
     for (i = 0; i < f->sizek; i++) // mark literals
-        markvalue(g, &f->k[i]);
+        m.markval(&f->k[i]);
     for (i = 0; i < f->sizeupvalues; i++)
     { // mark upvalue names
         if (f->upvalues[i])
-            stringmark(f->upvalues[i]);
+            m.markstr(f->upvalues[i]);
     }
     for (i = 0; i < f->sizep; i++)
     { // mark nested protos
         if (f->p[i])
-            markobject(g, f->p[i]);
+            m.markobj(obj2gco(f->p[i]));
     }
     for (i = 0; i < f->sizelocvars; i++)
     { // mark local-variable names
         if (f->locvars[i].varname)
-            stringmark(f->locvars[i].varname);
+            m.markstr(f->locvars[i].varname);
     }
+    for (i = 0; i < f->sizenativerefs; i++) // mark objects referenced by native code
+        m.markobj(f->nativerefs[i]);
 }
 
-static void traverseclosure(global_State* g, Closure* cl)
+template<typename Marker>
+static void traverseclosure(Marker& m, Closure* cl)
 {
-    markobject(g, cl->env);
+    m.markobj(obj2gco(cl->env));
     if (cl->isC)
     {
         int i;
         for (i = 0; i < cl->nupvalues; i++) // mark its upvalues
-            markvalue(g, &cl->c.upvals[i]);
+            m.markval(&cl->c.upvals[i]);
     }
     else
     {
         int i;
         LUAU_ASSERT(cl->nupvalues == cl->l.p->nups);
-        markobject(g, cast_to(Proto*, cl->l.p));
+        m.markobj(obj2gco(cl->l.p));
         for (i = 0; i < cl->nupvalues; i++) // mark its upvalues
-            markvalue(g, &cl->l.uprefs[i]);
+            m.markval(&cl->l.uprefs[i]);
     }
 }
 
-static void traversestack(global_State* g, lua_State* l)
+template<typename Marker>
+static void traversestack(Marker& m, lua_State* l)
 {
-    markobject(g, l->gt);
+    m.markobj(obj2gco(l->gt));
     if (l->namecall)
-        stringmark(l->namecall);
+        m.markstr(l->namecall);
     for (StkId o = l->stack; o < l->top; o++)
-        markvalue(g, o);
+        m.markval(o);
     for (UpVal* uv = l->openupval; uv; uv = uv->u.open.threadnext)
     {
         LUAU_ASSERT(upisopen(uv));
         uv->markedopen = 1;
-        markobject(g, uv);
+        m.markobj(obj2gco(uv));
     }
 }
 
@@ -439,47 +554,46 @@ static void shrinkstack(lua_State* L)
 }
 
 /*
-** traverse one gray object, turning it to black.
+** traverse the first gray object of the marker, turning it to black.
 ** Returns `quantity' traversed.
 */
-static size_t propagatemark(global_State* g)
+template<typename Marker>
+static size_t traversegray(Marker& m, GCObject* o)
 {
-    GCObject* o = g->gray;
+    global_State* g = m.g;
     LUAU_ASSERT(isgray(o));
-    gray2black(o);
+    m.blacken(o);
     switch (o->gch.tt)
     {
     case LUA_TTABLE:
     {
         Table* h = gco2h(o);
-        g->gray = h->gclist;
-        if (traversetable(g, h)) // table is weak?
-            black2gray(o);       // keep it gray
-        return sizeof(Table) + sizeof(TValue) * h->sizearray + sizeof(LuaNode) * sizenode(h);
+        m.popgray(h->gclist);
+        if (traversetable(m, h)) // table is weak?
+            m.keepgray(o);       // keep it gray
+        return sizeof(Table) + sizeof(TValue) * (h->sizearray + sizeslots(h)) + sizeof(LuaNode) * sizenode(h);
     }
     case LUA_TFUNCTION:
     {
         Closure* cl = gco2cl(o);
-        g->gray = cl->gclist;
-        traverseclosure(g, cl);
+        m.popgray(cl->gclist);
+        traverseclosure(m, cl);
         return cl->isC ? sizeCclosure(cl->nupvalues) : sizeLclosure(cl->nupvalues);
     }
     case LUA_TTHREAD:
     {
         lua_State* th = gco2th(o);
-        g->gray = th->gclist;
+        m.popgray(th->gclist);
 
         bool active = th->isactive || th == th->global->mainthread;
 
-        traversestack(g, th);
+        traversestack(m, th);
 
         // active threads will need to be rescanned later to mark new stack writes so we mark them gray again
         if (active)
         {
-            th->gclist = g->grayagain;
-            g->grayagain = o;
-
-            black2gray(o);
+            m.pushgrayagain(th);
+            m.keepgray(o);
         }
 
         // the stack needs to be cleared after the last modification of the thread state before sweep begins
@@ -496,8 +610,8 @@ static size_t propagatemark(global_State* g)
     case LUA_TPROTO:
     {
         Proto* p = gco2p(o);
-        g->gray = p->gclist;
-        traverseproto(g, p);
+        m.popgray(p->gclist);
+        traverseproto(m, p);
         return sizeof(Proto) + sizeof(Instruction) * p->sizecode + sizeof(Proto*) * p->sizep + sizeof(TValue) * p->sizek + p->sizelineinfo +
                sizeof(LocVar) * p->sizelocvars + sizeof(TString*) * p->sizeupvalues;
     }
@@ -507,6 +621,12 @@ static size_t propagatemark(global_State* g)
     }
 }
 
+static size_t propagatemark(global_State* g)
+{
+    GCMarker m = {g};
+    return traversegray(m, g->gray);
+}
+
 static size_t propagateall(global_State* g)
 {
     size_t work = 0;
@@ -527,7 +647,9 @@ static int isobjcleared(GCObject* o)
 {
     if (o->gch.tt == LUA_TSTRING)
     {
-        stringmark(&o->ts); // strings are `values', so are never weak
+        // strings are `values', so are never weak; the mark is atomic because weak tables may be cleared in parallel
+        if (gcatomicload(&o->gch.marked) & WHITEBITS)
+            gcatomicand(&o->gch.marked, ~WHITEBITS);
         return 0;
     }
 
@@ -537,55 +659,74 @@ static int isobjcleared(GCObject* o)
 #define iscleared(o) (iscollectable(o) && isobjcleared(gcvalue(o)))
 
 /*
-** clear collected entries from weaktables
+** clear collected entries from a weak table, returning the number of entries that are left
 */
-static size_t cleartable(lua_State* L, GCObject* l)
+static int clearentries(Table* h)
 {
-    size_t work = 0;
-    while (l)
+    int i = h->sizearray;
+    while (i--)
     {
-        Table* h = gco2h(l);
-        work += sizeof(Table) + sizeof(TValue) * h->sizearray + sizeof(LuaNode) * sizenode(h);
+        TValue* o = &h->array[i];
+        if (iscleared(o))   // value was collected?
+            setnilvalue(o); // remove value
+    }
+    i = isshaped(h) ? gshape(h)->count : 0;
+    while (i--)
+    {
+        TValue* o = &gslots(h)[i];
+        if (iscleared(o))   // value was collected?
+            setnilvalue(o); // remove value
+    }
+    i = sizenode(h);
+    int activevalues = 0;
+    while (i--)
+    {
+        LuaNode* n = gnode(h, i);
 
-        int i = h->sizearray;
-        while (i--)
-        {
-            TValue* o = &h->array[i];
-            if (iscleared(o))   // value was collected?
-                setnilvalue(o); // remove value
-        }
-        i = sizenode(h);
-        int activevalues = 0;
-        while (i--)
+        // non-empty entry?
+        if (!ttisnil(gval(n)))
         {
-            LuaNode* n = gnode(h, i);
-
-            // non-empty entry?
-            if (!ttisnil(gval(n)))
+            // can we clear key or value?
+            if (iscleared(gkey(n)) || iscleared(gval(n)))
             {
-                // can we clear key or value?
-                if (iscleared(gkey(n)) || iscleared(gval(n)))
-                {
-                    setnilvalue(gval(n)); // remove value ...
-                    removeentry(n);       // remove entry from table
-                }
-                else
-                {
-                    activevalues++;
-                }
+                setnilvalue(gval(n)); // remove value ...
+                removeentry(n);       // remove entry from table
+            }
+            else
+            {
+                activevalues++;
             }
         }
+    }
+    return activevalues;
+}
 
-        if (const char* modev = gettablemode(L->global, h))
+static void shrinkweak(lua_State* L, Table* h, int activevalues)
+{
+    if (const char* modev = gettablemode(L->global, h))
+    {
+        // are we allowed to shrink this weak table?
+        if (strchr(modev, 's'))
         {
-            // are we allowed to shrink this weak table?
-            if (strchr(modev, 's'))
-            {
-                // shrink at 37.5% occupancy
-                if (activevalues < sizenode(h) * 3 / 8)
-                    luaH_resizehash(L, h, activevalues);
-            }
+            // shrink at 37.5% occupancy
+            if (activevalues < sizenode(h) * 3 / 8)
+                luaH_resizehash(L, h, activevalues);
         }
+    }
+}
+
+/*
+** clear collected entries from weaktables
+*/
+static size_t cleartable(lua_State* L, GCObject* l)
+{
+    size_t work = 0;
+    while (l)
+    {
+        Table* h = gco2h(l);
+        work += sizeof(Table) + sizeof(TValue) * (h->sizearray + sizeslots(h)) + sizeof(LuaNode) * sizenode(h);
+
+        shrinkweak(L, h, clearentries(h));
 
         l = h->gclist;
     }
@@ -626,7 +767,9 @@ static void freeobj(lua_State* L, GCObject* o, lua_Page* page)
 static void shrinkbuffers(lua_State* L)
 {
     global_State* g = L->global;
-    // check size of string hash
+    // check size of string hash; shrinking has to wait for the incremental resize in progress to finish
+    if (g->strt.oldhash)
+        return;
     if (g->strt.nuse < cast_to(uint32_t, g->strt.size / 4) && g->strt.size > LUA_MINSTRTABSIZE * 2)
         luaS_resize(L, g->strt.size / 2); // table is too big
 }
@@ -649,6 +792,31 @@ static bool deletegco(void* context, lua_Page* page, GCObject* gco)
     return true;
 }
 
+static bool whitengco(void* context, lua_Page* page, GCObject* gco)
+{
+    lua_State* L = (lua_State*)context;
+    global_State* g = L->global;
+
+    LUAU_ASSERT(!isdead(g, gco));
+    makewhite(g, gco);
+    return false;
+}
+
+// reset marks of all objects, including old ones; must be called between collections
+static void whitenall(lua_State* L)
+{
+    global_State* g = L->global;
+
+    LUAU_ASSERT(g->gcstate == GCSpause);
+    luaM_visitgco(L, L, whitengco);
+    makewhite(g, obj2gco(g->mainthread));
+
+    g->gray = NULL;
+    g->grayagain = NULL;
+    g->weak = NULL;
+    g->gcsticky = 0;
+}
+
 void luaC_freeall(lua_State* L)
 {
     global_State* g = L->global;
@@ -657,6 +825,10 @@ void luaC_freeall(lua_State* L)
 
     luaM_visitgco(L, L, deletegco);
 
+    // finish pending string table resize; all buckets are empty at this point
+    if (g->strt.oldhash)
+        luaS_rehash(L, g->strt.oldsize);
+
     for (int i = 0; i < g->strt.size; i++) // free all string lists
         LUAU_ASSERT(g->strt.hash[i] == NULL);
 
@@ -671,13 +843,50 @@ static void markmt(global_State* g)
             markobject(g, g->mt[i]);
 }
 
+// mark keys of all shapes, since shapes of dead tables can still be reused by new tables until the dead tables are swept
+static size_t markshapes(global_State* g)
+{
+    size_t work = 0;
+
+    // each shape adds one key to its parent, so marking the last key of every shape marks all keys
+    TableShape* s = g->shaperoot ? g->shaperoot->children : NULL;
+
+    while (s)
+    {
+        markobject(g, s->keys[s->count - 1]);
+        work += sizeof(TableShape);
+
+        if (s->children)
+        {
+            s = s->children;
+        }
+        else
+        {
+            while (s && !s->sibling)
+                s = s->parent;
+
+            if (s)
+                s = s->sibling;
+        }
+    }
+
+    return work;
+}
+
 // mark root set
 static void markroot(lua_State* L)
 {
     global_State* g = L->global;
-    g->gray = NULL;
-    g->grayagain = NULL;
-    g->weak = NULL;
+
+    // after a sticky sweep, old objects stay marked and gray lists hold objects that refer to young ones
+    g->gcminor = g->gcsticky;
+
+    if (!g->gcminor)
+    {
+        g->gray = NULL;
+        g->grayagain = NULL;
+    }
+    LUAU_ASSERT(g->weak == NULL);
     markobject(g, g->mainthread);
     // make global table be traversed before main stack
     markobject(g, g->mainthread->gt);
@@ -720,7 +929,9 @@ static size_t clearupvals(lua_State* L)
         LUAU_ASSERT(!isblack(obj2gco(uv))); // open upvalues are never black
         LUAU_ASSERT(iswhite(obj2gco(uv)) || !iscollectable(uv->v) || !iswhite(gcvalue(uv->v)));
 
-        if (uv->markedopen)
+        // note: open upvalues only survive a collection if their thread is alive and traversed, so old upvalues belong to old threads
+        // which may not be traversed during minor collections but are still alive
+        if (uv->markedopen || isold(obj2gco(uv)))
         {
             // upvalue is still open (belongs to alive thread)
             LUAU_ASSERT(isgray(obj2gco(uv)));
@@ -739,6 +950,472 @@ static size_t clearupvals(lua_State* L)
     return work;
 }
 
+// decide if marks of surviving objects should be kept during the next sweep, making the following collection a minor one
+static bool keepmarks(global_State* g)
+{
+    if (!g->gcgen)
+        return false;
+
+    // a major collection is always followed by a minor collection
+    if (!g->gcminor)
+        return true;
+
+    // start a major collection once the heap that was left after a minor collection grows too much
+    return g->gcgenlastsize <= g->gcgenmajorbase / 100 * (100 + g->gcgenmajormul);
+}
+
+/*
+** Parallel marking (see LUA_GCSETWORKERS)
+**
+** Atomic stage is indivisible, so on large heaps it can take a long time; when the host provides a 'gcparallel' callback, the
+** work of marking the objects that are still gray and of clearing the weak tables is split between multiple worker threads.
+** Only the atomic stage uses workers: it's the only stage that doesn't interleave with the mutator, and the only stage that
+** has to finish marking in one go.
+**
+** Each worker has its own gray list and traverses objects with the same code as propagatemark (see GCMarker). An object is
+** marked by the worker that clears its white bits, which is done atomically so that each object is queued exactly once; all
+** other updates to mark bits are also atomic, since the mark byte of an object may be updated by multiple workers at the same
+** time.
+**
+** Workers share gray objects through a pool protected by a spinlock: a worker that runs out of work takes a batch of objects
+** from the pool, and a worker that has a lot of work while the pool is empty donates half of its gray list to the pool. The
+** work is done when the pool is empty and no worker is in the middle of processing a batch. This works even if the host runs
+** the tasks one after another, in which case the first worker marks everything.
+*/
+#define GC_PARALLEL_BATCH 32
+#define GC_PARALLEL_SHARELIMIT 64
+
+struct GCParallelMark;
+
+// marker used by each worker thread (see GCMarker)
+struct GCParallelWorker
+{
+    GCParallelMark* pm;
+    global_State* g;
+
+    GCObject* gray; // gray objects that this worker has to traverse
+    int graycount;
+
+    GCObject* grayagain; // threads that have to be traversed again by the next stage
+    GCObject* weak;      // weak tables that have to be cleared
+
+    size_t work;
+
+    void markobj(GCObject* o);
+
+    template<typename T>
+    void markval(const T* o)
+    {
+        checkconsistency(o);
+        if (iscollectable(o))
+            markobj(gcvalue(o));
+    }
+
+    void markstr(TString* s)
+    {
+        markobj(obj2gco(s));
+    }
+
+    const char* tablemode(Table* h);
+
+    void popgray(GCObject* next)
+    {
+        gray = next;
+        graycount--;
+    }
+
+    void pushgrayagain(lua_State* th)
+    {
+        th->gclist = grayagain;
+        grayagain = obj2gco(th);
+    }
+
+    void pushweak(Table* h)
+    {
+        h->gclist = weak;
+        weak = obj2gco(h);
+    }
+
+    void blacken(GCObject* o)
+    {
+        gcatomicor(&o->gch.marked, bitmask(BLACKBIT));
+    }
+
+    void keepgray(GCObject* o)
+    {
+        gcatomicand(&o->gch.marked, ~bitmask(BLACKBIT));
+    }
+};
+
+struct GCParallelMark
+{
+    global_State* g;
+
+    std::atomic<bool> lock;
+    GCObject* pool; // protected by lock
+    std::atomic<int> poolcount;
+    int busy; // number of workers that are traversing objects taken from the pool; protected by lock
+
+    bool remarkupvals; // workers need to remark open upvalues before marking
+    GCObject* weak;    // weak tables that need to be cleared
+
+    int workers;
+    GCParallelWorker worker[LUA_GCMAXWORKERS];
+};
+
+static void parlock(GCParallelMark* pm)
+{
+    while (pm->lock.exchange(true, std::memory_order_acquire))
+        std::this_thread::yield();
+}
+
+static void parunlock(GCParallelMark* pm)
+{
+    pm->lock.store(false, std::memory_order_release);
+}
+
+static GCObject** getgclist(GCObject* o)
+{
+    switch (o->gch.tt)
+    {
+    case LUA_TTABLE:
+        return &gco2h(o)->gclist;
+    case LUA_TFUNCTION:
+        return &gco2cl(o)->gclist;
+    case LUA_TTHREAD:
+        return &gco2th(o)->gclist;
+    case LUA_TPROTO:
+        return &gco2p(o)->gclist;
+    default:
+        LUAU_ASSERT(0);
+        return NULL;
+    }
+}
+
+void GCParallelWorker::markobj(GCObject* o)
+{
+    if (!(gcatomicload(&o->gch.marked) & WHITEBITS))
+        return;
+
+    // only one worker can observe the white bits when clearing them, and that worker is responsible for the object
+    if (!(gcatomicand(&o->gch.marked, ~WHITEBITS) & WHITEBITS))
+        return;
+
+    switch (o->gch.tt)
+    {
+    case LUA_TSTRING:
+    {
+        return;
+    }
+    case LUA_TUSERDATA:
+    {
+        Table* mt = gco2u(o)->metatable;
+        blacken(o); // udata are never gray
+        if (mt)
+            markobj(obj2gco(mt));
+        return;
+    }
+    case LUA_TUPVAL:
+    {
+        UpVal* uv = gco2uv(o);
+        markval(uv->v);
+        if (!upisopen(uv)) // closed?
+            blacken(o);    // open upvalues are never black
+        return;
+    }
+    default:
+    {
+        GCObject** gclist = getgclist(o);
+        *gclist = gray;
+        gray = o;
+        graycount++;
+        break;
+    }
+    }
+}
+
+// same as gettablemode, but doesn't update the metatable cache, which may be read by other workers
+const char* GCParallelWorker::tablemode(Table* h)
+{
+    Table* mt = h->metatable;
+
+    if (!mt || (mt->tmcache & (1u << TM_MODE)))
+        return NULL;
+
+    const TValue* mode = luaH_getstr(mt, g->tmname[TM_MODE]);
+
+    if (ttisstring(mode))
+        return svalue(mode);
+
+    return NULL;
+}
+
+// move first 'count' objects from the worker gray list to the shared pool
+static void pardonate(GCParallelWorker* w, int count)
+{
+    LUAU_ASSERT(count > 0 && count <= w->graycount);
+    GCParallelMark* pm = w->pm;
+
+    GCObject* first = w->gray;
+    GCObject* last = first;
+    for (int i = 1; i < count; i++)
+        last = *getgclist(last);
+
+    w->gray = *getgclist(last);
+    w->graycount -= count;
+
+    parlock(pm);
+    *getgclist(last) = pm->pool;
+    pm->pool = first;
+    pm->poolcount.store(pm->poolcount.load(std::memory_order_relaxed) + count, std::memory_order_relaxed);
+    parunlock(pm);
+}
+
+static void pardrain(GCParallelWorker* w)
+{
+    GCParallelMark* pm = w->pm;
+
+    while (w->gray)
+    {
+        // share half of our work if other workers have nothing to take
+        if (w->graycount > GC_PARALLEL_SHARELIMIT && pm->poolcount.load(std::memory_order_relaxed) == 0)
+            pardonate(w, w->graycount / 2);
+
+        w->work += traversegray(*w, w->gray);
+    }
+}
+
+static void parmarktask(void* context, int worker)
+{
+    GCParallelMark* pm = (GCParallelMark*)context;
+    GCParallelWorker* w = &pm->worker[worker];
+    global_State* g = pm->g;
+
+    LUAU_ASSERT(unsigned(worker) < unsigned(pm->workers));
+
+    if (pm->remarkupvals)
+    {
+        parlock(pm);
+        pm->busy++;
+        parunlock(pm);
+
+        // each worker remarks its share of open upvalues, see remarkupvals
+        int index = 0;
+        for (UpVal* uv = g->uvhead.u.open.next; uv != &g->uvhead; uv = uv->u.open.next, index++)
+        {
+            if (index % pm->workers != worker)
+                continue;
+
+            w->work += sizeof(UpVal);
+
+            LUAU_ASSERT(upisopen(uv));
+
+            if (!(gcatomicload(&uv->marked) & (WHITEBITS | bitmask(BLACKBIT))))
+                w->markval(uv->v);
+        }
+
+        pardrain(w);
+
+        parlock(pm);
+        pm->busy--;
+        parunlock(pm);
+    }
+
+    for (;;)
+    {
+        parlock(pm);
+
+        if (pm->pool)
+        {
+            int count = 0;
+            GCObject* last = pm->pool;
+            while (count + 1 < GC_PARALLEL_BATCH && *getgclist(last))
+            {
+                last = *getgclist(last);
+                count++;
+            }
+            count++;
+
+            LUAU_ASSERT(!w->gray);
+            w->gray = pm->pool;
+            w->graycount = count;
+            pm->pool = *getgclist(last);
+            *getgclist(last) = NULL;
+            pm->poolcount.store(pm->poolcount.load(std::memory_order_relaxed) - count, std::memory_order_relaxed);
+            pm->busy++;
+
+            parunlock(pm);
+
+            pardrain(w);
+
+            parlock(pm);
+            pm->busy--;
+            parunlock(pm);
+        }
+        else if (pm->busy == 0)
+        {
+            parunlock(pm);
+            break;
+        }
+        else
+        {
+            parunlock(pm);
+            std::this_thread::yield();
+        }
+    }
+}
+
+static void parcleartask(void* context, int worker)
+{
+    GCParallelMark* pm = (GCParallelMark*)context;
+    GCParallelWorker* w = &pm->worker[worker];
+
+    int index = 0;
+    for (GCObject* l = pm->weak; l; l = gco2h(l)->gclist, index++)
+    {
+        if (index % pm->workers != worker)
+            continue;
+
+        Table* h = gco2h(l);
+        w->work += sizeof(Table) + sizeof(TValue) * (h->sizearray + sizeslots(h)) + sizeof(LuaNode) * sizenode(h);
+
+        clearentries(h);
+    }
+}
+
+static void parinit(GCParallelMark* pm, global_State* g)
+{
+    pm->g = g;
+    pm->lock.store(false, std::memory_order_relaxed);
+    pm->pool = NULL;
+    pm->poolcount.store(0, std::memory_order_relaxed);
+    pm->busy = 0;
+    pm->remarkupvals = false;
+    pm->weak = NULL;
+    pm->workers = g->gcworkers;
+
+    for (int i = 0; i < pm->workers; i++)
+    {
+        GCParallelWorker* w = &pm->worker[i];
+        w->pm = pm;
+        w->g = g;
+        w->gray = NULL;
+        w->graycount = 0;
+        w->grayagain = NULL;
+        w->weak = NULL;
+        w->work = 0;
+    }
+}
+
+static size_t parrun(lua_State* L, GCParallelMark* pm, void (*task)(void* context, int worker))
+{
+    global_State* g = L->global;
+
+    g->cb.gcparallel(L, task, pm, pm->workers);
+
+    LUAU_ASSERT(pm->pool == NULL && pm->busy == 0);
+
+    size_t work = 0;
+
+    // merge worker results back into global lists
+    for (int i = 0; i < pm->workers; i++)
+    {
+        GCParallelWorker* w = &pm->worker[i];
+        LUAU_ASSERT(w->gray == NULL);
+
+        while (GCObject* o = w->grayagain)
+        {
+            lua_State* th = gco2th(o);
+            w->grayagain = th->gclist;
+            th->gclist = g->grayagain;
+            g->grayagain = o;
+        }
+
+        while (GCObject* o = w->weak)
+        {
+            Table* h = gco2h(o);
+            w->weak = h->gclist;
+            h->gclist = g->weak;
+            g->weak = o;
+        }
+
+        work += w->work;
+        w->work = 0;
+    }
+
+#ifdef LUAI_GCMETRICS
+    g->gcmetrics.currcycle.atomicworkers = pm->workers;
+#endif
+
+    return work;
+}
+
+static bool useparallel(global_State* g)
+{
+    return g->cb.gcparallel && g->gcworkers > 1;
+}
+
+// traverse all gray objects during atomic stage, using worker threads if they are available
+static size_t propagateatomic(lua_State* L, bool upvals)
+{
+    global_State* g = L->global;
+    LUAU_ASSERT(g->gcstate == GCSatomic);
+
+    if (!useparallel(g))
+    {
+        size_t work = upvals ? remarkupvals(g) : 0;
+        return work + propagateall(g);
+    }
+
+    GCParallelMark pm;
+    parinit(&pm, g);
+
+    pm.remarkupvals = upvals;
+    pm.pool = g->gray;
+    g->gray = NULL;
+
+    int count = 0;
+    for (GCObject* o = pm.pool; o; o = *getgclist(o))
+        count++;
+    pm.poolcount.store(count, std::memory_order_relaxed);
+
+    return parrun(L, &pm, parmarktask);
+}
+
+// remove collected objects from weak tables during atomic stage, using worker threads if they are available
+static size_t clearatomic(lua_State* L)
+{
+    global_State* g = L->global;
+
+    if (!useparallel(g))
+        return cleartable(L, g->weak);
+
+    GCParallelMark pm;
+    parinit(&pm, g);
+
+    pm.weak = g->weak;
+
+    size_t work = parrun(L, &pm, parcleartask);
+
+    // shrinking weak tables allocates memory, so it has to happen on the calling thread
+    for (GCObject* l = g->weak; l; l = gco2h(l)->gclist)
+    {
+        Table* h = gco2h(l);
+
+        const char* modev = gettablemode(g, h);
+        if (!modev || !strchr(modev, 's'))
+            continue;
+
+        int activevalues = 0;
+        for (int i = 0; i < sizenode(h); i++)
+            activevalues += !ttisnil(gval(gnode(h, i)));
+
+        shrinkweak(L, h, activevalues);
+    }
+
+    return work;
+}
+
 static size_t atomic(lua_State* L)
 {
     global_State* g = L->global;
@@ -750,10 +1427,8 @@ static size_t atomic(lua_State* L)
     double currts = lua_clock();
 #endif
 
-    // remark occasional upvalues of (maybe) dead threads
-    work += remarkupvals(g);
-    // traverse objects caught by write barrier and by 'remarkupvals'
-    work += propagateall(g);
+    // remark occasional upvalues of (maybe) dead threads and traverse objects caught by write barrier and by 'remarkupvals'
+    work += propagateatomic(L, /* upvals= */ true);
 
 #ifdef LUAI_GCMETRICS
     g->gcmetrics.currcycle.atomictimeupval += recordGcDeltaTime(currts);
@@ -765,7 +1440,8 @@ static size_t atomic(lua_State* L)
     LUAU_ASSERT(!iswhite(obj2gco(g->mainthread)));
     markobject(g, L); // mark running thread
     markmt(g);        // mark basic metatables (again)
-    work += propagateall(g);
+    work += markshapes(g);
+    work += propagateatomic(L, /* upvals= */ false);
 
 #ifdef LUAI_GCMETRICS
     g->gcmetrics.currcycle.atomictimeweak += recordGcDeltaTime(currts);
@@ -774,14 +1450,29 @@ static size_t atomic(lua_State* L)
     // remark gray again
     g->gray = g->grayagain;
     g->grayagain = NULL;
-    work += propagateall(g);
+    work += propagateatomic(L, /* upvals= */ false);
 
 #ifdef LUAI_GCMETRICS
     g->gcmetrics.currcycle.atomictimegray += recordGcDeltaTime(currts);
 #endif
 
     // remove collected objects from weak tables
-    work += cleartable(L, g->weak);
+    work += clearatomic(L);
+
+    g->gcsticky = keepmarks(g);
+
+    if (g->gcsticky)
+    {
+        // weak tables stay gray after the sweep and have to be traversed and cleared again by the next minor collection
+        while (GCObject* o = g->weak)
+        {
+            Table* h = gco2h(o);
+            g->weak = h->gclist;
+            h->gclist = g->grayagain;
+            g->grayagain = o;
+        }
+    }
+
     g->weak = NULL;
 
 #ifdef LUAI_GCMETRICS
@@ -820,6 +1511,7 @@ static int sweepgcopage(lua_State* L, lua_Page* page)
     LUAU_ASSERT(testbit(deadmask, FIXEDBIT)); // make sure we never sweep fixed objects
 
     int newwhite = luaC_white(g);
+    bool sticky = g->gcsticky;
 
     for (char* pos = start; pos != end; pos += blockSize)
     {
@@ -833,8 +1525,18 @@ static int sweepgcopage(lua_State* L, lua_Page* page)
         if ((gco->gch.marked ^ WHITEBITS) & deadmask)
         {
             LUAU_ASSERT(!isdead(g, gco));
-            // make it white (for next cycle)
-            gco->gch.marked = cast_byte((gco->gch.marked & maskmarks) | newwhite);
+
+            if (sticky)
+            {
+                // keep the mark; objects that were marked become old (young objects allocated during sweep are already white)
+                if (!iswhite(gco))
+                    l_setbit(gco->gch.marked, OLDBIT);
+            }
+            else
+            {
+                // make it white (for next cycle)
+                gco->gch.marked = cast_byte((gco->gch.marked & maskmarks) | newwhite);
+            }
         }
         else
         {
@@ -847,6 +1549,10 @@ static int sweepgcopage(lua_State* L, lua_Page* page)
         }
     }
 
+    // pages with few surviving objects are filled last, so that they can be freed once the remaining objects die
+    if (g->gcsparsepage)
+        luaM_demotesparsepage(L, page);
+
     return int(end - start) / blockSize;
 }
 
@@ -854,6 +1560,14 @@ static size_t gcstep(lua_State* L, size_t limit)
 {
     size_t cost = 0;
     global_State* g = L->global;
+
+    // continue incremental resize of the string table
+    if (g->strt.oldhash)
+    {
+        luaS_rehash(L, STRTAB_GCREHASHSTEP);
+        cost += STRTAB_GCREHASHSTEP * sizeof(TString*);
+    }
+
     switch (g->gcstate)
     {
     case GCSpause:
@@ -933,10 +1647,19 @@ static size_t gcstep(lua_State* L, size_t limit)
         {
             // don't forget to visit main thread, it's the only object not allocated in GCO pages
             LUAU_ASSERT(!isdead(g, obj2gco(g->mainthread)));
-            makewhite(g, obj2gco(g->mainthread)); // make it white (for next cycle)
+            if (!g->gcsticky)
+                makewhite(g, obj2gco(g->mainthread)); // make it white (for next cycle)
 
             shrinkbuffers(L);
 
+            // release empty pages that were not reused during the cycle
+            luaM_trimidlepages(L);
+
+            g->gcgenlastsize = g->totalbytes;
+
+            if (!g->gcminor)
+                g->gcgenmajorbase = g->totalbytes;
+
             g->gcstate = GCSpause; // end collection
         }
         break;
@@ -1035,8 +1758,8 @@ size_t luaC_step(lua_State* L, bool assist)
     // at the end of the last cycle
     if (g->gcstate == GCSpause)
     {
-        // at the end of a collection cycle, set goal based on gcgoal setting
-        size_t heapgoal = (g->totalbytes / 100) * g->gcgoal;
+        // at the end of a collection cycle, set goal based on gcgoal setting (or minor multiplier, if next collection is a minor one)
+        size_t heapgoal = (g->totalbytes / 100) * (g->gcsticky ? 100 + g->gcgenminormul : g->gcgoal);
         size_t heaptrigger = getheaptrigger(g, heapgoal);
 
         g->GCthreshold = heaptrigger;
@@ -1090,6 +1813,10 @@ void luaC_fullgc(lua_State* L)
         gcstep(L, SIZE_MAX);
     }
 
+    // full collection has to traverse old objects as well
+    if (g->gcsticky)
+        whitenall(L);
+
     // clear markedopen bits for all open upvalues; these might be stuck from half-finished mark prior to full gc
     for (UpVal* uv = g->uvhead.u.open.next; uv != &g->uvhead; uv = uv->u.open.next)
     {
@@ -1135,9 +1862,9 @@ void luaC_barrierf(lua_State* L, GCObject* o, GCObject* v)
 {
     global_State* g = L->global;
     LUAU_ASSERT(isblack(o) && iswhite(v) && !isdead(g, v) && !isdead(g, o));
-    LUAU_ASSERT(g->gcstate != GCSpause);
-    // must keep invariant?
-    if (keepinvariant(g))
+    LUAU_ASSERT(g->gcstate != GCSpause || g->gcsticky);
+    // must keep invariant? (old objects are not traversed by minor collections, so they can't be made white)
+    if (keepinvariantgen(g))
         reallymarkobject(g, v); // restore invariant
     else                        // don't mind
         makewhite(g, o);        // mark as white just to avoid other barriers
@@ -1157,7 +1884,7 @@ void luaC_barriertable(lua_State* L, Table* t, GCObject* v)
     }
 
     LUAU_ASSERT(isblack(o) && !isdead(g, o));
-    LUAU_ASSERT(g->gcstate != GCSpause);
+    LUAU_ASSERT(g->gcstate != GCSpause || g->gcsticky);
     black2gray(o); // make table gray (again)
     t->gclist = g->grayagain;
     g->grayagain = o;
@@ -1167,7 +1894,7 @@ void luaC_barrierback(lua_State* L, GCObject* o, GCObject** gclist)
 {
     global_State* g = L->global;
     LUAU_ASSERT(isblack(o) && !isdead(g, o));
-    LUAU_ASSERT(g->gcstate != GCSpause);
+    LUAU_ASSERT(g->gcstate != GCSpause || g->gcsticky);
 
     black2gray(o); // make object gray (again)
     *gclist = g->grayagain;
@@ -1183,7 +1910,7 @@ void luaC_upvalclosed(lua_State* L, UpVal* uv)
 
     if (isgray(o))
     {
-        if (keepinvariant(g))
+        if (keepinvariantgen(g))
         {
             gray2black(o); // closed upvalues need barrier
             luaC_barrier(L, uv, uv->v);
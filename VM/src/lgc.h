@@ -13,6 +13,10 @@
 #define LUAI_GCSTEPMUL 200 // GC runs 'twice the speed' of memory allocation
 #define LUAI_GCSTEPSIZE 1  // GC runs every KB of memory allocation
 
+// generational mode settings
+#define LUAI_GCGENMINORMUL 50  // 50% (minor collection starts after the heap grows by half)
+#define LUAI_GCGENMAJORMUL 100 // 100% (major collection starts after the heap doubles since the last major collection)
+
 /*
 ** Possible states of the Garbage Collector
 */
@@ -31,6 +35,12 @@
 */
 #define keepinvariant(g) ((g)->gcstate == GCSpropagate || (g)->gcstate == GCSpropagateagain || (g)->gcstate == GCSatomic)
 
+/*
+** in generational mode, sweep may keep the marks of surviving objects; this makes them old and the invariant is then kept
+** during the sweep and the pause that follows, so that write barriers can track references from old objects to young ones
+*/
+#define keepinvariantgen(g) (keepinvariant(g) || (g)->gcsticky)
+
 /*
 ** some useful bit tricks
 */
@@ -52,18 +62,21 @@
 ** bit 1 - object is white (type 1)
 ** bit 2 - object is black
 ** bit 3 - object is fixed (should not be collected)
+** bit 4 - object is old (survived a collection in generational mode and kept its mark)
 */
 
 #define WHITE0BIT 0
 #define WHITE1BIT 1
 #define BLACKBIT 2
 #define FIXEDBIT 3
+#define OLDBIT 4
 #define WHITEBITS bit2mask(WHITE0BIT, WHITE1BIT)
 
 #define iswhite(x) test2bits((x)->gch.marked, WHITE0BIT, WHITE1BIT)
 #define isblack(x) testbit((x)->gch.marked, BLACKBIT)
 #define isgray(x) (!testbits((x)->gch.marked, WHITEBITS | bitmask(BLACKBIT)))
 #define isfixed(x) testbit((x)->gch.marked, FIXEDBIT)
+#define isold(x) testbit((x)->gch.marked, OLDBIT)
 
 #define otherwhite(g) (g->currentwhite ^ WHITEBITS)
 #define isdead(g, v) (((v)->gch.marked & (WHITEBITS | bitmask(FIXEDBIT))) == (otherwhite(g) & WHITEBITS))
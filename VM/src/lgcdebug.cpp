@@ -17,7 +17,7 @@ static void validateobjref(global_State* g, GCObject* f, GCObject* t)
 {
     LUAU_ASSERT(!isdead(g, t));
 
-    if (keepinvariant(g))
+    if (keepinvariantgen(g))
     {
         // basic incremental invariant: black can't point to white
         LUAU_ASSERT(!(isblack(f) && iswhite(t)));
@@ -35,9 +35,13 @@ static void validateref(global_State* g, GCObject* f, TValue* v)
 
 static void validatetable(global_State* g, Table* h)
 {
-    int sizenode = 1 << h->lsizenode;
+    // nodes of tables with a shape only hold the shape
+    int sizenode = isshaped(h) ? 0 : 1 << h->lsizenode;
 
-    LUAU_ASSERT(h->lastfree <= sizenode);
+    if (isshaped(h))
+        LUAU_ASSERT(h->lsizenode == 0 && h->sizearray == 0 && sizeslots(h) >= gshape(h)->count);
+    else
+        LUAU_ASSERT(h->lastfree <= sizenode);
 
     if (h->metatable)
         validateobjref(g, obj2gco(h), obj2gco(h->metatable));
@@ -45,6 +49,15 @@ static void validatetable(global_State* g, Table* h)
     for (int i = 0; i < h->sizearray; ++i)
         validateref(g, obj2gco(h), &h->array[i]);
 
+    if (isshaped(h))
+    {
+        for (int i = 0; i < gshape(h)->count; ++i)
+        {
+            validateobjref(g, obj2gco(h), obj2gco(gshape(h)->keys[i]));
+            validateref(g, obj2gco(h), &gslots(h)[i]);
+        }
+    }
+
     for (int i = 0; i < sizenode; ++i)
     {
         LuaNode* n = &h->node[i];
@@ -181,7 +194,7 @@ static void validateobj(global_State* g, GCObject* o)
 
 static void validategraylist(global_State* g, GCObject* o)
 {
-    if (!keepinvariant(g))
+    if (!keepinvariantgen(g))
         return;
 
     while (o)
@@ -288,11 +301,12 @@ static void dumpstring(FILE* f, TString* ts)
 
 static void dumptable(FILE* f, Table* h)
 {
-    size_t size = sizeof(Table) + (h->node == &luaH_dummynode ? 0 : sizenode(h) * sizeof(LuaNode)) + h->sizearray * sizeof(TValue);
+    size_t size = sizeof(Table) + (h->node == &luaH_dummynode ? 0 : isshaped(h) ? 2 * sizeof(LuaNode) : sizenode(h) * sizeof(LuaNode)) +
+                  (h->sizearray + sizeslots(h)) * sizeof(TValue);
 
     fprintf(f, "{\"type\":\"table\",\"cat\":%d,\"size\":%d", h->memcat, int(size));
 
-    if (h->node != &luaH_dummynode)
+    if (h->node != &luaH_dummynode && !isshaped(h))
     {
         fprintf(f, ",\"pairs\":[");
 
@@ -324,6 +338,35 @@ static void dumptable(FILE* f, Table* h)
 
         fprintf(f, "]");
     }
+    if (isshaped(h))
+    {
+        fprintf(f, ",\"pairs\":[");
+
+        bool first = true;
+
+        for (int i = 0; i < gshape(h)->count; ++i)
+        {
+            const TValue* v = &gslots(h)[i];
+
+            if (!ttisnil(v))
+            {
+                if (!first)
+                    fputc(',', f);
+                first = false;
+
+                dumpref(f, obj2gco(gshape(h)->keys[i]));
+
+                fputc(',', f);
+
+                if (iscollectable(v))
+                    dumpref(f, gcvalue(v));
+                else
+                    fprintf(f, "null");
+            }
+        }
+
+        fprintf(f, "]");
+    }
     if (h->sizearray)
     {
         fprintf(f, ",\"array\":[");
@@ -475,8 +518,9 @@ static void dumpthread(FILE* f, lua_State* th)
 
 static void dumpproto(FILE* f, Proto* p)
 {
-    size_t size = sizeof(Proto) + sizeof(Instruction) * p->sizecode + sizeof(Proto*) * p->sizep + sizeof(TValue) * p->sizek + p->sizelineinfo +
-                  sizeof(LocVar) * p->sizelocvars + sizeof(TString*) * p->sizeupvalues;
+    // data shared with a bytecode image or mapping doesn't belong to this state
+    size_t size = sizeof(Proto) + (p->sharedcode ? 0 : sizeof(Instruction) * p->sizecode) + sizeof(Proto*) * p->sizep + sizeof(TValue) * p->sizek +
+                  (p->sharedinfo ? 0 : p->sizelineinfo) + sizeof(LocVar) * p->sizelocvars + sizeof(TString*) * p->sizeupvalues;
 
     fprintf(f, "{\"type\":\"proto\",\"cat\":%d,\"size\":%d", p->memcat, int(size));
 
@@ -646,20 +690,20 @@ static void enumtable(EnumContext* ctx, Table* h)
     // Provide a name for a special registry table
     enumnode(ctx, obj2gco(h), h == hvalue(registry(ctx->L)) ? "registry" : NULL);
 
-    if (h->node != &luaH_dummynode)
-    {
-        bool weakkey = false;
-        bool weakvalue = false;
+    bool weakkey = false;
+    bool weakvalue = false;
 
-        if (const TValue* mode = gfasttm(ctx->L->global, h->metatable, TM_MODE))
+    if (const TValue* mode = gfasttm(ctx->L->global, h->metatable, TM_MODE))
+    {
+        if (ttisstring(mode))
         {
-            if (ttisstring(mode))
-            {
-                weakkey = strchr(svalue(mode), 'k') != NULL;
-                weakvalue = strchr(svalue(mode), 'v') != NULL;
-            }
+            weakkey = strchr(svalue(mode), 'k') != NULL;
+            weakvalue = strchr(svalue(mode), 'v') != NULL;
         }
+    }
 
+    if (h->node != &luaH_dummynode)
+    {
         for (int i = 0; i < sizenode(h); ++i)
         {
             const LuaNode& n = h->node[i];
@@ -692,6 +736,25 @@ static void enumtable(EnumContext* ctx, Table* h)
         }
     }
 
+    if (isshaped(h))
+    {
+        TableShape* s = gshape(h);
+
+        for (int i = 0; i < s->count; ++i)
+        {
+            const TValue* v = &gslots(h)[i];
+
+            if (!ttisnil(v))
+            {
+                if (!weakkey)
+                    enumedge(ctx, obj2gco(h), obj2gco(s->keys[i]), "[key]");
+
+                if (!weakvalue && iscollectable(v))
+                    enumedge(ctx, obj2gco(h), gcvalue(v), getstr(s->keys[i]));
+            }
+        }
+    }
+
     if (h->sizearray)
         enumedges(ctx, obj2gco(h), h->array, h->sizearray, "array");
 
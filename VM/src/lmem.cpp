@@ -67,9 +67,14 @@
  * size up to reduce the chance that we'll allocate pages that have very few allocated blocks. The size
  * class strategy is determined by SizeClassConfig constructor.
  *
- * Note that when the last block in a page is freed, we immediately free the page with frealloc - the
- * memory manager doesn't currently attempt to keep unused memory around. This can result in excessive
- * allocation traffic and can be mitigated by adding a page cache in the future.
+ * When the last block in a page is freed, the page is placed into a page cache (global_State::pagecache)
+ * instead of being freed with frealloc, as long as the total size of cached pages doesn't exceed the limit
+ * (global_State::pagecachelimit, see LUA_GCSETPAGECACHE). Since all size class pages have the same size,
+ * the cached pages can be reused for any size class and for both GCO and non-GCO pages, which avoids the
+ * allocation traffic when the application allocates and frees objects of different sizes in quick
+ * succession. Pages for large GCOs are not cached. To avoid keeping unused memory around indefinitely,
+ * the cache tracks the smallest size it had during a GC cycle; at the end of the cycle, this many bytes
+ * worth of pages were not needed by the application at any point during the cycle and are freed.
  *
  * For both GCO and non-GCO pages, the per-page block allocation combines bump pointer style allocation
  * (lua_Page::freeNext) and per-page free list (lua_Page::freeList). We use the bump allocator to allocate
@@ -208,9 +213,25 @@ static lua_Page* newpage(lua_State* L, lua_Page** gcopageset, int pageSize, int
 
     LUAU_ASSERT(pageSize - int(offsetof(lua_Page, data)) >= blockSize * blockCount);
 
-    lua_Page* page = (lua_Page*)(*g->frealloc)(g->ud, NULL, 0, pageSize);
-    if (!page)
-        luaD_throw(L, LUA_ERRMEM);
+    lua_Page* page = NULL;
+
+    if (pageSize == kPageSize && g->pagecache)
+    {
+        page = g->pagecache;
+        ASAN_UNPOISON_MEMORY_REGION(page, offsetof(lua_Page, data));
+
+        g->pagecache = page->next;
+        g->pagecachebytes -= kPageSize;
+
+        if (g->pagecacheidle > g->pagecachebytes)
+            g->pagecacheidle = g->pagecachebytes;
+    }
+    else
+    {
+        page = (lua_Page*)(*g->frealloc)(g->ud, NULL, 0, pageSize);
+        if (!page)
+            luaD_throw(L, LUA_ERRMEM);
+    }
 
     ASAN_POISON_MEMORY_REGION(page->data, blockSize * blockCount);
 
@@ -272,10 +293,56 @@ static void freepage(lua_State* L, lua_Page** gcopageset, lua_Page* page)
             *gcopageset = page->gcolistnext;
     }
 
+    // keep the page around for reuse if the cache has space
+    if (page->pageSize == kPageSize && g->pagecachebytes + kPageSize <= g->pagecachelimit)
+    {
+        page->prev = NULL;
+        page->next = g->pagecache;
+        g->pagecache = page;
+        g->pagecachebytes += kPageSize;
+
+        ASAN_POISON_MEMORY_REGION(page, kPageSize);
+        return;
+    }
+
     // so long
     (*g->frealloc)(g->ud, page, page->pageSize, 0);
 }
 
+// free cached pages until the cache size doesn't exceed the limit; returns the number of freed bytes
+size_t luaM_trimpagecache(lua_State* L, size_t limit)
+{
+    global_State* g = L->global;
+    size_t freed = 0;
+
+    while (g->pagecache && g->pagecachebytes > limit)
+    {
+        lua_Page* page = g->pagecache;
+        ASAN_UNPOISON_MEMORY_REGION(page, kPageSize);
+
+        g->pagecache = page->next;
+        g->pagecachebytes -= kPageSize;
+        freed += kPageSize;
+
+        (*g->frealloc)(g->ud, page, kPageSize, 0);
+    }
+
+    if (g->pagecacheidle > g->pagecachebytes)
+        g->pagecacheidle = g->pagecachebytes;
+
+    return freed;
+}
+
+// free cached pages that were not reused since the last call; called at the end of every GC cycle
+void luaM_trimidlepages(lua_State* L)
+{
+    global_State* g = L->global;
+
+    luaM_trimpagecache(L, g->pagecachebytes - g->pagecacheidle);
+
+    g->pagecacheidle = g->pagecachebytes;
+}
+
 static void freeclasspage(lua_State* L, lua_Page** freepageset, lua_Page** gcopageset, lua_Page* page, uint8_t sizeClass)
 {
     // remove page from freelist
@@ -345,7 +412,10 @@ static void* newgcoblock(lua_State* L, int sizeClass)
 
     // slow path: no page in the freelist, allocate a new one
     if (!page)
+    {
         page = newclasspage(L, g->freegcopages, &g->allgcopages, sizeClass, false);
+        g->freegcopagestail[sizeClass] = page;
+    }
 
     LUAU_ASSERT(!page->prev);
     LUAU_ASSERT(page->freeList || page->freeNext >= 0);
@@ -377,6 +447,8 @@ static void* newgcoblock(lua_State* L, int sizeClass)
         g->freegcopages[sizeClass] = page->next;
         if (page->next)
             page->next->prev = NULL;
+        else
+            g->freegcopagestail[sizeClass] = NULL;
         page->next = NULL;
     }
 
@@ -438,6 +510,8 @@ static void freegcoblock(lua_State* L, int sizeClass, void* block, lua_Page* pag
         page->next = g->freegcopages[sizeClass];
         if (page->next)
             page->next->prev = page;
+        else
+            g->freegcopagestail[sizeClass] = page;
         g->freegcopages[sizeClass] = page;
     }
 
@@ -451,7 +525,12 @@ static void freegcoblock(lua_State* L, int sizeClass, void* block, lua_Page* pag
 
     // if it's the last block in the page, we don't need the page
     if (page->busyBlocks == 0)
+    {
+        if (g->freegcopagestail[sizeClass] == page)
+            g->freegcopagestail[sizeClass] = page->prev;
+
         freeclasspage(L, g->freegcopages, &g->allgcopages, page, sizeClass);
+    }
 }
 
 void* luaM_new_(lua_State* L, size_t nsize, uint8_t memcat)
@@ -603,6 +682,73 @@ lua_Page* luaM_getnextgcopage(lua_Page* page)
     return page->gcolistnext;
 }
 
+// move a sparse page to the end of the page free list, so that objects are allocated in denser pages first; this gives the
+// remaining objects in the page a chance to die, at which point the page is freed
+void luaM_demotesparsepage(lua_State* L, lua_Page* page)
+{
+    global_State* g = L->global;
+
+    // large objects are allocated in dedicated pages; pages that still have space at the end are being filled by the allocator
+    if (page->pageSize != kPageSize || page->freeNext >= 0)
+        return;
+
+    int blockCount = (kPageSize - offsetof(lua_Page, data)) / page->blockSize;
+
+    if (page->busyBlocks * 100 >= blockCount * g->gcsparsepage)
+        return;
+
+    int sizeClass = sizeclass(page->blockSize);
+    LUAU_ASSERT(sizeClass >= 0 && kSizeClassConfig.sizeOfClass[sizeClass] == page->blockSize);
+
+    // page is in the free list since it has free blocks; nothing to do if it's already at the end
+    lua_Page* tail = g->freegcopagestail[sizeClass];
+    LUAU_ASSERT(page->freeList && tail);
+
+    if (tail == page)
+        return;
+
+    // remove page from freelist
+    page->next->prev = page->prev;
+
+    if (page->prev)
+        page->prev->next = page->next;
+    else
+        g->freegcopages[sizeClass] = page->next;
+
+    // append it after the last page
+    page->prev = tail;
+    page->next = NULL;
+    tail->next = page;
+    g->freegcopagestail[sizeClass] = page;
+}
+
+// compute the size of live objects and the total size of pages for GCO pages of the given size class, or for all GCO pages if it's negative
+void luaM_getpagestats(lua_State* L, int sizeClass, size_t* usedBytes, size_t* pageBytes)
+{
+    global_State* g = L->global;
+
+    int blockSize = sizeClass < 0 ? 0 : kSizeClassConfig.sizeOfClass[sizeClass];
+
+    *usedBytes = 0;
+    *pageBytes = 0;
+
+    for (lua_Page* page = g->allgcopages; page; page = page->gcolistnext)
+    {
+        // note: large objects get dedicated pages that are sized to fit the block exactly and don't belong to any size class
+        if (sizeClass >= 0 && (page->pageSize != kPageSize || page->blockSize != blockSize))
+            continue;
+
+        *usedBytes += size_t(page->busyBlocks) * page->blockSize;
+        *pageBytes += page->pageSize;
+    }
+}
+
+// return the size of blocks that belong to the given size class, or 0 if the size class is not used
+int luaM_getsizeclasssize(int sizeClass)
+{
+    return size_t(sizeClass) < size_t(kSizeClassConfig.classCount) ? kSizeClassConfig.sizeOfClass[sizeClass] : 0;
+}
+
 void luaM_visitpage(lua_Page* page, void* context, bool (*visitor)(void* context, lua_Page* page, GCObject* gco))
 {
     char* start;
@@ -25,8 +25,15 @@ LUAI_FUNC void* luaM_realloc_(lua_State* L, void* block, size_t osize, size_t ns
 
 LUAI_FUNC l_noret luaM_toobig(lua_State* L);
 
+LUAI_FUNC size_t luaM_trimpagecache(lua_State* L, size_t limit);
+LUAI_FUNC void luaM_trimidlepages(lua_State* L);
+
 LUAI_FUNC void luaM_getpagewalkinfo(lua_Page* page, char** start, char** end, int* busyBlocks, int* blockSize);
 LUAI_FUNC lua_Page* luaM_getnextgcopage(lua_Page* page);
 
+LUAI_FUNC void luaM_demotesparsepage(lua_State* L, lua_Page* page);
+LUAI_FUNC void luaM_getpagestats(lua_State* L, int sizeClass, size_t* usedBytes, size_t* pageBytes);
+LUAI_FUNC int luaM_getsizeclasssize(int sizeClass);
+
 LUAI_FUNC void luaM_visitpage(lua_Page* page, void* context, bool (*visitor)(void* context, lua_Page* page, GCObject* gco));
 LUAI_FUNC void luaM_visitgco(lua_State* L, void* context, bool (*visitor)(void* context, lua_Page* page, GCObject* gco));
@@ -257,6 +257,12 @@ typedef struct Udata
 /*
 ** Function Prototypes
 */
+// type feedback recorded by the interpreter for each instruction in Proto::typeprofile
+#define LUA_TYPEPROFILE_NONNUMBER 1 // arithmetic operand wasn't a number
+#define LUA_TYPEPROFILE_NONTABLE 2  // GETTABLEKS/NAMECALL object wasn't a table
+#define LUA_TYPEPROFILE_VECTORB 4   // arithmetic took a vector fast path with a vector first operand
+#define LUA_TYPEPROFILE_VECTORC 8   // arithmetic took a vector fast path with a vector second operand
+
 // clang-format off
 typedef struct Proto
 {
@@ -290,6 +296,10 @@ typedef struct Proto
 
     uint8_t* typeinfo;
 
+    uint8_t* typeprofile; // for each instruction, LUA_TYPEPROFILE_* bits; only allocated for functions loaded while tiering is enabled
+
+    GCObject** nativerefs; // objects that native code compares against by identity; they are kept alive for as long as the function is
+
     void* userdata;
 
     GCObject* gclist;
@@ -304,6 +314,13 @@ typedef struct Proto
     int linegaplog2;
     int linedefined;
     int bytecodeid;
+    int sizenativerefs;
+
+    uint8_t sharedinfo; // lineinfo and typeinfo are owned by a bytecode image or mapping
+    uint8_t sharedcode; // code is owned by a bytecode mapping
+
+    unsigned int tierentries; // calls in the interpreter, see luaV_tierentry
+    unsigned int tierloops;   // loop iterations in the interpreter, see VM_TIER_LOOP
 } Proto;
 // clang-format on
 
@@ -393,6 +410,9 @@ typedef struct TKey
     int next : 28; // for chaining
 } TKey;
 
+// key tag of the node that holds the shape of a table in place of its hash part, see ltable.h
+#define LUA_TSHAPE (LUA_TDEADKEY + 1)
+
 typedef struct LuaNode
 {
     TValue val;
@@ -421,6 +441,25 @@ typedef struct LuaNode
         checkliveness(L->global, i_o); \
     }
 
+/*
+** Table shapes: shared layout of string keys for tables that store string-keyed fields densely instead of using a hash part
+*/
+typedef struct TableShape
+{
+    struct TableShape* parent;   // shape with the same keys except for the last one
+    struct TableShape* children; // shapes that extend this shape with one more key
+    struct TableShape* sibling;  // next child of the parent shape
+
+    int refs; // number of tables and child shapes that refer to this shape
+
+    uint8_t count;      // number of keys
+    uint8_t lsizeindex; // log2 of size of key index that follows the keys
+
+    TString* keys[1]; // keys in slot order, followed by an open addressing index that maps key hash to slot+1
+} TableShape;
+
+#define shapeindex(s) (cast_to(uint8_t*, &(s)->keys[(s)->count]))
+
 // clang-format off
 typedef struct Table
 {
@@ -436,7 +475,7 @@ typedef struct Table
     int sizearray; // size of `array' array
     union
     {
-        int lastfree;  // any free position is before this position
+        int lastfree;  // any free position is before this position; for tables with a shape, number of slots
         int aboundary; // negated 'boundary' of `array' array; iff aboundary < 0
     };
 
@@ -9,6 +9,7 @@
 #include "lgc.h"
 #include "ldo.h"
 #include "ldebug.h"
+#include "lvm.h"
 
 /*
 ** Main thread combines a thread state and the global state
@@ -87,13 +88,17 @@ static void close_state(lua_State* L)
     global_State* g = L->global;
     luaF_close(L, L->stack); // close all upvalues for this thread
     luaC_freeall(L);         // collect all objects
-    LUAU_ASSERT(g->strt.nuse == 0);
+    luaH_freeshapes(L);
+    luaV_releasebytecode(L); // functions that shared data with images and mappings are gone
+    LUAU_ASSERT(g->strt.nuse == 0 && g->strt.oldhash == NULL);
     luaM_freearray(L, L->global->strt.hash, L->global->strt.size, TString*, 0);
     freestack(L, L);
+    luaM_trimpagecache(L, 0);
     for (int i = 0; i < LUA_SIZECLASSES; i++)
     {
         LUAU_ASSERT(g->freepages[i] == NULL);
         LUAU_ASSERT(g->freegcopages[i] == NULL);
+        LUAU_ASSERT(g->freegcopagestail[i] == NULL);
     }
     LUAU_ASSERT(g->allgcopages == NULL);
     LUAU_ASSERT(g->totalbytes == sizeof(LG));
@@ -189,9 +194,15 @@ lua_State* lua_newstate(lua_Alloc f, void* ud)
     g->strt.size = 0;
     g->strt.nuse = 0;
     g->strt.hash = NULL;
+    g->strt.oldhash = NULL;
+    g->strt.oldsize = 0;
+    g->strt.oldpos = 0;
     setnilvalue(&g->pseudotemp);
     setnilvalue(registry(L));
     g->gcstate = GCSpause;
+    g->gcgen = 0;
+    g->gcsticky = 0;
+    g->gcminor = 0;
     g->gray = NULL;
     g->grayagain = NULL;
     g->weak = NULL;
@@ -199,13 +210,33 @@ lua_State* lua_newstate(lua_Alloc f, void* ud)
     g->gcgoal = LUAI_GCGOAL;
     g->gcstepmul = LUAI_GCSTEPMUL;
     g->gcstepsize = LUAI_GCSTEPSIZE << 10;
+    g->gcgenminormul = LUAI_GCGENMINORMUL;
+    g->gcgenmajormul = LUAI_GCGENMAJORMUL;
+    g->gcgenmajorbase = 0;
+    g->gcgenlastsize = 0;
+    g->gcsparsepage = 0;
+    g->gcworkers = 0;
     for (i = 0; i < LUA_SIZECLASSES; i++)
     {
         g->freepages[i] = NULL;
         g->freegcopages[i] = NULL;
+        g->freegcopagestail[i] = NULL;
     }
+    g->pagecache = NULL;
+    g->pagecachebytes = 0;
+    g->pagecachelimit = LUA_PAGECACHESIZE;
+    g->pagecacheidle = 0;
+
     g->allgcopages = NULL;
     g->sweepgcopage = NULL;
+    g->shaperoot = NULL;
+    g->shapecount = 0;
+    g->images = NULL;
+    g->sizeimages = 0;
+    g->nimages = 0;
+    g->mappings = NULL;
+    g->sizemappings = 0;
+    g->nmappings = 0;
     for (i = 0; i < LUA_T_COUNT; i++)
         g->mt[i] = NULL;
     for (i = 0; i < LUA_UTAG_LIMIT; i++)
@@ -22,6 +22,10 @@ typedef struct stringtable
     TString** hash;
     uint32_t nuse; // number of elements
     int size;
+
+    TString** oldhash; // buckets that still need to be moved to 'hash' during incremental resize, NULL if resize isn't in progress
+    int oldsize;
+    int oldpos;        // buckets in 'oldhash' before this position have been moved
 } stringtable;
 // clang-format on
 
@@ -118,6 +122,7 @@ struct GCCycleMetrics
     double atomictimeweak = 0.0;
     double atomictimegray = 0.0;
     double atomictimeclear = 0.0;
+    int atomicworkers = 0; // number of threads that ran atomic stage marking, 0 if it ran on the calling thread
 
     double sweeptime = 0.0;
     double sweepassisttime = 0.0;
@@ -142,6 +147,13 @@ struct GCMetrics
     // when cycle is completed, last cycle values are updated
     uint64_t completedcycles = 0;
 
+    // in generational mode, minor cycles only traverse young objects; all other cycles are major
+    uint64_t completedminorcycles = 0;
+    uint64_t completedmajorcycles = 0;
+
+    // longest time spent resizing the string table at once; resize is incremental, see luaS_rehash
+    double stringtableresizemaxtime = 0.0;
+
     GCCycleMetrics lastcycle;
     GCCycleMetrics currcycle;
 };
@@ -154,6 +166,17 @@ struct lua_ExecutionCallbacks
     void (*close)(lua_State* L);                 // called when global VM state is closed
     void (*destroy)(lua_State* L, Proto* proto); // called when function is destroyed
     int (*enter)(lua_State* L, Proto* proto);    // called when function is about to start/resume (when execdata is present), return 0 to exit VM
+
+    void (*tierup)(lua_State* L, Proto* proto); // called when an interpreted function crosses one of the thresholds below; must not call into Lua
+    unsigned int tierentrythreshold;             // number of calls
+    unsigned int tierloopthreshold;              // number of loop iterations
+};
+
+// Bytecode executed in place by functions of the state, released when the state is closed
+struct BytecodeMapping
+{
+    void (*release)(void* ud);
+    void* ud;
 };
 
 /*
@@ -171,6 +194,9 @@ typedef struct global_State
 
     uint8_t currentwhite;
     uint8_t gcstate; // state of garbage collector
+    uint8_t gcgen;    // generational mode is enabled, see LUA_GCGEN
+    uint8_t gcsticky; // sweep keeps the marks of survivors, making them old, so that the next collection is a minor one
+    uint8_t gcminor;  // current collection started with old objects marked and only traverses young and modified objects
 
 
     GCObject* gray;      // list of gray objects
@@ -183,9 +209,21 @@ typedef struct global_State
     int gcgoal;                               // see LUAI_GCGOAL
     int gcstepmul;                            // see LUAI_GCSTEPMUL
     int gcstepsize;                          // see LUAI_GCSTEPSIZE
+    int gcgenminormul;                        // see LUAI_GCGENMINORMUL
+    int gcgenmajormul;                        // see LUAI_GCGENMAJORMUL
+    size_t gcgenmajorbase;                    // heap size at the end of the last major collection
+    size_t gcgenlastsize;                     // heap size at the end of the last collection
+    int gcsparsepage;                         // occupancy in percent below which swept GCO pages are used for allocation last
+    int gcworkers;                            // number of threads used for parallel marking in atomic stage, see LUA_GCSETWORKERS
 
     struct lua_Page* freepages[LUA_SIZECLASSES]; // free page linked list for each size class for non-collectable objects
     struct lua_Page* freegcopages[LUA_SIZECLASSES]; // free page linked list for each size class for collectable objects
+    struct lua_Page* freegcopagestail[LUA_SIZECLASSES]; // last page in the free page linked list for each size class for collectable objects
+    struct lua_Page* pagecache; // empty pages kept for reuse, linked with lua_Page::next
+    size_t pagecachebytes;      // total size of pages in the cache
+    size_t pagecachelimit;      // maximum size of pages in the cache
+    size_t pagecacheidle;       // smallest size of the cache since the end of the last GC cycle
+
     struct lua_Page* allgcopages; // page linked list with all pages for all classes
     struct lua_Page* sweepgcopage; // position of the sweep in `allgcopages'
 
@@ -198,6 +236,17 @@ typedef struct global_State
     TString* ttname[LUA_T_COUNT];       // names for basic types
     TString* tmname[TM_N];             // array with tag-method names
 
+    TableShape* shaperoot; // shape without keys that new tables start with, see luaH_new
+    int shapecount;        // number of shapes that currently exist
+
+    lua_BytecodeImage** images; // bytecode images that functions of this state share data with, see luau_loadimage
+    int sizeimages;
+    int nimages;
+
+    BytecodeMapping* mappings; // bytecode that functions of this state execute in place, see luau_loadmapped
+    int sizemappings;
+    int nmappings;
+
     TValue pseudotemp; // storage for temporary values used in pseudo2addr
 
     TValue registry; // registry table, used by lua_ref and LUA_REGISTRYINDEX
@@ -7,65 +7,217 @@
 
 #include <string.h>
 
-unsigned int luaS_hash(const char* str, size_t len)
+#define rol(x, s) ((x >> s) | (x << (32 - s)))
+
+/*
+** Strings that are 32 bytes or longer are hashed in 16-byte blocks using four independent 32-bit lanes, which maps directly
+** to 128-bit SIMD registers. Each block is added to the lanes, mixed within each lane and then across lanes; the last block
+** overlaps the previous one to avoid a byte loop for the tail. All implementations must produce identical results.
+*/
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+
+static void hashblocks(uint32_t* state, const char* str, size_t len)
 {
-    // Note that this hashing algorithm is replicated in BytecodeBuilder.cpp, BytecodeBuilder::getStringHash
-    unsigned int a = 0, b = 0;
-    unsigned int h = unsigned(len);
+    __m128i v = _mm_loadu_si128((const __m128i*)state);
 
-    // hash prefix in 12b chunks (using aligned reads) with ARX based hash (LuaJIT v2.1, lookup3)
-    // note that we stop at length<32 to maintain compatibility with Lua 5.1
-    while (len >= 32)
+    for (size_t offset = 0;; offset += 16)
     {
-#define rol(x, s) ((x >> s) | (x << (32 - s)))
-#define mix(u, v, w) a ^= h, a -= rol(h, u), b ^= a, b -= rol(a, v), h ^= b, h -= rol(b, w)
+        const char* block = offset + 16 < len ? str + offset : str + len - 16;
+
+        __m128i t = _mm_add_epi32(v, _mm_loadu_si128((const __m128i*)block));
+        t = _mm_xor_si128(t, _mm_or_si128(_mm_slli_epi32(t, 13), _mm_srli_epi32(t, 19)));
+
+        __m128i r = _mm_shuffle_epi32(t, _MM_SHUFFLE(0, 3, 2, 1)); // lane i gets lane i+1
+        r = _mm_or_si128(_mm_slli_epi32(r, 7), _mm_srli_epi32(r, 25));
+        v = _mm_add_epi32(t, r);
+
+        if (offset + 16 >= len)
+            break;
+    }
+
+    _mm_storeu_si128((__m128i*)state, v);
+}
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+
+static void hashblocks(uint32_t* state, const char* str, size_t len)
+{
+    uint32x4_t v = vld1q_u32(state);
+
+    for (size_t offset = 0;; offset += 16)
+    {
+        const char* block = offset + 16 < len ? str + offset : str + len - 16;
+
+        uint32x4_t t = vaddq_u32(v, vreinterpretq_u32_u8(vld1q_u8((const uint8_t*)block)));
+        t = veorq_u32(t, vorrq_u32(vshlq_n_u32(t, 13), vshrq_n_u32(t, 19)));
+
+        uint32x4_t r = vextq_u32(t, t, 1); // lane i gets lane i+1
+        r = vorrq_u32(vshlq_n_u32(r, 7), vshrq_n_u32(r, 25));
+        v = vaddq_u32(t, r);
+
+        if (offset + 16 >= len)
+            break;
+    }
+
+    vst1q_u32(state, v);
+}
+#else
+static void hashblocks(uint32_t* state, const char* str, size_t len)
+{
+    for (size_t offset = 0;; offset += 16)
+    {
+        const char* block = offset + 16 < len ? str + offset : str + len - 16;
 
         // should compile into fast unaligned reads
-        uint32_t block[3];
-        memcpy(block, str, 12);
-
-        a += block[0];
-        b += block[1];
-        h += block[2];
-        mix(14, 11, 25);
-        str += 12;
-        len -= 12;
-
-#undef mix
-#undef rol
+        uint32_t data[4];
+        memcpy(data, block, 16);
+
+        uint32_t t[4];
+        for (int i = 0; i < 4; ++i)
+        {
+            t[i] = state[i] + data[i];
+            t[i] ^= rol(t[i], 19);
+        }
+
+        for (int i = 0; i < 4; ++i)
+        {
+            uint32_t r = t[(i + 1) & 3];
+            state[i] = t[i] + rol(r, 25);
+        }
+
+        if (offset + 16 >= len)
+            break;
     }
+}
+#endif
+
+unsigned int luaS_hash(const char* str, size_t len)
+{
+    // Note that this hashing algorithm is replicated in BytecodeBuilder.cpp, BytecodeBuilder::getStringHash for short strings
+    unsigned int h = unsigned(len);
 
     // original Lua 5.1 hash for compatibility (exact match when len<32)
-    for (size_t i = len; i > 0; --i)
-        h ^= (h << 5) + (h >> 2) + (uint8_t)str[i - 1];
+    if (len < 32)
+    {
+        for (size_t i = len; i > 0; --i)
+            h ^= (h << 5) + (h >> 2) + (uint8_t)str[i - 1];
 
-    return h;
+        return h;
+    }
+
+    uint32_t state[4] = {h, h ^ 0x9e3779b9, 0x85ebca6b, 0xc2b2ae35};
+    hashblocks(state, str, len);
+
+    // final mix of the lanes (lookup3)
+    uint32_t a = state[0], b = state[1] ^ state[3], c = state[2] ^ h;
+
+    c ^= b, c -= rol(b, 18);
+    a ^= c, a -= rol(c, 21);
+    b ^= a, b -= rol(a, 7);
+    c ^= b, c -= rol(b, 16);
+    a ^= c, a -= rol(c, 28);
+    b ^= a, b -= rol(a, 18);
+    c ^= b, c -= rol(b, 8);
+
+    return c;
 }
 
+#ifdef LUAI_GCMETRICS
+static void recordResizeTime(global_State* g, double starttime)
+{
+    double duration = lua_clock() - starttime;
+
+    if (duration > g->gcmetrics.stringtableresizemaxtime)
+        g->gcmetrics.stringtableresizemaxtime = duration;
+}
+#endif
+
+// move strings from a bucket of the old array to the new array during incremental resize
+static void rehashbucket(stringtable* tb, int i)
+{
+    TString* p = tb->oldhash[i];
+    tb->oldhash[i] = NULL;
+
+    while (p)
+    {                            // for each node in the list
+        TString* next = p->next; // save next
+        unsigned int h = p->hash;
+        int h1 = lmod(h, tb->size); // new position
+        LUAU_ASSERT(cast_int(h % tb->size) == lmod(h, tb->size));
+        p->next = tb->hash[h1]; // chain it
+        tb->hash[h1] = p;
+        p = next;
+    }
+}
+
+// strings with a given hash can only be found using the new array after the bucket they used to be in has been moved
+#define rehashforlookup(tb, h) \
+    { \
+        if (LUAU_UNLIKELY((tb)->oldhash != NULL)) \
+            rehashbucket(tb, lmod(h, (tb)->oldsize)); \
+    }
+
+/*
+** String table is resized incrementally to avoid long pauses when it contains many strings: the old array is kept until
+** all strings are moved to the new array, which happens a few buckets at a time on every new string and on every GC step.
+** Lookups and removals move the bucket of the string first, so that they only need to check the new array.
+*/
 void luaS_resize(lua_State* L, int newsize)
 {
-    TString** newhash = luaM_newarray(L, newsize, TString*, 0);
     stringtable* tb = &L->global->strt;
+
+    // finish previous resize
+    if (tb->oldhash)
+        luaS_rehash(L, tb->oldsize);
+
+#ifdef LUAI_GCMETRICS
+    double starttime = lua_clock();
+#endif
+
+    TString** newhash = luaM_newarray(L, newsize, TString*, 0);
     for (int i = 0; i < newsize; i++)
         newhash[i] = NULL;
-    // rehash
-    for (int i = 0; i < tb->size; i++)
+
+    tb->oldhash = tb->hash;
+    tb->oldsize = tb->size;
+    tb->oldpos = 0;
+    tb->hash = newhash;
+    tb->size = newsize;
+
+#ifdef LUAI_GCMETRICS
+    recordResizeTime(L->global, starttime);
+#endif
+}
+
+// move up to 'buckets' buckets of the old array to the new array, freeing the old array when all buckets have been moved
+void luaS_rehash(lua_State* L, int buckets)
+{
+    stringtable* tb = &L->global->strt;
+    LUAU_ASSERT(tb->oldhash);
+
+#ifdef LUAI_GCMETRICS
+    double starttime = lua_clock();
+#endif
+
+    int end = buckets < tb->oldsize - tb->oldpos ? tb->oldpos + buckets : tb->oldsize;
+
+    for (int i = tb->oldpos; i < end; i++)
+        rehashbucket(tb, i);
+
+    tb->oldpos = end;
+
+    if (end == tb->oldsize)
     {
-        TString* p = tb->hash[i];
-        while (p)
-        {                            // for each node in the list
-            TString* next = p->next; // save next
-            unsigned int h = p->hash;
-            int h1 = lmod(h, newsize); // new position
-            LUAU_ASSERT(cast_int(h % newsize) == lmod(h, newsize));
-            p->next = newhash[h1]; // chain it
-            newhash[h1] = p;
-            p = next;
-        }
+        luaM_freearray(L, tb->oldhash, tb->oldsize, TString*, 0);
+        tb->oldhash = NULL;
+        tb->oldsize = 0;
+        tb->oldpos = 0;
     }
-    luaM_freearray(L, tb->hash, tb->size, TString*, 0);
-    tb->size = newsize;
-    tb->hash = newhash;
+
+#ifdef LUAI_GCMETRICS
+    recordResizeTime(L->global, starttime);
+#endif
 }
 
 static TString* newlstr(lua_State* L, const char* str, size_t l, unsigned int h)
@@ -88,7 +240,9 @@ static TString* newlstr(lua_State* L, const char* str, size_t l, unsigned int h)
     tb->hash[h] = ts;
 
     tb->nuse++;
-    if (tb->nuse > cast_to(uint32_t, tb->size) && tb->size <= INT_MAX / 2)
+    if (tb->oldhash)
+        luaS_rehash(L, STRTAB_REHASHSTEP); // continue resize
+    else if (tb->nuse > cast_to(uint32_t, tb->size) && tb->size <= INT_MAX / 2)
         luaS_resize(L, tb->size * 2); // too crowded
 
     return ts;
@@ -114,12 +268,13 @@ TString* luaS_buffinish(lua_State* L, TString* ts)
 {
     unsigned int h = luaS_hash(ts->data, ts->len);
     stringtable* tb = &L->global->strt;
+    rehashforlookup(tb, h);
     int bucket = lmod(h, tb->size);
 
     // search if we already have this string in the hash table
     for (TString* el = tb->hash[bucket]; el != NULL; el = el->next)
     {
-        if (el->len == ts->len && memcmp(el->data, ts->data, ts->len) == 0)
+        if (el->hash == h && el->len == ts->len && memcmp(el->data, ts->data, ts->len) == 0)
         {
             // string may be dead
             if (isdead(L->global, obj2gco(el)))
@@ -138,7 +293,9 @@ TString* luaS_buffinish(lua_State* L, TString* ts)
     tb->hash[bucket] = ts;
 
     tb->nuse++;
-    if (tb->nuse > cast_to(uint32_t, tb->size) && tb->size <= INT_MAX / 2)
+    if (tb->oldhash)
+        luaS_rehash(L, STRTAB_REHASHSTEP); // continue resize
+    else if (tb->nuse > cast_to(uint32_t, tb->size) && tb->size <= INT_MAX / 2)
         luaS_resize(L, tb->size * 2); // too crowded
 
     return ts;
@@ -147,9 +304,10 @@ TString* luaS_buffinish(lua_State* L, TString* ts)
 TString* luaS_newlstr(lua_State* L, const char* str, size_t l)
 {
     unsigned int h = luaS_hash(str, l);
+    rehashforlookup(&L->global->strt, h);
     for (TString* el = L->global->strt.hash[lmod(h, L->global->strt.size)]; el != NULL; el = el->next)
     {
-        if (el->len == l && (memcmp(str, getstr(el), l) == 0))
+        if (el->hash == h && el->len == l && (memcmp(str, getstr(el), l) == 0))
         {
             // string may be dead
             if (isdead(L->global, obj2gco(el)))
@@ -164,6 +322,7 @@ static bool unlinkstr(lua_State* L, TString* ts)
 {
     global_State* g = L->global;
 
+    rehashforlookup(&g->strt, ts->hash);
     TString** p = &g->strt.hash[lmod(ts->hash, g->strt.size)];
 
     while (TString* curr = *p)
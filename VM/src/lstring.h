@@ -20,7 +20,12 @@
 
 LUAI_FUNC unsigned int luaS_hash(const char* str, size_t len);
 
+// number of string table buckets that are moved during incremental resize on every new string and on every GC step
+#define STRTAB_REHASHSTEP 2
+#define STRTAB_GCREHASHSTEP 256
+
 LUAI_FUNC void luaS_resize(lua_State* L, int newsize);
+LUAI_FUNC void luaS_rehash(lua_State* L, int buckets);
 
 LUAI_FUNC TString* luaS_newlstr(lua_State* L, const char* str, size_t l);
 LUAI_FUNC void luaS_free(lua_State* L, TString* ts, struct lua_Page* page);
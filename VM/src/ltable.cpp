@@ -21,6 +21,13 @@
  * invariant where the boundary must be in the array part - this enforces a consistent iteration order through the
  * prefix of the table when using pairs(), and allows to implement algorithms that access elements in 1..#t range
  * more efficiently.
+ *
+ * Tables that start empty and only get string keys can use a shape instead of a hash part. A shape is a list of string keys
+ * that is shared by all tables that received the same keys in the same order; each table stores the values densely in slots,
+ * in key order.
+ * Shapes form a tree where a shape extends its parent with one more key, so adding a key moves the table to a child shape.
+ * Once a table gets a key of another type, or more string keys than a shape can hold, it switches to a hash part for good.
+ * The shape and the slots are kept in place of the hash part, see isshaped, so tables without a shape don't pay for them.
  */
 
 #include "ltable.h"
@@ -33,6 +40,8 @@
 
 #include <string.h>
 
+LUAU_FASTFLAGVARIABLE(LuauTableShapes, false)
+
 // max size of both array and hash part is 2^MAXBITS
 #define MAXBITS 26
 #define MAXSIZE (1 << MAXBITS)
@@ -40,7 +49,7 @@
 static_assert(offsetof(LuaNode, val) == 0, "Unexpected Node memory layout, pointer cast in gval2slot is incorrect");
 
 // TKey is bitpacked for memory efficiency so we need to validate bit counts for worst case
-static_assert(TKey{{NULL}, {0}, LUA_TDEADKEY, 0}.tt == LUA_TDEADKEY, "not enough bits for tt");
+static_assert(TKey{{NULL}, {0}, LUA_TSHAPE, 0}.tt == LUA_TSHAPE, "not enough bits for tt");
 static_assert(TKey{{NULL}, {0}, LUA_TNIL, MAXSIZE - 1}.next == MAXSIZE - 1, "not enough bits for next");
 static_assert(TKey{{NULL}, {0}, LUA_TNIL, -(MAXSIZE - 1)}.next == -(MAXSIZE - 1), "not enough bits for next");
 
@@ -161,6 +170,253 @@ static int arrayindex(double key)
     return luai_numeq(cast_num(i), key) ? i : -1;
 }
 
+/*
+** {=============================================================
+** Shapes
+** ==============================================================
+*/
+
+#define sizeshape(count, lsizeindex) (offsetof(TableShape, keys) + sizeof(TString*) * (count) + twoto(lsizeindex))
+
+// size of the block that tables with a shape use in place of the hash part
+#define sizeslotvector(size) (2 * sizeof(LuaNode) + sizeof(TValue) * (size))
+
+/*
+** returns the slot of `key' in shape `s', or -1 if the shape doesn't have the key
+*/
+static int findshapekey(const TableShape* s, const TString* key)
+{
+    const uint8_t* index = shapeindex(s);
+    unsigned int mask = twoto(s->lsizeindex) - 1;
+
+    // index is at most half full so an empty entry will terminate the probe sequence
+    for (unsigned int i = key->hash & mask;; i = (i + 1) & mask)
+    {
+        int slot = index[i] - 1;
+        if (slot < 0 || s->keys[slot] == key)
+            return slot;
+    }
+}
+
+static TableShape* newshape(lua_State* L, TableShape* parent, TString* key)
+{
+    int count = parent ? parent->count + 1 : 0;
+    int lsizeindex = count > 0 ? ceillog2(count * 2) : 0;
+
+    TableShape* s = cast_to(TableShape*, luaM_new_(L, sizeshape(count, lsizeindex), 0));
+    s->parent = parent;
+    s->children = NULL;
+    s->sibling = NULL;
+    s->refs = 0;
+    s->count = cast_byte(count);
+    s->lsizeindex = cast_byte(lsizeindex);
+
+    if (parent)
+    {
+        memcpy(s->keys, parent->keys, parent->count * sizeof(TString*));
+        s->keys[count - 1] = key;
+
+        // children keep the parent alive so that it can be found again by tables that are still using it
+        s->sibling = parent->children;
+        parent->children = s;
+        parent->refs++;
+    }
+
+    uint8_t* index = shapeindex(s);
+    unsigned int mask = twoto(lsizeindex) - 1;
+    memset(index, 0, twoto(lsizeindex));
+
+    for (int i = 0; i < count; i++)
+    {
+        unsigned int pos = s->keys[i]->hash & mask;
+        while (index[pos] != 0)
+            pos = (pos + 1) & mask;
+        index[pos] = cast_byte(i + 1);
+    }
+
+    L->global->shapecount++;
+    return s;
+}
+
+static void releaseshape(lua_State* L, TableShape* s)
+{
+    // unused shapes are freed right away, which releases the reference they hold to the parent
+    while (--s->refs == 0)
+    {
+        TableShape* parent = s->parent;
+        LUAU_ASSERT(parent && !s->children); // root shape is kept alive by the global state
+
+        TableShape** p = &parent->children;
+        while (*p != s)
+            p = &(*p)->sibling;
+        *p = s->sibling;
+
+        luaM_free_(L, s, sizeshape(s->count, s->lsizeindex), 0);
+        L->global->shapecount--;
+
+        s = parent;
+    }
+}
+
+static TableShape* getshaperoot(lua_State* L)
+{
+    global_State* g = L->global;
+
+    if (!g->shaperoot)
+    {
+        g->shaperoot = newshape(L, NULL, NULL);
+        g->shaperoot->refs = 1;
+    }
+
+    return g->shaperoot;
+}
+
+/*
+** returns the shape that extends `s' with `key', or NULL if a new shape is needed but can't be created
+*/
+static TableShape* getshapechild(lua_State* L, TableShape* s, TString* key)
+{
+    if (s->count >= LUA_MAXSHAPEKEYS)
+        return NULL;
+
+    for (TableShape** p = &s->children; *p; p = &(*p)->sibling)
+    {
+        TableShape* c = *p;
+
+        if (c->keys[c->count - 1] == key)
+        {
+            // move the shape to the front, since most tables are constructed using a few paths through the tree
+            *p = c->sibling;
+            c->sibling = s->children;
+            s->children = c;
+            return c;
+        }
+    }
+
+    if (L->global->shapecount >= LUA_MAXSHAPES)
+        return NULL;
+
+    return newshape(L, s, key);
+}
+
+/*
+** gives a table without array and hash parts the root shape and room for `size' keys
+*/
+static void newslotvector(lua_State* L, Table* t, int size)
+{
+    LUAU_ASSERT(t->node == dummynode && t->sizearray == 0);
+    TableShape* root = getshaperoot(L);
+
+    LuaNode* n = cast_to(LuaNode*, luaM_new_(L, sizeslotvector(size), t->memcat));
+    setnilvalue(gval(&n[0]));
+    setnilvalue(gval(&n[1]));
+    setnilvalue(gkey(&n[1]));
+    gnext(&n[1]) = 0;
+    // the key of the first node holds the shape; it's chained to the second node, which stays free
+    gkey(&n[0])->value.p = root;
+    gkey(&n[0])->tt = LUA_TSHAPE;
+    gnext(&n[0]) = 1;
+
+    TValue* slots = cast_to(TValue*, n + 2);
+    for (int i = 0; i < size; i++)
+        setnilvalue(&slots[i]);
+
+    root->refs++;
+    t->node = n;
+    t->lastfree = size;
+}
+
+static void setslotvector(lua_State* L, Table* t, int size)
+{
+    int oldsize = t->lastfree;
+    t->node = cast_to(LuaNode*, luaM_realloc_(L, t->node, sizeslotvector(oldsize), sizeslotvector(size), t->memcat));
+    TValue* slots = gslots(t);
+    for (int i = oldsize; i < size; i++)
+        setnilvalue(&slots[i]);
+    t->lastfree = size;
+}
+
+/*
+** adds a string key to a table with a shape, returns NULL if the table has to switch to a hash part instead
+*/
+static TValue* newshapekey(lua_State* L, Table* t, const TValue* key)
+{
+    TableShape* s = gshape(t);
+
+    if (s->count >= LUA_MAXSHAPEKEYS)
+        return NULL;
+
+    // grow slots first so that a failed allocation leaves the table intact
+    int size = t->lastfree;
+    if (s->count == size)
+        setslotvector(L, t, size == 0 ? 2 : size * 2 < LUA_MAXSHAPEKEYS ? size * 2 : LUA_MAXSHAPEKEYS);
+
+    TableShape* child = getshapechild(L, s, tsvalue(key));
+    if (!child)
+        return NULL;
+
+    child->refs++;
+    gkey(t->node)->value.p = child;
+    releaseshape(L, s); // parent is still used by the child
+
+    luaC_barriert(L, t, key);
+    TValue* val = &gslots(t)[child->count - 1];
+    LUAU_ASSERT(ttisnil(val));
+    return val;
+}
+
+static void setnodevector(lua_State* L, Table* t, int size);
+static TValue* newkey(lua_State* L, Table* t, const TValue* key);
+
+/*
+** moves keys of a table with a shape to a new hash part that has room for `extra' more keys
+*/
+static void unshape(lua_State* L, Table* t, int extra)
+{
+    TableShape* s = gshape(t);
+    LuaNode* nold = t->node;
+    TValue* slots = gslots(t);
+    int size = t->lastfree;
+
+    int used = 0;
+    for (int i = 0; i < s->count; i++)
+        used += !ttisnil(&slots[i]);
+
+    // the table keeps the shape if the allocation fails; the hash part keeps the capacity of the slots, which may come from a size hint
+    setnodevector(L, t, used + extra > size ? used + extra : size);
+
+    for (int i = 0; i < s->count; i++)
+    {
+        if (!ttisnil(&slots[i]))
+        {
+            TValue k;
+            setsvalue(L, &k, s->keys[i]);
+            setobjt2t(L, newkey(L, t, &k), &slots[i]);
+        }
+    }
+
+    luaM_free_(L, nold, sizeslotvector(size), t->memcat);
+    releaseshape(L, s);
+}
+
+void luaH_freeshapes(lua_State* L)
+{
+    global_State* g = L->global;
+
+    if (TableShape* root = g->shaperoot)
+    {
+        // all tables have been freed at this point, so only the root shape remains
+        LUAU_ASSERT(root->refs == 1 && !root->children && g->shapecount == 1);
+        luaM_free_(L, root, sizeshape(0, 0), 0);
+        g->shaperoot = NULL;
+        g->shapecount = 0;
+    }
+}
+
+/*
+** }=============================================================
+*/
+
 /*
 ** returns the index of a `key' for table traversals. First goes all
 ** elements in the array part, then elements in the hash part. The
@@ -190,6 +446,13 @@ static int findindex(lua_State* L, Table* t, StkId key)
                 break;
             n += gnext(n);
         }
+        if (isshaped(t))
+        {
+            // slots are numbered after the node that holds the shape
+            int slot = ttisstring(key) ? findshapekey(gshape(t), tsvalue(key)) : -1;
+            if (slot >= 0)
+                return slot + t->sizearray + sizenode(t);
+        }
         luaG_runerror(L, "invalid key to 'next'"); // key not found
     }
 }
@@ -215,6 +478,20 @@ int luaH_next(lua_State* L, Table* t, StkId key)
             return 1;
         }
     }
+    if (isshaped(t))
+    {
+        TableShape* s = gshape(t);
+        TValue* slots = gslots(t);
+        for (i -= sizenode(t); i < s->count; i++)
+        { // then slots
+            if (!ttisnil(&slots[i]))
+            { // a non-nil value?
+                setsvalue(L, key, s->keys[i]);
+                setobj2s(L, key + 1, &slots[i]);
+                return 1;
+            }
+        }
+    }
     return 0; // no more elements
 }
 
@@ -436,6 +713,8 @@ static int adjustasize(Table* t, int size, const TValue* ek)
 
 void luaH_resizearray(lua_State* L, Table* t, int nasize)
 {
+    if (isshaped(t))
+        unshape(L, t, 0);
     int nsize = (t->node == dummynode) ? 0 : sizenode(t);
     int asize = adjustasize(t, nasize, NULL);
     resize(L, t, asize, nsize);
@@ -443,6 +722,8 @@ void luaH_resizearray(lua_State* L, Table* t, int nasize)
 
 void luaH_resizehash(lua_State* L, Table* t, int nhsize)
 {
+    if (isshaped(t))
+        unshape(L, t, 0);
     resize(L, t, t->sizearray, nhsize);
 }
 
@@ -512,9 +793,70 @@ Table* luaH_new(lua_State* L, int narray, int nhash)
     return t;
 }
 
+/*
+** creates an empty table that is expected to get `nkeys' string keys, which gets a shape with room for them up front
+*/
+Table* luaH_newshaped(lua_State* L, int nkeys)
+{
+    if (!FFlag::LuauTableShapes || nkeys > LUA_MAXSHAPEKEYS)
+        return luaH_new(L, 0, nkeys);
+
+    Table* t = luaH_new(L, 0, 0);
+    if (nkeys > 0)
+        newslotvector(L, t, nkeys);
+    return t;
+}
+
+/*
+** returns a copy of a table template that has a shape, or the template itself if it can't have one; the shape lists the keys in the
+** traversal order of the template, so that tables created from it are traversed in the same order as before
+*/
+Table* luaH_shapetemplate(lua_State* L, Table* t)
+{
+    if (!FFlag::LuauTableShapes || t->sizearray != 0 || t->node == dummynode || isshaped(t))
+        return t;
+
+    int count = 0;
+    for (int i = 0; i < sizenode(t); i++)
+    {
+        LuaNode* n = gnode(t, i);
+        if (!ttisnil(gval(n)))
+        {
+            if (!ttisstring(gkey(n)))
+                return t;
+            count++;
+        }
+    }
+
+    if (count > LUA_MAXSHAPEKEYS)
+        return t;
+
+    Table* st = luaH_newshaped(L, count);
+
+    for (int i = 0; i < sizenode(t); i++)
+    {
+        LuaNode* n = gnode(t, i);
+        if (!ttisnil(gval(n)))
+        {
+            TValue k;
+            getnodekey(L, &k, n);
+            setobj2t(L, luaH_set(L, st, &k), gval(n));
+            luaC_barriert(L, st, gval(n));
+        }
+    }
+
+    // the copy switches to a hash part if it runs out of shapes, and may be traversed in another order then
+    return isshaped(st) ? st : t;
+}
+
 void luaH_free(lua_State* L, Table* t, lua_Page* page)
 {
-    if (t->node != dummynode)
+    if (isshaped(t))
+    {
+        releaseshape(L, gshape(t));
+        luaM_free_(L, t->node, sizeslotvector(t->lastfree), t->memcat);
+    }
+    else if (t->node != dummynode)
         luaM_freearray(L, t->node, sizenode(t), LuaNode, t->memcat);
     if (t->array)
         luaM_freearray(L, t->array, t->sizearray, TValue, t->memcat);
@@ -543,6 +885,21 @@ static LuaNode* getfreepos(Table* t)
 */
 static TValue* newkey(lua_State* L, Table* t, const TValue* key)
 {
+    // tables that start empty get a shape for their first string key
+    if (FFlag::LuauTableShapes && ttisstring(key) && t->node == dummynode && t->sizearray == 0)
+        newslotvector(L, t, 1);
+
+    if (isshaped(t))
+    {
+        if (ttisstring(key))
+        {
+            if (TValue* val = newshapekey(L, t, key))
+                return val;
+        }
+
+        unshape(L, t, 1);
+    }
+
     // enforce boundary invariant
     if (ttisnumber(key) && nvalue(key) == t->sizearray + 1)
     {
@@ -630,6 +987,12 @@ const TValue* luaH_getnum(Table* t, int key)
 const TValue* luaH_getstr(Table* t, TString* key)
 {
     LuaNode* n = hashstr(t, key);
+    // every key hashes to the first node in a table with a shape, which is the node that holds the shape
+    if (gkey(n)->tt == LUA_TSHAPE)
+    {
+        int slot = findshapekey(gshape(t), key);
+        return slot >= 0 ? &gslots(t)[slot] : luaO_nilobject;
+    }
     for (;;)
     { // check whether `key' is somewhere in the chain
         if (ttisstring(gkey(n)) && tsvalue(gkey(n)) == key)
@@ -817,7 +1180,17 @@ Table* luaH_clone(lua_State* L, Table* tt)
         memcpy(t->array, tt->array, t->sizearray * sizeof(TValue));
     }
 
-    if (tt->node != dummynode)
+    if (isshaped(tt))
+    {
+        // clones share the shape but don't need spare slots
+        int count = gshape(tt)->count;
+        t->node = cast_to(LuaNode*, luaM_new_(L, sizeslotvector(count), t->memcat));
+        t->lastfree = count;
+
+        memcpy(t->node, tt->node, sizeslotvector(count));
+        gshape(t)->refs++;
+    }
+    else if (tt->node != dummynode)
     {
         int size = 1 << tt->lsizenode;
         t->node = luaM_newarray(L, size, LuaNode, t->memcat);
@@ -840,8 +1213,17 @@ void luaH_clear(Table* tt)
 
     maybesetaboundary(tt, 0);
 
+    // clear slots, keeping the keys in case they are added again
+    if (isshaped(tt))
+    {
+        TValue* slots = gslots(tt);
+        for (int i = 0; i < gshape(tt)->count; ++i)
+        {
+            setnilvalue(&slots[i]);
+        }
+    }
     // clear hash part
-    if (tt->node != dummynode)
+    else if (tt->node != dummynode)
     {
         int size = sizenode(tt);
         tt->lastfree = size;
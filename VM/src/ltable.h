@@ -9,7 +9,23 @@
 #define gval(n) (&(n)->val)
 #define gnext(n) ((n)->key.next)
 
-#define gval2slot(t, v) int(cast_to(LuaNode*, static_cast<const TValue*>(v)) - t->node)
+/*
+** Tables with a shape don't have a hash part. Instead, `node' points to a node that holds the shape in its key and a free
+** node that it is chained to, followed by the values of the shape keys. Hash lookups of any key miss, and the chain stops
+** lookups from assuming that a key is absent after checking its main position.
+*/
+#define isshaped(t) (gkey((t)->node)->tt == LUA_TSHAPE)
+#define gshape(t) (cast_to(TableShape*, gkey((t)->node)->value.p))
+#define gslots(t) (cast_to(TValue*, (t)->node + 2))
+
+// number of slots in a table with a shape, 0 for other tables
+#define sizeslots(t) (isshaped(t) ? (t)->lastfree : 0)
+
+// predictive lookup in a table with a shape: the value in `slot' if the shape has `key' there, NULL otherwise
+#define gshapeslot(t, slot, key) (unsigned(slot) < gshape(t)->count && gshape(t)->keys[slot] == (key) ? &gslots(t)[slot] : NULL)
+
+#define gval2slot(t, v) \
+    (isshaped(t) ? int(static_cast<const TValue*>(v) - gslots(t)) : int(cast_to(LuaNode*, static_cast<const TValue*>(v)) - (t)->node))
 
 // reset cache of absent metamethods, cache is updated in luaT_gettm
 #define invalidateTMcache(t) t->tmcache = 0
@@ -22,6 +38,8 @@ LUAI_FUNC const TValue* luaH_get(Table* t, const TValue* key);
 LUAI_FUNC TValue* luaH_set(lua_State* L, Table* t, const TValue* key);
 LUAI_FUNC TValue* luaH_newkey(lua_State* L, Table* t, const TValue* key);
 LUAI_FUNC Table* luaH_new(lua_State* L, int narray, int lnhash);
+LUAI_FUNC Table* luaH_newshaped(lua_State* L, int nkeys);
+LUAI_FUNC Table* luaH_shapetemplate(lua_State* L, Table* t);
 LUAI_FUNC void luaH_resizearray(lua_State* L, Table* t, int nasize);
 LUAI_FUNC void luaH_resizehash(lua_State* L, Table* t, int nhsize);
 LUAI_FUNC void luaH_free(lua_State* L, Table* t, struct lua_Page* page);
@@ -29,6 +47,7 @@ LUAI_FUNC int luaH_next(lua_State* L, Table* t, StkId key);
 LUAI_FUNC int luaH_getn(Table* t);
 LUAI_FUNC Table* luaH_clone(lua_State* L, Table* tt);
 LUAI_FUNC void luaH_clear(Table* tt);
+LUAI_FUNC void luaH_freeshapes(lua_State* L);
 
 #define luaH_setslot(L, t, slot, key) (invalidateTMcache(t), (slot == luaO_nilobject ? luaH_newkey(L, t, key) : cast_to(TValue*, slot)))
 
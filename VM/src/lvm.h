@@ -24,10 +24,26 @@ LUAI_FUNC void luaV_gettable(lua_State* L, const TValue* t, TValue* key, StkId v
 LUAI_FUNC void luaV_settable(lua_State* L, const TValue* t, TValue* key, StkId val);
 LUAI_FUNC void luaV_concat(lua_State* L, int total, int last);
 LUAI_FUNC void luaV_getimport(lua_State* L, Table* env, TValue* k, StkId res, uint32_t id, bool propagatenil);
+LUAI_FUNC void luaV_releasebytecode(lua_State* L);
 LUAI_FUNC void luaV_prepareFORN(lua_State* L, StkId plimit, StkId pstep, StkId pinit);
 LUAI_FUNC void luaV_callTM(lua_State* L, int nparams, int res);
 LUAI_FUNC void luaV_tryfuncTM(lua_State* L, StkId func);
 
+// tiered compilation: interpreted functions are passed to the tierup callback once they are entered often enough
+// without a tierup callback, the interpreter only pays for a check of that callback
+#if LUA_USE_TIERING
+#define luaV_tierentry(L, p) \
+    { \
+        lua_ExecutionCallbacks* ecb = &(L)->global->ecb; \
+        if (LUAU_UNLIKELY(!!ecb->tierup) && ++(p)->tierentries == ecb->tierentrythreshold) \
+            ecb->tierup(L, p); \
+    }
+#else
+#define luaV_tierentry(L, p) \
+    { \
+    }
+#endif
+
 LUAI_FUNC void luau_execute(lua_State* L);
 LUAI_FUNC int luau_precall(lua_State* L, struct lua_TValue* func, int nresults);
 LUAI_FUNC void luau_poscall(lua_State* L, StkId first);
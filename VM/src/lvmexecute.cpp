@@ -66,6 +66,13 @@
 #define VM_PATCH_C(pc, slot) *const_cast<Instruction*>(pc) = ((uint8_t(slot) << 24) | (0x00ffffffu & *(pc)))
 #define VM_PATCH_E(pc, slot) *const_cast<Instruction*>(pc) = ((uint32_t(slot) << 8) | (0x000000ffu & *(pc)))
 
+// type feedback for native code is only recorded when instructions leave their numeric or table fast paths, see Proto::typeprofile
+#define VM_PROFILE(pc, bits) \
+    { \
+        if (LUAU_UNLIKELY(cl->l.p->typeprofile != NULL)) \
+            cl->l.p->typeprofile[(pc)-cl->l.p->code] |= (bits); \
+    }
+
 #define VM_INTERRUPT() \
     { \
         void (*interrupt)(lua_State*, int) = L->global->cb.interrupt; \
@@ -104,7 +111,8 @@
         VM_DISPATCH_OP(LOP_CAPTURE), VM_DISPATCH_OP(LOP_DEP_JUMPIFEQK), VM_DISPATCH_OP(LOP_DEP_JUMPIFNOTEQK), VM_DISPATCH_OP(LOP_FASTCALL1), \
         VM_DISPATCH_OP(LOP_FASTCALL2), VM_DISPATCH_OP(LOP_FASTCALL2K), VM_DISPATCH_OP(LOP_FORGPREP), VM_DISPATCH_OP(LOP_JUMPXEQKNIL), \
         VM_DISPATCH_OP(LOP_JUMPXEQKB), VM_DISPATCH_OP(LOP_JUMPXEQKN), VM_DISPATCH_OP(LOP_JUMPXEQKS), VM_DISPATCH_OP(LOP_IDIV), \
-        VM_DISPATCH_OP(LOP_IDIVK),
+        VM_DISPATCH_OP(LOP_IDIVK), VM_DISPATCH_OP(LOP_MOVE_MOVE), VM_DISPATCH_OP(LOP_MOVE_CALL), VM_DISPATCH_OP(LOP_LOADN_LOADN), \
+        VM_DISPATCH_OP(LOP_LOADN_CALL), VM_DISPATCH_OP(LOP_LOADK_LOADK), VM_DISPATCH_OP(LOP_LOADK_CALL), VM_DISPATCH_OP(LOP_GETIMPORT_CALL),
 
 #if defined(__GNUC__) || defined(__clang__)
 #define VM_USE_CGOTO 1
@@ -132,9 +140,49 @@
     goto dispatchContinue
 #endif
 
+// Fused instructions continue with the handler of their second instruction directly, without dispatching on its opcode, unless each instruction
+// has to be observed by single-step hooks; the compiler only fuses instructions on the same line, so breakpoints never replace the second one
+#define VM_NEXT_FUSED(op) \
+    { \
+        if (SingleStep) \
+            VM_NEXT(); \
+        VM_CONTINUE(op); \
+    }
+
 // Does VM support native execution via ExecutionCallbacks? We mostly assume it does but keep the define to make it easy to quantify the cost.
 #define VM_HAS_NATIVE 1
 
+#if LUA_USE_TIERING
+// loops that run often enough pass their function to the tierup callback as well
+// on-stack replacement: a loop that runs in the interpreter continues in native code as soon as its function has it
+// native code can be entered at any loop back edge, because it doesn't keep state across it outside of the stack frame
+// frames that exited native code midway keep the native flag and only return to native code after calls, as they would without this
+// both only happen with a tierup callback, so that without one a back edge doesn't touch the function
+#define VM_TIER_LOOP() \
+    { \
+        lua_ExecutionCallbacks* ecb = &L->global->ecb; \
+        if (LUAU_UNLIKELY(!!ecb->tierup)) \
+        { \
+            Proto* p = cl->l.p; \
+            if (++p->tierloops == ecb->tierloopthreshold) \
+                ecb->tierup(L, p); \
+            if (VM_HAS_NATIVE && p->execdata && !(L->ci->flags & LUA_CALLINFO_NATIVE) && !SingleStep) \
+            { \
+                L->ci->savedpc = pc; \
+                L->ci->flags |= LUA_CALLINFO_NATIVE; \
+                if (ecb->enter(L, p) == 1) \
+                    goto reentry; \
+                else \
+                    goto exit; \
+            } \
+        } \
+    }
+#else
+#define VM_TIER_LOOP() \
+    { \
+    }
+#endif
+
 LUAU_NOINLINE void luau_callhook(lua_State* L, lua_Hook hook, void* userdata)
 {
     ptrdiff_t base = savestack(L, L->base);
@@ -456,12 +504,20 @@ reentry:
                     int slot = LUAU_INSN_C(insn) & h->nodemask8;
                     LuaNode* n = &h->node[slot];
 
+                    TValue* sv = 0;
+
                     // fast-path: value is in expected slot
                     if (LUAU_LIKELY(ttisstring(gkey(n)) && tsvalue(gkey(n)) == tsvalue(kv) && !ttisnil(gval(n))))
                     {
                         setobj2s(L, ra, gval(n));
                         VM_NEXT();
                     }
+                    // fast-path: table has a shape with the key in expected slot
+                    else if (isshaped(h) && (sv = gshapeslot(h, LUAU_INSN_C(insn), tsvalue(kv))) && !ttisnil(sv))
+                    {
+                        setobj2s(L, ra, sv);
+                        VM_NEXT();
+                    }
                     else if (!h->metatable)
                     {
                         // fast-path: value is not in expected slot, but the table lookup doesn't involve metatable
@@ -489,6 +545,8 @@ reentry:
                 }
                 else
                 {
+                    VM_PROFILE(pc - 2, LUA_TYPEPROFILE_NONTABLE);
+
                     // fast-path: user data with C __index TM
                     const TValue* fn = 0;
                     if (ttisuserdata(rb) && (fn = fasttm(L, uvalue(rb)->metatable, TM_INDEX)) && ttisfunction(fn) && clvalue(fn)->isC)
@@ -573,6 +631,8 @@ reentry:
                     int slot = LUAU_INSN_C(insn) & h->nodemask8;
                     LuaNode* n = &h->node[slot];
 
+                    TValue* sv = 0;
+
                     // fast-path: value is in expected slot
                     if (LUAU_LIKELY(ttisstring(gkey(n)) && tsvalue(gkey(n)) == tsvalue(kv) && !ttisnil(gval(n)) && !h->readonly))
                     {
@@ -580,6 +640,13 @@ reentry:
                         luaC_barriert(L, h, ra);
                         VM_NEXT();
                     }
+                    // fast-path: table has a shape with the key in expected slot
+                    else if (isshaped(h) && (sv = gshapeslot(h, LUAU_INSN_C(insn), tsvalue(kv))) && !ttisnil(sv) && !h->readonly)
+                    {
+                        setobj2t(L, sv, ra);
+                        luaC_barriert(L, h, ra);
+                        VM_NEXT();
+                    }
                     else if (fastnotm(h->metatable, TM_NEWINDEX) && !h->readonly)
                     {
                         VM_PROTECT_PC(); // set may fail
@@ -809,24 +876,37 @@ reentry:
                     // for predictive lookups
                     LuaNode* n = &h->node[tsvalue(kv)->hash & (sizenode(h) - 1)];
 
-                    const TValue* mt = 0;
-                    const LuaNode* mtn = 0;
+                    const TValue* v = 0;
 
                     // fast-path: key is in the table in expected slot
                     if (ttisstring(gkey(n)) && tsvalue(gkey(n)) == tsvalue(kv) && !ttisnil(gval(n)))
+                        v = gval(n);
+                    // fast-path: table has a shape, so the main position is never a match and the shape is searched instead
+                    else if (isshaped(h))
+                        v = luaH_getstr(h, tsvalue(kv));
+
+                    // fast-path: key is absent from the base, table has an __index table, and it has the result in the expected slot
+                    if (v ? ttisnil(v) : gnext(n) == 0)
                     {
-                        // note: order of copies allows rb to alias ra+1 or ra
-                        setobj2s(L, ra + 1, rb);
-                        setobj2s(L, ra, gval(n));
+                        const TValue* mt = fasttm(L, h->metatable, TM_INDEX);
+
+                        if (mt && ttistable(mt))
+                        {
+                            Table* mh = hvalue(mt);
+                            const LuaNode* mtn = &mh->node[LUAU_INSN_C(insn) & mh->nodemask8];
+
+                            if (ttisstring(gkey(mtn)) && tsvalue(gkey(mtn)) == tsvalue(kv))
+                                v = gval(mtn);
+                            else if (isshaped(mh))
+                                v = gshapeslot(mh, LUAU_INSN_C(insn), tsvalue(kv));
+                        }
                     }
-                    // fast-path: key is absent from the base, table has an __index table, and it has the result in the expected slot
-                    else if (gnext(n) == 0 && (mt = fasttm(L, hvalue(rb)->metatable, TM_INDEX)) && ttistable(mt) &&
-                             (mtn = &hvalue(mt)->node[LUAU_INSN_C(insn) & hvalue(mt)->nodemask8]) && ttisstring(gkey(mtn)) &&
-                             tsvalue(gkey(mtn)) == tsvalue(kv) && !ttisnil(gval(mtn)))
+
+                    if (v && !ttisnil(v))
                     {
                         // note: order of copies allows rb to alias ra+1 or ra
                         setobj2s(L, ra + 1, rb);
-                        setobj2s(L, ra, gval(mtn));
+                        setobj2s(L, ra, v);
                     }
                     else
                     {
@@ -844,6 +924,8 @@ reentry:
                 }
                 else
                 {
+                    VM_PROFILE(pc - 2, LUA_TYPEPROFILE_NONTABLE);
+
                     Table* mt = ttisuserdata(rb) ? uvalue(rb)->metatable : L->global->mt[ttype(rb)];
                     const TValue* tmi = 0;
 
@@ -862,6 +944,8 @@ reentry:
                         int slot = LUAU_INSN_C(insn) & h->nodemask8;
                         LuaNode* n = &h->node[slot];
 
+                        TValue* sv = 0;
+
                         // fast-path: metatable with __index that has method in expected slot
                         if (LUAU_LIKELY(ttisstring(gkey(n)) && tsvalue(gkey(n)) == tsvalue(kv) && !ttisnil(gval(n))))
                         {
@@ -869,6 +953,13 @@ reentry:
                             setobj2s(L, ra + 1, rb);
                             setobj2s(L, ra, gval(n));
                         }
+                        // fast-path: metatable with __index that has a shape with method in expected slot
+                        else if (isshaped(h) && (sv = gshapeslot(h, LUAU_INSN_C(insn), tsvalue(kv))) && !ttisnil(sv))
+                        {
+                            // note: order of copies allows rb to alias ra+1 or ra
+                            setobj2s(L, ra + 1, rb);
+                            setobj2s(L, ra, sv);
+                        }
                         else
                         {
                             // slow-path: handles slot mismatch
@@ -952,6 +1043,8 @@ reentry:
                         setnilvalue(argi++); // complete missing arguments
                     L->top = p->is_vararg ? argi : ci->top;
 
+                    luaV_tierentry(L, p);
+
                     // reentry
                     // codeentry may point to NATIVECALL instruction when proto is compiled to native code
                     // this will result in execution continuing in native code, and is equivalent to if (p->execdata) but has no additional overhead
@@ -1462,6 +1555,8 @@ reentry:
                 }
                 else if (ttisvector(rb) && ttisvector(rc))
                 {
+                    VM_PROFILE(pc - 1, LUA_TYPEPROFILE_NONNUMBER | LUA_TYPEPROFILE_VECTORB | LUA_TYPEPROFILE_VECTORC);
+
                     const float* vb = rb->value.v;
                     const float* vc = rc->value.v;
                     setvvalue(ra, vb[0] + vc[0], vb[1] + vc[1], vb[2] + vc[2], vb[3] + vc[3]);
@@ -1469,6 +1564,8 @@ reentry:
                 }
                 else
                 {
+                    VM_PROFILE(pc - 1, LUA_TYPEPROFILE_NONNUMBER);
+
                     // fast-path for userdata with C functions
                     const TValue* fn = 0;
                     if (ttisuserdata(rb) && (fn = luaT_gettmbyobj(L, rb, TM_ADD)) && ttisfunction(fn) && clvalue(fn)->isC)
@@ -1508,6 +1605,8 @@ reentry:
                 }
                 else if (ttisvector(rb) && ttisvector(rc))
                 {
+                    VM_PROFILE(pc - 1, LUA_TYPEPROFILE_NONNUMBER | LUA_TYPEPROFILE_VECTORB | LUA_TYPEPROFILE_VECTORC);
+
                     const float* vb = rb->value.v;
                     const float* vc = rc->value.v;
                     setvvalue(ra, vb[0] - vc[0], vb[1] - vc[1], vb[2] - vc[2], vb[3] - vc[3]);
@@ -1515,6 +1614,8 @@ reentry:
                 }
                 else
                 {
+                    VM_PROFILE(pc - 1, LUA_TYPEPROFILE_NONNUMBER);
+
                     // fast-path for userdata with C functions
                     const TValue* fn = 0;
                     if (ttisuserdata(rb) && (fn = luaT_gettmbyobj(L, rb, TM_SUB)) && ttisfunction(fn) && clvalue(fn)->isC)
@@ -1554,6 +1655,8 @@ reentry:
                 }
                 else if (ttisvector(rb) && ttisnumber(rc))
                 {
+                    VM_PROFILE(pc - 1, LUA_TYPEPROFILE_NONNUMBER | LUA_TYPEPROFILE_VECTORB);
+
                     const float* vb = rb->value.v;
                     float vc = cast_to(float, nvalue(rc));
                     setvvalue(ra, vb[0] * vc, vb[1] * vc, vb[2] * vc, vb[3] * vc);
@@ -1561,6 +1664,8 @@ reentry:
                 }
                 else if (ttisvector(rb) && ttisvector(rc))
                 {
+                    VM_PROFILE(pc - 1, LUA_TYPEPROFILE_NONNUMBER | LUA_TYPEPROFILE_VECTORB | LUA_TYPEPROFILE_VECTORC);
+
                     const float* vb = rb->value.v;
                     const float* vc = rc->value.v;
                     setvvalue(ra, vb[0] * vc[0], vb[1] * vc[1], vb[2] * vc[2], vb[3] * vc[3]);
@@ -1568,6 +1673,8 @@ reentry:
                 }
                 else if (ttisnumber(rb) && ttisvector(rc))
                 {
+                    VM_PROFILE(pc - 1, LUA_TYPEPROFILE_NONNUMBER | LUA_TYPEPROFILE_VECTORC);
+
                     float vb = cast_to(float, nvalue(rb));
                     const float* vc = rc->value.v;
                     setvvalue(ra, vb * vc[0], vb * vc[1], vb * vc[2], vb * vc[3]);
@@ -1575,6 +1682,8 @@ reentry:
                 }
                 else
                 {
+                    VM_PROFILE(pc - 1, LUA_TYPEPROFILE_NONNUMBER);
+
                     // fast-path for userdata with C functions
                     StkId rbc = ttisnumber(rb) ? rc : rb;
                     const TValue* fn = 0;
@@ -1615,6 +1724,8 @@ reentry:
                 }
                 else if (ttisvector(rb) && ttisnumber(rc))
                 {
+                    VM_PROFILE(pc - 1, LUA_TYPEPROFILE_NONNUMBER | LUA_TYPEPROFILE_VECTORB);
+
                     const float* vb = rb->value.v;
                     float vc = cast_to(float, nvalue(rc));
                     setvvalue(ra, vb[0] / vc, vb[1] / vc, vb[2] / vc, vb[3] / vc);
@@ -1622,6 +1733,8 @@ reentry:
                 }
                 else if (ttisvector(rb) && ttisvector(rc))
                 {
+                    VM_PROFILE(pc - 1, LUA_TYPEPROFILE_NONNUMBER | LUA_TYPEPROFILE_VECTORB | LUA_TYPEPROFILE_VECTORC);
+
                     const float* vb = rb->value.v;
                     const float* vc = rc->value.v;
                     setvvalue(ra, vb[0] / vc[0], vb[1] / vc[1], vb[2] / vc[2], vb[3] / vc[3]);
@@ -1629,6 +1742,8 @@ reentry:
                 }
                 else if (ttisnumber(rb) && ttisvector(rc))
                 {
+                    VM_PROFILE(pc - 1, LUA_TYPEPROFILE_NONNUMBER | LUA_TYPEPROFILE_VECTORC);
+
                     float vb = cast_to(float, nvalue(rb));
                     const float* vc = rc->value.v;
                     setvvalue(ra, vb / vc[0], vb / vc[1], vb / vc[2], vb / vc[3]);
@@ -1636,6 +1751,8 @@ reentry:
                 }
                 else
                 {
+                    VM_PROFILE(pc - 1, LUA_TYPEPROFILE_NONNUMBER);
+
                     // fast-path for userdata with C functions
                     StkId rbc = ttisnumber(rb) ? rc : rb;
                     const TValue* fn = 0;
@@ -1676,6 +1793,8 @@ reentry:
                 }
                 else if (ttisvector(rb) && ttisnumber(rc))
                 {
+                    VM_PROFILE(pc - 1, LUA_TYPEPROFILE_NONNUMBER | LUA_TYPEPROFILE_VECTORB);
+
                     const float* vb = vvalue(rb);
                     float vc = cast_to(float, nvalue(rc));
                     setvvalue(ra, float(luai_numidiv(vb[0], vc)), float(luai_numidiv(vb[1], vc)), float(luai_numidiv(vb[2], vc)),
@@ -1684,6 +1803,8 @@ reentry:
                 }
                 else
                 {
+                    VM_PROFILE(pc - 1, LUA_TYPEPROFILE_NONNUMBER);
+
                     // fast-path for userdata with C functions
                     StkId rbc = ttisnumber(rb) ? rc : rb;
                     const TValue* fn = 0;
@@ -1726,6 +1847,8 @@ reentry:
                 }
                 else
                 {
+                    VM_PROFILE(pc - 1, LUA_TYPEPROFILE_NONNUMBER);
+
                     // slow-path, may invoke C/Lua via metamethods
                     VM_PROTECT(luaV_doarith(L, ra, rb, rc, TM_MOD));
                     VM_NEXT();
@@ -1747,6 +1870,8 @@ reentry:
                 }
                 else
                 {
+                    VM_PROFILE(pc - 1, LUA_TYPEPROFILE_NONNUMBER);
+
                     // slow-path, may invoke C/Lua via metamethods
                     VM_PROTECT(luaV_doarith(L, ra, rb, rc, TM_POW));
                     VM_NEXT();
@@ -1768,6 +1893,8 @@ reentry:
                 }
                 else
                 {
+                    VM_PROFILE(pc - 1, LUA_TYPEPROFILE_NONNUMBER);
+
                     // slow-path, may invoke C/Lua via metamethods
                     VM_PROTECT(luaV_doarith(L, ra, rb, kv, TM_ADD));
                     VM_NEXT();
@@ -1789,6 +1916,8 @@ reentry:
                 }
                 else
                 {
+                    VM_PROFILE(pc - 1, LUA_TYPEPROFILE_NONNUMBER);
+
                     // slow-path, may invoke C/Lua via metamethods
                     VM_PROTECT(luaV_doarith(L, ra, rb, kv, TM_SUB));
                     VM_NEXT();
@@ -1810,6 +1939,8 @@ reentry:
                 }
                 else if (ttisvector(rb))
                 {
+                    VM_PROFILE(pc - 1, LUA_TYPEPROFILE_NONNUMBER | LUA_TYPEPROFILE_VECTORB);
+
                     const float* vb = rb->value.v;
                     float vc = cast_to(float, nvalue(kv));
                     setvvalue(ra, vb[0] * vc, vb[1] * vc, vb[2] * vc, vb[3] * vc);
@@ -1817,6 +1948,8 @@ reentry:
                 }
                 else
                 {
+                    VM_PROFILE(pc - 1, LUA_TYPEPROFILE_NONNUMBER);
+
                     // fast-path for userdata with C functions
                     const TValue* fn = 0;
                     if (ttisuserdata(rb) && (fn = luaT_gettmbyobj(L, rb, TM_MUL)) && ttisfunction(fn) && clvalue(fn)->isC)
@@ -1856,6 +1989,8 @@ reentry:
                 }
                 else if (ttisvector(rb))
                 {
+                    VM_PROFILE(pc - 1, LUA_TYPEPROFILE_NONNUMBER | LUA_TYPEPROFILE_VECTORB);
+
                     const float* vb = rb->value.v;
                     float vc = cast_to(float, nvalue(kv));
                     setvvalue(ra, vb[0] / vc, vb[1] / vc, vb[2] / vc, vb[3] / vc);
@@ -1863,6 +1998,8 @@ reentry:
                 }
                 else
                 {
+                    VM_PROFILE(pc - 1, LUA_TYPEPROFILE_NONNUMBER);
+
                     // fast-path for userdata with C functions
                     const TValue* fn = 0;
                     if (ttisuserdata(rb) && (fn = luaT_gettmbyobj(L, rb, TM_DIV)) && ttisfunction(fn) && clvalue(fn)->isC)
@@ -1902,6 +2039,8 @@ reentry:
                 }
                 else if (ttisvector(rb))
                 {
+                    VM_PROFILE(pc - 1, LUA_TYPEPROFILE_NONNUMBER | LUA_TYPEPROFILE_VECTORB);
+
                     const float* vb = vvalue(rb);
                     float vc = cast_to(float, nvalue(kv));
                     setvvalue(ra, float(luai_numidiv(vb[0], vc)), float(luai_numidiv(vb[1], vc)), float(luai_numidiv(vb[2], vc)),
@@ -1910,6 +2049,8 @@ reentry:
                 }
                 else
                 {
+                    VM_PROFILE(pc - 1, LUA_TYPEPROFILE_NONNUMBER);
+
                     // fast-path for userdata with C functions
                     const TValue* fn = 0;
                     if (ttisuserdata(rb) && (fn = luaT_gettmbyobj(L, rb, TM_IDIV)) && ttisfunction(fn) && clvalue(fn)->isC)
@@ -1951,6 +2092,8 @@ reentry:
                 }
                 else
                 {
+                    VM_PROFILE(pc - 1, LUA_TYPEPROFILE_NONNUMBER);
+
                     // slow-path, may invoke C/Lua via metamethods
                     VM_PROTECT(luaV_doarith(L, ra, rb, kv, TM_MOD));
                     VM_NEXT();
@@ -1978,6 +2121,8 @@ reentry:
                 }
                 else
                 {
+                    VM_PROFILE(pc - 1, LUA_TYPEPROFILE_NONNUMBER);
+
                     // slow-path, may invoke C/Lua via metamethods
                     VM_PROTECT(luaV_doarith(L, ra, rb, kv, TM_POW));
                     VM_NEXT();
@@ -2069,6 +2214,8 @@ reentry:
                 }
                 else if (ttisvector(rb))
                 {
+                    VM_PROFILE(pc - 1, LUA_TYPEPROFILE_NONNUMBER | LUA_TYPEPROFILE_VECTORB);
+
                     const float* vb = rb->value.v;
                     setvvalue(ra, -vb[0], -vb[1], -vb[2], -vb[3]);
                     VM_NEXT();
@@ -2145,7 +2292,8 @@ reentry:
 
                 VM_PROTECT_PC(); // luaH_new may fail due to OOM
 
-                sethvalue(L, ra, luaH_new(L, aux, b == 0 ? 0 : (1 << (b - 1))));
+                Table* h = LUAU_INSN_C(insn) ? luaH_newshaped(L, b == 0 ? 0 : (1 << (b - 1))) : luaH_new(L, aux, b == 0 ? 0 : (1 << (b - 1)));
+                sethvalue(L, ra, h);
                 VM_PROTECT(luaC_checkGC(L));
                 VM_NEXT();
             }
@@ -2226,6 +2374,7 @@ reentry:
 
             VM_CASE(LOP_FORNLOOP)
             {
+                VM_TIER_LOOP();
                 VM_INTERRUPT();
                 Instruction insn = *pc++;
                 StkId ra = VM_REG(LUAU_INSN_A(insn));
@@ -2311,6 +2460,7 @@ reentry:
 
             VM_CASE(LOP_FORGLOOP)
             {
+                VM_TIER_LOOP();
                 VM_INTERRUPT();
                 Instruction insn = *pc++;
                 StkId ra = VM_REG(LUAU_INSN_A(insn));
@@ -2379,6 +2529,32 @@ reentry:
                         index++;
                     }
 
+                    // then we advance index through the slots, which are numbered after the node that holds the shape
+                    if (isshaped(h))
+                    {
+                        TableShape* shape = gshape(h);
+                        TValue* slots = gslots(h);
+                        int base = sizearray + sizenode;
+
+                        while (unsigned(index - base) < unsigned(shape->count))
+                        {
+                            TValue* e = &slots[index - base];
+
+                            if (!ttisnil(e))
+                            {
+                                setpvalue(ra + 2, reinterpret_cast<void*>(uintptr_t(index + 1)));
+                                setsvalue(L, ra + 3, shape->keys[index - base]);
+                                setobj2s(L, ra + 4, e);
+
+                                pc += LUAU_INSN_D(insn);
+                                LUAU_ASSERT(unsigned(pc - cl->l.p->code) < unsigned(cl->l.p->sizecode));
+                                VM_NEXT();
+                            }
+
+                            index++;
+                        }
+                    }
+
                     // fallthrough to exit
                     pc++;
                     VM_NEXT();
@@ -2599,6 +2775,7 @@ reentry:
 
             VM_CASE(LOP_JUMPBACK)
             {
+                VM_TIER_LOOP();
                 VM_INTERRUPT();
                 Instruction insn = *pc++;
 
@@ -2933,6 +3110,84 @@ reentry:
                 VM_NEXT();
             }
 
+            VM_CASE(LOP_MOVE_MOVE)
+            {
+                Instruction insn = *pc++;
+                StkId ra = VM_REG(LUAU_INSN_A(insn));
+                StkId rb = VM_REG(LUAU_INSN_B(insn));
+
+                setobj2s(L, ra, rb);
+                VM_NEXT_FUSED(LOP_MOVE);
+            }
+
+            VM_CASE(LOP_MOVE_CALL)
+            {
+                Instruction insn = *pc++;
+                StkId ra = VM_REG(LUAU_INSN_A(insn));
+                StkId rb = VM_REG(LUAU_INSN_B(insn));
+
+                setobj2s(L, ra, rb);
+                VM_NEXT_FUSED(LOP_CALL);
+            }
+
+            VM_CASE(LOP_LOADN_LOADN)
+            {
+                Instruction insn = *pc++;
+                StkId ra = VM_REG(LUAU_INSN_A(insn));
+
+                setnvalue(ra, LUAU_INSN_D(insn));
+                VM_NEXT_FUSED(LOP_LOADN);
+            }
+
+            VM_CASE(LOP_LOADN_CALL)
+            {
+                Instruction insn = *pc++;
+                StkId ra = VM_REG(LUAU_INSN_A(insn));
+
+                setnvalue(ra, LUAU_INSN_D(insn));
+                VM_NEXT_FUSED(LOP_CALL);
+            }
+
+            VM_CASE(LOP_LOADK_LOADK)
+            {
+                Instruction insn = *pc++;
+                StkId ra = VM_REG(LUAU_INSN_A(insn));
+                TValue* kv = VM_KV(LUAU_INSN_D(insn));
+
+                setobj2s(L, ra, kv);
+                VM_NEXT_FUSED(LOP_LOADK);
+            }
+
+            VM_CASE(LOP_LOADK_CALL)
+            {
+                Instruction insn = *pc++;
+                StkId ra = VM_REG(LUAU_INSN_A(insn));
+                TValue* kv = VM_KV(LUAU_INSN_D(insn));
+
+                setobj2s(L, ra, kv);
+                VM_NEXT_FUSED(LOP_CALL);
+            }
+
+            VM_CASE(LOP_GETIMPORT_CALL)
+            {
+                Instruction insn = *pc;
+                StkId ra = VM_REG(LUAU_INSN_A(insn));
+                TValue* kv = VM_KV(LUAU_INSN_D(insn));
+
+                // fast-path: import resolution was successful and closure environment is "safe" for import
+                if (!ttisnil(kv) && cl->env->safeenv)
+                {
+                    setobj2s(L, ra, kv);
+                    pc += 2; // skip over AUX
+                    VM_NEXT_FUSED(LOP_CALL);
+                }
+                else
+                {
+                    // slow-path: import is resolved by GETIMPORT from the start, the CALL after it is dispatched separately
+                    VM_CONTINUE(LOP_GETIMPORT);
+                }
+            }
+
 #if !VM_USE_CGOTO
         default:
             LUAU_ASSERT(!"Unknown opcode");
@@ -2989,6 +3244,8 @@ int luau_precall(lua_State* L, StkId func, int nresults)
 
         ci->savedpc = p->code;
 
+        luaV_tierentry(L, p);
+
 #if VM_HAS_NATIVE
         if (p->execdata)
             ci->flags = LUA_CALLINFO_NATIVE;
@@ -13,6 +13,10 @@
 
 #include <string.h>
 
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
 // TODO: RAII deallocation doesn't work for longjmp builds if a memory error happens
 template<typename T>
 struct TempBuffer
@@ -102,13 +106,6 @@ static unsigned int readVarInt(const char* data, size_t size, size_t& offset)
     return result;
 }
 
-static TString* readString(TempBuffer<TString*>& strings, const char* data, size_t size, size_t& offset)
-{
-    unsigned int id = readVarInt(data, size, offset);
-
-    return id == 0 ? NULL : strings[id - 1];
-}
-
 static void resolveImportSafe(lua_State* L, Table* env, TValue* k, uint32_t id)
 {
     struct ResolveImport
@@ -153,20 +150,460 @@ static void resolveImportSafe(lua_State* L, Table* env, TValue* k, uint32_t id)
     }
 }
 
-int luau_load(lua_State* L, const char* chunkname, const char* data, size_t size, int env)
+static size_t alignoffset(const char* data, size_t offset)
+{
+    return offset + (-uintptr_t(data + offset) & 3);
+}
+
+// type feedback is only useful for functions that tiering may compile later
+static void allocprofile(lua_State* L, Proto* p)
+{
+    if (L->global->ecb.tierup)
+    {
+        p->typeprofile = luaM_newarray(L, p->sizecode, uint8_t, p->memcat);
+        memset(p->typeprofile, 0, p->sizecode);
+    }
+}
+
+/*
+** Bytecode is parsed into an image first, and functions are created from the image afterwards. luau_load parses into a temporary
+** image that refers to the bytecode in place, while images from luau_decode keep a copy of the bytecode so that they can be loaded
+** into many states; in that case only the objects that each state owns are created. Instructions are always copied unless the
+** bytecode is mapped, since they are patched at runtime.
+** Images can be shared between states, so their memory isn't accounted for by any state; it comes from the allocator of the state
+** that decoded them, and the last release frees it from any thread.
+*/
+
+// constant with the payload already decoded; strings are 1-based string ids, tables refer to a range of keys in `tablekeys'
+struct ImageConstant
+{
+    uint8_t kind;
+
+    union
+    {
+        uint8_t boolean;
+        double number;
+        uint32_t id; // string id, import id or proto id
+
+        struct
+        {
+            uint32_t offset;
+            uint32_t count;
+        } table;
+    };
+};
+
+// strings refer to the bytecode in place
+struct ImageString
+{
+    uint32_t offset;
+    uint32_t length;
+};
+
+struct ImageLocVar
+{
+    uint32_t varname;
+    int startpc;
+    int endpc;
+    uint8_t reg;
+};
+
+// arrays of a function are stored as ranges in the image arrays; instructions and type info are offsets in the bytecode, line info is
+// an offset in the bytecode for mapped images and in `lineinfo' otherwise; -1 offsets mark absent data
+struct ImageProto
+{
+    uint8_t maxstacksize;
+    uint8_t numparams;
+    uint8_t nups;
+    uint8_t is_vararg;
+    uint8_t flags;
+    uint8_t debuginfo;
+
+    int typeinfo;
+
+    int sizecode;
+    uint32_t code;
+
+    int sizek;
+    uint32_t k;
+
+    int sizep;
+    uint32_t p;
+
+    int linedefined;
+    uint32_t debugname;
+
+    int linegaplog2;
+    int sizelineinfo;
+    int lineinfo;
+
+    int sizelocvars;
+    uint32_t locvars;
+
+    int sizeupvalues;
+    uint32_t upvalues;
+};
+
+template<typename T>
+struct ImageArray
 {
+    T* data;
+    uint32_t count;
+    uint32_t size;
+};
+
+struct lua_BytecodeImage
+{
+    long refs;
+
+    lua_Alloc frealloc;
+    void* ud;
+
+    const char* bytecode;
+    size_t bytecodesize;
+    bool ownsbytecode;
+    bool mapped; // bytecode uses the aligned layout and protos refer to the instructions and line info in place
+
+    uint8_t version;
+
+    ImageArray<ImageString> strings;
+    ImageArray<ImageProto> protos;
+    ImageArray<ImageConstant> constants;
+    ImageArray<uint32_t> tablekeys;
+    ImageArray<uint32_t> protoids;
+    ImageArray<ImageLocVar> locvars;
+    ImageArray<uint32_t> upvalues;
+    ImageArray<uint8_t> lineinfo; // 4-byte aligned ranges, since line info is followed by abslineinfo
+
+    uint32_t mainid;
+};
+
+// makes room for `extra' more elements; returns false if memory can't be allocated
+template<typename T>
+static bool reservearray(lua_BytecodeImage* image, ImageArray<T>& array, size_t extra)
+{
+    size_t needed = array.count + extra;
+
+    if (needed <= array.size)
+        return true;
+
+    size_t newsize = array.size * size_t(2) > needed ? array.size * size_t(2) : needed;
+
+    if (newsize > UINT32_MAX / sizeof(T))
+        return false;
+
+    T* data = (T*)(*image->frealloc)(image->ud, array.data, array.size * sizeof(T), newsize * sizeof(T));
+
+    if (!data)
+        return false;
+
+    array.data = data;
+    array.size = uint32_t(newsize);
+    return true;
+}
+
+template<typename T>
+static void freearray(lua_BytecodeImage* image, ImageArray<T>& array)
+{
+    (*image->frealloc)(image->ud, array.data, array.size * sizeof(T), 0);
+
+    array.data = NULL;
+    array.count = 0;
+    array.size = 0;
+}
+
+static void initimage(lua_BytecodeImage* image, global_State* g, const char* data, size_t size, bool mapped)
+{
+    memset(image, 0, sizeof(lua_BytecodeImage));
+
+    image->frealloc = g->frealloc;
+    image->ud = g->ud;
+    image->bytecode = data;
+    image->bytecodesize = size;
+    image->mapped = mapped;
+}
+
+// frees everything the image owns except for the image itself; safe to call more than once
+static void clearimage(lua_BytecodeImage* image)
+{
+    freearray(image, image->strings);
+    freearray(image, image->protos);
+    freearray(image, image->constants);
+    freearray(image, image->tablekeys);
+    freearray(image, image->protoids);
+    freearray(image, image->locvars);
+    freearray(image, image->upvalues);
+    freearray(image, image->lineinfo);
+
+    if (image->ownsbytecode)
+    {
+        (*image->frealloc)(image->ud, (char*)image->bytecode, image->bytecodesize, 0);
+        image->bytecode = NULL;
+        image->ownsbytecode = false;
+    }
+}
+
+// returns false if memory can't be allocated; errors in the bytecode are reported when the image is loaded, since that's when the chunk
+// name is known
+static bool decodeimage(lua_BytecodeImage* image)
+{
+    const char* data = image->bytecode;
+    size_t size = image->bytecodesize;
+    bool mapped = image->mapped;
+
     size_t offset = 0;
 
     uint8_t version = read<uint8_t>(data, size, offset);
+    image->version = version;
+
+    // 0 means the rest of the bytecode is the error message
+    if (version == 0 || version < LBC_VERSION_MIN || version > LBC_VERSION_MAX)
+        return true;
+
+    uint8_t typesversion = 0;
 
+    if (version >= 4)
+    {
+        typesversion = read<uint8_t>(data, size, offset);
+    }
+
+    // string table
+    unsigned int stringCount = readVarInt(data, size, offset);
+    if (!reservearray(image, image->strings, stringCount))
+        return false;
+
+    for (unsigned int i = 0; i < stringCount; ++i)
+    {
+        ImageString& str = image->strings.data[image->strings.count++];
+
+        str.length = readVarInt(data, size, offset);
+        str.offset = uint32_t(offset);
+        offset += str.length;
+    }
+
+    // proto table
+    unsigned int protoCount = readVarInt(data, size, offset);
+    if (!reservearray(image, image->protos, protoCount))
+        return false;
+
+    for (unsigned int i = 0; i < protoCount; ++i)
+    {
+        if (mapped)
+            offset = alignoffset(data, offset);
+
+        ImageProto& p = image->protos.data[image->protos.count++];
+
+        p.maxstacksize = read<uint8_t>(data, size, offset);
+        p.numparams = read<uint8_t>(data, size, offset);
+        p.nups = read<uint8_t>(data, size, offset);
+        p.is_vararg = read<uint8_t>(data, size, offset);
+        p.flags = 0;
+        p.typeinfo = -1;
+
+        if (version >= 4)
+        {
+            p.flags = read<uint8_t>(data, size, offset);
+
+            uint32_t typesize = readVarInt(data, size, offset);
+
+            if (typesize && typesversion == LBC_TYPE_VERSION)
+            {
+                const uint8_t* types = (const uint8_t*)data + offset;
+
+                LUAU_ASSERT(typesize == unsigned(2 + p.numparams));
+                LUAU_ASSERT(types[0] == LBC_TYPE_FUNCTION);
+                LUAU_ASSERT(types[1] == p.numparams);
+
+                p.typeinfo = int(offset);
+            }
 
+            offset += typesize;
+        }
+
+        p.sizecode = readVarInt(data, size, offset);
+
+        if (mapped)
+            offset = alignoffset(data, offset);
+
+        LUAU_ASSERT(offset + p.sizecode * sizeof(Instruction) <= size);
+
+        p.code = uint32_t(offset);
+        offset += p.sizecode * sizeof(Instruction);
+
+        p.sizek = readVarInt(data, size, offset);
+        p.k = image->constants.count;
+
+        if (!reservearray(image, image->constants, p.sizek))
+            return false;
+
+        for (int j = 0; j < p.sizek; ++j)
+        {
+            ImageConstant& k = image->constants.data[image->constants.count++];
+            k.kind = read<uint8_t>(data, size, offset);
+
+            switch (k.kind)
+            {
+            case LBC_CONSTANT_NIL:
+                break;
+
+            case LBC_CONSTANT_BOOLEAN:
+                k.boolean = read<uint8_t>(data, size, offset);
+                break;
+
+            case LBC_CONSTANT_NUMBER:
+                k.number = read<double>(data, size, offset);
+                break;
+
+            case LBC_CONSTANT_STRING:
+                k.id = readVarInt(data, size, offset);
+                break;
+
+            case LBC_CONSTANT_IMPORT:
+                k.id = read<uint32_t>(data, size, offset);
+                break;
+
+            case LBC_CONSTANT_TABLE:
+            {
+                k.table.offset = image->tablekeys.count;
+                k.table.count = readVarInt(data, size, offset);
+
+                if (!reservearray(image, image->tablekeys, k.table.count))
+                    return false;
+
+                for (uint32_t i = 0; i < k.table.count; ++i)
+                    image->tablekeys.data[image->tablekeys.count++] = readVarInt(data, size, offset);
+                break;
+            }
+
+            case LBC_CONSTANT_CLOSURE:
+                k.id = readVarInt(data, size, offset);
+                break;
+
+            default:
+                LUAU_ASSERT(!"Unexpected constant kind");
+            }
+        }
+
+        p.sizep = readVarInt(data, size, offset);
+        p.p = image->protoids.count;
+
+        if (!reservearray(image, image->protoids, p.sizep))
+            return false;
+
+        for (int j = 0; j < p.sizep; ++j)
+            image->protoids.data[image->protoids.count++] = readVarInt(data, size, offset);
+
+        p.linedefined = readVarInt(data, size, offset);
+        p.debugname = readVarInt(data, size, offset);
+
+        p.linegaplog2 = 0;
+        p.sizelineinfo = 0;
+        p.lineinfo = -1;
+
+        uint8_t lineinfo = read<uint8_t>(data, size, offset);
+
+        if (lineinfo)
+        {
+            p.linegaplog2 = read<uint8_t>(data, size, offset);
+
+            int intervals = ((p.sizecode - 1) >> p.linegaplog2) + 1;
+            int absoffset = (p.sizecode + 3) & ~3;
+
+            p.sizelineinfo = absoffset + intervals * sizeof(int);
+
+            if (mapped)
+            {
+                offset = alignoffset(data, offset);
+                LUAU_ASSERT(offset + p.sizelineinfo <= size);
+
+                p.lineinfo = int(offset);
+                offset += p.sizelineinfo;
+            }
+            else
+            {
+                uint32_t start = (image->lineinfo.count + 3) & ~3;
+
+                if (!reservearray(image, image->lineinfo, start - image->lineinfo.count + p.sizelineinfo))
+                    return false;
+
+                p.lineinfo = int(start);
+                image->lineinfo.count = start + p.sizelineinfo;
+
+                uint8_t* pli = image->lineinfo.data + start;
+                int* pabsli = (int*)(pli + absoffset);
+
+                uint8_t lastoffset = 0;
+                for (int j = 0; j < p.sizecode; ++j)
+                {
+                    lastoffset += read<uint8_t>(data, size, offset);
+                    pli[j] = lastoffset;
+                }
+
+                int lastline = 0;
+                for (int j = 0; j < intervals; ++j)
+                {
+                    lastline += read<int32_t>(data, size, offset);
+                    pabsli[j] = lastline;
+                }
+            }
+        }
+
+        p.debuginfo = read<uint8_t>(data, size, offset);
+        p.sizelocvars = 0;
+        p.locvars = 0;
+        p.sizeupvalues = 0;
+        p.upvalues = 0;
+
+        if (p.debuginfo)
+        {
+            p.sizelocvars = readVarInt(data, size, offset);
+            p.locvars = image->locvars.count;
+
+            if (!reservearray(image, image->locvars, p.sizelocvars))
+                return false;
+
+            for (int j = 0; j < p.sizelocvars; ++j)
+            {
+                ImageLocVar& l = image->locvars.data[image->locvars.count++];
+                l.varname = readVarInt(data, size, offset);
+                l.startpc = readVarInt(data, size, offset);
+                l.endpc = readVarInt(data, size, offset);
+                l.reg = read<uint8_t>(data, size, offset);
+            }
+
+            p.sizeupvalues = readVarInt(data, size, offset);
+            p.upvalues = image->upvalues.count;
+
+            if (!reservearray(image, image->upvalues, p.sizeupvalues))
+                return false;
+
+            for (int j = 0; j < p.sizeupvalues; ++j)
+                image->upvalues.data[image->upvalues.count++] = readVarInt(data, size, offset);
+        }
+    }
+
+    image->mainid = readVarInt(data, size, offset);
+
+    return true;
+}
+
+static TString* getimagestring(TempBuffer<TString*>& strings, uint32_t id)
+{
+    return id == 0 ? NULL : strings[id - 1];
+}
+
+// creates the functions of the image and pushes the main function; with sharedinfo, functions refer to the line info and type info of
+// the image, which has to outlive them, otherwise they get their own copies
+static int loadimage(lua_State* L, const char* chunkname, lua_BytecodeImage* image, int env, bool sharedinfo)
+{
+    uint8_t version = image->version;
 
     // 0 means the rest of the bytecode is the error message
     if (version == 0)
     {
         char chunkbuf[LUA_IDSIZE];
         const char* chunkid = luaO_chunkid(chunkbuf, sizeof(chunkbuf), chunkname, strlen(chunkname));
-        lua_pushfstring(L, "%s%.*s", chunkid, int(size - offset), data + offset);
+        lua_pushfstring(L, "%s%.*s", chunkid, int(image->bytecodesize - 1), image->bytecode + 1);
         return 1;
     }
 
@@ -191,69 +628,71 @@ int luau_load(lua_State* L, const char* chunkname, const char* data, size_t size
 
     TString* source = luaS_new(L, chunkname);
 
-    uint8_t typesversion = 0;
-
-    if (version >= 4)
-    {
-        typesversion = read<uint8_t>(data, size, offset);
-    }
+    const char* data = image->bytecode;
 
     // string table
-    unsigned int stringCount = readVarInt(data, size, offset);
+    unsigned int stringCount = image->strings.count;
     TempBuffer<TString*> strings(L, stringCount);
 
     for (unsigned int i = 0; i < stringCount; ++i)
     {
-        unsigned int length = readVarInt(data, size, offset);
-
-        strings[i] = luaS_newlstr(L, data + offset, length);
-        offset += length;
+        const ImageString& str = image->strings.data[i];
+        strings[i] = luaS_newlstr(L, data + str.offset, str.length);
     }
 
     // proto table
-    unsigned int protoCount = readVarInt(data, size, offset);
+    unsigned int protoCount = image->protos.count;
     TempBuffer<Proto*> protos(L, protoCount);
 
     for (unsigned int i = 0; i < protoCount; ++i)
     {
+        const ImageProto& ip = image->protos.data[i];
+
         Proto* p = luaF_newproto(L);
         p->source = source;
         p->bytecodeid = int(i);
+        p->sharedinfo = sharedinfo;
+        p->sharedcode = image->mapped;
 
-        p->maxstacksize = read<uint8_t>(data, size, offset);
-        p->numparams = read<uint8_t>(data, size, offset);
-        p->nups = read<uint8_t>(data, size, offset);
-        p->is_vararg = read<uint8_t>(data, size, offset);
+        p->maxstacksize = ip.maxstacksize;
+        p->numparams = ip.numparams;
+        p->nups = ip.nups;
+        p->is_vararg = ip.is_vararg;
+        p->flags = ip.flags;
 
-        if (version >= 4)
+        if (ip.typeinfo >= 0)
         {
-            p->flags = read<uint8_t>(data, size, offset);
+            uint8_t* types = (uint8_t*)data + ip.typeinfo;
+            int typesize = 2 + p->numparams;
 
-            uint32_t typesize = readVarInt(data, size, offset);
-
-            if (typesize && typesversion == LBC_TYPE_VERSION)
+            if (sharedinfo)
+            {
+                p->typeinfo = types;
+            }
+            else
             {
-                uint8_t* types = (uint8_t*)data + offset;
-
-                LUAU_ASSERT(typesize == unsigned(2 + p->numparams));
-                LUAU_ASSERT(types[0] == LBC_TYPE_FUNCTION);
-                LUAU_ASSERT(types[1] == p->numparams);
-
                 p->typeinfo = luaM_newarray(L, typesize, uint8_t, p->memcat);
                 memcpy(p->typeinfo, types, typesize);
             }
-
-            offset += typesize;
         }
 
-        p->sizecode = readVarInt(data, size, offset);
-        p->code = luaM_newarray(L, p->sizecode, Instruction, p->memcat);
-        for (int j = 0; j < p->sizecode; ++j)
-            p->code[j] = read<uint32_t>(data, size, offset);
+        p->sizecode = ip.sizecode;
+
+        if (image->mapped)
+        {
+            p->code = (Instruction*)(data + ip.code);
+        }
+        else
+        {
+            p->code = luaM_newarray(L, p->sizecode, Instruction, p->memcat);
+            memcpy(p->code, data + ip.code, p->sizecode * sizeof(Instruction));
+        }
 
         p->codeentry = p->code;
 
-        p->sizek = readVarInt(data, size, offset);
+        allocprofile(L, p);
+
+        p->sizek = ip.sizek;
         p->k = luaM_newarray(L, p->sizek, TValue, p->memcat);
 
 #ifdef HARDMEMTESTS
@@ -267,60 +706,47 @@ int luau_load(lua_State* L, const char* chunkname, const char* data, size_t size
 
         for (int j = 0; j < p->sizek; ++j)
         {
-            switch (read<uint8_t>(data, size, offset))
+            const ImageConstant& k = image->constants.data[ip.k + j];
+
+            switch (k.kind)
             {
             case LBC_CONSTANT_NIL:
                 setnilvalue(&p->k[j]);
                 break;
 
             case LBC_CONSTANT_BOOLEAN:
-            {
-                uint8_t v = read<uint8_t>(data, size, offset);
-                setbvalue(&p->k[j], v);
+                setbvalue(&p->k[j], k.boolean);
                 break;
-            }
 
             case LBC_CONSTANT_NUMBER:
-            {
-                double v = read<double>(data, size, offset);
-                setnvalue(&p->k[j], v);
+                setnvalue(&p->k[j], k.number);
                 break;
-            }
 
             case LBC_CONSTANT_STRING:
-            {
-                TString* v = readString(strings, data, size, offset);
-                setsvalue(L, &p->k[j], v);
+                setsvalue(L, &p->k[j], getimagestring(strings, k.id));
                 break;
-            }
 
             case LBC_CONSTANT_IMPORT:
-            {
-                uint32_t iid = read<uint32_t>(data, size, offset);
-                resolveImportSafe(L, envt, p->k, iid);
+                resolveImportSafe(L, envt, p->k, k.id);
                 setobj(L, &p->k[j], L->top - 1);
                 L->top--;
                 break;
-            }
 
             case LBC_CONSTANT_TABLE:
             {
-                int keys = readVarInt(data, size, offset);
-                Table* h = luaH_new(L, 0, keys);
-                for (int i = 0; i < keys; ++i)
+                Table* h = luaH_new(L, 0, k.table.count);
+                for (uint32_t i = 0; i < k.table.count; ++i)
                 {
-                    int key = readVarInt(data, size, offset);
-                    TValue* val = luaH_set(L, h, &p->k[key]);
+                    TValue* val = luaH_set(L, h, &p->k[image->tablekeys.data[k.table.offset + i]]);
                     setnvalue(val, 0.0);
                 }
-                sethvalue(L, &p->k[j], h);
+                sethvalue(L, &p->k[j], luaH_shapetemplate(L, h));
                 break;
             }
 
             case LBC_CONSTANT_CLOSURE:
             {
-                uint32_t fid = readVarInt(data, size, offset);
-                Closure* cl = luaF_newLclosure(L, protos[fid]->nups, envt, protos[fid]);
+                Closure* cl = luaF_newLclosure(L, protos[k.id]->nups, envt, protos[k.id]);
                 cl->preload = (cl->nupvalues > 0);
                 setclvalue(L, &p->k[j], cl);
                 break;
@@ -331,75 +757,61 @@ int luau_load(lua_State* L, const char* chunkname, const char* data, size_t size
             }
         }
 
-        p->sizep = readVarInt(data, size, offset);
+        p->sizep = ip.sizep;
         p->p = luaM_newarray(L, p->sizep, Proto*, p->memcat);
         for (int j = 0; j < p->sizep; ++j)
-        {
-            uint32_t fid = readVarInt(data, size, offset);
-            p->p[j] = protos[fid];
-        }
-
-        p->linedefined = readVarInt(data, size, offset);
-        p->debugname = readString(strings, data, size, offset);
+            p->p[j] = protos[image->protoids.data[ip.p + j]];
 
-        uint8_t lineinfo = read<uint8_t>(data, size, offset);
+        p->linedefined = ip.linedefined;
+        p->debugname = getimagestring(strings, ip.debugname);
 
-        if (lineinfo)
+        if (ip.lineinfo >= 0)
         {
-            p->linegaplog2 = read<uint8_t>(data, size, offset);
-
-            int intervals = ((p->sizecode - 1) >> p->linegaplog2) + 1;
-            int absoffset = (p->sizecode + 3) & ~3;
+            uint8_t* lineinfo = image->mapped ? (uint8_t*)data + ip.lineinfo : image->lineinfo.data + ip.lineinfo;
 
-            p->sizelineinfo = absoffset + intervals * sizeof(int);
-            p->lineinfo = luaM_newarray(L, p->sizelineinfo, uint8_t, p->memcat);
-            p->abslineinfo = (int*)(p->lineinfo + absoffset);
+            p->linegaplog2 = ip.linegaplog2;
+            p->sizelineinfo = ip.sizelineinfo;
 
-            uint8_t lastoffset = 0;
-            for (int j = 0; j < p->sizecode; ++j)
+            if (sharedinfo)
             {
-                lastoffset += read<uint8_t>(data, size, offset);
-                p->lineinfo[j] = lastoffset;
+                p->lineinfo = lineinfo;
             }
-
-            int lastline = 0;
-            for (int j = 0; j < intervals; ++j)
+            else
             {
-                lastline += read<int32_t>(data, size, offset);
-                p->abslineinfo[j] = lastline;
+                p->lineinfo = luaM_newarray(L, p->sizelineinfo, uint8_t, p->memcat);
+                memcpy(p->lineinfo, lineinfo, p->sizelineinfo);
             }
-        }
 
-        uint8_t debuginfo = read<uint8_t>(data, size, offset);
+            p->abslineinfo = (int*)(p->lineinfo + ((p->sizecode + 3) & ~3));
+        }
 
-        if (debuginfo)
+        if (ip.debuginfo)
         {
-            p->sizelocvars = readVarInt(data, size, offset);
+            p->sizelocvars = ip.sizelocvars;
             p->locvars = luaM_newarray(L, p->sizelocvars, LocVar, p->memcat);
 
             for (int j = 0; j < p->sizelocvars; ++j)
             {
-                p->locvars[j].varname = readString(strings, data, size, offset);
-                p->locvars[j].startpc = readVarInt(data, size, offset);
-                p->locvars[j].endpc = readVarInt(data, size, offset);
-                p->locvars[j].reg = read<uint8_t>(data, size, offset);
+                const ImageLocVar& l = image->locvars.data[ip.locvars + j];
+
+                p->locvars[j].varname = getimagestring(strings, l.varname);
+                p->locvars[j].startpc = l.startpc;
+                p->locvars[j].endpc = l.endpc;
+                p->locvars[j].reg = l.reg;
             }
 
-            p->sizeupvalues = readVarInt(data, size, offset);
+            p->sizeupvalues = ip.sizeupvalues;
             p->upvalues = luaM_newarray(L, p->sizeupvalues, TString*, p->memcat);
 
             for (int j = 0; j < p->sizeupvalues; ++j)
-            {
-                p->upvalues[j] = readString(strings, data, size, offset);
-            }
+                p->upvalues[j] = getimagestring(strings, image->upvalues.data[ip.upvalues + j]);
         }
 
         protos[i] = p;
     }
 
     // "main" proto is pushed to Lua stack
-    uint32_t mainid = readVarInt(data, size, offset);
-    Proto* main = protos[mainid];
+    Proto* main = protos[image->mainid];
 
     luaC_threadbarrier(L);
 
@@ -411,3 +823,174 @@ int luau_load(lua_State* L, const char* chunkname, const char* data, size_t size
 
     return 0;
 }
+
+// TODO: RAII deallocation doesn't work for longjmp builds if a memory error happens
+struct TempImage
+{
+    lua_BytecodeImage image;
+
+    ~TempImage()
+    {
+        clearimage(&image);
+    }
+};
+
+// in mapped mode, data uses the aligned layout and protos refer to the instructions and line info in place
+static int loadbytecode(lua_State* L, const char* chunkname, const char* data, size_t size, int env, bool mapped)
+{
+    TempImage temp;
+    initimage(&temp.image, L->global, data, size, mapped);
+
+    if (!decodeimage(&temp.image))
+    {
+        clearimage(&temp.image);
+        luaD_throw(L, LUA_ERRMEM);
+    }
+
+    // mapped data is owned by the state, so functions can refer to it
+    return loadimage(L, chunkname, &temp.image, env, /* sharedinfo= */ mapped);
+}
+
+int luau_load(lua_State* L, const char* chunkname, const char* data, size_t size, int env)
+{
+    return loadbytecode(L, chunkname, data, size, env, /* mapped= */ false);
+}
+
+int luau_loadmapped(lua_State* L, const char* chunkname, char* data, size_t size, int env, void (*release)(void* ud), void* ud)
+{
+    global_State* g = L->global;
+
+    // the state owns the data from now on, even if it can't be loaded
+    if (g->nmappings == g->sizemappings)
+    {
+        int newsize = g->sizemappings == 0 ? 4 : g->sizemappings * 2;
+        luaM_reallocarray(L, g->mappings, g->sizemappings, newsize, BytecodeMapping, 0);
+        g->sizemappings = newsize;
+    }
+
+    BytecodeMapping& mapping = g->mappings[g->nmappings++];
+    mapping.release = release;
+    mapping.ud = ud;
+
+    // bytecode that doesn't use the aligned layout (including compilation errors) is loaded normally
+    if (size == 0 || uint8_t(data[0]) != LBC_ALIGNED_MARKER)
+        return loadbytecode(L, chunkname, data, size, env, /* mapped= */ false);
+
+    if (uintptr_t(data) & 3)
+    {
+        char chunkbuf[LUA_IDSIZE];
+        const char* chunkid = luaO_chunkid(chunkbuf, sizeof(chunkbuf), chunkname, strlen(chunkname));
+        lua_pushfstring(L, "%s: mapped bytecode must be aligned to 4 bytes", chunkid);
+        return 1;
+    }
+
+    return loadbytecode(L, chunkname, data + 1, size - 1, env, /* mapped= */ true);
+}
+
+// images can be retained and released from many threads
+static long addimagerefs(lua_BytecodeImage* image, long delta)
+{
+#ifdef _MSC_VER
+    return _InterlockedExchangeAdd(&image->refs, delta) + delta;
+#else
+    return __atomic_add_fetch(&image->refs, delta, __ATOMIC_ACQ_REL);
+#endif
+}
+
+lua_BytecodeImage* luau_decode(lua_State* L, const char* data, size_t size)
+{
+    global_State* g = L->global;
+
+    lua_BytecodeImage* image = (lua_BytecodeImage*)(*g->frealloc)(g->ud, NULL, 0, sizeof(lua_BytecodeImage));
+    if (!image)
+        luaD_throw(L, LUA_ERRMEM);
+
+    initimage(image, g, NULL, size, /* mapped= */ false);
+    image->refs = 1;
+
+    // the image keeps a copy of the bytecode, since strings, instructions and type info refer to it
+    char* copy = (char*)(*g->frealloc)(g->ud, NULL, 0, size);
+
+    if (copy)
+    {
+        memcpy(copy, data, size);
+        image->bytecode = copy;
+        image->ownsbytecode = true;
+    }
+
+    if (!copy || !decodeimage(image))
+    {
+        clearimage(image);
+        (*g->frealloc)(g->ud, image, sizeof(lua_BytecodeImage), 0);
+        luaD_throw(L, LUA_ERRMEM);
+    }
+
+    return image;
+}
+
+void luau_retainimage(lua_BytecodeImage* image)
+{
+    addimagerefs(image, 1);
+}
+
+void luau_releaseimage(lua_BytecodeImage* image)
+{
+    if (addimagerefs(image, -1) == 0)
+    {
+        lua_Alloc frealloc = image->frealloc;
+        void* ud = image->ud;
+
+        clearimage(image);
+        (*frealloc)(ud, image, sizeof(lua_BytecodeImage), 0);
+    }
+}
+
+static void retainimage(lua_State* L, lua_BytecodeImage* image)
+{
+    global_State* g = L->global;
+
+    for (int i = 0; i < g->nimages; ++i)
+        if (g->images[i] == image)
+            return;
+
+    if (g->nimages == g->sizeimages)
+    {
+        int newsize = g->sizeimages == 0 ? 4 : g->sizeimages * 2;
+        luaM_reallocarray(L, g->images, g->sizeimages, newsize, lua_BytecodeImage*, 0);
+        g->sizeimages = newsize;
+    }
+
+    g->images[g->nimages++] = image;
+    luau_retainimage(image);
+}
+
+void luaV_releasebytecode(lua_State* L)
+{
+    global_State* g = L->global;
+
+    for (int i = 0; i < g->nimages; ++i)
+        luau_releaseimage(g->images[i]);
+
+    luaM_freearray(L, g->images, g->sizeimages, lua_BytecodeImage*, 0);
+    g->images = NULL;
+    g->sizeimages = 0;
+    g->nimages = 0;
+
+    for (int i = 0; i < g->nmappings; ++i)
+        if (g->mappings[i].release)
+            g->mappings[i].release(g->mappings[i].ud);
+
+    luaM_freearray(L, g->mappings, g->sizemappings, BytecodeMapping, 0);
+    g->mappings = NULL;
+    g->sizemappings = 0;
+    g->nmappings = 0;
+}
+
+int luau_loadimage(lua_State* L, const char* chunkname, lua_BytecodeImage* image, int env)
+{
+    // functions will point to the image data, so the state needs to keep the image alive
+    if (image->version != 0 && image->version >= LBC_VERSION_MIN && image->version <= LBC_VERSION_MAX)
+        retainimage(L, image);
+
+    return loadimage(L, chunkname, image, env, /* sharedinfo= */ true);
+}
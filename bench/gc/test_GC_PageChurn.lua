@@ -0,0 +1,21 @@
+local bench = script and require(script.Parent.bench_support) or require("bench_support")
+
+-- measures allocator throughput when pages of different size classes are emptied and refilled in quick succession
+-- to compare with the page cache disabled, run with luau --page-cache=0
+function test()
+    local live = {}
+
+    for i = 1,400 do
+        -- every iteration allocates objects of a different size, so pages of the previous size class become empty
+        local size = 1 + (i * 7) % 30
+        local objects = table.create(2000)
+
+        for j = 1,2000 do
+            objects[j] = table.create(size, j)
+        end
+
+        live[i % 4] = objects
+    end
+end
+
+bench.runCode(test, "GC: page churn")
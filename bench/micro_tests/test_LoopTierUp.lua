@@ -0,0 +1,37 @@
+local bench = script and require(script.Parent.bench_support) or require("bench_support")
+
+-- Every run loads a fresh copy of the loop, so with tiered compilation (--codegen-tiering) it starts in the interpreter
+-- and switches to native code in the middle of the first slice, while the last slice runs natively from the start
+local source = [[
+    local slices = ...
+    local times = {}
+    local sum = 0
+    local i = 0
+
+    for slice = 1, slices do
+        local ts0 = os.clock()
+        local limit = i + 200000
+
+        while i < limit do
+            i += 1
+            sum += i % 7
+        end
+
+        times[slice] = os.clock() - ts0
+    end
+
+    return times, sum
+]]
+
+local function testSlice(index)
+    return function()
+        local loop = loadstring(source)
+        local times, sum = loop(10)
+        assert(sum == 5999997)
+
+        return times[index]
+    end
+end
+
+bench.runCode(testSlice(1), "LoopTierUp: first slice")
+bench.runCode(testSlice(10), "LoopTierUp: last slice")
@@ -0,0 +1,36 @@
+local bench = script and require(script.Parent.bench_support) or require("bench_support")
+
+-- every test interns 1M strings, so strings/sec is 1e9 / reported time in ms
+-- the first three tests create new strings, and the last one mostly finds strings that are already in the string table
+
+bench.runCode(function()
+    for j=1,1e6 do
+        local _ = "key" .. j
+    end
+end, "StringIntern: 1M short keys")
+
+bench.runCode(function()
+    local prefix = string.rep("x", 40)
+
+    for j=1,1e6 do
+        local _ = prefix .. j
+    end
+end, "StringIntern: 1M 48-byte strings")
+
+bench.runCode(function()
+    local prefix = string.rep("x", 200)
+
+    for j=1,1e6 do
+        local _ = prefix .. j
+    end
+end, "StringIntern: 1M 208-byte strings")
+
+bench.runCode(function()
+    local json = '{"id":1234567,"name":"some property value","tags":["alpha","beta","gamma"]}'
+
+    for j=1,1e5 do
+        for k=1,10 do
+            local _ = string.sub(json, k, k + 20 + j % 40)
+        end
+    end
+end, "StringIntern: 1M substrings")
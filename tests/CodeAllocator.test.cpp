@@ -120,6 +120,125 @@ TEST_CASE("CodeAllocationFailure")
     REQUIRE(!allocator.allocate(nullptr, 0, code.data(), code.size(), nativeData, sizeNativeData, nativeEntry));
 }
 
+TEST_CASE("CodeAllocationReuse")
+{
+    size_t blockSize = 1024 * 1024;
+    size_t maxTotalSize = 1024 * 1024;
+    CodeAllocator allocator(blockSize, maxTotalSize);
+
+    std::vector<uint8_t> code;
+    code.resize(128);
+
+    uint8_t* nativeData[3] = {};
+    size_t sizeNativeData[3] = {};
+    uint8_t* nativeEntry[3] = {};
+
+    for (int i = 0; i < 3; ++i)
+        REQUIRE(allocator.allocate(nullptr, 0, code.data(), code.size(), nativeData[i], sizeNativeData[i], nativeEntry[i]));
+
+    // released ranges are reused in address order, neighbours are merged into a range that fits larger code
+    allocator.deallocate(nativeData[1], sizeNativeData[1]);
+    allocator.deallocate(nativeData[0], sizeNativeData[0]);
+
+    code.resize(code.size() + (nativeData[1] - nativeData[0]));
+
+    uint8_t* reusedData = nullptr;
+    size_t sizeReusedData = 0;
+    uint8_t* reusedEntry = nullptr;
+
+    REQUIRE(allocator.allocate(nullptr, 0, code.data(), code.size(), reusedData, sizeReusedData, reusedEntry));
+    CHECK(reusedData == nativeData[0]);
+    CHECK(sizeReusedData == code.size());
+
+    // code that doesn't fit into released ranges goes after the existing allocations
+    REQUIRE(allocator.allocate(nullptr, 0, code.data(), code.size(), reusedData, sizeReusedData, reusedEntry));
+    CHECK(reusedData > nativeData[2]);
+}
+
+TEST_CASE("CodeAllocationBelow")
+{
+    size_t blockSize = 64 * 1024;
+    size_t maxTotalSize = 256 * 1024;
+    CodeAllocator allocator(blockSize, maxTotalSize);
+
+    std::vector<uint8_t> code;
+    code.resize(128);
+
+    uint8_t* nativeData[3] = {};
+    size_t sizeNativeData[3] = {};
+    uint8_t* nativeEntry[3] = {};
+
+    for (int i = 0; i < 3; ++i)
+        REQUIRE(allocator.allocate(nullptr, 0, code.data(), code.size(), nativeData[i], sizeNativeData[i], nativeEntry[i]));
+
+    uint8_t* movedData = nullptr;
+    size_t sizeMovedData = 0;
+    uint8_t* movedEntry = nullptr;
+
+    // without released ranges, neither the rest of the current block nor a new block is used
+    CHECK(!allocator.allocateBelow(nativeData[2], nullptr, 0, code.data(), code.size(), movedData, sizeMovedData, movedEntry));
+    CHECK(allocator.getTotalSize() == blockSize);
+
+    allocator.deallocate(nativeData[1], sizeNativeData[1]);
+
+    // only ranges that start below the limit are used
+    CHECK(!allocator.allocateBelow(nativeData[1], nullptr, 0, code.data(), code.size(), movedData, sizeMovedData, movedEntry));
+
+    REQUIRE(allocator.allocateBelow(nativeData[2], nullptr, 0, code.data(), code.size(), movedData, sizeMovedData, movedEntry));
+    CHECK(movedData == nativeData[1]);
+
+    // code larger than the released ranges doesn't fit
+    allocator.deallocate(nativeData[0], sizeNativeData[0]);
+    code.resize(blockSize / 2);
+
+    CHECK(!allocator.allocateBelow(nativeData[2], nullptr, 0, code.data(), code.size(), movedData, sizeMovedData, movedEntry));
+    CHECK(allocator.getTotalSize() == blockSize);
+}
+
+TEST_CASE("CodeAllocationBlockRelease")
+{
+    struct AllocationData
+    {
+        size_t bytesAllocated = 0;
+        size_t bytesFreed = 0;
+    };
+
+    AllocationData allocationData{};
+
+    const auto allocationCallback = [](void* context, void* oldPointer, size_t oldSize, void* newPointer, size_t newSize)
+    {
+        AllocationData& allocationData = *static_cast<AllocationData*>(context);
+        allocationData.bytesFreed += oldSize;
+        allocationData.bytesAllocated += newSize;
+    };
+
+    size_t blockSize = 64 * 1024;
+    size_t maxTotalSize = 128 * 1024;
+    CodeAllocator allocator(blockSize, maxTotalSize, allocationCallback, &allocationData);
+
+    std::vector<uint8_t> code;
+    code.resize(40 * 1024);
+
+    uint8_t* nativeData[3] = {};
+    size_t sizeNativeData[3] = {};
+    uint8_t* nativeEntry[3] = {};
+
+    // each allocation needs its own block, so the limit is reached
+    REQUIRE(allocator.allocate(nullptr, 0, code.data(), code.size(), nativeData[0], sizeNativeData[0], nativeEntry[0]));
+    REQUIRE(allocator.allocate(nullptr, 0, code.data(), code.size(), nativeData[1], sizeNativeData[1], nativeEntry[1]));
+    REQUIRE(!allocator.allocate(nullptr, 0, code.data(), code.size(), nativeData[2], sizeNativeData[2], nativeEntry[2]));
+    CHECK(allocator.getTotalSize() == 2 * blockSize);
+
+    // releasing the only allocation of a block releases the block
+    allocator.deallocate(nativeData[0], sizeNativeData[0]);
+    CHECK(allocator.getTotalSize() == blockSize);
+    CHECK(allocationData.bytesFreed == blockSize);
+
+    REQUIRE(allocator.allocate(nullptr, 0, code.data(), code.size(), nativeData[2], sizeNativeData[2], nativeEntry[2]));
+    CHECK(allocator.getTotalSize() == 2 * blockSize);
+    CHECK(allocationData.bytesAllocated == 3 * blockSize);
+}
+
 TEST_CASE("CodeAllocationWithUnwindCallbacks")
 {
     struct Info
@@ -75,6 +75,7 @@ TEST_CASE("BytecodeIsStable")
     // Bytecode ops (serialized & in-memory)
     CHECK(LOP_FASTCALL2K == 75); // bytecode v1
     CHECK(LOP_JUMPXEQKS == 80); // bytecode v3
+    CHECK(LOP_GETIMPORT_CALL == 89); // bytecode v5
 
     // Bytecode fastcall ids (serialized & in-memory)
     // Note: these aren't strictly bound to specific bytecode versions, but must monotonically increase to keep backwards compat
@@ -7405,4 +7406,52 @@ RETURN R0 1
 )");
 }
 
+TEST_CASE("FusedInstructions")
+{
+    ScopedFastFlag luauCompileFusedInstructions{"LuauCompileFusedInstructions", true};
+
+    // pairs are fused left to right without overlapping, the second instruction of each pair is left in place
+    CHECK_EQ("\n" + compileFunction(R"(
+local a, b = ...
+print(a, b, 1, 2, "x")
+print("y")
+print()
+)",
+                        0, 2),
+        R"(
+GETVARARGS R0 2
+GETIMPORT R2 1 [print]
+MOVE_MOVE R3 R0
+MOVE R4 R1
+LOADN_LOADN R5 1
+LOADN R6 2
+LOADK_CALL R7 K2 ['x']
+CALL R2 5 0
+GETIMPORT R2 1 [print]
+LOADK_CALL R3 K3 ['y']
+CALL R2 1 0
+GETIMPORT_CALL R2 1 [print]
+CALL R2 0 0
+RETURN R0 0
+)");
+
+    // instructions on different lines are not fused, since a breakpoint can replace the second one
+    CHECK_EQ("\n" + compileFunction(R"(
+local a, b = ...
+print(
+    a,
+    b
+)
+)",
+                        0, 2),
+        R"(
+GETVARARGS R0 2
+GETIMPORT R2 1 [print]
+MOVE R3 R0
+MOVE R4 R1
+CALL R2 2 0
+RETURN R0 0
+)");
+}
+
 TEST_SUITE_END();
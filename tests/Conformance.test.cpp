@@ -9,18 +9,26 @@
 #include "Luau/ModuleResolver.h"
 #include "Luau/TypeInfer.h"
 #include "Luau/BytecodeBuilder.h"
+#include "Luau/CodeGen.h"
+#include "Luau/Compiler.h"
 #include "Luau/Frontend.h"
 
 #include "doctest.h"
 #include "ScopedFlags.h"
 
+#include <filesystem>
 #include <fstream>
+#include <random>
 #include <string>
+#include <thread>
 #include <vector>
 #include <math.h>
 
 extern bool verbose;
 extern bool codegen;
+extern bool codegenTiering;
+extern bool codegenA64;
+extern std::string codegenCache;
 extern int optimizationLevel;
 
 LUAU_FASTFLAG(LuauPCallDebuggerFix);
@@ -37,9 +45,10 @@ static lua_CompileOptions defaultOptions()
 
 static int lua_collectgarbage(lua_State* L)
 {
-    static const char* const opts[] = {"stop", "restart", "collect", "count", "isrunning", "step", "setgoal", "setstepmul", "setstepsize", nullptr};
-    static const int optsnum[] = {
-        LUA_GCSTOP, LUA_GCRESTART, LUA_GCCOLLECT, LUA_GCCOUNT, LUA_GCISRUNNING, LUA_GCSTEP, LUA_GCSETGOAL, LUA_GCSETSTEPMUL, LUA_GCSETSTEPSIZE};
+    static const char* const opts[] = {
+        "stop", "restart", "collect", "count", "isrunning", "step", "setgoal", "setstepmul", "setstepsize", "generational", "incremental", nullptr};
+    static const int optsnum[] = {LUA_GCSTOP, LUA_GCRESTART, LUA_GCCOLLECT, LUA_GCCOUNT, LUA_GCISRUNNING, LUA_GCSTEP, LUA_GCSETGOAL,
+        LUA_GCSETSTEPMUL, LUA_GCSETSTEPSIZE, LUA_GCGEN, LUA_GCINC};
 
     int o = luaL_checkoption(L, 1, "collect", opts);
     int ex = luaL_optinteger(L, 2, 0);
@@ -163,8 +172,22 @@ static StateRef runConformance(const char* name, void (*setup)(lua_State* L) = n
     StateRef globalState(initialLuaState, lua_close);
     lua_State* L = globalState.get();
 
-    if (codegen && !skipCodegen && luau_codegen_supported())
-        luau_codegen_create(L);
+    bool native = codegen && !skipCodegen && (codegenA64 ? Luau::CodeGen::isA64EmulationSupported() : luau_codegen_supported());
+
+    if (native)
+    {
+        if (codegenA64)
+            Luau::CodeGen::createA64Emulation(L);
+        else
+            luau_codegen_create(L);
+
+        if (!codegenCache.empty())
+            Luau::CodeGen::setCodeCacheDirectory(L, codegenCache.c_str());
+
+        // promote functions as early as possible to maximize coverage
+        if (codegenTiering)
+            Luau::CodeGen::enableTiering(L, {/* entryThreshold= */ 1, /* loopThreshold= */ 1});
+    }
 
     luaL_openlibs(L);
 
@@ -217,8 +240,8 @@ static StateRef runConformance(const char* name, void (*setup)(lua_State* L) = n
     int result = luau_load(L, chunkname.c_str(), bytecode, bytecodeSize, 0);
     free(bytecode);
 
-    if (result == 0 && codegen && !skipCodegen && luau_codegen_supported())
-        luau_codegen_compile(L, -1);
+    if (result == 0 && native && !codegenTiering)
+        Luau::CodeGen::compile(L, -1);
 
     int status = (result == 0) ? lua_resume(L, nullptr, 0) : LUA_ERRSYNTAX;
 
@@ -272,6 +295,9 @@ TEST_CASE("CodegenSupported")
 {
     if (codegen && !luau_codegen_supported())
         MESSAGE("Native code generation is not supported by the current configuration and will be disabled");
+
+    if (codegenA64 && !Luau::CodeGen::isA64EmulationSupported())
+        MESSAGE("A64 emulation is not supported by the current configuration and native code generation will be disabled");
 }
 
 TEST_CASE("Assert")
@@ -313,6 +339,22 @@ TEST_CASE("Tables")
     });
 }
 
+TEST_CASE("TableShapes")
+{
+    ScopedFastFlag sffs[] = {
+        {"LuauTableShapes", true},
+        {"LuauFloorDivision", true},
+    };
+
+    runConformance("tableshapes.lua");
+    runConformance("basic.lua");
+    runConformance("sort.lua");
+    runConformance("clear.lua");
+    runConformance("closure.lua");
+    runConformance("iter.lua");
+    runConformance("gc.lua");
+}
+
 TEST_CASE("PatternMatch")
 {
     runConformance("pm.lua");
@@ -384,6 +426,20 @@ TEST_CASE("Calls")
     runConformance("calls.lua");
 }
 
+TEST_CASE("FusedInstructions")
+{
+    ScopedFastFlag luauCompileFusedInstructions{"LuauCompileFusedInstructions", true};
+    ScopedFastFlag sffs{"LuauFloorDivision", true};
+
+    lua_CompileOptions copts = defaultOptions();
+    copts.optimizationLevel = 2;
+
+    runConformance("basic.lua", nullptr, nullptr, nullptr, &copts);
+    runConformance("calls.lua", nullptr, nullptr, nullptr, &copts);
+    runConformance("vararg.lua", nullptr, nullptr, nullptr, &copts);
+    runConformance("closure.lua", nullptr, nullptr, nullptr, &copts);
+}
+
 TEST_CASE("Attrib")
 {
     runConformance("attrib.lua");
@@ -394,6 +450,178 @@ TEST_CASE("GC")
     runConformance("gc.lua");
 }
 
+TEST_CASE("GCGenerational")
+{
+    auto setup = [](lua_State* L) {
+        lua_gc(L, LUA_GCGEN, 0);
+
+        // collect often to exercise transitions between minor and major collections
+        lua_gc(L, LUA_GCSETGENMINORMUL, 10);
+        lua_gc(L, LUA_GCSETGENMAJORMUL, 50);
+    };
+
+    runConformance("gc.lua", setup);
+    runConformance("coroutine.lua", setup);
+    runConformance("closure.lua", setup);
+    runConformance("iter.lua", setup);
+}
+
+static void runGcTasks(lua_State* L, void (*task)(void* context, int worker), void* context, int workers)
+{
+    std::vector<std::thread> threads;
+
+    for (int i = 1; i < workers; ++i)
+        threads.emplace_back(task, context, i);
+
+    task(context, 0);
+
+    for (std::thread& thread : threads)
+        thread.join();
+}
+
+static void setupGcParallel(lua_State* L)
+{
+    lua_callbacks(L)->gcparallel = runGcTasks;
+
+    CHECK(lua_gc(L, LUA_GCSETWORKERS, 4) == 0);
+}
+
+TEST_CASE("GCParallelMark")
+{
+    runConformance("gc.lua", setupGcParallel);
+    runConformance("coroutine.lua", setupGcParallel);
+    runConformance("closure.lua", setupGcParallel);
+
+    // generational mode keeps old weak tables and threads on gray lists that are traversed by the workers
+    runConformance("gc.lua", [](lua_State* L) {
+        setupGcParallel(L);
+        lua_gc(L, LUA_GCGEN, 0);
+        lua_gc(L, LUA_GCSETGENMINORMUL, 10);
+    });
+}
+
+TEST_CASE("GCPageCache")
+{
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    CHECK(lua_gc(L, LUA_GCSETPAGECACHE, 64) == LUA_PAGECACHESIZE / 1024);
+
+    // fill a few dozen pages with objects and free them
+    lua_createtable(L, 1000, 0);
+    for (int i = 1; i <= 1000; ++i)
+    {
+        lua_createtable(L, 4, 0);
+        lua_rawseti(L, -2, i);
+    }
+    lua_pop(L, 1);
+
+    lua_gc(L, LUA_GCCOLLECT, 0);
+
+    size_t cached = lua_totalbytes(L, LUA_MEMCACHED);
+    CHECK(cached > 0);
+    CHECK(cached <= 64 * 1024);
+
+    // cached pages are reused by new allocations
+    lua_createtable(L, 1000, 0);
+    for (int i = 1; i <= 1000; ++i)
+    {
+        lua_createtable(L, 4, 0);
+        lua_rawseti(L, -2, i);
+    }
+    CHECK(lua_totalbytes(L, LUA_MEMCACHED) < cached);
+    lua_pop(L, 1);
+
+    lua_gc(L, LUA_GCCOLLECT, 0);
+    CHECK(lua_totalbytes(L, LUA_MEMCACHED) > 0);
+
+    CHECK(lua_gc(L, LUA_GCTRIMPAGECACHE, 0) > 0);
+    CHECK(lua_totalbytes(L, LUA_MEMCACHED) == 0);
+
+    // negative limits are treated as 0
+    CHECK(lua_gc(L, LUA_GCSETPAGECACHE, -1) == 64);
+    CHECK(lua_gc(L, LUA_GCSETPAGECACHE, 64) == 0);
+
+    // pages that stay in the cache for an entire collection cycle are freed
+    lua_createtable(L, 1000, 0);
+    for (int i = 1; i <= 1000; ++i)
+    {
+        lua_createtable(L, 4, 0);
+        lua_rawseti(L, -2, i);
+    }
+    lua_pop(L, 1);
+
+    lua_gc(L, LUA_GCCOLLECT, 0);
+
+    size_t idle = lua_totalbytes(L, LUA_MEMCACHED);
+    CHECK(idle > 0);
+
+    lua_gc(L, LUA_GCCOLLECT, 0);
+    CHECK(lua_totalbytes(L, LUA_MEMCACHED) < idle);
+}
+
+TEST_CASE("GCSparsePages")
+{
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    CHECK(lua_gc(L, LUA_GCSETSPARSEPAGE, 25) == 0);
+
+    // allocate a lot of tables and keep every 16th alive
+    lua_createtable(L, 0, 0);
+    for (int i = 1; i <= 20000; ++i)
+    {
+        lua_createtable(L, 0, 0);
+
+        if (i % 16 == 0)
+            lua_rawseti(L, -2, i);
+        else
+            lua_pop(L, 1);
+    }
+
+    lua_gc(L, LUA_GCCOLLECT, 0);
+
+    size_t totalused = 0, totalpages = 0;
+    lua_gcpagestats(L, -1, &totalused, &totalpages);
+    CHECK(totalused > 0);
+    CHECK(totalused < totalpages);
+
+    // the size class of tables takes the most space and is mostly empty
+    size_t used = 0, pages = 0;
+
+    for (int i = 0; i < LUA_SIZECLASSES; ++i)
+    {
+        size_t classused = 0, classpages = 0;
+        int size = lua_gcpagestats(L, i, &classused, &classpages);
+
+        if (size == 0)
+            CHECK(classpages == 0);
+
+        if (classpages > pages)
+        {
+            used = classused;
+            pages = classpages;
+        }
+    }
+
+    CHECK(used * 4 < pages);
+
+    // once the remaining objects die, the pages are freed
+    lua_pop(L, 1);
+    lua_gc(L, LUA_GCCOLLECT, 0);
+
+    size_t afterused = 0, afterpages = 0;
+    lua_gcpagestats(L, -1, &afterused, &afterpages);
+    CHECK(afterpages + pages / 2 < totalpages);
+
+    auto setup = [](lua_State* L) {
+        lua_gc(L, LUA_GCSETSPARSEPAGE, 50);
+    };
+
+    runConformance("gc.lua", setup);
+    runConformance("closure.lua", setup);
+}
+
 TEST_CASE("Bitwise")
 {
     runConformance("bitwise.lua");
@@ -579,6 +807,7 @@ TEST_CASE("Debugger")
     static lua_State* interruptedthread = nullptr;
     static bool singlestep = false;
     static int stephits = 0;
+    bool fused = false;
 
     SUBCASE("")
     {
@@ -588,14 +817,29 @@ TEST_CASE("Debugger")
     {
         singlestep = true;
     }
+    SUBCASE("FusedInstructions")
+    {
+        singlestep = false;
+        fused = true;
+    }
+    SUBCASE("FusedInstructionsSingleStep")
+    {
+        singlestep = true;
+        fused = true;
+    }
 
     breakhits = 0;
     interruptedthread = nullptr;
     stephits = 0;
 
+    ScopedFastFlag luauCompileFusedInstructions{"LuauCompileFusedInstructions", fused};
+
     lua_CompileOptions copts = defaultOptions();
     copts.debugLevel = 2;
 
+    if (fused)
+        copts.optimizationLevel = 2;
+
     runConformance(
         "debugger.lua",
         [](lua_State* L) {
@@ -726,6 +970,21 @@ TEST_CASE("Debugger")
                 CHECK(lua_isnil(L, -1));
                 lua_pop(L, 1);
             }
+            else if (breakhits == 15)
+            {
+                // breakpoint is on the second instruction of a fused pair, so only the first one has executed
+                const char* x = lua_getlocal(L, 0, 1);
+                REQUIRE(x);
+                CHECK(strcmp(x, "x") == 0);
+                CHECK(lua_tointeger(L, -1) == 10);
+                lua_pop(L, 1);
+
+                const char* y = lua_getlocal(L, 0, 2);
+                REQUIRE(y);
+                CHECK(strcmp(y, "y") == 0);
+                CHECK(lua_tointeger(L, -1) == 7);
+                lua_pop(L, 1);
+            }
 
             if (interruptedthread)
             {
@@ -735,7 +994,7 @@ TEST_CASE("Debugger")
         },
         nullptr, &copts, /* skipCodegen */ true); // Native code doesn't support debugging yet
 
-    CHECK(breakhits == 14); // 2 hits per breakpoint
+    CHECK(breakhits == 16); // 2 hits per breakpoint
 
     if (singlestep)
         CHECK(stephits > 100); // note; this will depend on number of instructions which can vary, so we just make sure the callback gets hit often
@@ -1867,6 +2126,1081 @@ TEST_CASE("NativeTypeAnnotations")
         nullptr, nullptr, &copts);
 }
 
+TEST_CASE("BytecodeImage")
+{
+    const char* source = R"(
+local Point = {}
+Point.__index = Point
+
+function Point.new(x, y)
+    return setmetatable({x = x, y = y}, Point)
+end
+
+function Point:length()
+    return math.sqrt(self.x * self.x + self.y * self.y)
+end
+
+local function fail()
+    error("boom")
+end
+
+local ok, err = pcall(fail)
+assert(not ok and err:find(":14: boom"))
+assert(debug.info(1, "l") == 19)
+
+counter = (counter or 0) + 1
+return Point.new(3, 4):length() + counter
+)";
+
+    lua_CompileOptions copts = defaultOptions();
+    copts.debugLevel = 2;
+
+    size_t bytecodeSize = 0;
+    char* bytecode = luau_compile(source, strlen(source), &copts, &bytecodeSize);
+    // images outlive the state that decodes them, as long as its allocator is still usable
+    lua_BytecodeImage* image = nullptr;
+    {
+        StateRef globalState(luaL_newstate(), lua_close);
+        image = luau_decode(globalState.get(), bytecode, bytecodeSize);
+        free(bytecode);
+    }
+
+    REQUIRE(image);
+
+    auto run = [image](int runs) {
+        StateRef globalState(luaL_newstate(), lua_close);
+        lua_State* L = globalState.get();
+
+        if (codegen && luau_codegen_supported())
+            luau_codegen_create(L);
+
+        luaL_openlibs(L);
+
+        for (int i = 1; i <= runs; ++i)
+        {
+            REQUIRE(luau_loadimage(L, "=image", image, 0) == 0);
+
+            if (codegen && luau_codegen_supported())
+                luau_codegen_compile(L, -1);
+
+            REQUIRE(lua_pcall(L, 0, 1, 0) == 0);
+            CHECK(lua_tonumber(L, -1) == 5 + i);
+            lua_pop(L, 1);
+
+            lua_gc(L, LUA_GCCOLLECT, 0);
+        }
+    };
+
+    // the same image can be loaded many times into a state and into many states
+    run(3);
+    run(1);
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i)
+        threads.emplace_back(run, 2);
+    for (std::thread& t : threads)
+        t.join();
+
+    // states keep the image alive after the caller releases it
+    {
+        StateRef globalState(luaL_newstate(), lua_close);
+        lua_State* L = globalState.get();
+
+        luaL_openlibs(L);
+        REQUIRE(luau_loadimage(L, "=image", image, 0) == 0);
+
+        luau_releaseimage(image);
+        image = nullptr;
+
+        lua_gc(L, LUA_GCCOLLECT, 0);
+        REQUIRE(lua_pcall(L, 0, 1, 0) == 0);
+        CHECK(lua_tonumber(L, -1) == 6);
+    }
+
+    // errors are reported when the image is loaded, like with luau_load
+    {
+        StateRef globalState(luaL_newstate(), lua_close);
+        lua_State* L = globalState.get();
+
+        const char* invalid = "local x =";
+        bytecode = luau_compile(invalid, strlen(invalid), nullptr, &bytecodeSize);
+        lua_BytecodeImage* errorImage = luau_decode(L, bytecode, bytecodeSize);
+        free(bytecode);
+
+        REQUIRE(luau_loadimage(L, "=invalid", errorImage, 0) == 1);
+        CHECK(std::string(lua_tostring(L, -1)) == "invalid:1: Expected identifier when parsing expression, got <eof>");
+        luau_releaseimage(errorImage);
+
+        const char mismatch[] = {127, 0};
+        lua_BytecodeImage* mismatchImage = luau_decode(L, mismatch, sizeof(mismatch));
+
+        REQUIRE(luau_loadimage(L, "=mismatch", mismatchImage, 0) == 1);
+        CHECK(std::string(lua_tostring(L, -1)).find("bytecode version mismatch") != std::string::npos);
+        luau_releaseimage(mismatchImage);
+    }
+}
+
+TEST_CASE("BytecodeMapped")
+{
+    const char* source = R"(
+local function fail()
+    error("boom")
+end
+
+local function sum(n)
+    local s = 0
+    for i = 1, n do
+        s += i
+    end
+    return s
+end
+
+local ok, err = pcall(fail)
+assert(not ok and err:find(":3: boom"))
+assert(debug.info(1, "l") == 16)
+
+return sum(100)
+)";
+
+    Luau::CompileOptions options;
+    options.optimizationLevel = optimizationLevel;
+    options.debugLevel = 2;
+
+    Luau::BytecodeBuilder bcb;
+    bcb.setAlignedLayout(true);
+    Luau::compileOrThrow(bcb, source, options);
+
+    const std::string& bytecode = bcb.getBytecode();
+
+    int released = 0;
+    auto release = [](void* ud) {
+        ++*static_cast<int*>(ud);
+    };
+
+    // data has to be aligned and writable, like a private file mapping
+    std::vector<uint32_t> storage((bytecode.size() + 3) / 4);
+    char* data = reinterpret_cast<char*>(storage.data());
+    memcpy(data, bytecode.data(), bytecode.size());
+
+    {
+        StateRef globalState(luaL_newstate(), lua_close);
+        lua_State* L = globalState.get();
+
+        if (codegen && luau_codegen_supported())
+            luau_codegen_create(L);
+
+        luaL_openlibs(L);
+
+        // aligned layout is not accepted by the regular loader
+        REQUIRE(luau_load(L, "=mapped", bytecode.data(), bytecode.size(), 0) == 1);
+        CHECK(std::string(lua_tostring(L, -1)).find("bytecode version mismatch") != std::string::npos);
+        lua_pop(L, 1);
+
+        for (int i = 0; i < 2; ++i)
+        {
+            REQUIRE(luau_loadmapped(L, "=mapped", data, bytecode.size(), 0, release, &released) == 0);
+
+            if (codegen && luau_codegen_supported())
+                luau_codegen_compile(L, -1);
+
+            REQUIRE(lua_pcall(L, 0, 1, 0) == 0);
+            CHECK(lua_tonumber(L, -1) == 5050);
+            lua_pop(L, 1);
+        }
+
+        // patching instructions in place works
+        REQUIRE(luau_loadmapped(L, "=mapped", data, bytecode.size(), 0, release, &released) == 0);
+        CHECK(lua_breakpoint(L, -1, 9, 1) == 9);
+        CHECK(lua_breakpoint(L, -1, 9, 0) == 9);
+        REQUIRE(lua_pcall(L, 0, 1, 0) == 0);
+        CHECK(lua_tonumber(L, -1) == 5050);
+
+        lua_gc(L, LUA_GCCOLLECT, 0);
+        CHECK(released == 0);
+    }
+
+    CHECK(released == 3);
+
+    // bytecode in the regular layout and compilation errors are copied
+    {
+        StateRef globalState(luaL_newstate(), lua_close);
+        lua_State* L = globalState.get();
+
+        size_t bytecodeSize = 0;
+        char* regular = luau_compile("return 42", 9, nullptr, &bytecodeSize);
+
+        REQUIRE(luau_loadmapped(L, "=regular", regular, bytecodeSize, 0, free, regular) == 0);
+        REQUIRE(lua_pcall(L, 0, 1, 0) == 0);
+        CHECK(lua_tonumber(L, -1) == 42);
+
+        char* invalid = luau_compile("local x =", 9, nullptr, &bytecodeSize);
+
+        REQUIRE(luau_loadmapped(L, "=invalid", invalid, bytecodeSize, 0, free, invalid) == 1);
+        CHECK(std::string(lua_tostring(L, -1)) == "invalid:1: Expected identifier when parsing expression, got <eof>");
+    }
+}
+
+TEST_CASE("NativeCodeCache")
+{
+    if (!luau_codegen_supported())
+        return;
+
+    const char* source = R"(
+local function sum(t)
+    local s = 0
+    for _, v in t do
+        s += v.value
+    end
+    return s
+end
+
+local items = {}
+for i = 1, 100 do
+    items[i] = {value = i}
+end
+
+return sum(items) + math.floor(2.5)
+)";
+
+    // each run gets its own directory, so that concurrent test runs don't share entries; it's removed even if a check fails
+    struct TempDirectory
+    {
+        std::filesystem::path path;
+
+        TempDirectory()
+        {
+            std::random_device random;
+            std::string name = "luau-native-code-cache-" + std::to_string(random()) + "-" + std::to_string(random());
+
+            path = std::filesystem::temp_directory_path() / name;
+            std::filesystem::create_directories(path);
+        }
+
+        ~TempDirectory()
+        {
+            std::error_code ec;
+            std::filesystem::remove_all(path, ec);
+        }
+    } temp;
+
+    const std::filesystem::path& directory = temp.path;
+
+    size_t bytecodeSize = 0;
+    char* bytecode = luau_compile(source, strlen(source), nullptr, &bytecodeSize);
+
+    auto run = [&](bool interpretFirst) {
+        StateRef globalState(luaL_newstate(), lua_close);
+        lua_State* L = globalState.get();
+
+        Luau::CodeGen::create(L);
+        Luau::CodeGen::setCodeCacheDirectory(L, directory.string().c_str());
+        luaL_openlibs(L);
+
+        REQUIRE(luau_load(L, "=cache", bytecode, bytecodeSize, 0) == 0);
+
+        // the interpreter patches instructions, which shouldn't affect the cache
+        if (interpretFirst)
+        {
+            lua_pushvalue(L, -1);
+            REQUIRE(lua_pcall(L, 0, 1, 0) == 0);
+            CHECK(lua_tonumber(L, -1) == 5052);
+            lua_pop(L, 1);
+        }
+
+        Luau::CodeGen::CompilationStats stats;
+        REQUIRE(Luau::CodeGen::compile(L, -1, 0, &stats) == Luau::CodeGen::CodeGenCompilationResult::Success);
+
+        REQUIRE(lua_pcall(L, 0, 1, 0) == 0);
+        CHECK(lua_tonumber(L, -1) == 5052);
+
+        CHECK(stats.functionsCompiled == 2);
+        return stats.functionsLoadedFromCache;
+    };
+
+    CHECK(run(false) == 0);
+    CHECK(run(false) == 2);
+    CHECK(run(true) == 2);
+
+    // damaged entries are ignored and replaced
+    for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(directory))
+        std::filesystem::resize_file(entry.path(), std::filesystem::file_size(entry.path()) - 1);
+
+    CHECK(run(false) == 0);
+    CHECK(run(false) == 2);
+
+    // code generated with different flags is cached separately
+    {
+        ScopedFastFlag noOpt{"DebugCodegenNoOpt", true};
+        CHECK(run(false) == 0);
+        CHECK(run(false) == 2);
+    }
+
+    // an entry that was stored for other bytecode under the same key is not loaded; a collision is simulated by giving the entry of the
+    // first source the key of a second one that only differs in an operator
+    std::vector<std::filesystem::path> entries;
+    for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(directory))
+        entries.push_back(entry.path());
+
+    std::string other = source;
+    other.replace(other.find("s += v.value"), 12, "s -= v.value");
+
+    free(bytecode);
+    bytecode = luau_compile(other.c_str(), other.size(), nullptr, &bytecodeSize);
+
+    auto runOther = [&]() {
+        StateRef globalState(luaL_newstate(), lua_close);
+        lua_State* L = globalState.get();
+
+        Luau::CodeGen::create(L);
+        Luau::CodeGen::setCodeCacheDirectory(L, directory.string().c_str());
+        luaL_openlibs(L);
+
+        REQUIRE(luau_load(L, "=cache", bytecode, bytecodeSize, 0) == 0);
+
+        Luau::CodeGen::CompilationStats stats;
+        REQUIRE(Luau::CodeGen::compile(L, -1, 0, &stats) == Luau::CodeGen::CodeGenCompilationResult::Success);
+
+        REQUIRE(lua_pcall(L, 0, 1, 0) == 0);
+        CHECK(lua_tonumber(L, -1) == -5048);
+
+        return stats.functionsLoadedFromCache;
+    };
+
+    CHECK(runOther() == 0);
+
+    std::filesystem::path otherEntry;
+    for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(directory))
+    {
+        if (std::find(entries.begin(), entries.end(), entry.path()) == entries.end())
+            otherEntry = entry.path();
+    }
+
+    REQUIRE(!otherEntry.empty());
+
+    auto readEntry = [](const std::filesystem::path& path) {
+        std::ifstream file(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    };
+
+    std::string otherContents = readEntry(otherEntry);
+    std::string collision = readEntry(entries[0]);
+
+    // the key follows the magic and the version in the header
+    REQUIRE(collision.size() > 16);
+    collision.replace(8, 8, otherContents.substr(8, 8));
+
+    {
+        std::ofstream file(otherEntry, std::ios::binary | std::ios::trunc);
+        file.write(collision.data(), collision.size());
+    }
+
+    CHECK(runOther() == 0);
+    CHECK(runOther() == 2);
+
+    free(bytecode);
+}
+
+TEST_CASE("NativeTiering")
+{
+    if (!luau_codegen_supported())
+        return;
+
+    const char* source = R"(
+local function leaf(x)
+    return x * 2
+end
+
+local function loop(n)
+    local s = 0
+    for i = 1, n do
+        s += i
+    end
+    return s
+end
+
+local function cold()
+    return 1
+end
+
+local s = 0
+for i = 1, 10 do
+    s += leaf(i)
+end
+
+return s + loop(100) + cold()
+)";
+
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    Luau::CodeGen::create(L);
+    Luau::CodeGen::enableTiering(L, {/* entryThreshold= */ 5, /* loopThreshold= */ 50});
+    luaL_openlibs(L);
+
+    size_t bytecodeSize = 0;
+    char* bytecode = luau_compile(source, strlen(source), nullptr, &bytecodeSize);
+    REQUIRE(luau_load(L, "=tiering", bytecode, bytecodeSize, 0) == 0);
+    free(bytecode);
+
+    REQUIRE(lua_pcall(L, 0, 1, 0) == 0);
+    CHECK(lua_tonumber(L, -1) == 110 + 5050 + 1);
+
+    // leaf is promoted after 5 calls and loop after 50 iterations; main and cold stay interpreted
+    Luau::CodeGen::TieringStats stats = Luau::CodeGen::getTieringStats(L);
+    CHECK(stats.functionsPromoted == 2);
+    CHECK(stats.functionsFailed == 0);
+    CHECK(stats.compileTime >= 0.0);
+}
+
+TEST_CASE("NativeTypeFeedback")
+{
+    if (!luau_codegen_supported())
+        return;
+
+    const char* source = R"(
+local function add(a, b)
+    return a + b
+end
+
+local function addm(a, b)
+    return a + b
+end
+
+local obj = setmetatable({}, {__add = function() return 42 end})
+
+local s = 0
+for i = 1, 10 do
+    s += add(i, 1)
+    s += addm(if i < 3 then obj else i, 1)
+end
+
+return s, add, addm, obj
+)";
+
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    Luau::CodeGen::create(L);
+    Luau::CodeGen::enableTiering(L, {/* entryThreshold= */ 3, /* loopThreshold= */ 1000});
+    luaL_openlibs(L);
+
+    size_t bytecodeSize = 0;
+    char* bytecode = luau_compile(source, strlen(source), nullptr, &bytecodeSize);
+    REQUIRE(luau_load(L, "=feedback", bytecode, bytecodeSize, 0) == 0);
+    free(bytecode);
+
+    REQUIRE(lua_pcall(L, 0, 4, 0) == 0);
+    CHECK(lua_tonumber(L, -4) == 65 + 84 + 60);
+    CHECK(Luau::CodeGen::getTieringStats(L).functionsPromoted == 2);
+
+    Luau::CodeGen::AssemblyOptions options;
+    options.includeIr = true;
+
+    // addm has seen a metamethod before it was compiled, add has only seen numbers
+    CHECK(Luau::CodeGen::getAssembly(L, -3, options).find("bb_fallback") == std::string::npos);
+    CHECK(Luau::CodeGen::getAssembly(L, -2, options).find("bb_fallback") != std::string::npos);
+
+    // speculated native code exits to the interpreter, which records the new type
+    lua_pushvalue(L, -3);
+    lua_pushvalue(L, -2);
+    lua_pushnumber(L, 1);
+    REQUIRE(lua_pcall(L, 2, 1, 0) == 0);
+    CHECK(lua_tonumber(L, -1) == 42);
+    lua_pop(L, 1);
+
+    CHECK(Luau::CodeGen::getAssembly(L, -3, options).find("bb_fallback") != std::string::npos);
+}
+
+TEST_CASE("NativeLoopEntry")
+{
+    if (!luau_codegen_supported())
+        return;
+
+    const char* source = R"(
+local function numeric()
+    local switched = nil
+    for i = 1, 300 do
+        if not switched and is_native() then
+            switched = i
+        end
+    end
+    return switched
+end
+
+local function conditional()
+    local switched = nil
+    local i = 0
+    while i < 300 do
+        i += 1
+        if not switched and is_native() then
+            switched = i
+        end
+    end
+    return switched
+end
+
+local function generic(t)
+    local switched = nil
+    local sum = 0
+    for k, v in pairs(t) do
+        sum += v
+        if not switched and is_native() then
+            switched = k
+        end
+    end
+    assert(sum == 45150)
+    return switched
+end
+
+local t = {}
+for i = 1, 300 do
+    t[i] = i
+end
+
+-- main chunk switched to native code in the loop above; every other function is called once, so each one switches in its own loop
+assert(is_native())
+return numeric(), conditional(), generic(t)
+)";
+
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    Luau::CodeGen::create(L);
+    Luau::CodeGen::enableTiering(L, {/* entryThreshold= */ 1000, /* loopThreshold= */ 100});
+    luaL_openlibs(L);
+
+    lua_pushcclosurek(
+        L,
+        [](lua_State* L) -> int {
+            extern int luaG_isnative(lua_State * L, int level);
+
+            lua_pushboolean(L, luaG_isnative(L, 1));
+            return 1;
+        },
+        "is_native", 0, nullptr);
+    lua_setglobal(L, "is_native");
+
+    // native code for global access relies on a safe environment
+    luaL_sandbox(L);
+
+    size_t bytecodeSize = 0;
+    char* bytecode = luau_compile(source, strlen(source), nullptr, &bytecodeSize);
+    REQUIRE(luau_load(L, "=loopentry", bytecode, bytecodeSize, 0) == 0);
+    free(bytecode);
+
+    REQUIRE(lua_pcall(L, 0, 3, 0) == 0);
+
+    // loop counters reach the threshold at the back edge, and the next iteration runs natively
+    CHECK(lua_tonumber(L, -3) == 101);
+    CHECK(lua_tonumber(L, -2) == 101);
+    CHECK(lua_tonumber(L, -1) == 100);
+
+    CHECK(Luau::CodeGen::getTieringStats(L).functionsPromoted == 4);
+}
+
+TEST_CASE("NativeLoopEntryUnreachable")
+{
+    ScopedFastFlag bytecodeVersion4("BytecodeVersion4", true);
+
+    if (!luau_codegen_supported())
+        return;
+
+    // native code assumes that the argument is a number, so the loop back edge is unreachable in native code; when the argument check
+    // fails, the function runs in the interpreter, which reaches the back edge
+    Luau::BytecodeBuilder bcb;
+
+    uint32_t fid = bcb.beginFunction(1);
+    bcb.setFunctionTypeInfo(std::string{LBC_TYPE_FUNCTION, 1, LBC_TYPE_NUMBER});
+
+    size_t jumpToBack = bcb.emitLabel();
+    bcb.emitAD(LOP_JUMPIFNOT, 0, 0);
+    bcb.emitAD(LOP_LOADN, 1, 0);
+    bcb.emitABC(LOP_RETURN, 1, 2, 0);
+    size_t loop = bcb.emitLabel();
+    bcb.emitAD(LOP_LOADN, 1, 1);
+    bcb.emitABC(LOP_RETURN, 1, 2, 0);
+    size_t back = bcb.emitLabel();
+    bcb.emitAD(LOP_JUMPBACK, 0, 0);
+
+    REQUIRE(bcb.patchJumpD(jumpToBack, back));
+    REQUIRE(bcb.patchJumpD(back, loop));
+    bcb.endFunction(/* maxstacksize= */ 2, /* numupvalues= */ 0);
+
+    uint32_t mainid = bcb.beginFunction(0, /* isvararg= */ true);
+    bcb.emitABC(LOP_PREPVARARGS, 0, 0, 0);
+    bcb.emitAD(LOP_NEWCLOSURE, 0, bcb.addChildFunction(fid));
+    bcb.emitABC(LOP_RETURN, 0, 2, 0);
+    bcb.endFunction(/* maxstacksize= */ 1, /* numupvalues= */ 0);
+
+    bcb.setMainFunction(mainid);
+    bcb.finalize();
+
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    Luau::CodeGen::create(L);
+    luaL_openlibs(L);
+
+    // native code is only entered at loop back edges when tiering is enabled; thresholds are high enough that it doesn't compile anything
+    Luau::CodeGen::enableTiering(L, {/* entryThreshold= */ 1000000, /* loopThreshold= */ 1000000});
+
+    const std::string& bytecode = bcb.getBytecode();
+    REQUIRE(luau_load(L, "=unreachable", bytecode.data(), bytecode.size(), 0) == 0);
+    REQUIRE(Luau::CodeGen::compile(L, -1) == Luau::CodeGen::CodeGenCompilationResult::Success);
+    REQUIRE(lua_pcall(L, 0, 1, 0) == 0);
+
+    lua_pushvalue(L, -1);
+    lua_pushnumber(L, 1);
+    REQUIRE(lua_pcall(L, 1, 1, 0) == 0);
+    CHECK(lua_tonumber(L, -1) == 0);
+    lua_pop(L, 1);
+
+    // the interpreter continues at the back edge instead of trying to enter native code there again
+    lua_pushvalue(L, -1);
+    lua_pushnil(L);
+    REQUIRE(lua_pcall(L, 1, 1, 0) == 0);
+    CHECK(lua_tonumber(L, -1) == 1);
+    lua_pop(L, 1);
+}
+
+TEST_CASE("NativeInlining")
+{
+    if (!luau_codegen_supported())
+        return;
+
+    const char* source = R"(
+local Point = {}
+Point.__index = Point
+
+function Point.new(x, y)
+    return setmetatable({x = x, y = y}, Point)
+end
+
+function Point:getX()
+    return self.x
+end
+
+function Point:setX(v)
+    self.x = v
+end
+
+function Point:sum()
+    return self.x + self.y
+end
+
+local Other = {}
+Other.__index = Other
+
+function Other:getX()
+    return -1
+end
+
+function Other:setX(v)
+end
+
+function Other:sum()
+    return 0
+end
+
+local function scale(v)
+    return v * 2
+end
+
+local function run(p, n)
+    local s = 0
+    for i = 1, n do
+        p:setX(i)
+        s += p:getX() + p:sum() + scale(i)
+    end
+    return s
+end
+
+local frozen = table.freeze(Point.new(1, 2))
+local ok, err = pcall(run, frozen, 1)
+assert(not ok and err:find("readonly"))
+
+-- run is compiled in the middle of the loop with the methods of Point as the expected callees
+assert(run(Point.new(1, 2), 100) == 4 * 5050 + 2 * 100)
+
+-- other closures, fields in other table slots and readonly tables make a regular call
+assert(run(setmetatable({}, Other), 10) == 2 * 55 - 10)
+assert(run(setmetatable({a = 1, b = 2, c = 3, d = 4, x = 5, y = 6}, Point), 10) == 4 * 55 + 6 * 10)
+
+ok, err = pcall(run, frozen, 1)
+assert(not ok and err:find("readonly"))
+assert(frozen.x == 1)
+
+return "OK"
+)";
+
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    Luau::CodeGen::create(L);
+    Luau::CodeGen::enableTiering(L, {/* entryThreshold= */ 1000, /* loopThreshold= */ 10});
+    luaL_openlibs(L);
+
+    size_t bytecodeSize = 0;
+    char* bytecode = luau_compile(source, strlen(source), nullptr, &bytecodeSize);
+    REQUIRE(luau_load(L, "=inlining", bytecode, bytecodeSize, 0) == 0);
+    free(bytecode);
+
+    REQUIRE(lua_pcall(L, 0, 1, 0) == 0);
+    CHECK(strcmp(lua_tostring(L, -1), "OK") == 0);
+
+    // setX, getX, sum and scale
+    Luau::CodeGen::TieringStats stats = Luau::CodeGen::getTieringStats(L);
+    CHECK(stats.functionsPromoted == 1);
+    CHECK(stats.callsInlined == 4);
+}
+
+TEST_CASE("NativeVectorArith")
+{
+    if (!luau_codegen_supported() || LUA_VECTOR_SIZE != 3)
+        return;
+
+    const char* source = R"(
+local function step(p, v, dt, n)
+    for i = 1, n do
+        p = p + v * dt
+        v = v - p / 4
+        v = (2 * -v + v) / v
+    end
+    return p, v
+end
+
+local p, v = step(vector(1, 2, 3), vector(0.5, -1, 0.25), 0.1, 100)
+local pn, vn = step(1, 0.5, 0.1, 10)
+local ok = pcall(step, vector(1, 2, 3), {}, 0.1, 1)
+
+return p, v, pn, vn, ok, step
+)";
+
+    auto run = [&](lua_State* L, bool native) {
+        if (native)
+        {
+            Luau::CodeGen::create(L);
+            Luau::CodeGen::enableTiering(L, {/* entryThreshold= */ 1000, /* loopThreshold= */ 10});
+        }
+
+        luaL_openlibs(L);
+        lua_pushcfunction(L, lua_vector, "vector");
+        lua_setglobal(L, "vector");
+
+        Luau::CompileOptions copts = {};
+        copts.vectorCtor = "vector";
+
+        std::string bytecode = Luau::compile(source, copts);
+        REQUIRE(luau_load(L, "=vector", bytecode.data(), bytecode.size(), 0) == 0);
+        REQUIRE(lua_pcall(L, 0, 6, 0) == 0);
+    };
+
+    StateRef interpState(luaL_newstate(), lua_close);
+    StateRef nativeState(luaL_newstate(), lua_close);
+
+    run(interpState.get(), false);
+    run(nativeState.get(), true);
+
+    // vector lanes are computed with the same single-precision operations as in the interpreter
+    for (int i = -6; i <= -5; ++i)
+    {
+        const float* expected = lua_tovector(interpState.get(), i);
+        const float* actual = lua_tovector(nativeState.get(), i);
+        REQUIRE(expected);
+        REQUIRE(actual);
+        CHECK(memcmp(expected, actual, 3 * sizeof(float)) == 0);
+    }
+
+    // numbers and other values reach the arithmetic through the fallback
+    CHECK(lua_tonumber(nativeState.get(), -4) == lua_tonumber(interpState.get(), -4));
+    CHECK(lua_tonumber(nativeState.get(), -3) == lua_tonumber(interpState.get(), -3));
+    CHECK(!lua_toboolean(nativeState.get(), -2));
+
+    CHECK(Luau::CodeGen::getTieringStats(nativeState.get()).functionsPromoted == 1);
+
+    Luau::CodeGen::AssemblyOptions options;
+    options.includeIr = true;
+
+    std::string ir = Luau::CodeGen::getAssembly(nativeState.get(), -1, options);
+    CHECK(ir.find("ADD_VEC") != std::string::npos);
+    CHECK(ir.find("SUB_VEC") != std::string::npos);
+    CHECK(ir.find("MUL_VEC") != std::string::npos);
+    CHECK(ir.find("DIV_VEC") != std::string::npos);
+    CHECK(ir.find("UNM_VEC") != std::string::npos);
+    CHECK(ir.find("NUM_TO_VEC") != std::string::npos);
+}
+
+// Values that emulated native code has to reproduce exactly; numbers and vectors are compared by their bits and objects by type
+static std::string describeEmulatedValue(lua_State* L, int idx)
+{
+    char buf[64];
+
+    switch (lua_type(L, idx))
+    {
+    case LUA_TNIL:
+        return "nil";
+    case LUA_TBOOLEAN:
+        return lua_toboolean(L, idx) ? "true" : "false";
+    case LUA_TNUMBER:
+    {
+        double v = lua_tonumber(L, idx);
+        uint64_t bits;
+        memcpy(&bits, &v, sizeof(bits));
+        snprintf(buf, sizeof(buf), "%.17g/%016llx", v, (unsigned long long)bits);
+        return buf;
+    }
+    case LUA_TVECTOR:
+    {
+        const float* v = lua_tovector(L, idx);
+        uint32_t bits[3];
+        memcpy(bits, v, sizeof(bits));
+        snprintf(buf, sizeof(buf), "vector(%08x, %08x, %08x)", bits[0], bits[1], bits[2]);
+        return buf;
+    }
+    case LUA_TSTRING:
+        return "'" + std::string(lua_tostring(L, idx)) + "'";
+    default:
+        return luaL_typename(L, idx);
+    }
+}
+
+TEST_CASE("NativeA64Emulation")
+{
+    if (!Luau::CodeGen::isA64EmulationSupported() || LUA_VECTOR_SIZE != 3)
+        return;
+
+    const char* source = R"(
+local function fib(n)
+    if n < 2 then return n end
+    return fib(n - 1) + fib(n - 2)
+end
+
+local function mix(t, s)
+    local sum, keys = 0, 0
+    for k, v in pairs(t) do
+        keys += 1
+        snapshot()
+        sum += v * (k % 3) + math.floor(v / 7) - bit32.band(v, 5)
+    end
+    for i, v in ipairs(t) do
+        sum = sum - i ^ 2 + v % 4
+        snapshot()
+    end
+    return sum, keys, string.rep(s, 3) .. #t, math.sqrt(sum * sum + 1), math.abs(-sum) > 0
+end
+
+local function vecs(p, v, n)
+    for i = 1, n do
+        p = p + v * 0.25
+        v = -(v - p / 3)
+        snapshot()
+    end
+    return p, v
+end
+
+local t = {}
+for i = 1, 40 do t[i] = i * 3 - 1 end
+
+local sum, keys, str, root, positive = mix(t, "ab")
+local ok, err = pcall(function() return t.missing.field end)
+local p, v = vecs(vector(1, 2, 3), vector(-0.5, 0.125, 2), 20)
+
+return fib(15), sum, keys, str, root, positive, ok, p, v
+)";
+
+    // native code running in the emulator has to match the interpreter bit for bit, both in the results and in the registers that it keeps in
+    // the stack frame, which are recorded by snapshot() calls
+    struct RunState
+    {
+        std::vector<std::string> snapshots;
+        std::vector<std::string> stack;
+    };
+
+    auto run = [&](bool native, bool tiering) {
+        RunState result;
+
+        StateRef globalState(luaL_newstate(), lua_close);
+        lua_State* L = globalState.get();
+
+        if (native)
+        {
+            Luau::CodeGen::createA64Emulation(L);
+
+            if (tiering)
+                Luau::CodeGen::enableTiering(L, {/* entryThreshold= */ 1, /* loopThreshold= */ 1});
+        }
+
+        luaL_openlibs(L);
+        lua_pushcfunction(L, lua_vector, "vector");
+        lua_setglobal(L, "vector");
+
+        lua_pushlightuserdata(L, &result.snapshots);
+        lua_pushcclosurek(
+            L,
+            [](lua_State* L) -> int {
+                std::vector<std::string>* snapshots = static_cast<std::vector<std::string>*>(lua_tolightuserdata(L, lua_upvalueindex(1)));
+                std::string snapshot;
+
+                for (int n = 1; const char* name = lua_getlocal(L, 1, n); ++n)
+                {
+                    snapshot += std::string(name) + "=" + describeEmulatedValue(L, -1) + " ";
+                    lua_pop(L, 1);
+                }
+
+                snapshots->push_back(snapshot);
+                return 0;
+            },
+            "snapshot", 1, nullptr);
+        lua_setglobal(L, "snapshot");
+
+        Luau::CompileOptions copts = {};
+        copts.vectorCtor = "vector";
+        copts.debugLevel = 2;
+
+        std::string bytecode = Luau::compile(source, copts);
+        REQUIRE(luau_load(L, "=emulation", bytecode.data(), bytecode.size(), 0) == 0);
+
+        if (native && !tiering)
+            Luau::CodeGen::compile(L, -1);
+
+        REQUIRE(lua_pcall(L, 0, LUA_MULTRET, 0) == 0);
+
+        for (int i = 1; i <= lua_gettop(L); ++i)
+            result.stack.push_back(describeEmulatedValue(L, i));
+
+        return result;
+    };
+
+    RunState expected = run(false, false);
+
+    CHECK(expected.stack.size() == 9);
+    CHECK(expected.snapshots.size() == 100);
+
+    for (bool tiering : {false, true})
+    {
+        RunState actual = run(true, tiering);
+
+        CHECK(actual.stack == expected.stack);
+        REQUIRE(actual.snapshots.size() == expected.snapshots.size());
+
+        for (size_t i = 0; i < expected.snapshots.size(); ++i)
+            CHECK(actual.snapshots[i] == expected.snapshots[i]);
+    }
+
+    // coverage is reported for the opcodes of the module on each target
+    Luau::CodeGen::AssemblyOptions options;
+    options.includeCoverage = true;
+
+    for (Luau::CodeGen::AssemblyOptions::Target target : {Luau::CodeGen::AssemblyOptions::A64, Luau::CodeGen::AssemblyOptions::X64_SystemV})
+    {
+        options.target = target;
+
+        StateRef state(luaL_newstate(), lua_close);
+
+        std::string bytecode = Luau::compile(source);
+        REQUIRE(luau_load(state.get(), "=emulation", bytecode.data(), bytecode.size(), 0) == 0);
+
+        std::string coverage = Luau::CodeGen::getAssembly(state.get(), -1, options);
+        CHECK(coverage.find("; opcode") != std::string::npos);
+        CHECK(coverage.find("; FORGLOOP") != std::string::npos);
+        CHECK(coverage.find("; GETTABLEKS") != std::string::npos);
+    }
+}
+
+TEST_CASE("NativeCodeEviction")
+{
+    if (!luau_codegen_supported())
+        return;
+
+    // with tiering, every function is compiled into a separate allocation; each of them inlines the leaf function
+    std::string source = "local fns = {}\nlocal function leaf(x) return x end\n";
+
+    for (int i = 1; i <= 40; ++i)
+        source += "fns[" + std::to_string(i) + "] = function(n) local s = 0 for j = 1, n do s += leaf(j) * " + std::to_string(i) + " end return s end\n";
+
+    source += R"(
+local function round()
+    local s = 0
+    for _, f in fns do
+        s += f(10)
+    end
+    return s
+end
+
+return round() + round() + round()
+)";
+
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    Luau::CodeGen::create(L);
+    Luau::CodeGen::enableTiering(L, {/* entryThreshold= */ 1, /* loopThreshold= */ 1});
+    Luau::CodeGen::setNativeCodeLimit(L, 32 * 1024);
+    luaL_openlibs(L);
+
+    std::string bytecode = Luau::compile(source);
+    REQUIRE(luau_load(L, "=eviction", bytecode.data(), bytecode.size(), 0) == 0);
+    REQUIRE(lua_pcall(L, 0, 1, 0) == 0);
+    CHECK(lua_tonumber(L, -1) == 3 * 55 * 820);
+
+    // evicted functions are promoted again on their next call, and they release the inlined closures with their code, so they inline the
+    // calls again
+    Luau::CodeGen::TieringStats stats = Luau::CodeGen::getTieringStats(L);
+    CHECK(stats.functionsEvicted > 0);
+    CHECK(stats.functionsPromoted > 40);
+    CHECK(stats.callsInlined > 40);
+}
+
+TEST_CASE("NativeCodeRepack")
+{
+    if (!luau_codegen_supported())
+        return;
+
+    ScopedFastFlag repack{"DebugCodegenRepack", true};
+
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    Luau::CodeGen::create(L);
+    luaL_openlibs(L);
+
+    auto load = [&](int k) {
+        std::string source = "return function(n) local s = 0 for i = 1, n do s += i * " + std::to_string(k) + " end return s end";
+        std::string bytecode = Luau::compile(source);
+        REQUIRE(luau_load(L, "=repack", bytecode.data(), bytecode.size(), 0) == 0);
+
+        Luau::CodeGen::CompilationStats stats = {};
+        REQUIRE(Luau::CodeGen::compile(L, -1, 0, &stats) == Luau::CodeGen::CodeGenCompilationResult::Success);
+
+        REQUIRE(lua_pcall(L, 0, 1, 0) == 0);
+        return stats;
+    };
+
+    load(1);
+    load(2);
+    load(3);
+
+    // second module is released and the third one can move into its place
+    lua_remove(L, -2);
+    lua_gc(L, LUA_GCCOLLECT, 0);
+
+    Luau::CodeGen::CompilationStats stats = load(4);
+    CHECK(stats.nativeCodeRepackedBytes > 0);
+    CHECK(stats.functionsEvicted == 0);
+
+    // moved code still runs
+    const int factors[] = {1, 3, 4};
+
+    for (int i = 0; i < 3; ++i)
+    {
+        lua_pushvalue(L, i + 1);
+        lua_pushinteger(L, 10);
+        REQUIRE(lua_pcall(L, 1, 1, 0) == 0);
+        CHECK(lua_tointeger(L, -1) == 55 * factors[i]);
+        lua_pop(L, 1);
+    }
+}
+
 TEST_CASE("HugeFunction")
 {
     std::string source;
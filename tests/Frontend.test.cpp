@@ -9,6 +9,7 @@
 #include "doctest.h"
 
 #include <algorithm>
+#include <atomic>
 
 using namespace Luau;
 
@@ -43,6 +44,25 @@ struct NaiveModuleResolver : ModuleResolver
 
 NaiveModuleResolver naiveModuleResolver;
 
+struct TestModuleCacheStore : ModuleCacheStore
+{
+    std::optional<std::string> read(uint64_t key) override
+    {
+        auto it = entries.find(key);
+        if (it == entries.end())
+            return std::nullopt;
+
+        return it->second;
+    }
+
+    void write(uint64_t key, const std::string& data) override
+    {
+        entries[key] = data;
+    }
+
+    std::unordered_map<uint64_t, std::string> entries;
+};
+
 struct NaiveFileResolver : NullFileResolver
 {
     std::optional<ModuleInfo> resolveModule(const ModuleInfo* context, AstExpr* expr) override
@@ -585,6 +605,133 @@ TEST_CASE_FIXTURE(FrontendFixture, "mark_non_immediate_reverse_deps_as_dirty")
     CHECK(std::find(markedDirty.begin(), markedDirty.end(), "game/Gui/Modules/C") != markedDirty.end());
 }
 
+TEST_CASE_FIXTURE(FrontendFixture, "early_cutoff_after_implementation_only_edit")
+{
+    ScopedFastFlag sff[] = {
+        {"LuauFrontendEarlyCutoff", true},
+        {"DebugLuauDeferredConstraintResolution", false},
+    };
+
+    fileResolver.source["game/Gui/Modules/A"] = "return {hello=5, world=true}";
+
+    for (const char* name : {"B1", "B2", "B3", "B4"})
+    {
+        fileResolver.source[std::string("game/Gui/Modules/") + name] = R"(
+            local A = require(game:GetService('Gui').Modules.A)
+            return {value = A.hello}
+        )";
+    }
+
+    fileResolver.source["game/Gui/Modules/C"] = R"(
+        local Modules = game:GetService('Gui').Modules
+        local B1, B2, B3, B4 = require(Modules.B1), require(Modules.B2), require(Modules.B3), require(Modules.B4)
+        return {c_value = B1.value + B2.value + B3.value + B4.value}
+    )";
+
+    LUAU_REQUIRE_NO_ERRORS(frontend.check("game/Gui/Modules/C"));
+    CHECK_EQ(6, frontend.stats.filesStrict + frontend.stats.filesNonstrict);
+
+    // Values change, types and their locations stay the same
+    fileResolver.source["game/Gui/Modules/A"] = "return {hello=6, world=true}";
+
+    std::vector<Luau::ModuleName> markedDirty;
+    frontend.markDirty("game/Gui/Modules/A", &markedDirty);
+    CHECK_EQ(6, std::unordered_set<Luau::ModuleName>(markedDirty.begin(), markedDirty.end()).size());
+    CHECK(frontend.isDirty("game/Gui/Modules/C"));
+
+    frontend.clearStats();
+
+    LUAU_REQUIRE_NO_ERRORS(frontend.check("game/Gui/Modules/C"));
+    CHECK_EQ(1, frontend.stats.filesStrict + frontend.stats.filesNonstrict);
+    CHECK_EQ(5, frontend.stats.earlyCutoffHits);
+    CHECK(!frontend.isDirty("game/Gui/Modules/C"));
+
+    // Reused modules still match the syntax trees of their sources
+    ModulePtr cModule = frontend.moduleResolver.getModule("game/Gui/Modules/C");
+    REQUIRE(cModule);
+    CHECK_EQ(frontend.getSourceModule("game/Gui/Modules/C")->allocator, cModule->allocator);
+    CHECK_EQ("{| c_value: number |}", toString(cModule->returnType));
+
+    // Interface change has to check all dependents again
+    fileResolver.source["game/Gui/Modules/A"] = "return {hello='hi!'}";
+    frontend.markDirty("game/Gui/Modules/A");
+
+    frontend.clearStats();
+
+    CheckResult result = frontend.check("game/Gui/Modules/C");
+    CHECK_EQ(6, frontend.stats.filesStrict + frontend.stats.filesNonstrict);
+    CHECK_EQ(0, frontend.stats.earlyCutoffHits);
+
+    cModule = frontend.moduleResolver.getModule("game/Gui/Modules/C");
+    REQUIRE(cModule);
+    CHECK_EQ(4, cModule->errors.size());
+}
+
+TEST_CASE_FIXTURE(FrontendFixture, "early_cutoff_stops_at_unchanged_interface")
+{
+    ScopedFastFlag sff[] = {
+        {"LuauFrontendEarlyCutoff", true},
+        {"DebugLuauDeferredConstraintResolution", false},
+    };
+
+    fileResolver.source["game/Gui/Modules/A"] = "return {hello=5}";
+    fileResolver.source["game/Gui/Modules/B"] = R"(
+        local A = require(game:GetService('Gui').Modules.A)
+        return {value = 1}
+    )";
+    fileResolver.source["game/Gui/Modules/C"] = R"(
+        local B = require(game:GetService('Gui').Modules.B)
+        return {value = B.value}
+    )";
+
+    frontend.check("game/Gui/Modules/C");
+
+    // B is checked again since its dependency changed, but its own interface doesn't depend on A
+    fileResolver.source["game/Gui/Modules/A"] = "return {hello='hi!'}";
+    frontend.markDirty("game/Gui/Modules/A");
+
+    frontend.clearStats();
+
+    frontend.check("game/Gui/Modules/C");
+    CHECK_EQ(2, frontend.stats.filesStrict + frontend.stats.filesNonstrict);
+    CHECK_EQ(1, frontend.stats.earlyCutoffHits);
+}
+
+TEST_CASE_FIXTURE(FrontendFixture, "normalizer_cache_is_shared_between_modules")
+{
+    ScopedFastFlag sff[] = {
+        {"LuauNormalizerSharedCache", true},
+        {"LuauTransitiveSubtyping", true},
+        {"DebugLuauDeferredConstraintResolution", false},
+    };
+
+    // Subtyping check against a union normalizes both sides, and 'boolean' is a builtin type
+    fileResolver.source["Modules/A"] = R"(
+        local b: boolean = true
+        local x: true | false = b
+    )";
+    fileResolver.source["Modules/B"] = fileResolver.source["Modules/A"];
+
+    CheckResult resultA = frontend.check("Modules/A");
+    LUAU_REQUIRE_NO_ERRORS(resultA);
+    CHECK_EQ(0, frontend.stats.normalizerCacheHits);
+    CHECK_EQ(1, frontend.stats.normalizerCacheMisses);
+
+    CheckResult resultB = frontend.check("Modules/B");
+    LUAU_REQUIRE_NO_ERRORS(resultB);
+    CHECK_EQ(1, frontend.stats.normalizerCacheHits);
+    CHECK_EQ(1, frontend.stats.normalizerCacheMisses);
+    CHECK_GE(frontend.stats.timeNormalizerCacheSaved, 0.0);
+
+    frontend.clearStats();
+    frontend.clear();
+
+    // Cache is reset with the modules
+    frontend.check("Modules/A");
+    CHECK_EQ(0, frontend.stats.normalizerCacheHits);
+    CHECK_EQ(1, frontend.stats.normalizerCacheMisses);
+}
+
 #if 0
 // Does not work yet. :(
 TEST_CASE_FIXTURE(FrontendFixture, "recheck_if_dependent_script_has_a_parse_error")
@@ -1222,4 +1369,208 @@ TEST_CASE_FIXTURE(FrontendFixture, "parse_only")
     CHECK_EQ("Type 'string' could not be converted into 'number'", toString(result.errors[0]));
 }
 
+TEST_CASE_FIXTURE(FrontendFixture, "module_cache")
+{
+    ScopedFastFlag sff{"DebugLuauDeferredConstraintResolution", false};
+
+    fileResolver.source["game/A"] = R"(
+        export type Point<T = number> = {x: T, y: T}
+        local function make<T>(x: T, y: T): Point<T>
+            return {x = x, y = y}
+        end
+        return {make = make, origin = make(0, 0), names = {"x", "y"} :: {string}}
+    )";
+
+    fileResolver.source["game/B"] = R"(
+        local A = require(game.A)
+        export type Point = A.Point
+        local p: A.Point<string> = A.make("x", "y")
+        local n: number = p.x
+        local unused = A.origin.z
+        return A.origin
+    )";
+
+    TestModuleCacheStore store;
+    frontend.moduleCacheStore = &store;
+
+    FrontendOptions options;
+    options.runLintChecks = true;
+
+    CheckResult result1 = frontend.check("game/B", options);
+    LUAU_REQUIRE_ERROR_COUNT(2, result1);
+
+    // B has type errors, which are only reported by a fresh check
+    CHECK_EQ(0, frontend.stats.moduleCacheHits);
+    CHECK_EQ(2, frontend.stats.moduleCacheMisses);
+    CHECK_EQ(1, store.entries.size());
+
+    ModulePtr a1 = frontend.moduleResolver.getModule("game/A");
+    ModulePtr b1 = frontend.moduleResolver.getModule("game/B");
+    REQUIRE(a1);
+    REQUIRE(b1);
+
+    // Start over as if the process was restarted
+    frontend.clear();
+
+    CheckResult result2 = frontend.check("game/B", options);
+    LUAU_REQUIRE_ERROR_COUNT(2, result2);
+
+    CHECK_EQ(1, frontend.stats.moduleCacheHits);
+    CHECK_EQ(3, frontend.stats.moduleCacheMisses);
+
+    for (size_t i = 0; i < result1.errors.size(); ++i)
+    {
+        CHECK_EQ(result1.errors[i].location, result2.errors[i].location);
+        CHECK_EQ(result1.errors[i].moduleName, result2.errors[i].moduleName);
+        CHECK_EQ(toString(result1.errors[i]), toString(result2.errors[i]));
+    }
+
+    CHECK(get<TypeMismatch>(result2.errors[0]));
+    CHECK(get<UnknownProperty>(result2.errors[1]));
+
+    REQUIRE_EQ(2, result1.lintResult.warnings.size());
+    REQUIRE_EQ(2, result2.lintResult.warnings.size());
+
+    for (size_t i = 0; i < result1.lintResult.warnings.size(); ++i)
+    {
+        CHECK_EQ(result1.lintResult.warnings[i].code, result2.lintResult.warnings[i].code);
+        CHECK_EQ(result1.lintResult.warnings[i].location, result2.lintResult.warnings[i].location);
+        CHECK_EQ(result1.lintResult.warnings[i].text, result2.lintResult.warnings[i].text);
+    }
+
+    ModulePtr a2 = frontend.moduleResolver.getModule("game/A");
+    ModulePtr b2 = frontend.moduleResolver.getModule("game/B");
+    REQUIRE(a2);
+    REQUIRE(b2);
+
+    CHECK_EQ(toString(a1->returnType), toString(a2->returnType));
+    CHECK_EQ(toString(b1->returnType), toString(b2->returnType));
+    CHECK_EQ(a1->interfaceHash, a2->interfaceHash);
+    CHECK_EQ(b1->interfaceHash, b2->interfaceHash);
+
+    REQUIRE(b2->exportedTypeBindings.count("Point"));
+    CHECK_EQ(toString(b1->exportedTypeBindings["Point"].type), toString(b2->exportedTypeBindings["Point"].type));
+
+    // Loaded interfaces can be used to check modules that weren't cached
+    fileResolver.source["game/C"] = R"(
+        local A = require(game.A)
+        local p: A.Point = A.make(1, 2)
+        local s: string = p.x
+        local n: number = A.names[1]
+    )";
+
+    CheckResult result3 = frontend.check("game/C", options);
+    LUAU_REQUIRE_ERROR_COUNT(2, result3);
+    CHECK_EQ("Type 'number' could not be converted into 'string'", toString(result3.errors[0]));
+    CHECK_EQ("Type 'string' could not be converted into 'number'", toString(result3.errors[1]));
+}
+
+TEST_CASE_FIXTURE(FrontendFixture, "module_cache_key_includes_dependency_interfaces")
+{
+    ScopedFastFlag sff{"DebugLuauDeferredConstraintResolution", false};
+
+    fileResolver.source["game/A"] = "return {value = 1}";
+    fileResolver.source["game/B"] = "local A = require(game.A) return {value = A.value}";
+    fileResolver.source["game/C"] = "local B = require(game.B) local x: number = B.value";
+
+    TestModuleCacheStore store;
+    frontend.moduleCacheStore = &store;
+
+    FrontendOptions options;
+
+    LUAU_REQUIRE_NO_ERRORS(frontend.check("game/C", options));
+    CHECK_EQ(3, frontend.stats.moduleCacheMisses);
+
+    // Implementation change of A doesn't affect the interface, so B and C are loaded from the cache
+    // Note that the interface includes definition locations, so the change keeps them intact
+    fileResolver.source["game/A"] = "return {value = 2}";
+    frontend.clear();
+    frontend.clearStats();
+
+    LUAU_REQUIRE_NO_ERRORS(frontend.check("game/C", options));
+    CHECK_EQ(2, frontend.stats.moduleCacheHits);
+    CHECK_EQ(1, frontend.stats.moduleCacheMisses);
+
+    // Interface change of A has to be seen by B and C
+    fileResolver.source["game/A"] = "return {value = 'hi'}";
+    frontend.clear();
+    frontend.clearStats();
+
+    CheckResult result = frontend.check("game/C", options);
+    LUAU_REQUIRE_ERROR_COUNT(1, result);
+    CHECK_EQ("game/C", result.errors[0].moduleName);
+    CHECK_EQ(0, frontend.stats.moduleCacheHits);
+    CHECK_EQ(3, frontend.stats.moduleCacheMisses);
+}
+
+TEST_CASE_FIXTURE(FrontendFixture, "check_queued_modules_parallel")
+{
+    // Every module requires the two previous ones
+    for (int i = 0; i < 40; ++i)
+    {
+        std::string source = "local value = " + std::to_string(i) + "\n";
+
+        for (int dep = std::max(0, i - 2); dep < i; ++dep)
+            source += "value += require(game.M" + std::to_string(dep) + ").value\n";
+
+        if (i % 10 == 9)
+            source += "local s: string = value\n";
+
+        source += "return {value = value}";
+
+        fileResolver.source["game/M" + std::to_string(i)] = source;
+        frontend.queueModuleCheck("game/M" + std::to_string(i));
+    }
+
+    // Calls don't overlap, but they can come from different threads
+    std::atomic<size_t> progressCalls = 0;
+    std::atomic<size_t> lastDone = 0;
+
+    std::vector<ModuleName> checked = frontend.checkQueuedModulesParallel(4, {}, [&](size_t done, size_t total) {
+        progressCalls++;
+        lastDone = std::max(lastDone.load(), done);
+    });
+
+    CHECK_EQ(40, checked.size());
+    CHECK_EQ(40, progressCalls);
+    CHECK_EQ(40, lastDone);
+    CHECK_EQ(4, frontend.stats.timeThreadBusy.size());
+
+    for (int i = 0; i < 40; ++i)
+    {
+        ModuleName name = "game/M" + std::to_string(i);
+        CHECK(!frontend.isDirty(name));
+
+        std::optional<CheckResult> result = frontend.getCheckResult(name, false);
+        REQUIRE(result);
+        CHECK_EQ(i % 10 == 9 ? 1 : 0, result->errors.size());
+
+        ModulePtr module = frontend.moduleResolver.getModule(name);
+        REQUIRE(module);
+        CHECK_EQ("{| value: number |}", toString(module->returnType));
+    }
+}
+
+TEST_CASE_FIXTURE(FrontendFixture, "check_queued_modules_parallel_cycle")
+{
+    fileResolver.source["game/A"] = "return require(game.B)";
+    fileResolver.source["game/B"] = "return require(game.A)";
+    fileResolver.source["game/C"] = "local B = require(game.B) return {}";
+
+    frontend.queueModuleCheck("game/C");
+    frontend.queueModuleCheck("game/A");
+
+    std::vector<ModuleName> checked = frontend.checkQueuedModulesParallel(2);
+    CHECK_EQ(3, checked.size());
+
+    CHECK(!frontend.isDirty("game/A"));
+    CHECK(!frontend.isDirty("game/B"));
+    CHECK(!frontend.isDirty("game/C"));
+
+    std::optional<CheckResult> resultA = frontend.getCheckResult("game/A", false);
+    REQUIRE(resultA);
+    LUAU_REQUIRE_ERROR_COUNT(1, *resultA);
+    CHECK(get<ModuleHasCyclicDependency>(resultA->errors[0]));
+}
+
 TEST_SUITE_END();
@@ -4,7 +4,9 @@
 #include "Luau/IrDump.h"
 #include "Luau/IrUtils.h"
 #include "Luau/OptimizeConstProp.h"
+#include "Luau/OptimizeDeadStore.h"
 #include "Luau/OptimizeFinalX64.h"
+#include "Luau/OptimizeLoops.h"
 #include "ScopedFlags.h"
 
 #include "doctest.h"
@@ -110,6 +112,7 @@ public:
     static const int tnil = 0;
     static const int tboolean = 1;
     static const int tnumber = 3;
+    static const int tvector = 4;
     static const int tstring = 5;
     static const int ttable = 6;
 };
@@ -917,6 +920,44 @@ bb_0:
 )");
 }
 
+TEST_CASE_FIXTURE(IrBuilderFixture, "SkipCheckTagOfVectorResult")
+{
+    IrOp block = build.block(IrBlockKind::Internal);
+    IrOp fallback = build.block(IrBlockKind::Fallback);
+
+    build.beginBlock(block);
+
+    IrOp a = build.inst(IrCmd::LOAD_TVALUE, build.vmReg(1));
+    IrOp b = build.inst(IrCmd::LOAD_TVALUE, build.vmReg(2));
+    build.inst(IrCmd::STORE_TVALUE, build.vmReg(0), build.inst(IrCmd::TAG_VECTOR, build.inst(IrCmd::ADD_VEC, a, b)));
+
+    // Tag of a vector computed in registers is known and the value is forwarded to the next use
+    build.inst(IrCmd::CHECK_TAG, build.inst(IrCmd::LOAD_TAG, build.vmReg(0)), build.constTag(tvector), fallback);
+    IrOp c = build.inst(IrCmd::LOAD_TVALUE, build.vmReg(0));
+    build.inst(IrCmd::STORE_TVALUE, build.vmReg(3), build.inst(IrCmd::TAG_VECTOR, build.inst(IrCmd::UNM_VEC, c)));
+    build.inst(IrCmd::RETURN, build.constUint(0));
+
+    build.beginBlock(fallback);
+    build.inst(IrCmd::RETURN, build.constUint(1));
+
+    updateUseCounts(build.function);
+    constPropInBlockChains(build, true);
+
+    CHECK("\n" + toString(build.function, /* includeUseInfo */ false) == R"(
+bb_0:
+   %0 = LOAD_TVALUE R1
+   %1 = LOAD_TVALUE R2
+   %2 = ADD_VEC %0, %1
+   %3 = TAG_VECTOR %2
+   STORE_TVALUE R0, %3
+   %8 = UNM_VEC %3
+   %9 = TAG_VECTOR %8
+   STORE_TVALUE R3, %9
+   RETURN 0u
+
+)");
+}
+
 TEST_CASE_FIXTURE(IrBuilderFixture, "SkipOncePerBlockChecks")
 {
     IrOp block = build.block(IrBlockKind::Internal);
@@ -2786,3 +2827,555 @@ bb_0:
 }
 
 TEST_SUITE_END();
+
+TEST_SUITE_BEGIN("DeadStoreRemoval");
+
+TEST_CASE_FIXTURE(IrBuilderFixture, "OverwrittenStores")
+{
+    IrOp entry = build.block(IrBlockKind::Internal);
+
+    build.beginBlock(entry);
+    build.inst(IrCmd::STORE_DOUBLE, build.vmReg(1), build.constDouble(0.5));
+    build.inst(IrCmd::STORE_TAG, build.vmReg(1), build.constTag(tnumber));
+    build.inst(IrCmd::STORE_DOUBLE, build.vmReg(1), build.constDouble(1.5));
+
+    // Integer store doesn't cover the whole value
+    build.inst(IrCmd::STORE_DOUBLE, build.vmReg(2), build.constDouble(2.5));
+    build.inst(IrCmd::STORE_INT, build.vmReg(2), build.constInt(1));
+    build.inst(IrCmd::STORE_TAG, build.vmReg(2), build.constTag(tboolean));
+
+    IrOp value = build.inst(IrCmd::LOAD_TVALUE, build.vmReg(0));
+    build.inst(IrCmd::STORE_TAG, build.vmReg(3), build.constTag(tnumber));
+    build.inst(IrCmd::STORE_TVALUE, build.vmReg(3), value);
+    build.inst(IrCmd::RETURN, build.vmReg(1), build.constInt(3));
+
+    updateUseCounts(build.function);
+    computeCfgInfo(build.function);
+    markDeadStoresInBlockChains(build);
+
+    CHECK("\n" + toString(build.function, /* includeUseInfo */ false) == R"(
+bb_0:
+; in regs: R0
+   STORE_TAG R1, tnumber
+   STORE_DOUBLE R1, 1.5
+   STORE_DOUBLE R2, 2.5
+   STORE_INT R2, 1i
+   STORE_TAG R2, tboolean
+   %6 = LOAD_TVALUE R0
+   STORE_TVALUE R3, %6
+   RETURN R1, 3i
+
+)");
+}
+
+TEST_CASE_FIXTURE(IrBuilderFixture, "StoresAreKeptBeforeObservation")
+{
+    IrOp entry = build.block(IrBlockKind::Internal);
+
+    build.beginBlock(entry);
+    build.inst(IrCmd::STORE_DOUBLE, build.vmReg(1), build.constDouble(0.5));
+    build.inst(IrCmd::STORE_TAG, build.vmReg(1), build.constTag(tnumber));
+    build.inst(IrCmd::INTERRUPT, build.constUint(0));
+    build.inst(IrCmd::STORE_DOUBLE, build.vmReg(1), build.constDouble(1.5));
+    IrOp tag = build.inst(IrCmd::LOAD_TAG, build.vmReg(0));
+    build.inst(IrCmd::CHECK_TAG, tag, build.constTag(tnumber), build.vmExit(1));
+    build.inst(IrCmd::STORE_DOUBLE, build.vmReg(1), build.constDouble(2.5));
+    IrOp value = build.inst(IrCmd::LOAD_DOUBLE, build.vmReg(1));
+    build.inst(IrCmd::STORE_DOUBLE, build.vmReg(2), value);
+    build.inst(IrCmd::STORE_DOUBLE, build.vmReg(1), build.constDouble(3.5));
+    build.inst(IrCmd::RETURN, build.vmReg(1), build.constInt(2));
+
+    updateUseCounts(build.function);
+    computeCfgInfo(build.function);
+    markDeadStoresInBlockChains(build);
+
+    CHECK("\n" + toString(build.function, /* includeUseInfo */ false) == R"(
+bb_0:
+; in regs: R0
+   STORE_DOUBLE R1, 0.5
+   STORE_TAG R1, tnumber
+   INTERRUPT 0u
+   STORE_DOUBLE R1, 1.5
+   %4 = LOAD_TAG R0
+   CHECK_TAG %4, tnumber, exit(1)
+   STORE_DOUBLE R1, 2.5
+   %7 = LOAD_DOUBLE R1
+   STORE_DOUBLE R2, %7
+   STORE_DOUBLE R1, 3.5
+   RETURN R1, 2i
+
+)");
+}
+
+TEST_CASE_FIXTURE(IrBuilderFixture, "DeadRegistersAtChainEnd")
+{
+    IrOp entry = build.block(IrBlockKind::Internal);
+    IrOp fallback = build.block(IrBlockKind::Fallback);
+    IrOp next = build.block(IrBlockKind::Internal);
+    IrOp exit1 = build.block(IrBlockKind::Internal);
+    IrOp exit2 = build.block(IrBlockKind::Internal);
+
+    build.beginBlock(entry);
+    IrOp a = build.inst(IrCmd::LOAD_DOUBLE, build.vmReg(0));
+    IrOp b = build.inst(IrCmd::ADD_NUM, a, build.constDouble(1.0));
+    build.inst(IrCmd::STORE_DOUBLE, build.vmReg(3), b);
+    build.inst(IrCmd::STORE_TAG, build.vmReg(3), build.constTag(tnumber));
+    IrOp c = build.inst(IrCmd::MUL_NUM, b, b);
+    build.inst(IrCmd::STORE_DOUBLE, build.vmReg(4), c);
+    build.inst(IrCmd::STORE_TAG, build.vmReg(4), build.constTag(tnumber));
+    IrOp tag = build.inst(IrCmd::LOAD_TAG, build.vmReg(1));
+    build.inst(IrCmd::CHECK_TAG, tag, build.constTag(tnumber), fallback);
+    IrOp d = build.inst(IrCmd::ADD_NUM, c, build.constDouble(2.0));
+    build.inst(IrCmd::STORE_DOUBLE, build.vmReg(5), d);
+    build.inst(IrCmd::STORE_TAG, build.vmReg(5), build.constTag(tnumber));
+    IrOp e = build.inst(IrCmd::SUB_NUM, d, c);
+    build.inst(IrCmd::STORE_DOUBLE, build.vmReg(2), e);
+    build.inst(IrCmd::STORE_TAG, build.vmReg(2), build.constTag(tnumber));
+    build.inst(IrCmd::JUMP, next);
+
+    // Fallback only reads R4
+    build.beginBlock(fallback);
+    build.inst(IrCmd::DO_LEN, build.vmReg(2), build.vmReg(4));
+    build.inst(IrCmd::JUMP, next);
+
+    build.beginBlock(next);
+    IrOp f = build.inst(IrCmd::LOAD_DOUBLE, build.vmReg(2));
+    build.inst(IrCmd::JUMP_CMP_NUM, f, build.constDouble(0.0), build.cond(IrCondition::Less), exit1, exit2);
+
+    build.beginBlock(exit1);
+    build.inst(IrCmd::RETURN, build.vmReg(2), build.constInt(1));
+
+    build.beginBlock(exit2);
+    build.inst(IrCmd::RETURN, build.vmReg(0), build.constInt(1));
+
+    updateUseCounts(build.function);
+    computeCfgInfo(build.function);
+    markDeadStoresInBlockChains(build);
+
+    CHECK("\n" + toString(build.function, /* includeUseInfo */ false) == R"(
+bb_0:
+; successors: bb_fallback_1, bb_2
+; in regs: R0, R1
+; out regs: R0, R2
+   %0 = LOAD_DOUBLE R0
+   %1 = ADD_NUM %0, 1
+   %4 = MUL_NUM %1, %1
+   STORE_DOUBLE R4, %4
+   STORE_TAG R4, tnumber
+   %7 = LOAD_TAG R1
+   CHECK_TAG %7, tnumber, bb_fallback_1
+   %9 = ADD_NUM %4, 2
+   %12 = SUB_NUM %9, %4
+   STORE_DOUBLE R2, %12
+   STORE_TAG R2, tnumber
+   JUMP bb_2
+
+bb_fallback_1:
+; predecessors: bb_0
+; successors: bb_2
+; in regs: R0, R4
+; out regs: R0, R2
+   DO_LEN R2, R4
+   JUMP bb_2
+
+bb_2:
+; predecessors: bb_0, bb_fallback_1
+; successors: bb_3, bb_4
+; in regs: R0, R2
+; out regs: R0, R2
+   %18 = LOAD_DOUBLE R2
+   JUMP_CMP_NUM %18, 0, lt, bb_3, bb_4
+
+bb_3:
+; predecessors: bb_2
+; in regs: R2
+   RETURN R2, 1i
+
+bb_4:
+; predecessors: bb_2
+; in regs: R0
+   RETURN R0, 1i
+
+)");
+}
+
+TEST_CASE_FIXTURE(IrBuilderFixture, "StoresAcrossBlockChain")
+{
+    IrOp entry = build.block(IrBlockKind::Internal);
+    IrOp next = build.block(IrBlockKind::Internal);
+
+    build.beginBlock(entry);
+    build.inst(IrCmd::STORE_DOUBLE, build.vmReg(1), build.constDouble(0.5));
+    build.inst(IrCmd::STORE_TAG, build.vmReg(1), build.constTag(tnumber));
+    build.inst(IrCmd::JUMP, next);
+
+    build.beginBlock(next);
+    build.inst(IrCmd::STORE_DOUBLE, build.vmReg(1), build.constDouble(1.5));
+    build.inst(IrCmd::STORE_TAG, build.vmReg(1), build.constTag(tnumber));
+    build.inst(IrCmd::RETURN, build.vmReg(1), build.constInt(1));
+
+    updateUseCounts(build.function);
+    computeCfgInfo(build.function);
+    constPropInBlockChains(build, true);
+    markDeadStoresInBlockChains(build);
+
+    CHECK("\n" + toString(build.function, /* includeUseInfo */ false) == R"(
+bb_0:
+; successors: bb_1
+   STORE_TAG R1, tnumber
+   JUMP bb_1
+
+bb_1:
+; predecessors: bb_0
+   STORE_DOUBLE R1, 1.5
+   RETURN R1, 1i
+
+)");
+}
+
+TEST_CASE_FIXTURE(IrBuilderFixture, "CapturedRegistersAreKept")
+{
+    IrOp entry = build.block(IrBlockKind::Internal);
+
+    build.beginBlock(entry);
+    build.inst(IrCmd::CAPTURE, build.vmReg(1), build.constUint(1));
+    build.inst(IrCmd::STORE_DOUBLE, build.vmReg(1), build.constDouble(0.5));
+    build.inst(IrCmd::STORE_DOUBLE, build.vmReg(1), build.constDouble(1.5));
+    build.inst(IrCmd::STORE_DOUBLE, build.vmReg(2), build.constDouble(2.5));
+    build.inst(IrCmd::RETURN, build.vmReg(0), build.constInt(1));
+
+    updateUseCounts(build.function);
+    computeCfgInfo(build.function);
+    markDeadStoresInBlockChains(build);
+
+    CHECK("\n" + toString(build.function, /* includeUseInfo */ false) == R"(
+; captured regs: R1
+
+bb_0:
+; in regs: R0, R1
+   CAPTURE R1, 1u
+   STORE_DOUBLE R1, 0.5
+   STORE_DOUBLE R1, 1.5
+   RETURN R0, 1i
+
+)");
+}
+
+TEST_SUITE_END();
+
+TEST_SUITE_BEGIN("LoopVersioning");
+
+TEST_CASE_FIXTURE(IrBuilderFixture, "NumericLoopArrayAccess")
+{
+    IrOp entry = build.block(IrBlockKind::Internal);
+    IrOp header = build.block(IrBlockKind::Internal);
+    IrOp fallback = build.block(IrBlockKind::Fallback);
+    IrOp latch = build.block(IrBlockKind::Internal);
+    IrOp reverse = build.block(IrBlockKind::Internal);
+    IrOp direct = build.block(IrBlockKind::Internal);
+    IrOp exit = build.block(IrBlockKind::Internal);
+
+    build.beginBlock(entry);
+    build.inst(IrCmd::JUMP, header);
+
+    // R1 += R0[R4]
+    build.beginBlock(header);
+    build.inst(IrCmd::CHECK_TAG, build.inst(IrCmd::LOAD_TAG, build.vmReg(0)), build.constTag(ttable), fallback);
+    build.inst(IrCmd::CHECK_TAG, build.inst(IrCmd::LOAD_TAG, build.vmReg(1)), build.constTag(tnumber), fallback);
+    IrOp table = build.inst(IrCmd::LOAD_POINTER, build.vmReg(0));
+    IrOp index = build.inst(IrCmd::TRY_NUM_TO_INDEX, build.inst(IrCmd::LOAD_DOUBLE, build.vmReg(4)), fallback);
+    IrOp arrIndex = build.inst(IrCmd::SUB_INT, index, build.constInt(1));
+    build.inst(IrCmd::CHECK_ARRAY_SIZE, table, arrIndex, fallback);
+    build.inst(IrCmd::CHECK_NO_METATABLE, table, fallback);
+    IrOp value = build.inst(IrCmd::LOAD_DOUBLE, build.inst(IrCmd::GET_ARR_ADDR, table, arrIndex));
+    IrOp sum = build.inst(IrCmd::ADD_NUM, build.inst(IrCmd::LOAD_DOUBLE, build.vmReg(1)), value);
+    build.inst(IrCmd::STORE_DOUBLE, build.vmReg(1), sum);
+    build.inst(IrCmd::JUMP, latch);
+
+    build.beginBlock(fallback);
+    build.inst(IrCmd::JUMP, latch);
+
+    build.beginBlock(latch);
+    build.inst(IrCmd::INTERRUPT, build.constUint(5));
+    IrOp limit = build.inst(IrCmd::LOAD_DOUBLE, build.vmReg(2));
+    IrOp step = build.inst(IrCmd::LOAD_DOUBLE, build.vmReg(3));
+    IrOp idx = build.inst(IrCmd::LOAD_DOUBLE, build.vmReg(4));
+    IrOp nextIdx = build.inst(IrCmd::ADD_NUM, idx, step);
+    build.inst(IrCmd::STORE_DOUBLE, build.vmReg(4), nextIdx);
+    build.inst(IrCmd::JUMP_CMP_NUM, step, build.constDouble(0.0), build.cond(IrCondition::LessEqual), reverse, direct);
+
+    build.beginBlock(reverse);
+    build.inst(IrCmd::JUMP_CMP_NUM, limit, nextIdx, build.cond(IrCondition::LessEqual), header, exit);
+
+    build.beginBlock(direct);
+    build.inst(IrCmd::JUMP_CMP_NUM, nextIdx, limit, build.cond(IrCondition::LessEqual), header, exit);
+
+    build.beginBlock(exit);
+    build.inst(IrCmd::RETURN, build.vmReg(1), build.constInt(1));
+
+    build.function.blocks[latch.index].loopEntry = true;
+
+    updateUseCounts(build.function);
+    computeCfgInfo(build.function);
+    hoistLoopInvariantGuards(build);
+
+    CHECK("\n" + toString(build.function, /* includeUseInfo */ false) == R"(
+bb_0:
+; successors: bb_10
+; in regs: R0, R1, R2, R3, R4
+; out regs: R0, R1, R2, R3, R4
+   JUMP bb_10
+
+bb_1:
+; predecessors: bb_10, bb_10, bb_10, bb_10, bb_11, bb_11, bb_11, bb_11, bb_11
+; successors: bb_fallback_2, bb_fallback_2, bb_fallback_2, bb_fallback_2, bb_fallback_2, bb_3
+; in regs: R0, R1, R2, R3, R4
+; out regs: R0, R1, R2, R3, R4
+   %1 = LOAD_TAG R0
+   CHECK_TAG %1, ttable, bb_fallback_2
+   %3 = LOAD_TAG R1
+   CHECK_TAG %3, tnumber, bb_fallback_2
+   %5 = LOAD_POINTER R0
+   %6 = LOAD_DOUBLE R4
+   %7 = TRY_NUM_TO_INDEX %6, bb_fallback_2
+   %8 = SUB_INT %7, 1i
+   CHECK_ARRAY_SIZE %5, %8, bb_fallback_2
+   CHECK_NO_METATABLE %5, bb_fallback_2
+   %11 = GET_ARR_ADDR %5, %8
+   %12 = LOAD_DOUBLE %11
+   %13 = LOAD_DOUBLE R1
+   %14 = ADD_NUM %13, %12
+   STORE_DOUBLE R1, %14
+   JUMP bb_3
+
+bb_fallback_2:
+; predecessors: bb_1, bb_1, bb_1, bb_1, bb_1
+; successors: bb_3
+; in regs: R0, R1, R2, R3, R4
+; out regs: R0, R1, R2, R3, R4
+   JUMP bb_3
+
+bb_3:
+; predecessors: bb_1, bb_fallback_2, bb_8
+; successors: bb_4, bb_5
+; in regs: R0, R1, R2, R3, R4
+; out regs: R0, R1, R2, R3, R4
+   INTERRUPT 5u
+   %19 = LOAD_DOUBLE R2
+   %20 = LOAD_DOUBLE R3
+   %21 = LOAD_DOUBLE R4
+   %22 = ADD_NUM %21, %20
+   STORE_DOUBLE R4, %22
+   JUMP_CMP_NUM %20, 0, le, bb_4, bb_5
+
+bb_4:
+; predecessors: bb_3
+; successors: bb_10, bb_6
+; in regs: R0, R1, R2, R3, R4
+; out regs: R0, R1, R2, R3, R4
+   JUMP_CMP_NUM %19, %22, le, bb_10, bb_6
+
+bb_5:
+; predecessors: bb_3
+; successors: bb_10, bb_6
+; in regs: R0, R1, R2, R3, R4
+; out regs: R0, R1, R2, R3, R4
+   JUMP_CMP_NUM %22, %19, le, bb_10, bb_6
+
+bb_6:
+; predecessors: bb_4, bb_5, bb_9
+; in regs: R1
+   RETURN R1, 1i
+
+bb_7:
+; predecessors: bb_9, bb_11
+; successors: bb_8
+; in regs: R0, R1, R2, R3, R4
+; out regs: R0, R1, R2, R3, R4
+   %30 = LOAD_POINTER R0
+   %31 = LOAD_DOUBLE R4
+   %32 = NUM_TO_INT %31
+   %33 = SUB_INT %32, 1i
+   %34 = GET_ARR_ADDR %30, %33
+   %35 = LOAD_DOUBLE %34
+   %36 = LOAD_DOUBLE R1
+   %37 = ADD_NUM %36, %35
+   STORE_DOUBLE R1, %37
+   JUMP bb_8
+
+bb_8:
+; predecessors: bb_7
+; successors: bb_3, bb_9
+; in regs: R0, R1, R2, R3, R4
+; out regs: R0, R1, R2, R3, R4
+   CHECK_NO_INTERRUPT bb_3
+   %41 = LOAD_DOUBLE R2
+   %42 = LOAD_DOUBLE R3
+   %43 = LOAD_DOUBLE R4
+   %44 = ADD_NUM %43, %42
+   STORE_DOUBLE R4, %44
+   JUMP bb_9
+
+bb_9:
+; predecessors: bb_8
+; successors: bb_7, bb_6
+; in regs: R0, R1, R2, R3, R4
+; out regs: R0, R1, R2, R3, R4
+   JUMP_CMP_NUM %44, %41, le, bb_7, bb_6
+
+bb_10:
+; predecessors: bb_0, bb_4, bb_5
+; successors: bb_1, bb_1, bb_1, bb_1, bb_11
+; in regs: R0, R1, R2, R3, R4
+; out regs: R0, R1, R2, R3, R4
+   %48 = LOAD_TAG R0
+   CHECK_TAG %48, ttable, bb_1
+   %50 = LOAD_TAG R1
+   CHECK_TAG %50, tnumber, bb_1
+   %52 = LOAD_POINTER R0
+   CHECK_NO_METATABLE %52, bb_1
+   %54 = LOAD_DOUBLE R3
+   JUMP_CMP_NUM %54, 1, not_eq, bb_1, bb_11
+
+bb_11:
+; predecessors: bb_10
+; successors: bb_1, bb_1, bb_1, bb_1, bb_7, bb_1
+; in regs: R0, R1, R2, R3, R4
+; out regs: R0, R1, R2, R3, R4
+   %56 = LOAD_DOUBLE R2
+   %57 = TRY_NUM_TO_INDEX %56, bb_1
+   %58 = LOAD_DOUBLE R4
+   %59 = TRY_NUM_TO_INDEX %58, bb_1
+   %60 = SUB_INT %59, 1i
+   %61 = SUB_INT %57, 1i
+   %62 = LOAD_POINTER R0
+   CHECK_ARRAY_SIZE %62, %60, bb_1
+   CHECK_ARRAY_SIZE %62, %61, bb_1
+   JUMP_CMP_NUM %58, %56, le, bb_7, bb_1
+
+)");
+}
+
+TEST_CASE_FIXTURE(IrBuilderFixture, "GuardsOnRegistersWrittenInLoopAreKept")
+{
+    IrOp entry = build.block(IrBlockKind::Internal);
+    IrOp header = build.block(IrBlockKind::Internal);
+    IrOp body = build.block(IrBlockKind::Internal);
+    IrOp latch = build.block(IrBlockKind::Internal);
+    IrOp exit = build.block(IrBlockKind::Internal);
+
+    build.beginBlock(entry);
+    build.inst(IrCmd::JUMP, header);
+
+    // while R0 do R1 = R2.x end
+    build.beginBlock(header);
+    build.inst(IrCmd::JUMP_IF_FALSY, build.vmReg(0), exit, body);
+
+    build.beginBlock(body);
+    build.inst(IrCmd::CHECK_TAG, build.inst(IrCmd::LOAD_TAG, build.vmReg(1)), build.constTag(tnumber), build.vmExit(1));
+    build.inst(IrCmd::CHECK_TAG, build.inst(IrCmd::LOAD_TAG, build.vmReg(2)), build.constTag(ttable), build.vmExit(1));
+    IrOp table = build.inst(IrCmd::LOAD_POINTER, build.vmReg(2));
+    build.inst(IrCmd::CHECK_NO_METATABLE, table, build.vmExit(1));
+    IrOp value = build.inst(IrCmd::LOAD_TVALUE, build.inst(IrCmd::GET_ARR_ADDR, table, build.constInt(0)));
+    build.inst(IrCmd::STORE_TVALUE, build.vmReg(1), value);
+    build.inst(IrCmd::JUMP, latch);
+
+    build.beginBlock(latch);
+    build.inst(IrCmd::INTERRUPT, build.constUint(3));
+    build.inst(IrCmd::JUMP, header);
+
+    build.beginBlock(exit);
+    build.inst(IrCmd::RETURN, build.vmReg(1), build.constInt(1));
+
+    build.function.blocks[latch.index].loopEntry = true;
+
+    updateUseCounts(build.function);
+    computeCfgInfo(build.function);
+    hoistLoopInvariantGuards(build);
+
+    CHECK("\n" + toString(build.function, /* includeUseInfo */ false) == R"(
+bb_0:
+; successors: bb_8
+; in regs: R0, R1, R2
+; out regs: R0, R1, R2
+   JUMP bb_8
+
+bb_1:
+; predecessors: bb_8, bb_8
+; successors: bb_4, bb_2
+; in regs: R0, R1, R2
+; out regs: R0, R1, R2
+   JUMP_IF_FALSY R0, bb_4, bb_2
+
+bb_2:
+; predecessors: bb_1
+; successors: bb_3
+; in regs: R0, R1, R2
+; out regs: R0, R1, R2
+   %2 = LOAD_TAG R1
+   CHECK_TAG %2, tnumber, exit(1)
+   %4 = LOAD_TAG R2
+   CHECK_TAG %4, ttable, exit(1)
+   %6 = LOAD_POINTER R2
+   CHECK_NO_METATABLE %6, exit(1)
+   %8 = GET_ARR_ADDR %6, 0i
+   %9 = LOAD_TVALUE %8
+   STORE_TVALUE R1, %9
+   JUMP bb_3
+
+bb_3:
+; predecessors: bb_2, bb_7
+; successors: bb_8
+; in regs: R0, R1, R2
+; out regs: R0, R1, R2
+   INTERRUPT 3u
+   JUMP bb_8
+
+bb_4:
+; predecessors: bb_1, bb_5
+; in regs: R1
+   RETURN R1, 1i
+
+bb_5:
+; predecessors: bb_7, bb_8
+; successors: bb_4, bb_6
+; in regs: R0, R1, R2
+; out regs: R0, R1, R2
+   JUMP_IF_FALSY R0, bb_4, bb_6
+
+bb_6:
+; predecessors: bb_5
+; successors: bb_7
+; in regs: R0, R1, R2
+; out regs: R0, R1, R2
+   %16 = LOAD_TAG R1
+   CHECK_TAG %16, tnumber, exit(1)
+   %19 = LOAD_POINTER R2
+   %20 = GET_ARR_ADDR %19, 0i
+   %21 = LOAD_TVALUE %20
+   STORE_TVALUE R1, %21
+   JUMP bb_7
+
+bb_7:
+; predecessors: bb_6
+; successors: bb_3, bb_5
+; in regs: R0, R1, R2
+; out regs: R0, R1, R2
+   CHECK_NO_INTERRUPT bb_3
+   JUMP bb_5
+
+bb_8:
+; predecessors: bb_0, bb_3
+; successors: bb_1, bb_1, bb_5
+; in regs: R0, R1, R2
+; out regs: R0, R1, R2
+   %26 = LOAD_TAG R2
+   CHECK_TAG %26, ttable, bb_1
+   %28 = LOAD_POINTER R2
+   CHECK_NO_METATABLE %28, bb_1
+   JUMP bb_5
+
+)");
+}
+
+TEST_SUITE_END();
@@ -529,4 +529,42 @@ TEST_CASE_FIXTURE(BuiltinsFixture, "clone_table_bound_to_table_bound_to_table")
     REQUIRE(!tableA->boundTo);
 }
 
+TEST_CASE_FIXTURE(Fixture, "type_arena_memory_usage")
+{
+    TypeArena arena;
+
+    TypeId bound = arena.addType(BoundType{builtinTypes->numberType});
+    TypeId option = arena.addType(UnionType{{builtinTypes->numberType, builtinTypes->stringType}});
+
+    TableType ttv{TableState::Sealed, TypeLevel{}};
+    ttv.props["a property name that doesn't fit into the small string"] = Property{builtinTypes->numberType};
+    TypeId table = arena.addType(std::move(ttv));
+
+    arena.addTypePack({builtinTypes->numberType});
+
+    size_t boundKind = size_t(bound->ty.index());
+    size_t unionKind = size_t(option->ty.index());
+    size_t tableKind = size_t(table->ty.index());
+
+    CHECK_EQ("bound", std::string(getTypeKindName(boundKind)));
+    CHECK_EQ("union", std::string(getTypeKindName(unionKind)));
+    CHECK_EQ("table", std::string(getTypeKindName(tableKind)));
+
+    TypeArenaMemoryUsage usage = getMemoryUsage(arena);
+
+    REQUIRE(usage.typeCounts.size() > tableKind);
+    CHECK_EQ(1, usage.typeCounts[boundKind]);
+    CHECK_EQ(1, usage.typeCounts[unionKind]);
+    CHECK_EQ(1, usage.typeCounts[tableKind]);
+    CHECK_EQ(sizeof(Type), usage.typeBytes[boundKind]);
+    CHECK_EQ(sizeof(Type) + 2 * sizeof(TypeId), usage.typeBytes[unionKind]);
+    CHECK(usage.typeBytes[tableKind] > sizeof(Type) + sizeof(TableType));
+    CHECK_EQ(1, usage.typePackCount);
+
+    TypeArenaMemoryUsage total;
+    total.add(usage);
+    total.add(usage);
+    CHECK_EQ(usage.getTotalBytes() * 2, total.getTotalBytes());
+}
+
 TEST_SUITE_END();
@@ -839,4 +839,45 @@ TEST_CASE_FIXTURE(NormalizeFixture, "normalize_is_exactly_number")
     CHECK(!unionIntersection->isExactlyNumber());
 }
 
+TEST_CASE_FIXTURE(NormalizeFixture, "shared_cache_for_global_types")
+{
+    TypeArena globalTypes;
+    NormalizerSharedCache sharedCache{{&globalTypes}};
+
+    TypeId stringOrNumber = globalTypes.addType(UnionType{{builtinTypes->stringType, builtinTypes->numberType}});
+
+    TypeId tableX =
+        globalTypes.addType(TableType{TableType::Props{{"x", {builtinTypes->numberType}}}, std::nullopt, TypeLevel{}, TableState::Sealed});
+    TypeId tableY =
+        globalTypes.addType(TableType{TableType::Props{{"y", {builtinTypes->stringType}}}, std::nullopt, TypeLevel{}, TableState::Sealed});
+    TypeId tableXAndY = globalTypes.addType(IntersectionType{{tableX, tableY}});
+
+    TypeArena otherArena;
+    Normalizer otherNormalizer{&otherArena, builtinTypes, NotNull{&unifierState}};
+
+    normalizer.sharedCache = &sharedCache;
+    otherNormalizer.sharedCache = &sharedCache;
+
+    const NormalizedType* norm = normalizer.normalize(stringOrNumber);
+    REQUIRE(norm);
+    CHECK(normalizer.normalize(stringOrNumber) == norm);
+    CHECK(otherNormalizer.normalize(stringOrNumber) == norm);
+
+    // Intersection of tables is a new table in the arena of the normalizer, so it can't be shared
+    const NormalizedType* normXAndY = normalizer.normalize(tableXAndY);
+    REQUIRE(normXAndY);
+    CHECK(otherNormalizer.normalize(tableXAndY) != normXAndY);
+
+    // Types from a module arena are not looked up
+    normalizer.normalize(arena.addType(UnionType{{builtinTypes->stringType, builtinTypes->booleanType}}));
+
+    NormalizerSharedCache::Stats stats = sharedCache.takeStats();
+    CHECK(stats.hits == 1);
+    CHECK(stats.misses == 3);
+
+    stats = sharedCache.takeStats();
+    CHECK(stats.hits == 0);
+    CHECK(stats.misses == 0);
+}
+
 TEST_SUITE_END();
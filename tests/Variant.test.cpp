@@ -3,6 +3,7 @@
 
 #include <string>
 #include <ostream>
+#include <vector>
 
 #include "doctest.h"
 
@@ -248,4 +249,138 @@ TEST_CASE("MoveWithCopyableAlternative")
     CHECK(*s2 == "Hello, world! I am longer than a normal hello world string to avoid SSO.");
 }
 
+static constexpr size_t kInlineSize = 64;
+
+template<typename... Ts>
+using BoxingVariant = BasicVariant<kInlineSize, Ts...>;
+
+struct Large
+{
+    explicit Large(int x)
+        : x(x)
+    {
+        ++count;
+    }
+
+    Large(const Large& other)
+        : x(other.x)
+    {
+        ++count;
+    }
+
+    ~Large()
+    {
+        --count;
+    }
+
+    bool operator==(const Large& other) const
+    {
+        return x == other.x;
+    }
+
+    int x;
+    char padding[kInlineSize] = {};
+    static int count;
+};
+
+int Large::count = 0;
+
+TEST_CASE("LargeAlternative")
+{
+    static_assert(sizeof(BoxingVariant<int, Large>) < sizeof(Large), "large alternatives are stored separately");
+    static_assert(sizeof(Variant<int, Large>) > sizeof(Large), "plain variants store every alternative inline");
+
+    {
+        BoxingVariant<int, Large> v1 = Large{1};
+        REQUIRE(get_if<Large>(&v1));
+        CHECK(get_if<Large>(&v1)->x == 1);
+
+        BoxingVariant<int, Large> v2 = v1;
+        REQUIRE(get_if<Large>(&v2));
+        CHECK(get_if<Large>(&v1) != get_if<Large>(&v2));
+        CHECK(v1 == v2);
+        CHECK(Large::count == 2);
+
+        // Moving leaves the source with a value of its own
+        BoxingVariant<int, Large> v3 = std::move(v2);
+        REQUIRE(get_if<Large>(&v2));
+        REQUIRE(get_if<Large>(&v3));
+        CHECK(get_if<Large>(&v3) != get_if<Large>(&v2));
+        CHECK(get_if<Large>(&v3)->x == 1);
+        CHECK(Large::count == 3);
+
+        // Assignment doesn't leave extra copies behind, and keeps the value where it was, as it would be inline
+        const Large* large3 = get_if<Large>(&v3);
+        v3 = v1;
+        CHECK(get_if<Large>(&v3) == large3);
+        CHECK(get_if<Large>(&v3)->x == 1);
+        CHECK(Large::count == 3);
+
+        v3 = std::move(v1);
+        REQUIRE(get_if<Large>(&v1));
+        CHECK(Large::count == 3);
+
+        v2 = 5;
+        REQUIRE(get_if<int>(&v2));
+        CHECK(*get_if<int>(&v2) == 5);
+
+        const Large* large1 = get_if<Large>(&v1);
+        v1.emplace<Large>(7);
+        CHECK(get_if<Large>(&v1) == large1);
+        CHECK(visit([](auto&& v) {
+            return sizeof(v) > kInlineSize;
+        }, v1));
+        CHECK(get_if<Large>(&v1)->x == 7);
+        CHECK(Large::count == 2);
+
+        v1 = 3;
+        CHECK(Large::count == 1);
+    }
+
+    CHECK(Large::count == 0);
+
+    BoxingVariant<std::pair<Foo, char[kInlineSize]>, int> v4;
+    REQUIRE(get_if<std::pair<Foo, char[kInlineSize]>>(&v4));
+    CHECK(get_if<std::pair<Foo, char[kInlineSize]>>(&v4)->first.x == 42);
+}
+
+struct LargeVector
+{
+    bool operator==(const LargeVector& other) const
+    {
+        return first == other.first;
+    }
+
+    std::vector<int> first;
+    char padding[kInlineSize] = {};
+};
+
+TEST_CASE("LargeAlternativeMovedFrom")
+{
+    static_assert(BoxingVariant<int, LargeVector>::isBoxed<LargeVector>, "alternative is stored separately");
+
+    BoxingVariant<int, LargeVector> v1;
+    v1.emplace<LargeVector>().first = {1, 2, 3};
+
+    BoxingVariant<int, LargeVector> v2 = std::move(v1);
+    REQUIRE(get_if<LargeVector>(&v2));
+    CHECK(get_if<LargeVector>(&v2)->first.size() == 3);
+
+    // Moved-from value can still be used
+    REQUIRE(get_if<LargeVector>(&v1));
+    CHECK(get_if<LargeVector>(&v1)->first.empty());
+    get_if<LargeVector>(&v1)->first.push_back(4);
+    CHECK(v1 != v2);
+
+    BoxingVariant<int, LargeVector> v3 = 5;
+    v3 = std::move(v2);
+    REQUIRE(get_if<LargeVector>(&v3));
+    CHECK(get_if<LargeVector>(&v3)->first.size() == 3);
+    REQUIRE(get_if<LargeVector>(&v2));
+    CHECK(get_if<LargeVector>(&v2)->first.empty());
+
+    v2 = v3;
+    CHECK(v2 == v3);
+}
+
 TEST_SUITE_END();
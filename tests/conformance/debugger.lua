@@ -82,4 +82,16 @@ breakpoint(77)
 
 pcall(cond, nil) -- prevent inlining
 
+-- break on the second instruction of a pair that the compiler can fuse
+local function pair(x)
+	local y = x
+	y = 7
+	x = 8
+	return x + y
+end
+
+breakpoint(89)
+
+pcall(pair, 10) -- prevent inlining
+
 return 'OK'
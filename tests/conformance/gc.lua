@@ -350,4 +350,39 @@ do
   collectgarbage()
 end
 
+-- generational mode: old objects keep young objects they refer to alive through minor collections
+do
+  collectgarbage("generational")
+  collectgarbage()
+
+  local old = {}
+  local weak = setmetatable({}, {__mode = "k"})
+
+  -- suspended thread with an open upvalue that becomes old
+  local co = coroutine.wrap(function()
+    local v = {1}
+    local function get() return v[1] end
+    while true do
+      coroutine.yield(get())
+      v = {v[1] + 1}
+    end
+  end)
+
+  for i = 1,5000 do
+    old[i % 100 + 1] = {i}
+    weak[{}] = i
+    assert(co() == i)
+    collectgarbage("step", 1)
+  end
+
+  for i = 1,100 do
+    assert(old[i][1] % 100 + 1 == i)
+  end
+
+  collectgarbage()
+  assert(next(weak) == nil)
+
+  collectgarbage("incremental")
+end
+
 return('OK')
@@ -232,6 +232,60 @@ end
 
 assert(chr1("0") == "\0")
 
+-- long strings are hashed in blocks; equal strings that are built differently must be interned as the same string
+do
+  local t = {}
+  for i = 1, 100 do
+    t[string.rep("a", i) .. i] = i
+  end
+
+  for i = 1, 100 do
+    assert(t[table.concat({string.rep("a", i), tostring(i)})] == i)
+    assert(t[string.sub(string.rep("a", 200) .. i, 201 - i)] == i)
+  end
+
+  -- strings that only differ in a single byte
+  local base = string.rep("x", 77)
+  for i = 1, 77 do
+    local s = string.sub(base, 1, i - 1) .. "y" .. string.sub(base, i + 1)
+    assert(t[s] == nil)
+    t[s] = i
+  end
+
+  for i = 1, 77 do
+    assert(t[string.rep("x", i - 1) .. "y" .. string.rep("x", 77 - i)] == i)
+  end
+end
+
+-- string table is resized incrementally; strings must remain interned while buckets are being moved
+do
+  local t = {}
+  for i = 1, 50000 do
+    local s = "str" .. i
+    t[s] = i
+    if i % 1000 == 0 then
+      collectgarbage("step")
+      assert(t["str" .. (i / 2)] == i / 2)
+    end
+  end
+
+  for i = 1, 50000 do
+    assert(t["str" .. i] == i)
+  end
+
+  t = nil
+  collectgarbage()
+
+  -- table shrinks after strings are collected and can grow again
+  local u = {}
+  for i = 1, 20000 do
+    u[i] = "new" .. i
+  end
+  for i = 1, 20000 do
+    assert(u[i] == "new" .. i)
+  end
+end
+
 --[[
 local locales = { "ptb", "ISO-8859-1", "pt_BR" }
 local function trylocale (w)
@@ -0,0 +1,305 @@
+-- This file is part of the Luau programming language and is licensed under MIT License; see LICENSE.txt for details
+print("testing table shapes")
+
+local function count(t)
+  local c = 0
+  for k, v in pairs(t) do
+    c = c + 1
+  end
+  return c
+end
+
+-- records created in the same order share the layout
+do
+  local function point(x, y) return {x = x, y = y} end
+
+  local s = 0
+  for i = 1, 100 do
+    local p = point(i, -i)
+    assert(p.x == i and p.y == -i)
+    p.x = p.x + 1
+    s = s + p.x + p.y
+  end
+  assert(s == 100)
+
+  local p = point(1, 2)
+  p.z = 3
+  assert(p.x == 1 and p.y == 2 and p.z == 3)
+  assert(count(p) == 3)
+
+  -- same keys in a different order
+  local q = {}
+  q.z = 3; q.y = 2; q.x = 1
+  assert(q.x == 1 and q.y == 2 and q.z == 3)
+  assert(count(q) == 3)
+end
+
+-- removing fields keeps the layout, and the fields can be assigned again
+do
+  local t = {a = 1, b = 2, c = 3}
+  t.b = nil
+  assert(t.a == 1 and t.b == nil and t.c == 3)
+  assert(count(t) == 2)
+  assert(next({a = nil}) == nil)
+  t.b = 4
+  assert(t.b == 4 and count(t) == 3)
+
+  for k in pairs(t) do t[k] = nil end
+  assert(next(t) == nil)
+  t.d = 5
+  assert(next(t) == "d")
+end
+
+-- mixing in non-string keys and many fields turns tables into dictionaries
+do
+  local t = {a = 1, b = 2}
+  t[true] = 3
+  t[1.5] = 4
+  assert(t.a == 1 and t.b == 2 and t[true] == 3 and t[1.5] == 4)
+  assert(count(t) == 4)
+
+  local u = {}
+  for i = 1, 100 do u["f" .. i] = i end
+  for i = 1, 100 do assert(u["f" .. i] == i) end
+  assert(count(u) == 100)
+
+  -- numeric string keys are still strings
+  local v = {}
+  v["1"] = "s"
+  v[1] = "n"
+  assert(v["1"] == "s" and v[1] == "n")
+end
+
+-- arrays and fields coexist
+do
+  local t = {1, 2, 3, n = 3}
+  assert(#t == 3 and t.n == 3)
+  table.insert(t, 4)
+  t.n = #t
+  assert(#t == 4 and t.n == 4 and t[4] == 4)
+
+  local keys = {}
+  for k, v in pairs(t) do keys[#keys + 1] = k end
+  assert(#keys == 5)
+  assert(table.find(t, 3) == 3)
+end
+
+-- integer keys move fields to a hash part
+do
+  local t = {a = 1, b = 2}
+  t[1] = "x"
+  assert(#t == 1 and t.a == 1 and t.b == 2 and count(t) == 3)
+  t[2] = "y"
+  t.c = 3
+  assert(#t == 2 and t[2] == "y" and t.c == 3 and count(t) == 5)
+
+  local u = {x = 1}
+  table.insert(u, "v")
+  assert(u[1] == "v" and u.x == 1 and #u == 1)
+end
+
+-- method calls on objects that share a class
+do
+  local Account = {}
+  Account.__index = Account
+
+  function Account.new(balance)
+    return setmetatable({balance = balance, history = {}}, Account)
+  end
+
+  function Account:deposit(v)
+    self.balance = self.balance + v
+    table.insert(self.history, v)
+  end
+
+  function Account:total()
+    local s = 0
+    for _, v in ipairs(self.history) do s = s + v end
+    return s
+  end
+
+  local accounts = {}
+  for i = 1, 50 do
+    local a = Account.new(i)
+    for j = 1, 10 do a:deposit(j) end
+    accounts[i] = a
+  end
+
+  for i, a in ipairs(accounts) do
+    assert(a.balance == i + 55)
+    assert(a:total() == 55)
+  end
+
+  -- instance field shadows a method after the fact
+  local a = accounts[1]
+  a.total = function() return -1 end
+  assert(a:total() == -1)
+  a.total = nil
+  assert(a:total() == 55)
+
+  -- class changes after its methods have been looked up
+  local total = Account.total
+  Account.total = nil
+  assert(not pcall(function() return a:total() end))
+  Account.extra = true
+  Account.total = total
+  assert(a:total() == 55)
+
+  -- method is missing from both the instance and the class
+  local ok, err = pcall(function() return a:missing() end)
+  assert(not ok and err:find("missing"))
+end
+
+-- __index and __newindex only apply to absent fields
+do
+  local log = {}
+  local mt = {__index = function(t, k) return "default " .. k end, __newindex = function(t, k, v) log[#log + 1] = k; rawset(t, k, v) end}
+  local t = setmetatable({x = 1}, mt)
+  assert(t.x == 1 and t.y == "default y")
+  t.x = 2
+  t.y = 3
+  assert(#log == 1 and log[1] == "y")
+  t.y = nil
+  t.y = 4
+  assert(#log == 2 and t.y == 4)
+  assert(rawget(t, "x") == 2)
+end
+
+-- traversal allows assignment to existing fields
+do
+  local t = {a = 1, b = 2, c = 3, d = 4}
+  for k, v in pairs(t) do t[k] = v * 10 end
+  assert(t.a == 10 and t.b == 20 and t.c == 30 and t.d == 40)
+  for k in pairs(t) do t[k] = nil end
+  assert(next(t) == nil)
+
+  local k, v = next({q = 7})
+  assert(k == "q" and v == 7)
+  assert(next({q = 7}, "q") == nil)
+  assert(not pcall(next, {q = 7}, "r"))
+end
+
+-- table library
+do
+  local t = {a = 1, b = 2}
+  local c = table.clone(t)
+  c.a = 3
+  c.c = 4
+  assert(t.a == 1 and t.c == nil and c.a == 3 and c.b == 2 and c.c == 4)
+
+  table.clear(c)
+  assert(next(c) == nil)
+  c.b = 5
+  assert(c.b == 5 and count(c) == 1)
+
+  local f = table.freeze({a = 1})
+  assert(not pcall(function() f.a = 2 end))
+  assert(not pcall(function() f.b = 2 end))
+  assert(f.a == 1)
+end
+
+-- table constructors that use templates
+do
+  local function make(i) return {kind = "node", value = i, left = false, right = false} end
+
+  local root = make(0)
+  local cur = root
+  for i = 1, 20 do
+    cur.left = make(i)
+    cur = cur.left
+  end
+
+  local depth = 0
+  cur = root
+  while cur do
+    assert(cur.kind == "node" and cur.value == depth)
+    depth = depth + 1
+    cur = cur.left
+  end
+  assert(depth == 21)
+
+  -- templates with more keys than a shape can hold
+  local big = {a1 = 1, a2 = 2, a3 = 3, a4 = 4, a5 = 5, a6 = 6, a7 = 7, a8 = 8, a9 = 9, a10 = 10, a11 = 11, a12 = 12, a13 = 13, a14 = 14,
+    a15 = 15, a16 = 16, a17 = 17, a18 = 18, a19 = 19, a20 = 20, a21 = 21, a22 = 22, a23 = 23, a24 = 24, a25 = 25, a26 = 26, a27 = 27,
+    a28 = 28, a29 = 29, a30 = 30, a31 = 31, a32 = 32}
+  big.a33 = 33
+  assert(count(big) == 33 and big.a1 == 1 and big.a32 == 32 and big.a33 == 33)
+end
+
+-- empty tables that get their size from the fields assigned to them
+do
+  local function vec(x, y, z)
+    local v = {}
+    v.x = x
+    v.y = y
+    v.z = z
+    return v
+  end
+
+  local s = 0
+  for i = 1, 10 do
+    local v = vec(i, 2 * i, 3 * i)
+    v.x = v.x + v.y + v.z
+    s = s + v.x
+  end
+  assert(s == 330)
+
+  local keys = ""
+  for k in pairs(vec(1, 2, 3)) do keys = keys .. k end
+  assert(keys == "xyz")
+
+  local v = vec(1, 2, 3)
+  v[1.5] = 4
+  v.w = 5
+  assert(v.x == 1 and v.y == 2 and v.z == 3 and v[1.5] == 4 and v.w == 5 and count(v) == 5)
+
+  local u = vec(1, 2, 3)
+  u.w = 4
+  u.q = 5
+  assert(u.w == 4 and u.q == 5 and count(u) == 5)
+end
+
+-- many distinct layouts
+do
+  local objects = {}
+  for i = 1, 5000 do
+    local t = {}
+    t["k" .. i] = i
+    t["j" .. (i % 7)] = -i
+    t.common = true
+    objects[i] = t
+  end
+
+  collectgarbage()
+
+  for i = 1, 5000 do
+    local t = objects[i]
+    assert(t["k" .. i] == i and t["j" .. (i % 7)] == -i and t.common)
+  end
+end
+
+-- weak tables
+do
+  local wk = setmetatable({}, {__mode = "k"})
+  local wv = setmetatable({}, {__mode = "v"})
+
+  wv.a = {}
+  wv.b = "str"
+  wk.c = {}
+
+  collectgarbage()
+
+  assert(wv.a == nil and wv.b == "str")
+  assert(type(wk.c) == "table")
+end
+
+-- globals
+do
+  _G.shapedglobal = 1
+  shapedglobal = shapedglobal + 1
+  assert(_G.shapedglobal == 2)
+  _G.shapedglobal = nil
+  assert(shapedglobal == nil)
+end
+
+return "OK"
@@ -33,6 +33,15 @@ int optimizationLevel = 1;
 // Run conformance tests with native code generation
 bool codegen = false;
 
+// Compile functions for conformance tests as they become hot instead of compiling whole modules; can be enabled via --codegen-tiering
+bool codegenTiering = false;
+
+// Run conformance tests with A64 native code in the built-in emulator; can be enabled via --codegen-a64
+bool codegenA64 = false;
+
+// Directory for the native code cache used by conformance tests; can be set via --codegen-cache=<dir>
+std::string codegenCache;
+
 // Something to seed a pseudorandom number generator with
 std::optional<unsigned> randomSeed;
 
@@ -282,6 +291,24 @@ int main(int argc, char** argv)
         codegen = true;
     }
 
+    if (doctest::parseFlag(argc, argv, "--codegen-tiering"))
+    {
+        codegen = true;
+        codegenTiering = true;
+    }
+
+    if (doctest::parseFlag(argc, argv, "--codegen-a64"))
+    {
+        codegen = true;
+        codegenA64 = true;
+    }
+
+    doctest::String cacheDirectory;
+    if (doctest::parseOption(argc, argv, "--codegen-cache", &cacheDirectory) && cacheDirectory[0] == '=')
+    {
+        codegenCache = cacheDirectory.c_str() + 1;
+    }
+
     int level = -1;
     if (doctest::parseIntOption(argc, argv, "-O", doctest::option_int, level))
     {